@@ -0,0 +1,113 @@
+/**
+ * @file bench_gen.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 生成代码与模型解释执行的性能对比
+ *
+ * python3 tools/cson_gen.py -o bench_gen_model_gen --include bench_gen_model.h bench/bench_gen_model.c
+ * gcc -O2 -I. -Ibench bench/bench_gen.c bench/bench_gen_model.c bench_gen_model_gen.c cson.c cJSON.c -lm
+ */
+
+#include "cson.h"
+#include "bench_gen_model.h"
+#include "bench_gen_model_gen.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+static const char *s_sample =
+    "{\"id\":1024,\"name\":\"sensor-gateway-07\",\"created\":1760745600,\"score\":97.125,\"ratio\":0.1,"
+    "\"active\":true,\"extra\":{\"fw\":\"2.1.0\",\"tags\":[\"a\",\"b\"]},"
+    "\"pos\":{\"x\":120,\"y\":-45,\"tag\":\"origin\\n\\\"0\\\"\"},"
+    "\"path\":[{\"x\":1,\"y\":2,\"tag\":\"a\"},{\"x\":3,\"y\":4,\"tag\":\"b\"},{\"x\":5,\"y\":6,\"tag\":\"c\"},"
+    "{\"x\":7,\"y\":8,\"tag\":\"d\"}],\"ids\":[10,20,30,40,50,60,70,80],\"flags\":[1,0,1,1],"
+    "\"labels\":[\"north\",\"\\u00e9t\\u00e9\"]}";
+
+/**
+ * @brief 当前时间(秒)
+ *
+ * @return double 时间
+ */
+static double bench_now(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief 输出单项结果
+ *
+ * @param name 名称
+ * @param seconds 耗时
+ * @param iterations 迭代次数
+ * @param bytes 单次数据大小
+ */
+static void bench_report(const char *name, double seconds, int iterations, size_t bytes)
+{
+    printf("%-16s %10.1f ns/op %10.1f MB/s\n", name, seconds * 1e9 / iterations,
+           seconds > 0 ? (double)bytes * iterations / seconds / (1024 * 1024) : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+    record_t *record, *copy;
+    char *json, *gen;
+    size_t json_len;
+    double start;
+    int same;
+
+    cson_init(malloc, free);
+    record = cson_decode_ex(s_sample, record_model);
+    json = cson_encode_unformatted_ex(record, record_model);
+    json_len = strlen(json);
+
+    gen = cson_gen_record_model_encode(record);
+    same = gen && strcmp(gen, json) == 0;
+    cson_free_json(gen);
+    copy = cson_gen_record_model_decode(json);
+    gen = cson_gen_record_model_encode(copy);
+    same = same && gen && strcmp(gen, json) == 0;
+    cson_free_json(gen);
+    cson_free_ex(copy, record_model);
+    printf("json %zu bytes, %d iterations, generated output %s\n", json_len, iterations,
+           same ? "identical" : "DIFFERENT");
+
+    start = bench_now();
+    for (int i = 0; i < iterations; i++)
+    {
+        cson_free_json(cson_encode_unformatted_ex(record, record_model));
+    }
+    bench_report("model encode", bench_now() - start, iterations, json_len);
+
+    start = bench_now();
+    for (int i = 0; i < iterations; i++)
+    {
+        cson_free_json(cson_gen_record_model_encode(record));
+    }
+    bench_report("gen encode", bench_now() - start, iterations, json_len);
+
+    start = bench_now();
+    for (int i = 0; i < iterations; i++)
+    {
+        copy = cson_decode_ex(json, record_model);
+        cson_free_ex(copy, record_model);
+    }
+    bench_report("model decode", bench_now() - start, iterations, json_len);
+
+    start = bench_now();
+    for (int i = 0; i < iterations; i++)
+    {
+        copy = cson_gen_record_model_decode(json);
+        cson_free_ex(copy, record_model);
+    }
+    bench_report("gen decode", bench_now() - start, iterations, json_len);
+
+    cson_free_json(json);
+    cson_free_ex(record, record_model);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file bench_gen_model.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 代码生成性能测试使用的数据模型，同时作为tools/cson_gen.py的输入
+ */
+
+#include "bench_gen_model.h"
+
+cson_model_t point_model[4] = {
+    CSON_MODEL_OBJ(point_t),
+    CSON_MODEL_INT(point_t, x),
+    CSON_MODEL_INT(point_t, y),
+    CSON_MODEL_STRING(point_t, tag),
+};
+
+cson_model_t record_model[13] = {
+    CSON_MODEL_OBJ(record_t),
+    CSON_MODEL_INT(record_t, id),
+    CSON_MODEL_STRING(record_t, name),
+    CSON_MODEL_LONG(record_t, created),
+    CSON_MODEL_DOUBLE(record_t, score),
+    CSON_MODEL_FLOAT(record_t, ratio),
+    {CSON_TYPE_BOOL, "active", offsetof(record_t, active)},
+    CSON_MODEL_JSON(record_t, extra),
+    CSON_MODEL_STRUCT(record_t, pos, point_model, sizeof(point_model) / sizeof(cson_model_t)),
+    CSON_MODEL_LIST(record_t, path, point_model, sizeof(point_model) / sizeof(cson_model_t)),
+    CSON_MODEL_LIST(record_t, ids, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_ARRAY(record_t, flags, CSON_TYPE_INT, 4),
+    CSON_MODEL_ARRAY(record_t, labels, CSON_TYPE_STRING, 2),
+};
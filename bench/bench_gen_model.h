@@ -0,0 +1,43 @@
+/**
+ * @file bench_gen_model.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 代码生成性能测试使用的数据结构
+ */
+
+#ifndef __BENCH_GEN_MODEL_H__
+#define __BENCH_GEN_MODEL_H__
+
+#include "cson.h"
+
+typedef struct
+{
+    int x;
+    int y;
+    char *tag;
+} point_t;
+
+typedef struct
+{
+    int id;
+    char *name;
+    long created;
+    double score;
+    float ratio;
+    char active;
+    char *extra;
+    point_t *pos;
+    cson_list_t *path;
+    cson_list_t *ids;
+    int flags[4];
+    char *labels[2];
+} record_t;
+
+extern cson_model_t point_model[4];
+extern cson_model_t record_model[13];
+
+#endif
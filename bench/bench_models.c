@@ -0,0 +1,355 @@
+/**
+ * @file bench_models.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 性能测试使用的代表性数据模型及测试文档，同时作为tools/cson_gen.py的输入
+ */
+
+#include "bench_models.h"
+#include "stdarg.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+cson_model_t bench_flat_model[13] = {
+    CSON_MODEL_OBJ(bench_flat_t),
+    CSON_MODEL_INT(bench_flat_t, id),
+    CSON_MODEL_STRING(bench_flat_t, name),
+    CSON_MODEL_LONG(bench_flat_t, created),
+    CSON_MODEL_DOUBLE(bench_flat_t, score),
+    CSON_MODEL_FLOAT(bench_flat_t, ratio),
+    {CSON_TYPE_BOOL, "active", offsetof(bench_flat_t, active)},
+    CSON_MODEL_SHORT(bench_flat_t, level),
+    CSON_MODEL_STRING(bench_flat_t, status),
+    CSON_MODEL_INT(bench_flat_t, count),
+    CSON_MODEL_DOUBLE(bench_flat_t, lat),
+    CSON_MODEL_DOUBLE(bench_flat_t, lng),
+    CSON_MODEL_STRING(bench_flat_t, owner),
+};
+
+cson_model_t bench_node_model[5] = {
+    CSON_MODEL_OBJ(bench_node_t),
+    CSON_MODEL_INT(bench_node_t, depth),
+    CSON_MODEL_STRING(bench_node_t, name),
+    CSON_MODEL_DOUBLE(bench_node_t, weight),
+    CSON_MODEL_STRUCT(bench_node_t, child, bench_node_model, 5),
+};
+
+cson_model_t bench_point_model[3] = {
+    CSON_MODEL_OBJ(bench_point_t),
+    CSON_MODEL_INT(bench_point_t, x),
+    CSON_MODEL_INT(bench_point_t, y),
+};
+
+cson_model_t bench_track_model[4] = {
+    CSON_MODEL_OBJ(bench_track_t),
+    CSON_MODEL_INT(bench_track_t, id),
+    CSON_MODEL_LIST(bench_track_t, points, bench_point_model, 3),
+    CSON_MODEL_LIST(bench_track_t, ids, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+};
+
+cson_model_t bench_text_model[6] = {
+    CSON_MODEL_OBJ(bench_text_t),
+    CSON_MODEL_STRING(bench_text_t, title),
+    CSON_MODEL_STRING(bench_text_t, author),
+    CSON_MODEL_STRING(bench_text_t, body),
+    CSON_MODEL_STRING(bench_text_t, url),
+    CSON_MODEL_ARRAY(bench_text_t, labels, CSON_TYPE_STRING, 4),
+};
+
+cson_model_t bench_number_model[8] = {
+    CSON_MODEL_OBJ(bench_number_t),
+    CSON_MODEL_INT(bench_number_t, seq),
+    CSON_MODEL_LONG(bench_number_t, stamp),
+    CSON_MODEL_DOUBLE(bench_number_t, mean),
+    CSON_MODEL_DOUBLE(bench_number_t, stddev),
+    CSON_MODEL_ARRAY(bench_number_t, values, CSON_TYPE_DOUBLE, 16),
+    CSON_MODEL_ARRAY(bench_number_t, gains, CSON_TYPE_FLOAT, 8),
+    CSON_MODEL_ARRAY(bench_number_t, counters, CSON_TYPE_INT, 8),
+};
+
+cson_model_t bench_flat_doc_model[3] = {
+    CSON_MODEL_OBJ(bench_doc_root_t),
+    CSON_MODEL_INT(bench_doc_root_t, version),
+    CSON_MODEL_LIST(bench_doc_root_t, items, bench_flat_model, 13),
+};
+
+cson_model_t bench_track_doc_model[3] = {
+    CSON_MODEL_OBJ(bench_doc_root_t),
+    CSON_MODEL_INT(bench_doc_root_t, version),
+    CSON_MODEL_LIST(bench_doc_root_t, items, bench_track_model, 4),
+};
+
+cson_model_t bench_text_doc_model[3] = {
+    CSON_MODEL_OBJ(bench_doc_root_t),
+    CSON_MODEL_INT(bench_doc_root_t, version),
+    CSON_MODEL_LIST(bench_doc_root_t, items, bench_text_model, 6),
+};
+
+cson_model_t bench_number_doc_model[3] = {
+    CSON_MODEL_OBJ(bench_doc_root_t),
+    CSON_MODEL_INT(bench_doc_root_t, version),
+    CSON_MODEL_LIST(bench_doc_root_t, items, bench_number_model, 8),
+};
+
+/**
+ * @brief 各规模的记录数量
+ *
+ */
+static const int s_bench_items[BENCH_SCALE_MAX] = {1, 16, 256};
+
+/**
+ * @brief 各规模的嵌套层数
+ *
+ */
+static const int s_bench_depth[BENCH_SCALE_MAX] = {4, 32, 256};
+
+static const char *s_bench_scale_name[BENCH_SCALE_MAX] = {"small", "medium", "large"};
+
+static const char *s_bench_words[] = {
+    "sensor", "gateway", "north", "relay", "alpha", "delta", "meter", "bridge",
+    "ridge", "harbor", "signal", "vector", "orbit", "linear", "summit", "canyon",
+};
+
+/**
+ * @brief 文档输出缓冲
+ *
+ */
+typedef struct
+{
+    char *data;
+    size_t len;
+    size_t cap;
+    int error;
+} bench_buf_t;
+
+/**
+ * @brief 伪随机数(xorshift32)
+ *
+ * @param state 状态
+ * @return unsigned int 随机数
+ */
+static unsigned int bench_rand(unsigned int *state)
+{
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief 格式化写入文档
+ *
+ * @param buf 输出缓冲
+ * @param fmt 格式
+ */
+static void bench_printf(bench_buf_t *buf, const char *fmt, ...)
+{
+    va_list args;
+    int len;
+
+    if (buf->error)
+    {
+        return;
+    }
+    for (;;)
+    {
+        va_start(args, fmt);
+        len = vsnprintf(buf->data + buf->len, buf->cap - buf->len, fmt, args);
+        va_end(args);
+        if (len < 0)
+        {
+            buf->error = 1;
+            return;
+        }
+        if ((size_t)len < buf->cap - buf->len)
+        {
+            buf->len += (size_t)len;
+            return;
+        }
+        size_t cap = buf->cap * 2 + (size_t)len;
+        char *data = realloc(buf->data, cap);
+        if (!data)
+        {
+            buf->error = 1;
+            return;
+        }
+        buf->data = data;
+        buf->cap = cap;
+    }
+}
+
+/**
+ * @brief 写入随机单词组成的字符串
+ *
+ * @param buf 输出缓冲
+ * @param state 随机数状态
+ * @param words 单词数量
+ * @param escape 是否混入转义字符及非ASCII字符
+ */
+static void bench_text(bench_buf_t *buf, unsigned int *state, int words, int escape)
+{
+    bench_printf(buf, "\"");
+    for (int i = 0; i < words; i++)
+    {
+        unsigned int r = bench_rand(state);
+        bench_printf(buf, "%s%s", i ? " " : "", s_bench_words[r % (sizeof(s_bench_words) / sizeof(char *))]);
+        if (escape && (r >> 8) % 8 == 0)
+        {
+            static const char *escapes[] = {"\\n", "\\\"q\\\"", "\\u00e9t\\u00e9", "caf\xc3\xa9", "\\t", "\\\\"};
+            bench_printf(buf, " %s", escapes[(r >> 16) % (sizeof(escapes) / sizeof(char *))]);
+        }
+    }
+    bench_printf(buf, "\"");
+}
+
+static void bench_flat_item(bench_buf_t *buf, unsigned int *state, int i)
+{
+    bench_printf(buf, "{\"id\":%d,\"name\":", i + 1);
+    bench_text(buf, state, 2, 0);
+    bench_printf(buf, ",\"created\":%u,\"score\":%.3f,\"ratio\":%.2f,\"active\":%s,\"level\":%u,\"status\":",
+                 1760000000u + bench_rand(state) % 1000000, (bench_rand(state) % 100000) / 1000.0,
+                 (bench_rand(state) % 100) / 100.0, bench_rand(state) % 2 ? "true" : "false", bench_rand(state) % 16);
+    bench_text(buf, state, 1, 0);
+    bench_printf(buf, ",\"count\":%u,\"lat\":%.6f,\"lng\":%.6f,\"owner\":", bench_rand(state) % 100000,
+                 (int)(bench_rand(state) % 180000000) / 1e6 - 90.0, (int)(bench_rand(state) % 360000000) / 1e6 - 180.0);
+    bench_text(buf, state, 2, 0);
+    bench_printf(buf, "}");
+}
+
+static void bench_track_item(bench_buf_t *buf, unsigned int *state, int i)
+{
+    bench_printf(buf, "{\"id\":%d,\"points\":[", i + 1);
+    for (int j = 0; j < 16; j++)
+    {
+        bench_printf(buf, "%s{\"x\":%d,\"y\":%d}", j ? "," : "", (int)(bench_rand(state) % 2000) - 1000,
+                     (int)(bench_rand(state) % 2000) - 1000);
+    }
+    bench_printf(buf, "],\"ids\":[");
+    for (int j = 0; j < 16; j++)
+    {
+        bench_printf(buf, "%s%u", j ? "," : "", bench_rand(state) % 1000000);
+    }
+    bench_printf(buf, "]}");
+}
+
+static void bench_text_item(bench_buf_t *buf, unsigned int *state, int i)
+{
+    (void)i;
+    bench_printf(buf, "{\"title\":");
+    bench_text(buf, state, 6, 1);
+    bench_printf(buf, ",\"author\":");
+    bench_text(buf, state, 2, 0);
+    bench_printf(buf, ",\"body\":");
+    bench_text(buf, state, 40 + (int)(bench_rand(state) % 40), 1);
+    bench_printf(buf, ",\"url\":\"https:\\/\\/example.com\\/%s\\/%u\",\"labels\":[",
+                 s_bench_words[bench_rand(state) % (sizeof(s_bench_words) / sizeof(char *))], bench_rand(state));
+    for (int j = 0; j < 4; j++)
+    {
+        bench_printf(buf, "%s", j ? "," : "");
+        bench_text(buf, state, 1, 0);
+    }
+    bench_printf(buf, "]}");
+}
+
+static void bench_number_item(bench_buf_t *buf, unsigned int *state, int i)
+{
+    bench_printf(buf, "{\"seq\":%d,\"stamp\":%u,\"mean\":%.9f,\"stddev\":%.9f,\"values\":[", i,
+                 bench_rand(state), (int)(bench_rand(state) % 2000000) / 1000.0 - 1000.0,
+                 (bench_rand(state) % 1000000) / 1e4);
+    for (int j = 0; j < 16; j++)
+    {
+        bench_printf(buf, "%s%.6f", j ? "," : "", (int)(bench_rand(state) % 2000000000) / 1e6 - 1000.0);
+    }
+    bench_printf(buf, "],\"gains\":[");
+    for (int j = 0; j < 8; j++)
+    {
+        bench_printf(buf, "%s%.3f", j ? "," : "", (bench_rand(state) % 10000) / 1000.0);
+    }
+    bench_printf(buf, "],\"counters\":[");
+    for (int j = 0; j < 8; j++)
+    {
+        bench_printf(buf, "%s%d", j ? "," : "", (int)(bench_rand(state) % 2000000) - 1000000);
+    }
+    bench_printf(buf, "]}");
+}
+
+static void bench_nested(bench_buf_t *buf, unsigned int *state, int depth)
+{
+    for (int i = 0; i < depth; i++)
+    {
+        bench_printf(buf, "{\"depth\":%d,\"name\":", i);
+        bench_text(buf, state, 1, 0);
+        bench_printf(buf, ",\"weight\":%.4f%s", (bench_rand(state) % 100000) / 1e4, i + 1 < depth ? ",\"child\":" : "");
+    }
+    for (int i = 0; i < depth; i++)
+    {
+        bench_printf(buf, "}");
+    }
+}
+
+int bench_doc_build(bench_doc_t *doc, bench_shape_t shape, bench_scale_t scale)
+{
+    static const char *shape_name[BENCH_SHAPE_MAX] = {"flat", "nested", "list", "string", "number"};
+    static cson_model_t *model[BENCH_SHAPE_MAX] = {
+        bench_flat_doc_model, bench_node_model, bench_track_doc_model, bench_text_doc_model, bench_number_doc_model,
+    };
+    static const int model_size[BENCH_SHAPE_MAX] = {3, 5, 3, 3, 3};
+    static void (*item[BENCH_SHAPE_MAX])(bench_buf_t *, unsigned int *, int) = {
+        bench_flat_item, NULL, bench_track_item, bench_text_item, bench_number_item,
+    };
+    bench_buf_t buf = {NULL, 0, 0, 0};
+    unsigned int state = 0x9E3779B9u ^ (unsigned int)(shape * 131 + scale);
+
+    if (shape >= BENCH_SHAPE_MAX || scale >= BENCH_SCALE_MAX)
+    {
+        return -1;
+    }
+    buf.cap = 256;
+    buf.data = malloc(buf.cap);
+    if (!buf.data)
+    {
+        return -1;
+    }
+    if (shape == BENCH_SHAPE_NESTED)
+    {
+        doc->objects = s_bench_depth[scale];
+        bench_nested(&buf, &state, doc->objects);
+    }
+    else
+    {
+        doc->objects = s_bench_items[scale];
+        bench_printf(&buf, "{\"version\":1,\"items\":[");
+        for (int i = 0; i < doc->objects; i++)
+        {
+            bench_printf(&buf, "%s", i ? "," : "");
+            item[shape](&buf, &state, i);
+        }
+        bench_printf(&buf, "]}");
+    }
+    if (buf.error)
+    {
+        free(buf.data);
+        return -1;
+    }
+    doc->shape = shape_name[shape];
+    doc->scale = s_bench_scale_name[scale];
+    doc->model = model[shape];
+    doc->model_size = model_size[shape];
+    doc->json = buf.data;
+    doc->json_len = buf.len;
+    return 0;
+}
+
+void bench_doc_release(bench_doc_t *doc)
+{
+    free(doc->json);
+    doc->json = NULL;
+    doc->json_len = 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file bench_models.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 性能测试使用的代表性数据模型及测试文档
+ */
+
+#ifndef __BENCH_MODELS_H__
+#define __BENCH_MODELS_H__
+
+#include "cson.h"
+
+/**
+ * @brief 扁平结构体，全部为基础类型成员
+ *
+ */
+typedef struct
+{
+    int id;
+    char *name;
+    long created;
+    double score;
+    float ratio;
+    char active;
+    short level;
+    char *status;
+    int count;
+    double lat;
+    double lng;
+    char *owner;
+} bench_flat_t;
+
+/**
+ * @brief 深层嵌套结构体
+ *
+ */
+typedef struct bench_node
+{
+    int depth;
+    char *name;
+    double weight;
+    struct bench_node *child;
+} bench_node_t;
+
+/**
+ * @brief 链表元素
+ *
+ */
+typedef struct
+{
+    int x;
+    int y;
+} bench_point_t;
+
+/**
+ * @brief 链表密集结构体
+ *
+ */
+typedef struct
+{
+    int id;
+    cson_list_t *points;
+    cson_list_t *ids;
+} bench_track_t;
+
+/**
+ * @brief 字符串密集结构体
+ *
+ */
+typedef struct
+{
+    char *title;
+    char *author;
+    char *body;
+    char *url;
+    char *labels[4];
+} bench_text_t;
+
+/**
+ * @brief 数值密集结构体
+ *
+ */
+typedef struct
+{
+    int seq;
+    long stamp;
+    double mean;
+    double stddev;
+    double values[16];
+    float gains[8];
+    int counters[8];
+} bench_number_t;
+
+/**
+ * @brief 文档根结构体，items为对应形状的结构体链表
+ *
+ */
+typedef struct
+{
+    int version;
+    cson_list_t *items;
+} bench_doc_root_t;
+
+extern cson_model_t bench_flat_model[13];
+extern cson_model_t bench_node_model[5];
+extern cson_model_t bench_point_model[3];
+extern cson_model_t bench_track_model[4];
+extern cson_model_t bench_text_model[6];
+extern cson_model_t bench_number_model[8];
+
+extern cson_model_t bench_flat_doc_model[3];
+extern cson_model_t bench_track_doc_model[3];
+extern cson_model_t bench_text_doc_model[3];
+extern cson_model_t bench_number_doc_model[3];
+
+/**
+ * @brief 模型形状
+ *
+ */
+typedef enum
+{
+    BENCH_SHAPE_FLAT = 0,
+    BENCH_SHAPE_NESTED,
+    BENCH_SHAPE_LIST,
+    BENCH_SHAPE_STRING,
+    BENCH_SHAPE_NUMBER,
+    BENCH_SHAPE_MAX,
+} bench_shape_t;
+
+/**
+ * @brief 文档规模
+ *
+ */
+typedef enum
+{
+    BENCH_SCALE_SMALL = 0,
+    BENCH_SCALE_MEDIUM,
+    BENCH_SCALE_LARGE,
+    BENCH_SCALE_MAX,
+} bench_scale_t;
+
+/**
+ * @brief 测试文档
+ *
+ */
+typedef struct
+{
+    const char *shape;   /**< 形状名称 */
+    const char *scale;   /**< 规模名称 */
+    cson_model_t *model; /**< 根数据模型 */
+    int model_size;      /**< 根数据模型数量 */
+    int objects;         /**< 文档包含的记录数量，嵌套形状为嵌套层数 */
+    char *json;          /**< JSON文档 */
+    size_t json_len;     /**< JSON文档长度 */
+} bench_doc_t;
+
+/**
+ * @brief 生成测试文档，内容由固定种子确定，每次生成结果相同
+ *
+ * @param doc 测试文档
+ * @param shape 模型形状
+ * @param scale 文档规模
+ * @return int 0成功，-1失败
+ */
+int bench_doc_build(bench_doc_t *doc, bench_shape_t shape, bench_scale_t scale);
+
+/**
+ * @brief 释放测试文档
+ *
+ * @param doc 测试文档
+ */
+void bench_doc_release(bench_doc_t *doc);
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * @file bench_msgpack.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief JSON与MessagePack编解码性能对比
+ *
+ * gcc -O2 -I. bench/bench_msgpack.c cson.c cson_msgpack.c cJSON.c -o bench_msgpack
+ */
+
+#include "cson.h"
+#include "cson_msgpack.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+typedef struct
+{
+    int x;
+    int y;
+    char *tag;
+} point_t;
+
+typedef struct
+{
+    int id;
+    char *name;
+    long created;
+    double score;
+    char active;
+    point_t *pos;
+    cson_list_t *path;
+    cson_list_t *ids;
+    int flags[4];
+} record_t;
+
+cson_model_t point_model[] = {
+    CSON_MODEL_OBJ(point_t),
+    CSON_MODEL_INT(point_t, x),
+    CSON_MODEL_INT(point_t, y),
+    CSON_MODEL_STRING(point_t, tag),
+};
+
+cson_model_t record_model[] = {
+    CSON_MODEL_OBJ(record_t),
+    CSON_MODEL_INT(record_t, id),
+    CSON_MODEL_STRING(record_t, name),
+    CSON_MODEL_LONG(record_t, created),
+    CSON_MODEL_DOUBLE(record_t, score),
+    {CSON_TYPE_BOOL, "active", offsetof(record_t, active)},
+    CSON_MODEL_STRUCT(record_t, pos, point_model, sizeof(point_model) / sizeof(cson_model_t)),
+    CSON_MODEL_LIST(record_t, path, point_model, sizeof(point_model) / sizeof(cson_model_t)),
+    CSON_MODEL_LIST(record_t, ids, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_ARRAY(record_t, flags, CSON_TYPE_INT, 4),
+};
+
+static const char *s_sample =
+    "{\"id\":1024,\"name\":\"sensor-gateway-07\",\"created\":1760745600,\"score\":97.125,\"active\":true,"
+    "\"pos\":{\"x\":120,\"y\":-45,\"tag\":\"origin\"},"
+    "\"path\":[{\"x\":1,\"y\":2,\"tag\":\"a\"},{\"x\":3,\"y\":4,\"tag\":\"b\"},{\"x\":5,\"y\":6,\"tag\":\"c\"},"
+    "{\"x\":7,\"y\":8,\"tag\":\"d\"}],\"ids\":[10,20,30,40,50,60,70,80],\"flags\":[1,0,1,1]}";
+
+/**
+ * @brief 当前时间(秒)
+ *
+ * @return double 时间
+ */
+static double bench_now(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief 输出单项结果
+ *
+ * @param name 名称
+ * @param seconds 耗时
+ * @param iterations 迭代次数
+ * @param bytes 单次数据大小
+ */
+static void bench_report(const char *name, double seconds, int iterations, size_t bytes)
+{
+    printf("%-16s %10.1f ns/op %10.1f MB/s\n", name, seconds * 1e9 / iterations,
+           seconds > 0 ? (double)bytes * iterations / seconds / (1024 * 1024) : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+    record_t *record, *copy;
+    unsigned char *packed;
+    size_t json_len, packed_len;
+    char *json;
+    double start;
+
+    cson_init(malloc, free);
+    record = cson_decode(s_sample, record_model, sizeof(record_model) / sizeof(cson_model_t));
+    json = cson_encode_unformatted_ex(record, record_model);
+    json_len = strlen(json);
+    packed = cson_msgpack_encode_ex(record, record_model, &packed_len);
+    printf("json %zu bytes, msgpack %zu bytes, %d iterations\n", json_len, packed_len, iterations);
+
+    start = bench_now();
+    for (int i = 0; i < iterations; i++)
+    {
+        cson_free_json(cson_encode_unformatted_ex(record, record_model));
+    }
+    bench_report("json encode", bench_now() - start, iterations, json_len);
+
+    start = bench_now();
+    for (int i = 0; i < iterations; i++)
+    {
+        copy = cson_decode(json, record_model, sizeof(record_model) / sizeof(cson_model_t));
+        cson_free_ex(copy, record_model);
+    }
+    bench_report("json decode", bench_now() - start, iterations, json_len);
+
+    start = bench_now();
+    for (int i = 0; i < iterations; i++)
+    {
+        cson_msgpack_free(cson_msgpack_encode_ex(record, record_model, NULL));
+    }
+    bench_report("msgpack encode", bench_now() - start, iterations, packed_len);
+
+    start = bench_now();
+    for (int i = 0; i < iterations; i++)
+    {
+        copy = cson_msgpack_decode_ex(packed, packed_len, record_model);
+        cson_free_ex(copy, record_model);
+    }
+    bench_report("msgpack decode", bench_now() - start, iterations, packed_len);
+
+    cson_msgpack_free(packed);
+    cson_free_json(json);
+    cson_free_ex(record, record_model);
+    return 0;
+}
@@ -0,0 +1,360 @@
+/**
+ * @file bench_threads.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 多线程扩展性测试
+ *
+ * `s_cson`及cJSON的分配钩子是进程级全局状态，所有节点都经过同一个分配器；
+ * 通过对比不同分配方式下吞吐量随线程数的变化，区分瓶颈来自分配器还是解析本身
+ */
+
+#include "bench_threads.h"
+#include "cson_slab.h"
+#include "pthread.h"
+#include "sched.h"
+#include "stdatomic.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+#if defined(__GNUC__)
+#define BENCH_TLS __thread
+#else
+#define BENCH_TLS _Thread_local
+#endif
+
+/**
+ * @brief arena初始容量
+ *
+ */
+#define BENCH_ARENA_SIZE (64 * 1024)
+
+/**
+ * @brief arena内存块，数据紧随其后
+ *
+ */
+typedef struct bench_arena_chunk
+{
+    struct bench_arena_chunk *next;
+    size_t size;
+    size_t used;
+    double align;
+} bench_arena_chunk_t;
+
+/**
+ * @brief 工作线程状态
+ *
+ */
+typedef struct
+{
+    const bench_doc_t *doc;
+    bench_alloc_t alloc;
+    atomic_int *start;
+    atomic_int *stop;
+    unsigned int *samples; /**< 每条消息耗时(ns) */
+    size_t count;
+    size_t cap;
+    long long ops;
+    int error;
+} bench_worker_t;
+
+static BENCH_TLS bench_arena_chunk_t *s_bench_arena = NULL;
+
+static const char *s_bench_alloc_name[BENCH_ALLOC_MAX] = {"malloc", "slab", "arena"};
+
+const char *bench_alloc_name(bench_alloc_t alloc)
+{
+    return alloc < BENCH_ALLOC_MAX ? s_bench_alloc_name[alloc] : "unknown";
+}
+
+/**
+ * @brief arena分配，当前块不足时分配容量翻倍的新块
+ *
+ * @param size 大小
+ * @return void* 内存
+ */
+static void *bench_arena_malloc(size_t size)
+{
+    bench_arena_chunk_t *chunk = s_bench_arena;
+
+    size = (size + 15) & ~(size_t)15;
+    if (!chunk || chunk->used + size > chunk->size)
+    {
+        size_t cap = chunk ? chunk->size * 2 : BENCH_ARENA_SIZE;
+        while (cap < size)
+        {
+            cap *= 2;
+        }
+        chunk = malloc(sizeof(bench_arena_chunk_t) + cap);
+        if (!chunk)
+        {
+            return NULL;
+        }
+        chunk->next = s_bench_arena;
+        chunk->size = cap;
+        chunk->used = 0;
+        s_bench_arena = chunk;
+    }
+    void *ptr = (char *)(chunk + 1) + chunk->used;
+    chunk->used += size;
+    return ptr;
+}
+
+/**
+ * @brief arena释放，内存在消息处理完成后整体回收
+ *
+ * @param ptr 内存
+ */
+static void bench_arena_free(void *ptr)
+{
+    (void)ptr;
+}
+
+/**
+ * @brief 重置arena，仅保留最大的块
+ *
+ */
+static void bench_arena_reset(void)
+{
+    bench_arena_chunk_t *chunk = s_bench_arena;
+
+    if (!chunk)
+    {
+        return;
+    }
+    while (chunk->next)
+    {
+        bench_arena_chunk_t *next = chunk->next->next;
+        free(chunk->next);
+        chunk->next = next;
+    }
+    chunk->used = 0;
+}
+
+/**
+ * @brief 释放arena全部内存
+ *
+ */
+static void bench_arena_release(void)
+{
+    bench_arena_reset();
+    free(s_bench_arena);
+    s_bench_arena = NULL;
+}
+
+static double bench_threads_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief 记录一条消息的耗时
+ *
+ * @param worker 工作线程状态
+ * @param ns 耗时
+ */
+static void bench_worker_sample(bench_worker_t *worker, double ns)
+{
+    if (worker->count == worker->cap)
+    {
+        size_t cap = worker->cap ? worker->cap * 2 : 4096;
+        unsigned int *samples = realloc(worker->samples, cap * sizeof(unsigned int));
+        if (!samples)
+        {
+            worker->error = 1;
+            return;
+        }
+        worker->samples = samples;
+        worker->cap = cap;
+    }
+    worker->samples[worker->count++] = ns < 4e9 ? (unsigned int)ns : 0xFFFFFFFFu;
+}
+
+static void *bench_worker(void *arg)
+{
+    bench_worker_t *worker = arg;
+    const bench_doc_t *doc = worker->doc;
+    char *json = malloc(doc->json_len + 1);
+
+    if (!json)
+    {
+        worker->error = 1;
+        return NULL;
+    }
+    memcpy(json, doc->json, doc->json_len + 1);
+    while (!atomic_load(worker->start))
+    {
+        sched_yield();
+    }
+    while (!atomic_load_explicit(worker->stop, memory_order_relaxed))
+    {
+        double start = bench_threads_now();
+        void *obj = cson_decode(json, doc->model, doc->model_size);
+        if (!obj)
+        {
+            worker->error = 1;
+            break;
+        }
+        cson_free_json(cson_encode_unformatted(obj, doc->model, doc->model_size));
+        cson_free(obj, doc->model, doc->model_size);
+        if (worker->alloc == BENCH_ALLOC_ARENA)
+        {
+            bench_arena_reset();
+        }
+        bench_worker_sample(worker, (bench_threads_now() - start) * 1e9);
+        worker->ops++;
+    }
+    if (worker->alloc == BENCH_ALLOC_ARENA)
+    {
+        bench_arena_release();
+    }
+    else if (worker->alloc == BENCH_ALLOC_SLAB)
+    {
+        cson_slab_thread_exit();
+    }
+    free(json);
+    return NULL;
+}
+
+static int bench_sample_compare(const void *a, const void *b)
+{
+    unsigned int x = *(const unsigned int *)a;
+    unsigned int y = *(const unsigned int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 计算百分位
+ *
+ * @param samples 已排序的样本
+ * @param count 样本数量
+ * @param q 分位(0~1)
+ * @return double 分位值
+ */
+static double bench_percentile(const unsigned int *samples, size_t count, double q)
+{
+    return count ? (double)samples[(size_t)((double)(count - 1) * q)] : 0.0;
+}
+
+/**
+ * @brief 切换分配方式
+ *
+ * @param alloc 分配方式
+ */
+static void bench_alloc_use(bench_alloc_t alloc)
+{
+    switch (alloc)
+    {
+    case BENCH_ALLOC_SLAB:
+        cson_init(cson_slab_malloc, cson_slab_free);
+        break;
+    case BENCH_ALLOC_ARENA:
+        cson_init(bench_arena_malloc, bench_arena_free);
+        break;
+    default:
+        cson_init(malloc, free);
+        break;
+    }
+}
+
+int bench_threads_run(const bench_doc_t *doc, int threads, bench_alloc_t alloc, double seconds,
+                      bench_threads_result_t *result)
+{
+    bench_worker_t *workers;
+    pthread_t *tids;
+    atomic_int start = 0;
+    atomic_int stop = 0;
+    struct timespec wait;
+    unsigned int *samples;
+    size_t count = 0;
+    double begin;
+    int created = 0;
+    int error = 0;
+
+    if (threads < 1 || alloc >= BENCH_ALLOC_MAX)
+    {
+        return -1;
+    }
+    workers = calloc((size_t)threads, sizeof(bench_worker_t));
+    tids = calloc((size_t)threads, sizeof(pthread_t));
+    if (!workers || !tids)
+    {
+        free(workers);
+        free(tids);
+        return -1;
+    }
+
+    bench_alloc_use(alloc);
+    for (; created < threads; created++)
+    {
+        workers[created].doc = doc;
+        workers[created].alloc = alloc;
+        workers[created].start = &start;
+        workers[created].stop = &stop;
+        if (pthread_create(&tids[created], NULL, bench_worker, &workers[created]) != 0)
+        {
+            error = 1;
+            break;
+        }
+    }
+    begin = bench_threads_now();
+    atomic_store(&start, 1);
+    if (!error)
+    {
+        wait.tv_sec = (time_t)seconds;
+        wait.tv_nsec = (long)((seconds - (double)wait.tv_sec) * 1e9);
+        nanosleep(&wait, NULL);
+    }
+    atomic_store(&stop, 1);
+    for (int i = 0; i < created; i++)
+    {
+        pthread_join(tids[i], NULL);
+    }
+    result->seconds = bench_threads_now() - begin;
+    bench_alloc_use(BENCH_ALLOC_MALLOC);
+
+    result->threads = threads;
+    result->ops = 0;
+    for (int i = 0; i < created; i++)
+    {
+        result->ops += workers[i].ops;
+        count += workers[i].count;
+        error |= workers[i].error;
+    }
+    samples = malloc((count ? count : 1) * sizeof(unsigned int));
+    if (samples)
+    {
+        count = 0;
+        for (int i = 0; i < created; i++)
+        {
+            memcpy(samples + count, workers[i].samples, workers[i].count * sizeof(unsigned int));
+            count += workers[i].count;
+        }
+        qsort(samples, count, sizeof(unsigned int), bench_sample_compare);
+    }
+    else
+    {
+        count = 0;
+        error = 1;
+    }
+    result->ops_per_s = (double)result->ops / result->seconds;
+    result->mb_per_s = result->ops_per_s * (double)doc->json_len / (1024 * 1024);
+    result->p50 = bench_percentile(samples, count, 0.5);
+    result->p99 = bench_percentile(samples, count, 0.99);
+    result->p999 = bench_percentile(samples, count, 0.999);
+
+    for (int i = 0; i < created; i++)
+    {
+        free(workers[i].samples);
+    }
+    free(samples);
+    free(workers);
+    free(tids);
+    return error ? -1 : 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file bench_threads.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 多线程扩展性测试
+ */
+
+#ifndef __BENCH_THREADS_H__
+#define __BENCH_THREADS_H__
+
+#include "bench_models.h"
+
+/**
+ * @brief 内存分配方式
+ *
+ */
+typedef enum
+{
+    BENCH_ALLOC_MALLOC = 0, /**< 系统malloc/free */
+    BENCH_ALLOC_SLAB,       /**< 线程局部slab池，见`cson_slab_malloc` */
+    BENCH_ALLOC_ARENA,      /**< 线程局部arena，每条消息处理完成后整体重置 */
+    BENCH_ALLOC_MAX,
+} bench_alloc_t;
+
+/**
+ * @brief 多线程测试结果
+ *
+ */
+typedef struct
+{
+    int threads;        /**< 线程数 */
+    long long ops;      /**< 完成的消息数量 */
+    double seconds;     /**< 实际运行时间 */
+    double ops_per_s;   /**< 每秒消息数 */
+    double mb_per_s;    /**< 吞吐量(按JSON长度) */
+    double p50;         /**< 单条消息耗时中位数(ns) */
+    double p99;         /**< 单条消息耗时p99(ns) */
+    double p999;        /**< 单条消息耗时p999(ns) */
+} bench_threads_result_t;
+
+/**
+ * @brief 分配方式名称
+ *
+ * @param alloc 分配方式
+ * @return const char* 名称
+ */
+const char *bench_alloc_name(bench_alloc_t alloc);
+
+/**
+ * @brief 多线程解析及编码测试
+ *
+ * 每个线程持有独立的消息副本，循环执行解析、编码、释放，记录每条消息的耗时；
+ * 测试期间通过`cson_init`切换为指定的分配方式，结束后恢复为malloc/free
+ *
+ * @param doc 测试文档
+ * @param threads 线程数
+ * @param alloc 分配方式
+ * @param seconds 运行时间
+ * @param result 测试结果
+ * @return int 0成功，-1失败
+ */
+int bench_threads_run(const bench_doc_t *doc, int threads, bench_alloc_t alloc, double seconds,
+                      bench_threads_result_t *result);
+
+#endif
@@ -0,0 +1,754 @@
+/**
+ * @file cson_bench.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 编解码吞吐量测试
+ *
+ * 对扁平、深层嵌套、链表密集、字符串密集、数值密集五种形状的模型，在小、中、大三种文档规模下
+ * 分别测试解析、编码、释放及各二进制格式的耗时，输出每文档耗时、每记录耗时、吞吐量及每记录内存分配次数
+ *
+ * cson_bench [-t 秒] [-f text|csv|json] [-j 线程数,...] [-a malloc,slab,arena] [过滤字符串...]
+ *
+ * - `-t` 每项测试的最短运行时间，默认0.2秒；多线程测试为每种配置的运行时间，默认1秒
+ * - `-f` 输出格式，csv及json便于回归对比
+ * - `-j` 多线程扩展性测试，如`-j 1,2,4,8`，输出吞吐量随线程数的变化及单条消息耗时的p50/p99/p999
+ * - `-a` 多线程测试使用的分配方式，默认全部
+ * - 过滤字符串匹配`形状/规模/操作`，如`flat/large`、`/decode`；多线程测试匹配`形状/规模`
+ */
+
+#include "cson.h"
+#include "cson_msgpack.h"
+#include "cson_cbor.h"
+#include "cson_snapshot.h"
+#include "bench_models.h"
+#include "bench_threads.h"
+#ifdef CSON_BENCH_GEN
+#include "bench_models_gen.h"
+#endif
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+/**
+ * @brief 每批解析的文档数量，释放在计时之外进行
+ *
+ */
+#define BENCH_BATCH 32
+
+/**
+ * @brief 多线程测试最多的线程数配置
+ *
+ */
+#define BENCH_THREADS_MAX 32
+
+/**
+ * @brief 数据格式
+ *
+ */
+typedef enum
+{
+    BENCH_FORMAT_JSON = 0,
+    BENCH_FORMAT_MSGPACK,
+    BENCH_FORMAT_CBOR,
+    BENCH_FORMAT_SNAPSHOT,
+    BENCH_FORMAT_MAX,
+} bench_format_t;
+
+/**
+ * @brief 输出格式
+ *
+ */
+typedef enum
+{
+    BENCH_OUTPUT_TEXT = 0,
+    BENCH_OUTPUT_CSV,
+    BENCH_OUTPUT_JSON,
+} bench_output_t;
+
+/**
+ * @brief 单个文档的测试上下文
+ *
+ */
+typedef struct
+{
+    bench_doc_t doc;                        /**< 测试文档 */
+    void *obj;                              /**< 解析得到的参考对象 */
+    unsigned char *data[BENCH_FORMAT_MAX];  /**< 各格式的编码数据，JSON为doc.json */
+    size_t len[BENCH_FORMAT_MAX];           /**< 各格式的数据长度 */
+    void *(*gen_decode)(const char *);      /**< 生成代码的解析函数 */
+    char *(*gen_encode)(const void *);      /**< 生成代码的编码函数 */
+    void *batch[BENCH_BATCH];               /**< 解析结果 */
+} bench_ctx_t;
+
+/**
+ * @brief 计时及分配计数
+ *
+ */
+typedef struct
+{
+    double seconds;             /**< 累计耗时 */
+    unsigned long long allocs;  /**< 累计分配次数 */
+    double start;               /**< 本段开始时间 */
+    unsigned long long base;    /**< 本段开始时的分配次数 */
+} bench_meter_t;
+
+/**
+ * @brief 测试操作
+ *
+ */
+typedef struct
+{
+    const char *name;                                    /**< 名称 */
+    bench_format_t format;                               /**< 数据格式，用于计算吞吐量 */
+    int gen;                                             /**< 是否依赖生成代码 */
+    void (*run)(bench_ctx_t *ctx, int n, bench_meter_t *meter); /**< 执行n次 */
+} bench_op_t;
+
+static unsigned long long s_bench_allocs = 0;
+
+/**
+ * @brief 计数的内存分配函数
+ *
+ * @param size 大小
+ * @return void* 内存
+ */
+static void *bench_malloc(size_t size)
+{
+    s_bench_allocs++;
+    return malloc(size);
+}
+
+/**
+ * @brief 当前时间(秒)，单调时钟
+ *
+ * @return double 时间
+ */
+static double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void bench_meter_start(bench_meter_t *meter)
+{
+    meter->base = s_bench_allocs;
+    meter->start = bench_now();
+}
+
+static void bench_meter_stop(bench_meter_t *meter)
+{
+    meter->seconds += bench_now() - meter->start;
+    meter->allocs += s_bench_allocs - meter->base;
+}
+
+/**
+ * @brief 按格式解析一次
+ *
+ * @param ctx 测试上下文
+ * @param format 数据格式
+ * @return void* 对象
+ */
+static void *bench_decode_format(bench_ctx_t *ctx, bench_format_t format)
+{
+    bench_doc_t *doc = &ctx->doc;
+
+    switch (format)
+    {
+    case BENCH_FORMAT_MSGPACK:
+        return cson_msgpack_decode(ctx->data[format], ctx->len[format], doc->model, doc->model_size);
+    case BENCH_FORMAT_CBOR:
+        return cson_cbor_decode(ctx->data[format], ctx->len[format], doc->model, doc->model_size);
+    case BENCH_FORMAT_SNAPSHOT:
+        return cson_snapshot_decode(ctx->data[format], ctx->len[format], doc->model, doc->model_size);
+    default:
+        return cson_decode(doc->json, doc->model, doc->model_size);
+    }
+}
+
+/**
+ * @brief 解析n次，每批解析结果在计时外释放
+ *
+ */
+static void bench_run_decode(bench_ctx_t *ctx, int n, bench_meter_t *meter, bench_format_t format)
+{
+    while (n > 0)
+    {
+        int k = n < BENCH_BATCH ? n : BENCH_BATCH;
+        bench_meter_start(meter);
+        for (int i = 0; i < k; i++)
+        {
+            ctx->batch[i] = bench_decode_format(ctx, format);
+        }
+        bench_meter_stop(meter);
+        for (int i = 0; i < k; i++)
+        {
+            cson_free(ctx->batch[i], ctx->doc.model, ctx->doc.model_size);
+        }
+        n -= k;
+    }
+}
+
+static void bench_json_decode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    bench_run_decode(ctx, n, meter, BENCH_FORMAT_JSON);
+}
+
+static void bench_msgpack_decode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    bench_run_decode(ctx, n, meter, BENCH_FORMAT_MSGPACK);
+}
+
+static void bench_cbor_decode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    bench_run_decode(ctx, n, meter, BENCH_FORMAT_CBOR);
+}
+
+static void bench_snapshot_decode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    bench_run_decode(ctx, n, meter, BENCH_FORMAT_SNAPSHOT);
+}
+
+static void bench_json_free(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    while (n > 0)
+    {
+        int k = n < BENCH_BATCH ? n : BENCH_BATCH;
+        for (int i = 0; i < k; i++)
+        {
+            ctx->batch[i] = cson_decode(ctx->doc.json, ctx->doc.model, ctx->doc.model_size);
+        }
+        bench_meter_start(meter);
+        for (int i = 0; i < k; i++)
+        {
+            cson_free(ctx->batch[i], ctx->doc.model, ctx->doc.model_size);
+        }
+        bench_meter_stop(meter);
+        n -= k;
+    }
+}
+
+static void bench_json_encode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    bench_meter_start(meter);
+    for (int i = 0; i < n; i++)
+    {
+        cson_free_json(cson_encode_unformatted(ctx->obj, ctx->doc.model, ctx->doc.model_size));
+    }
+    bench_meter_stop(meter);
+}
+
+static void bench_msgpack_encode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    bench_meter_start(meter);
+    for (int i = 0; i < n; i++)
+    {
+        cson_msgpack_free(cson_msgpack_encode(ctx->obj, ctx->doc.model, ctx->doc.model_size, NULL));
+    }
+    bench_meter_stop(meter);
+}
+
+static void bench_cbor_encode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    bench_meter_start(meter);
+    for (int i = 0; i < n; i++)
+    {
+        cson_cbor_free(cson_cbor_encode(ctx->obj, ctx->doc.model, ctx->doc.model_size, NULL, 0));
+    }
+    bench_meter_stop(meter);
+}
+
+static void bench_snapshot_encode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    bench_meter_start(meter);
+    for (int i = 0; i < n; i++)
+    {
+        cson_snapshot_free(cson_snapshot_encode(ctx->obj, ctx->doc.model, ctx->doc.model_size, NULL));
+    }
+    bench_meter_stop(meter);
+}
+
+static void bench_gen_decode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    while (n > 0)
+    {
+        int k = n < BENCH_BATCH ? n : BENCH_BATCH;
+        bench_meter_start(meter);
+        for (int i = 0; i < k; i++)
+        {
+            ctx->batch[i] = ctx->gen_decode(ctx->doc.json);
+        }
+        bench_meter_stop(meter);
+        for (int i = 0; i < k; i++)
+        {
+            cson_free(ctx->batch[i], ctx->doc.model, ctx->doc.model_size);
+        }
+        n -= k;
+    }
+}
+
+static void bench_gen_encode(bench_ctx_t *ctx, int n, bench_meter_t *meter)
+{
+    bench_meter_start(meter);
+    for (int i = 0; i < n; i++)
+    {
+        cson_free_json(ctx->gen_encode(ctx->obj));
+    }
+    bench_meter_stop(meter);
+}
+
+static const bench_op_t s_bench_ops[] = {
+    {"decode", BENCH_FORMAT_JSON, 0, bench_json_decode},
+    {"encode", BENCH_FORMAT_JSON, 0, bench_json_encode},
+    {"free", BENCH_FORMAT_JSON, 0, bench_json_free},
+    {"gen_decode", BENCH_FORMAT_JSON, 1, bench_gen_decode},
+    {"gen_encode", BENCH_FORMAT_JSON, 1, bench_gen_encode},
+    {"msgpack_decode", BENCH_FORMAT_MSGPACK, 0, bench_msgpack_decode},
+    {"msgpack_encode", BENCH_FORMAT_MSGPACK, 0, bench_msgpack_encode},
+    {"cbor_decode", BENCH_FORMAT_CBOR, 0, bench_cbor_decode},
+    {"cbor_encode", BENCH_FORMAT_CBOR, 0, bench_cbor_encode},
+    {"snapshot_decode", BENCH_FORMAT_SNAPSHOT, 0, bench_snapshot_decode},
+    {"snapshot_encode", BENCH_FORMAT_SNAPSHOT, 0, bench_snapshot_encode},
+};
+
+#ifdef CSON_BENCH_GEN
+/**
+ * @brief 生成代码的函数适配
+ *
+ */
+#define BENCH_GEN_ADAPTER(name, type) \
+        static void *bench_gen_decode_##name(const char *json_str) \
+        { \
+                return cson_gen_##name##_decode(json_str); \
+        } \
+        static char *bench_gen_encode_##name(const void *obj) \
+        { \
+                return cson_gen_##name##_encode((const type *)obj); \
+        }
+
+BENCH_GEN_ADAPTER(bench_flat_doc_model, bench_doc_root_t)
+BENCH_GEN_ADAPTER(bench_node_model, bench_node_t)
+BENCH_GEN_ADAPTER(bench_track_doc_model, bench_doc_root_t)
+BENCH_GEN_ADAPTER(bench_text_doc_model, bench_doc_root_t)
+BENCH_GEN_ADAPTER(bench_number_doc_model, bench_doc_root_t)
+
+static void *(*s_bench_gen_decode[BENCH_SHAPE_MAX])(const char *) = {
+    bench_gen_decode_bench_flat_doc_model, bench_gen_decode_bench_node_model,
+    bench_gen_decode_bench_track_doc_model, bench_gen_decode_bench_text_doc_model,
+    bench_gen_decode_bench_number_doc_model,
+};
+
+static char *(*s_bench_gen_encode[BENCH_SHAPE_MAX])(const void *) = {
+    bench_gen_encode_bench_flat_doc_model, bench_gen_encode_bench_node_model,
+    bench_gen_encode_bench_track_doc_model, bench_gen_encode_bench_text_doc_model,
+    bench_gen_encode_bench_number_doc_model,
+};
+#endif
+
+/**
+ * @brief 释放二进制格式的编码数据
+ *
+ * @param ctx 测试上下文
+ * @param format 数据格式
+ */
+static void bench_data_free(bench_ctx_t *ctx, bench_format_t format)
+{
+    switch (format)
+    {
+    case BENCH_FORMAT_MSGPACK:
+        cson_msgpack_free(ctx->data[format]);
+        break;
+    case BENCH_FORMAT_CBOR:
+        cson_cbor_free(ctx->data[format]);
+        break;
+    case BENCH_FORMAT_SNAPSHOT:
+        cson_snapshot_free(ctx->data[format]);
+        break;
+    default:
+        return;
+    }
+    ctx->data[format] = NULL;
+}
+
+/**
+ * @brief 剔除无法还原文档的格式，如嵌套层数超过二进制格式的深度限制
+ *
+ * @param ctx 测试上下文
+ */
+static void bench_ctx_verify(bench_ctx_t *ctx)
+{
+    void *obj;
+
+    for (int format = BENCH_FORMAT_MSGPACK; format < BENCH_FORMAT_MAX; format++)
+    {
+        if (!ctx->data[format])
+        {
+            continue;
+        }
+        obj = bench_decode_format(ctx, (bench_format_t)format);
+        if (obj)
+        {
+            cson_free(obj, ctx->doc.model, ctx->doc.model_size);
+            continue;
+        }
+        bench_data_free(ctx, (bench_format_t)format);
+    }
+    if (ctx->gen_decode)
+    {
+        obj = ctx->gen_decode(ctx->doc.json);
+        if (obj)
+        {
+            cson_free(obj, ctx->doc.model, ctx->doc.model_size);
+        }
+        else
+        {
+            ctx->gen_decode = NULL;
+        }
+    }
+}
+
+/**
+ * @brief 初始化测试上下文
+ *
+ * @param ctx 测试上下文
+ * @param shape 模型形状
+ * @param scale 文档规模
+ * @return int 0成功，-1失败
+ */
+static int bench_ctx_init(bench_ctx_t *ctx, bench_shape_t shape, bench_scale_t scale)
+{
+    bench_doc_t *doc = &ctx->doc;
+
+    memset(ctx, 0, sizeof(bench_ctx_t));
+    if (bench_doc_build(doc, shape, scale) != 0)
+    {
+        return -1;
+    }
+    ctx->obj = cson_decode(doc->json, doc->model, doc->model_size);
+    if (!ctx->obj)
+    {
+        bench_doc_release(doc);
+        return -1;
+    }
+    ctx->data[BENCH_FORMAT_JSON] = (unsigned char *)doc->json;
+    ctx->len[BENCH_FORMAT_JSON] = doc->json_len;
+    ctx->data[BENCH_FORMAT_MSGPACK] = cson_msgpack_encode(ctx->obj, doc->model, doc->model_size,
+                                                          &ctx->len[BENCH_FORMAT_MSGPACK]);
+    ctx->data[BENCH_FORMAT_CBOR] = cson_cbor_encode(ctx->obj, doc->model, doc->model_size,
+                                                    &ctx->len[BENCH_FORMAT_CBOR], 0);
+    ctx->data[BENCH_FORMAT_SNAPSHOT] = cson_snapshot_encode(ctx->obj, doc->model, doc->model_size,
+                                                            &ctx->len[BENCH_FORMAT_SNAPSHOT]);
+#ifdef CSON_BENCH_GEN
+    ctx->gen_decode = s_bench_gen_decode[shape];
+    ctx->gen_encode = s_bench_gen_encode[shape];
+#endif
+    bench_ctx_verify(ctx);
+    return 0;
+}
+
+static void bench_ctx_release(bench_ctx_t *ctx)
+{
+    for (int format = BENCH_FORMAT_MSGPACK; format < BENCH_FORMAT_MAX; format++)
+    {
+        bench_data_free(ctx, (bench_format_t)format);
+    }
+    cson_free(ctx->obj, ctx->doc.model, ctx->doc.model_size);
+    bench_doc_release(&ctx->doc);
+}
+
+/**
+ * @brief 执行一项测试，按已测得的速度估算剩余迭代次数，直至累计耗时达到最短运行时间
+ *
+ * @param ctx 测试上下文
+ * @param op 测试操作
+ * @param min_time 最短运行时间
+ * @param iterations 总迭代次数
+ * @return bench_meter_t 计时结果
+ */
+static bench_meter_t bench_measure(bench_ctx_t *ctx, const bench_op_t *op, double min_time, long long *iterations)
+{
+    bench_meter_t meter;
+    int n = 1;
+
+    memset(&meter, 0, sizeof(meter));
+    op->run(ctx, 1, &meter);
+    memset(&meter, 0, sizeof(meter));
+    *iterations = 0;
+    while (meter.seconds < min_time)
+    {
+        op->run(ctx, n, &meter);
+        *iterations += n;
+        if (meter.seconds * 10 < min_time)
+        {
+            n = n < (1 << 20) ? n * 10 : n;
+        }
+        else if (meter.seconds < min_time)
+        {
+            double rest = (min_time - meter.seconds) * (double)*iterations / meter.seconds;
+            n = rest < 1 ? 1 : (rest > (1 << 24) ? (1 << 24) : (int)rest + 1);
+        }
+    }
+    return meter;
+}
+
+/**
+ * @brief 是否匹配过滤条件
+ *
+ * @param name `形状/规模/操作`
+ * @param filters 过滤字符串
+ * @param count 过滤字符串数量
+ * @return int 是否匹配
+ */
+static int bench_match(const char *name, char **filters, int count)
+{
+    if (count == 0)
+    {
+        return 1;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (strstr(name, filters[i]))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 多线程扩展性测试
+ *
+ * @param threads 线程数列表
+ * @param thread_count 线程数列表长度
+ * @param allocs 分配方式掩码
+ * @param seconds 每种配置的运行时间
+ * @param output 输出格式
+ * @param filters 过滤字符串
+ * @param filter_count 过滤字符串数量
+ */
+static void bench_scaling(const int *threads, int thread_count, int allocs, double seconds, bench_output_t output,
+                          char **filters, int filter_count)
+{
+    int results = 0;
+
+    if (output == BENCH_OUTPUT_CSV)
+    {
+        printf("shape,scale,alloc,threads,ops,ops_per_s,mb_per_s,efficiency,p50_ns,p99_ns,p999_ns\n");
+    }
+    else if (output == BENCH_OUTPUT_JSON)
+    {
+        printf("{\"seconds\":%g,\"results\":[", seconds);
+    }
+    else
+    {
+        printf("%-8s %-7s %-7s %7s %12s %10s %10s %10s %10s %10s\n", "shape", "scale", "alloc", "threads", "ops/s",
+               "MB/s", "efficiency", "p50(ns)", "p99(ns)", "p999(ns)");
+    }
+    for (int shape = 0; shape < BENCH_SHAPE_MAX; shape++)
+    {
+        for (int scale = 0; scale < BENCH_SCALE_MAX; scale++)
+        {
+            bench_doc_t doc;
+            char name[64];
+
+            if (bench_doc_build(&doc, (bench_shape_t)shape, (bench_scale_t)scale) != 0)
+            {
+                continue;
+            }
+            snprintf(name, sizeof(name), "%s/%s", doc.shape, doc.scale);
+            for (int alloc = 0; alloc < BENCH_ALLOC_MAX && bench_match(name, filters, filter_count); alloc++)
+            {
+                double base = 0;
+                if (!(allocs & (1 << alloc)))
+                {
+                    continue;
+                }
+                for (int i = 0; i < thread_count; i++)
+                {
+                    bench_threads_result_t r;
+                    if (bench_threads_run(&doc, threads[i], (bench_alloc_t)alloc, seconds, &r) != 0)
+                    {
+                        fprintf(stderr, "%s/%s: %d threads failed\n", name, bench_alloc_name((bench_alloc_t)alloc),
+                                threads[i]);
+                        continue;
+                    }
+                    if (i == 0)
+                    {
+                        base = r.ops_per_s / threads[0];
+                    }
+                    double efficiency = base > 0 ? r.ops_per_s / (base * threads[i]) : 0;
+
+                    if (output == BENCH_OUTPUT_CSV)
+                    {
+                        printf("%s,%s,%s,%d,%lld,%.1f,%.2f,%.3f,%.0f,%.0f,%.0f\n", doc.shape, doc.scale,
+                               bench_alloc_name((bench_alloc_t)alloc), r.threads, r.ops, r.ops_per_s, r.mb_per_s,
+                               efficiency, r.p50, r.p99, r.p999);
+                    }
+                    else if (output == BENCH_OUTPUT_JSON)
+                    {
+                        printf("%s\n{\"shape\":\"%s\",\"scale\":\"%s\",\"alloc\":\"%s\",\"threads\":%d,"
+                               "\"ops\":%lld,\"ops_per_s\":%.1f,\"mb_per_s\":%.2f,\"efficiency\":%.3f,"
+                               "\"p50_ns\":%.0f,\"p99_ns\":%.0f,\"p999_ns\":%.0f}",
+                               results ? "," : "", doc.shape, doc.scale, bench_alloc_name((bench_alloc_t)alloc),
+                               r.threads, r.ops, r.ops_per_s, r.mb_per_s, efficiency, r.p50, r.p99, r.p999);
+                    }
+                    else
+                    {
+                        printf("%-8s %-7s %-7s %7d %12.1f %10.1f %10.3f %10.0f %10.0f %10.0f\n", doc.shape,
+                               doc.scale, bench_alloc_name((bench_alloc_t)alloc), r.threads, r.ops_per_s, r.mb_per_s,
+                               efficiency, r.p50, r.p99, r.p999);
+                    }
+                    fflush(stdout);
+                    results++;
+                }
+            }
+            bench_doc_release(&doc);
+        }
+    }
+    if (output == BENCH_OUTPUT_JSON)
+    {
+        printf("\n]}\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    double min_time = 0.2;
+    int time_set = 0;
+    bench_output_t output = BENCH_OUTPUT_TEXT;
+    char **filters = malloc(sizeof(char *) * (size_t)argc);
+    int filter_count = 0;
+    int threads[BENCH_THREADS_MAX];
+    int thread_count = 0;
+    int allocs = (1 << BENCH_ALLOC_MAX) - 1;
+    int results = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            min_time = atof(argv[++i]);
+            time_set = 1;
+        }
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            for (char *p = argv[++i]; *p && thread_count < BENCH_THREADS_MAX; p += strcspn(p, ","), p += *p == ',')
+            {
+                int n = atoi(p);
+                if (n > 0)
+                {
+                    threads[thread_count++] = n;
+                }
+            }
+        }
+        else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+        {
+            i++;
+            allocs = 0;
+            for (int alloc = 0; alloc < BENCH_ALLOC_MAX; alloc++)
+            {
+                if (strstr(argv[i], bench_alloc_name((bench_alloc_t)alloc)))
+                {
+                    allocs |= 1 << alloc;
+                }
+            }
+        }
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+        {
+            i++;
+            output = strcmp(argv[i], "csv") == 0    ? BENCH_OUTPUT_CSV
+                     : strcmp(argv[i], "json") == 0 ? BENCH_OUTPUT_JSON
+                                                    : BENCH_OUTPUT_TEXT;
+        }
+        else
+        {
+            filters[filter_count++] = argv[i];
+        }
+    }
+
+    if (thread_count > 0)
+    {
+        bench_scaling(threads, thread_count, allocs, time_set ? min_time : 1.0, output, filters, filter_count);
+        free(filters);
+        return 0;
+    }
+
+    cson_init(bench_malloc, free);
+    if (output == BENCH_OUTPUT_CSV)
+    {
+        printf("shape,scale,op,bytes,objects,iterations,ns_per_doc,ns_per_object,mb_per_s,allocs_per_object\n");
+    }
+    else if (output == BENCH_OUTPUT_JSON)
+    {
+        printf("{\"min_time\":%g,\"results\":[", min_time);
+    }
+    else
+    {
+        printf("%-8s %-7s %-16s %9s %12s %12s %10s %12s\n", "shape", "scale", "op", "bytes", "ns/doc", "ns/object",
+               "MB/s", "allocs/obj");
+    }
+
+    for (int shape = 0; shape < BENCH_SHAPE_MAX; shape++)
+    {
+        for (int scale = 0; scale < BENCH_SCALE_MAX; scale++)
+        {
+            bench_ctx_t ctx;
+            if (bench_ctx_init(&ctx, (bench_shape_t)shape, (bench_scale_t)scale) != 0)
+            {
+                fprintf(stderr, "failed to build document %d/%d\n", shape, scale);
+                continue;
+            }
+            for (size_t i = 0; i < sizeof(s_bench_ops) / sizeof(bench_op_t); i++)
+            {
+                const bench_op_t *op = &s_bench_ops[i];
+                char name[64];
+                long long iterations;
+
+                snprintf(name, sizeof(name), "%s/%s/%s", ctx.doc.shape, ctx.doc.scale, op->name);
+                if ((op->gen && !ctx.gen_decode) || !ctx.data[op->format] || !bench_match(name, filters, filter_count))
+                {
+                    continue;
+                }
+                bench_meter_t meter = bench_measure(&ctx, op, min_time, &iterations);
+                double ns_doc = meter.seconds * 1e9 / (double)iterations;
+                double ns_object = ns_doc / ctx.doc.objects;
+                double mb_s = (double)ctx.len[op->format] * (double)iterations / meter.seconds / (1024 * 1024);
+                double allocs = (double)meter.allocs / (double)iterations / ctx.doc.objects;
+
+                if (output == BENCH_OUTPUT_CSV)
+                {
+                    printf("%s,%s,%s,%zu,%d,%lld,%.1f,%.1f,%.2f,%.2f\n", ctx.doc.shape, ctx.doc.scale, op->name,
+                           ctx.len[op->format], ctx.doc.objects, iterations, ns_doc, ns_object, mb_s, allocs);
+                }
+                else if (output == BENCH_OUTPUT_JSON)
+                {
+                    printf("%s\n{\"shape\":\"%s\",\"scale\":\"%s\",\"op\":\"%s\",\"bytes\":%zu,\"objects\":%d,"
+                           "\"iterations\":%lld,\"ns_per_doc\":%.1f,\"ns_per_object\":%.1f,\"mb_per_s\":%.2f,"
+                           "\"allocs_per_object\":%.2f}",
+                           results ? "," : "", ctx.doc.shape, ctx.doc.scale, op->name, ctx.len[op->format],
+                           ctx.doc.objects, iterations, ns_doc, ns_object, mb_s, allocs);
+                }
+                else
+                {
+                    printf("%-8s %-7s %-16s %9zu %12.1f %12.1f %10.1f %12.2f\n", ctx.doc.shape, ctx.doc.scale,
+                           op->name, ctx.len[op->format], ns_doc, ns_object, mb_s, allocs);
+                }
+                fflush(stdout);
+                results++;
+            }
+            bench_ctx_release(&ctx);
+        }
+    }
+
+    if (output == BENCH_OUTPUT_JSON)
+    {
+        printf("\n]}\n");
+    }
+    free(filters);
+    return 0;
+}
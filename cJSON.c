@@ -44,6 +44,7 @@
 #include <limits.h>
 #include <ctype.h>
 #include <float.h>
+#include <time.h>
 
 #ifdef ENABLE_LOCALES
 #include <locale.h>
@@ -249,6 +250,142 @@ static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
     return node;
 }
 
+#define in_arena(item) (((item)->type & cJSON_InArena) != 0)
+
+/* Blocks are kept in allocation order, the ones after current are free for reuse. */
+typedef struct arena_block
+{
+    struct arena_block *next;
+    size_t size;
+    size_t used;
+} arena_block;
+
+struct cJSON_Arena
+{
+    arena_block *first; /* allocated together with the arena */
+    arena_block *current;
+    size_t block_size; /* size of the next new block */
+};
+
+typedef union
+{
+    double number;
+    void *pointer;
+    size_t size;
+} arena_align;
+
+#define CJSON_ARENA_DEFAULT_BLOCK 4096
+
+CJSON_PUBLIC(cJSON_Arena *) cJSON_CreateArena(size_t block_size)
+{
+    cJSON_Arena *arena = NULL;
+
+    if (block_size == 0)
+    {
+        block_size = CJSON_ARENA_DEFAULT_BLOCK;
+    }
+    block_size = (block_size + sizeof(arena_align) - 1) & ~(sizeof(arena_align) - 1);
+    if ((block_size == 0) || (block_size > (size_t)-1 - sizeof(cJSON_Arena) - sizeof(arena_block)))
+    {
+        return NULL;
+    }
+
+    arena = (cJSON_Arena*)global_hooks.allocate(sizeof(cJSON_Arena) + sizeof(arena_block) + block_size);
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+    arena->first = (arena_block*)(void*)(arena + 1);
+    arena->first->next = NULL;
+    arena->first->size = block_size;
+    arena->first->used = 0;
+    arena->current = arena->first;
+    arena->block_size = block_size * 2;
+
+    return arena;
+}
+
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    arena->current = arena->first;
+    arena->first->used = 0;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteArena(cJSON_Arena *arena)
+{
+    arena_block *block = NULL;
+    arena_block *next = NULL;
+
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    for (block = arena->first->next; block != NULL; block = next)
+    {
+        next = block->next;
+        global_hooks.deallocate(block);
+    }
+    global_hooks.deallocate(arena);
+}
+
+static void *arena_allocate(cJSON_Arena * const arena, size_t size)
+{
+    arena_block *block = arena->current;
+    unsigned char *memory = NULL;
+
+    if (size > (size_t)-1 - sizeof(arena_align))
+    {
+        return NULL;
+    }
+    size = (size + sizeof(arena_align) - 1) & ~(sizeof(arena_align) - 1);
+
+    if ((block->size - block->used) < size)
+    {
+        if ((block->next == NULL) || (block->next->size < size))
+        {
+            size_t block_size = arena->block_size;
+            arena_block *fresh = NULL;
+
+            while (block_size < size)
+            {
+                if (block_size > ((size_t)-1 - sizeof(arena_block)) / 2)
+                {
+                    return NULL;
+                }
+                block_size *= 2;
+            }
+            fresh = (arena_block*)global_hooks.allocate(sizeof(arena_block) + block_size);
+            if (fresh == NULL)
+            {
+                return NULL;
+            }
+            fresh->next = block->next;
+            fresh->size = block_size;
+            block->next = fresh;
+            if (block_size <= ((size_t)-1 - sizeof(arena_block)) / 2)
+            {
+                arena->block_size = block_size * 2;
+            }
+        }
+        block = block->next;
+        block->used = 0;
+        arena->current = block;
+    }
+
+    memory = (unsigned char*)(block + 1) + block->used;
+    block->used += size;
+
+    return memory;
+}
+
+static void invalidate_index(cJSON * const object);
+
 /* Delete a cJSON structure. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
 {
@@ -256,6 +393,12 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
     while (item != NULL)
     {
         next = item->next;
+        if (in_arena(item))
+        {
+            /* released with its arena */
+            item = next;
+            continue;
+        }
         if (!(item->type & cJSON_IsReference) && (item->child != NULL))
         {
             cJSON_Delete(item->child);
@@ -270,6 +413,7 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
             global_hooks.deallocate(item->string);
             item->string = NULL;
         }
+        invalidate_index(item);
         global_hooks.deallocate(item);
         item = next;
     }
@@ -293,8 +437,40 @@ typedef struct
     size_t offset;
     size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
     internal_hooks hooks;
+    cJSON_bool in_place; /* strings without escapes reference the (writable) input instead of being copied */
+    cJSON_Arena *arena; /* if set, nodes and strings are allocated from it and flagged cJSON_InArena */
 } parse_buffer;
 
+static void *parse_allocate(parse_buffer * const input_buffer, size_t size)
+{
+    if (input_buffer->arena != NULL)
+    {
+        return arena_allocate(input_buffer->arena, size);
+    }
+
+    return input_buffer->hooks.allocate(size);
+}
+
+static cJSON *parse_new_item(parse_buffer * const input_buffer)
+{
+    cJSON *node = NULL;
+
+    if (input_buffer->arena == NULL)
+    {
+        return cJSON_New_Item(&input_buffer->hooks);
+    }
+
+    node = (cJSON*)arena_allocate(input_buffer->arena, sizeof(cJSON));
+    if (node != NULL)
+    {
+        memset(node, '\0', sizeof(cJSON));
+    }
+
+    return node;
+}
+
+static void arena_index(cJSON * const item, parse_buffer * const input_buffer);
+
 /* check if the given size is left to read in a given parse buffer (starting with 1) */
 #define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
 /* check if the buffer can be accessed at the given index (starting with 0) */
@@ -404,7 +580,7 @@ CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
 {
     char *copy = NULL;
     /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
-    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & (cJSON_IsReference | cJSON_InArena)))
     {
         return NULL;
     }
@@ -574,6 +750,12 @@ static cJSON_bool print_number(const cJSON * const item, printbuffer * const out
     {
         length = sprintf((char*)number_buffer, "%d", item->valueint);
     }
+    else if ((fabs(d) <= 9007199254740992.0) && (d == floor(d)))
+    {
+        /* integers up to 2^53 are exact in a double. %1.15g would print 2^53 as 9.00719925474099e+15,
+         * which compare_double accepts although it reads back as a different integer (e.g. 64 bit longs) */
+        length = sprintf((char*)number_buffer, "%.0f", d);
+    }
     else
     {
         /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
@@ -777,6 +959,8 @@ fail:
     return 0;
 }
 
+static void* cast_away_const(const void* string);
+
 /* Parse the input text into an unescaped cinput, and populate item. */
 static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -815,9 +999,22 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
             goto fail; /* string ended unexpectedly */
         }
 
+        if (input_buffer->in_place && (skipped_bytes == 0))
+        {
+            /* terminate the string in the input buffer and reference it */
+            *(unsigned char*)cast_away_const(input_end) = '\0';
+            item->type = cJSON_String | cJSON_IsReference;
+            item->valuestring = (char*)cast_away_const(input_pointer);
+
+            input_buffer->offset = (size_t) (input_end - input_buffer->content);
+            input_buffer->offset++;
+
+            return true;
+        }
+
         /* This is at most how much we need for the output */
         allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        output = (unsigned char*)parse_allocate(input_buffer, allocation_length + sizeof(""));
         if (output == NULL)
         {
             goto fail; /* allocation failure */
@@ -893,7 +1090,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     return true;
 
 fail:
-    if (output != NULL)
+    if ((output != NULL) && (input_buffer->arena == NULL))
     {
         input_buffer->hooks.deallocate(output);
         output = NULL;
@@ -1101,10 +1298,12 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return
 }
 
 /* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+static cJSON *parse_with_length(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, cJSON_bool in_place, cJSON_Arena *arena)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
     cJSON *item = NULL;
+    arena_block *arena_mark = NULL;
+    size_t arena_used = 0;
 
     /* reset error position */
     global_error.json = NULL;
@@ -1119,8 +1318,16 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
     buffer.length = buffer_length;
     buffer.offset = 0;
     buffer.hooks = global_hooks;
+    buffer.in_place = in_place;
+    buffer.arena = arena;
+    if (arena != NULL)
+    {
+        /* a failed parse gives back what it took from the arena */
+        arena_mark = arena->current;
+        arena_used = arena_mark->used;
+    }
 
-    item = cJSON_New_Item(&global_hooks);
+    item = parse_new_item(&buffer);
     if (item == NULL) /* memory fail */
     {
         goto fail;
@@ -1131,6 +1338,10 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
         /* parse failure. ep is set. */
         goto fail;
     }
+    if (arena != NULL)
+    {
+        item->type |= cJSON_InArena;
+    }
 
     /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
     if (require_null_terminated)
@@ -1149,7 +1360,12 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
     return item;
 
 fail:
-    if (item != NULL)
+    if (arena_mark != NULL)
+    {
+        arena->current = arena_mark;
+        arena_mark->used = arena_used;
+    }
+    else if (item != NULL)
     {
         cJSON_Delete(item);
     }
@@ -1180,6 +1396,11 @@ fail:
     return NULL;
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_with_length(value, buffer_length, return_parse_end, require_null_terminated, false, NULL);
+}
+
 /* Default options for cJSON_Parse */
 CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
 {
@@ -1191,6 +1412,21 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
     return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_ParseInPlace(char *value, size_t buffer_length)
+{
+    return parse_with_length(value, buffer_length, 0, 0, true, NULL);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArena(const char *value, size_t buffer_length, cJSON_Arena *arena)
+{
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    return parse_with_length(value, buffer_length, 0, 0, false, arena);
+}
+
 #define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
 
 static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
@@ -1455,6 +1691,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
 {
     cJSON *head = NULL; /* head of the linked list */
     cJSON *current_item = NULL;
+    size_t count = 0;
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
@@ -1489,7 +1726,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
@@ -1508,6 +1745,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
             new_item->prev = current_item;
             current_item = new_item;
         }
+        count++;
 
         /* parse next value */
         input_buffer->offset++;
@@ -1516,6 +1754,10 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
         {
             goto fail; /* failed to parse value */
         }
+        if (input_buffer->arena != NULL)
+        {
+            current_item->type |= cJSON_InArena;
+        }
         buffer_skip_whitespace(input_buffer);
     }
     while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
@@ -1534,13 +1776,14 @@ success:
 
     item->type = cJSON_Array;
     item->child = head;
+    item->child_count = count;
 
     input_buffer->offset++;
 
     return true;
 
 fail:
-    if (head != NULL)
+    if ((head != NULL) && (input_buffer->arena == NULL))
     {
         cJSON_Delete(head);
     }
@@ -1615,6 +1858,8 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
 {
     cJSON *head = NULL; /* linked list head */
     cJSON *current_item = NULL;
+    int key_flags = 0;
+    size_t count = 0;
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
@@ -1647,7 +1892,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
@@ -1666,6 +1911,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
             new_item->prev = current_item;
             current_item = new_item;
         }
+        count++;
 
         if (cannot_access_at_index(input_buffer, 1))
         {
@@ -1684,6 +1930,9 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         /* swap valuestring and string, because we parsed the name */
         current_item->string = current_item->valuestring;
         current_item->valuestring = NULL;
+        /* a name referencing the input buffer must never be freed */
+        key_flags = (current_item->type & cJSON_IsReference) ? cJSON_StringIsConst : 0;
+        current_item->type = key_flags;
 
         if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
         {
@@ -1695,8 +1944,14 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         buffer_skip_whitespace(input_buffer);
         if (!parse_value(current_item, input_buffer))
         {
+            current_item->type |= key_flags;
             goto fail; /* failed to parse value */
         }
+        current_item->type |= key_flags;
+        if (input_buffer->arena != NULL)
+        {
+            current_item->type |= cJSON_InArena;
+        }
         buffer_skip_whitespace(input_buffer);
     }
     while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
@@ -1715,12 +1970,17 @@ success:
 
     item->type = cJSON_Object;
     item->child = head;
+    item->child_count = count;
+    if (input_buffer->arena != NULL)
+    {
+        arena_index(item, input_buffer);
+    }
 
     input_buffer->offset++;
     return true;
 
 fail:
-    if (head != NULL)
+    if ((head != NULL) && (input_buffer->arena == NULL))
     {
         cJSON_Delete(head);
     }
@@ -1842,6 +2102,306 @@ static cJSON_bool print_object(const cJSON * const item, printbuffer * const out
     return true;
 }
 
+typedef struct
+{
+    unsigned long hash;
+    cJSON *item;
+} index_slot;
+
+/* Position vector of an array's or object's items, followed by an open addressing table of the member names
+ * when every item has one. Members are inserted in list order, so probing from a name's hash meets duplicate
+ * names in list order and the first match is the same as a linear scan's. */
+struct cJSON_Index
+{
+    const cJSON *first; /* object->child when built, catches items replaced without the API */
+    size_t count;
+    cJSON **items;
+    unsigned long seed[2];
+    size_t buckets; /* 0 if not hashed */
+    struct cJSON_Index *retired; /* stale index this one replaced, other readers may still be using it */
+    index_slot slots[1];
+};
+
+/* Lookups only read the tree except for publishing a lazily built index, which needs an atomic compare and swap.
+ * Without one no index is built lazily, so concurrent lookups stay read-only. */
+#if (CJSON_INDEX_MIN > 0) && (defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7)))))
+#define index_lazy 1
+#define index_load(object) __atomic_load_n(&(object)->child_index, __ATOMIC_ACQUIRE)
+#define index_publish(object, expected, index) __atomic_compare_exchange_n(&(object)->child_index, &(expected), (index), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+#define index_lazy 0
+#define index_load(object) ((object)->child_index)
+#endif
+
+#if CJSON_INDEX_MIN > 0
+#define index_rotl(x, b) ((((x) << (b)) | ((x) >> (32 - (b)))) & 0xffffffffUL)
+
+#define index_round(v) \
+    v[0] = (v[0] + v[1]) & 0xffffffffUL; v[1] = index_rotl(v[1], 5); v[1] ^= v[0]; v[0] = index_rotl(v[0], 16); \
+    v[2] = (v[2] + v[3]) & 0xffffffffUL; v[3] = index_rotl(v[3], 8); v[3] ^= v[2]; \
+    v[0] = (v[0] + v[3]) & 0xffffffffUL; v[3] = index_rotl(v[3], 7); v[3] ^= v[0]; \
+    v[2] = (v[2] + v[1]) & 0xffffffffUL; v[1] = index_rotl(v[1], 13); v[1] ^= v[2]; v[2] = index_rotl(v[2], 16)
+
+/* HalfSipHash-1-3 of the lower-cased name, keyed per index so colliding names can't be precomputed */
+static unsigned long index_hash(const unsigned long seed[2], const unsigned char *name)
+{
+    unsigned long v[4];
+    unsigned long word = 0;
+    size_t length = 0;
+
+    v[0] = seed[0];
+    v[1] = seed[1];
+    v[2] = 0x6c796765UL ^ seed[0];
+    v[3] = 0x74656462UL ^ seed[1];
+
+    for (; *name != '\0'; name++)
+    {
+        word |= (unsigned long)(unsigned char)tolower(*name) << (8 * (length & 3));
+        length++;
+        if ((length & 3) == 0)
+        {
+            v[3] ^= word;
+            index_round(v);
+            v[0] ^= word;
+            word = 0;
+        }
+    }
+
+    word |= ((unsigned long)length & 0xff) << 24;
+    v[3] ^= word;
+    index_round(v);
+    v[0] ^= word;
+    v[2] ^= 0xff;
+    index_round(v);
+    index_round(v);
+    index_round(v);
+
+    return v[1] ^ v[3];
+}
+
+/* Size of the index of an object's or array's items, 0 if it would overflow */
+static size_t index_size(const cJSON * const object, size_t * const count, size_t * const buckets)
+{
+    const cJSON *child = NULL;
+    cJSON_bool named = true;
+
+    *count = 0;
+    *buckets = 0;
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        named = named && (child->string != NULL);
+        (*count)++;
+    }
+    if (*count > ((size_t)-1 - sizeof(struct cJSON_Index)) / sizeof(cJSON*))
+    {
+        return 0;
+    }
+    if (named && (*count > 0))
+    {
+        *buckets = 4;
+        while (*buckets < *count * 2)
+        {
+            *buckets *= 2;
+        }
+        if (*buckets > ((size_t)-1 - sizeof(struct cJSON_Index) - *count * sizeof(cJSON*)) / sizeof(index_slot))
+        {
+            return 0;
+        }
+    }
+
+    return sizeof(struct cJSON_Index) + *buckets * sizeof(index_slot) + *count * sizeof(cJSON*);
+}
+
+/* Fill in the index in memory of index_size() bytes */
+static struct cJSON_Index *fill_index(const cJSON * const object, void * const memory, size_t count, size_t buckets)
+{
+    struct cJSON_Index *index = (struct cJSON_Index*)memory;
+    cJSON *child = NULL;
+    size_t position = 0;
+
+    index->first = object->child;
+    index->count = count;
+    index->items = (cJSON**)(void*)(index->slots + buckets);
+    index->buckets = buckets;
+    index->retired = NULL;
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        index->items[position++] = child;
+    }
+    if (buckets == 0)
+    {
+        return index;
+    }
+
+    memset(index->slots, '\0', buckets * sizeof(index_slot));
+    index->seed[0] = ((unsigned long)time(NULL) ^ (unsigned long)clock()) & 0xffffffffUL;
+    index->seed[1] = ((unsigned long)(size_t)index ^ (unsigned long)(size_t)&position) & 0xffffffffUL;
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        unsigned long hash = index_hash(index->seed, (const unsigned char*)child->string);
+        position = (size_t)hash & (buckets - 1);
+        while (index->slots[position].item != NULL)
+        {
+            position = (position + 1) & (buckets - 1);
+        }
+        index->slots[position].hash = hash;
+        index->slots[position].item = child;
+    }
+
+    return index;
+}
+
+#endif
+
+#if index_lazy
+/* Build the index of an object's or array's items, NULL if memory runs out */
+static struct cJSON_Index *build_index(const cJSON * const object)
+{
+    size_t count = 0;
+    size_t buckets = 0;
+    size_t size = index_size(object, &count, &buckets);
+    void *memory = NULL;
+
+    if (size == 0)
+    {
+        return NULL;
+    }
+    memory = global_hooks.allocate(size);
+    if (memory == NULL)
+    {
+        return NULL;
+    }
+
+    return fill_index(object, memory, count, buckets);
+}
+#endif
+
+/* Arena trees never change, so large objects get their member index while parsing instead of on first lookup.
+ * Arrays are left unindexed: they are mostly walked in order, and a position vector nobody asks for would only
+ * grow the arena. */
+static void arena_index(cJSON * const item, parse_buffer * const input_buffer)
+{
+#if CJSON_INDEX_MIN > 0
+    size_t count = 0;
+    size_t buckets = 0;
+    size_t size = 0;
+    void *memory = NULL;
+
+    if (item->child_count <= CJSON_INDEX_MIN)
+    {
+        return;
+    }
+    size = index_size(item, &count, &buckets);
+    if (size == 0)
+    {
+        return;
+    }
+    memory = arena_allocate(input_buffer->arena, size);
+    if (memory != NULL)
+    {
+        item->child_index = fill_index(item, memory, count, buckets);
+    }
+#else
+    (void)item;
+    (void)input_buffer;
+#endif
+}
+
+#if CJSON_INDEX_MIN > 0
+/* Check that the index still matches the object's items */
+static cJSON_bool index_current(const cJSON * const object, const struct cJSON_Index * const index)
+{
+    return (index != NULL) && (index->first == object->child) && (index->count == object->child_count);
+}
+
+/* Get a current index of the object, building it if missing or stale. A stale index is not freed here because
+ * a concurrent reader may still be probing it, the new index keeps it until invalidate_index. */
+static struct cJSON_Index *get_index(const cJSON * const object)
+{
+    cJSON *mutable_object = (cJSON*)cast_away_const(object);
+    struct cJSON_Index *current = NULL;
+#if index_lazy
+    struct cJSON_Index *index = NULL;
+#endif
+
+    if (object->type & cJSON_IsReference)
+    {
+        /* the items belong to the referent, which can change them without the reference noticing */
+        return NULL;
+    }
+    current = index_load(mutable_object);
+    if (index_current(object, current))
+    {
+        return current;
+    }
+#if index_lazy
+    if (in_arena(object))
+    {
+        /* built while parsing if the object is large enough, nowhere to free a later one */
+        return NULL;
+    }
+
+    index = build_index(object);
+    if (index == NULL)
+    {
+        return NULL;
+    }
+    index->retired = current;
+    if (!index_publish(mutable_object, current, index))
+    {
+        /* another reader published one first, current now holds it */
+        global_hooks.deallocate(index);
+        return index_current(object, current) ? current : NULL;
+    }
+
+    return index;
+#else
+    return NULL;
+#endif
+}
+
+static cJSON *index_lookup(const struct cJSON_Index * const index, const char * const name, const cJSON_bool case_sensitive)
+{
+    unsigned long hash = index_hash(index->seed, (const unsigned char*)name);
+    size_t position = (size_t)hash & (index->buckets - 1);
+
+    for (; index->slots[position].item != NULL; position = (position + 1) & (index->buckets - 1))
+    {
+        const index_slot *slot = &index->slots[position];
+        if ((slot->hash == hash)
+            && (case_sensitive ? (strcmp(name, slot->item->string) == 0)
+                               : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)slot->item->string) == 0)))
+        {
+            return slot->item;
+        }
+    }
+
+    return NULL;
+}
+
+#endif
+
+/* Free the index and the stale ones it replaced. Only called while changing or deleting the object,
+ * when no lookup may run concurrently. */
+static void invalidate_index(cJSON * const object)
+{
+    struct cJSON_Index *index = NULL;
+    struct cJSON_Index *retired = NULL;
+
+    if (object == NULL)
+    {
+        return;
+    }
+    index = object->child_index;
+    object->child_index = NULL;
+    while (index != NULL)
+    {
+        retired = index->retired;
+        global_hooks.deallocate(index);
+        index = retired;
+    }
+}
+
 /* Get Array size/item / object item. */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 {
@@ -1853,28 +2413,40 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
         return 0;
     }
 
-    child = array->child;
+    if (!(array->type & cJSON_IsReference))
+    {
+        /* FIXME: Can overflow here. Cannot be fixed without breaking the API */
+        return (int)array->child_count;
+    }
 
-    while(child != NULL)
+    /* a reference's count was taken when it was created, the referent may have changed since */
+    for (child = array->child; child != NULL; child = child->next)
     {
         size++;
-        child = child->next;
     }
 
-    /* FIXME: Can overflow here. Cannot be fixed without breaking the API */
-
     return (int)size;
 }
 
 static cJSON* get_array_item(const cJSON *array, size_t index)
 {
     cJSON *current_child = NULL;
+#if CJSON_INDEX_MIN > 0
+    struct cJSON_Index *items = NULL;
+#endif
 
     if (array == NULL)
     {
         return NULL;
     }
 
+#if CJSON_INDEX_MIN > 0
+    if ((index >= CJSON_INDEX_MIN) && ((items = get_index(array)) != NULL))
+    {
+        return (index < items->count) ? items->items[index] : NULL;
+    }
+#endif
+
     current_child = array->child;
     while ((current_child != NULL) && (index > 0))
     {
@@ -1898,18 +2470,36 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = NULL;
+#if CJSON_INDEX_MIN > 0
+    struct cJSON_Index *index = NULL;
+    size_t scanned = 0;
+#endif
 
     if ((object == NULL) || (name == NULL))
     {
         return NULL;
     }
 
+#if CJSON_INDEX_MIN > 0
+    index = index_load(object);
+    if ((index != NULL) && (index->buckets != 0) && index_current(object, index))
+    {
+        return index_lookup(index, name, case_sensitive);
+    }
+#endif
+
     current_element = object->child;
     if (case_sensitive)
     {
         while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
         {
             current_element = current_element->next;
+#if CJSON_INDEX_MIN > 0
+            if ((++scanned == CJSON_INDEX_MIN) && ((index = get_index(object)) != NULL) && (index->buckets != 0))
+            {
+                return index_lookup(index, name, case_sensitive);
+            }
+#endif
         }
     }
     else
@@ -1917,6 +2507,12 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
         while ((current_element != NULL) && (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) != 0))
         {
             current_element = current_element->next;
+#if CJSON_INDEX_MIN > 0
+            if ((++scanned == CJSON_INDEX_MIN) && ((index = get_index(object)) != NULL) && (index->buckets != 0))
+            {
+                return index_lookup(index, name, case_sensitive);
+            }
+#endif
         }
     }
 
@@ -1942,6 +2538,50 @@ CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *st
     return cJSON_GetObjectItem(object, string) ? 1 : 0;
 }
 
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *object)
+{
+    cJSON *child = NULL;
+
+    if ((object == NULL) || in_arena(object))
+    {
+        return;
+    }
+
+    invalidate_index(object);
+    object->child_count = 0;
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        object->child_count++;
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_IteratorInit(cJSON_Iterator *iterator, const cJSON *array)
+{
+    if (iterator == NULL)
+    {
+        return;
+    }
+
+    iterator->next = (array != NULL) ? array->child : NULL;
+    iterator->count = 0;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_IteratorNext(cJSON_Iterator *iterator)
+{
+    cJSON *current = NULL;
+
+    if ((iterator == NULL) || (iterator->next == NULL))
+    {
+        return NULL;
+    }
+
+    current = iterator->next;
+    iterator->next = current->next;
+    iterator->count++;
+
+    return current;
+}
+
 /* Utility for array list handling. */
 static void suffix_object(cJSON *prev, cJSON *item)
 {
@@ -1966,7 +2606,8 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
-    reference->type |= cJSON_IsReference;
+    reference->child_index = NULL;
+    reference->type = (reference->type & ~cJSON_InArena) | cJSON_IsReference;
     reference->next = reference->prev = NULL;
     return reference;
 }
@@ -1975,11 +2616,13 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
 {
     cJSON *child = NULL;
 
-    if ((item == NULL) || (array == NULL) || (array == item))
+    if ((item == NULL) || (array == NULL) || (array == item) || in_arena(array) || in_arena(item))
     {
         return false;
     }
 
+    invalidate_index(array);
+    array->child_count++;
     child = array->child;
     /*
      * To find the last item in array quickly, we use prev in array
@@ -2031,7 +2674,7 @@ static cJSON_bool add_item_to_object(cJSON * const object, const char * const st
     char *new_key = NULL;
     int new_type = cJSON_Invalid;
 
-    if ((object == NULL) || (string == NULL) || (item == NULL) || (object == item))
+    if ((object == NULL) || (string == NULL) || (item == NULL) || (object == item) || in_arena(object) || in_arena(item))
     {
         return false;
     }
@@ -2076,7 +2719,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObjectCS(cJSON *object, const char *stri
 
 CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToArray(cJSON *array, cJSON *item)
 {
-    if (array == NULL)
+    if ((array == NULL) || in_arena(array))
     {
         return false;
     }
@@ -2086,7 +2729,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToArray(cJSON *array, cJSON *item
 
 CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToObject(cJSON *object, const char *string, cJSON *item)
 {
-    if ((object == NULL) || (string == NULL))
+    if ((object == NULL) || (string == NULL) || in_arena(object))
     {
         return false;
     }
@@ -2204,11 +2847,13 @@ CJSON_PUBLIC(cJSON*) cJSON_AddArrayToObject(cJSON * const object, const char * c
 
 CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const item)
 {
-    if ((parent == NULL) || (item == NULL))
+    if ((parent == NULL) || (item == NULL) || in_arena(parent))
     {
         return NULL;
     }
 
+    invalidate_index(parent);
+    parent->child_count--;
     if (item != parent->child)
     {
         /* not the first element */
@@ -2282,7 +2927,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
 {
     cJSON *after_inserted = NULL;
 
-    if (which < 0 || newitem == NULL)
+    if (which < 0 || newitem == NULL || (array != NULL && in_arena(array)) || in_arena(newitem))
     {
         return false;
     }
@@ -2298,6 +2943,8 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
         return false;
     }
 
+    invalidate_index(array);
+    array->child_count++;
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
     after_inserted->prev = newitem;
@@ -2314,7 +2961,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
 
 CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement)
 {
-    if ((parent == NULL) || (parent->child == NULL) || (replacement == NULL) || (item == NULL))
+    if ((parent == NULL) || (parent->child == NULL) || (replacement == NULL) || (item == NULL) || in_arena(parent) || in_arena(replacement))
     {
         return false;
     }
@@ -2324,6 +2971,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         return true;
     }
 
+    invalidate_index(parent);
     replacement->next = item->next;
     replacement->prev = item->prev;
 
@@ -2373,7 +3021,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON
 
 static cJSON_bool replace_item_in_object(cJSON *object, const char *string, cJSON *replacement, cJSON_bool case_sensitive)
 {
-    if ((replacement == NULL) || (string == NULL))
+    if ((replacement == NULL) || (string == NULL) || in_arena(replacement) || ((object != NULL) && in_arena(object)))
     {
         return false;
     }
@@ -2510,6 +3158,10 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateObjectReference(const cJSON *child)
     if (item != NULL) {
         item->type = cJSON_Object | cJSON_IsReference;
         item->child = (cJSON*)cast_away_const(child);
+        for (; child != NULL; child = child->next)
+        {
+            item->child_count++;
+        }
     }
 
     return item;
@@ -2520,6 +3172,10 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateArrayReference(const cJSON *child) {
     if (item != NULL) {
         item->type = cJSON_Array | cJSON_IsReference;
         item->child = (cJSON*)cast_away_const(child);
+        for (; child != NULL; child = child->next)
+        {
+            item->child_count++;
+        }
     }
 
     return item;
@@ -2600,6 +3256,7 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateIntArray(const int *numbers, int count)
 
     if (a && a->child) {
         a->child->prev = n;
+        a->child_count = (size_t)count;
     }
 
     return a;
@@ -2640,6 +3297,7 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateFloatArray(const float *numbers, int count)
 
     if (a && a->child) {
         a->child->prev = n;
+        a->child_count = (size_t)count;
     }
 
     return a;
@@ -2680,6 +3338,7 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateDoubleArray(const double *numbers, int count)
 
     if (a && a->child) {
         a->child->prev = n;
+        a->child_count = (size_t)count;
     }
 
     return a;
@@ -2720,6 +3379,7 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateStringArray(const char *const *strings, int co
 
     if (a && a->child) {
         a->child->prev = n;
+        a->child_count = (size_t)count;
     }
 
     return a;
@@ -2745,7 +3405,7 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
         goto fail;
     }
     /* Copy over all vars */
-    newitem->type = item->type & (~cJSON_IsReference);
+    newitem->type = item->type & (~(cJSON_IsReference | cJSON_InArena));
     newitem->valueint = item->valueint;
     newitem->valuedouble = item->valuedouble;
     if (item->valuestring)
@@ -2791,6 +3451,7 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
             newitem->child = newchild;
             next = newchild;
         }
+        newitem->child_count++;
         child = child->next;
     }
     if (newitem && newitem->child)
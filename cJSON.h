@@ -98,6 +98,7 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
+#define cJSON_InArena 1024 /* allocated from a cJSON_Arena, see cJSON_ParseInArena */
 
 /* The cJSON structure: */
 typedef struct cJSON
@@ -120,6 +121,12 @@ typedef struct cJSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+    /* Index of an array's or object's items, built lazily by lookups (see CJSON_INDEX_MIN). Owned by cJSON. */
+    struct cJSON_Index *child_index;
+    /* Number of items in the child chain, kept up to date by the cJSON API. Not used for references, whose items
+     * belong to the referent. */
+    size_t child_count;
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -137,6 +144,17 @@ typedef int cJSON_bool;
 #define CJSON_NESTING_LIMIT 1000
 #endif
 
+/* A lookup that has to scan past this many items of an array or object builds an index of its items:
+ * a position vector for cJSON_GetArrayItem and a seeded hash table of member names for cJSON_GetObjectItem*,
+ * making later lookups O(1) amortized. Adding, detaching or replacing items drops the index. 0 disables it.
+ * Lookups on a tree nobody is changing may run concurrently: the index is published with an atomic compare and swap
+ * and an index gone stale is kept until the tree is changed through the API or deleted. Compilers without GCC-style
+ * atomics build no index lazily, only arena parsing indexes large objects. Containers made by the reference functions
+ * share the referent's items and are never indexed. */
+#ifndef CJSON_INDEX_MIN
+#define CJSON_INDEX_MIN 32
+#endif
+
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cJSON_Version(void);
 
@@ -151,6 +169,22 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error so will match cJSON_GetErrorPtr(). */
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+/* ParseInPlace does not copy strings without escape sequences: their closing quote in the (writable) buffer is overwritten with '\0'
+ * and valuestring/string reference the buffer (flagged cJSON_IsReference/cJSON_StringIsConst). The buffer must outlive the result. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseInPlace(char *value, size_t buffer_length);
+
+/* An arena is a chain of bump-allocated blocks. block_size is the size of the first block (0 picks a default),
+ * later blocks double. Returns NULL on allocation failure. */
+typedef struct cJSON_Arena cJSON_Arena;
+CJSON_PUBLIC(cJSON_Arena *) cJSON_CreateArena(size_t block_size);
+/* ParseInArena puts every node, key and string of the tree into the arena and flags the nodes cJSON_InArena.
+ * Objects with more than CJSON_INDEX_MIN members get their index in the arena while parsing, arrays get none.
+ * Such trees are read-only: functions that add, detach, replace or rename items or set a valuestring refuse them
+ * (returning false/NULL), cJSON_Delete ignores them and cJSON_Duplicate makes an ordinary copy. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArena(const char *value, size_t buffer_length, cJSON_Arena *arena);
+/* Release every tree parsed into the arena at once, keeping its blocks for reuse. */
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena);
+CJSON_PUBLIC(void) cJSON_DeleteArena(cJSON_Arena *arena);
 
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
@@ -172,6 +206,9 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
+/* Drop the index of an array or object and recount its items. Only needed after changing its items without the cJSON API
+ * (e.g. renaming item->string or linking item->next by hand). */
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *object);
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void);
 
@@ -289,6 +326,17 @@ CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
 /* Macro for iterating over an array or object */
 #define cJSON_ArrayForEach(element, array) for(element = (array != NULL) ? (array)->child : NULL; element != NULL; element = element->next)
 
+/* Iterator over the items of an array or object. Unlike cJSON_ArrayForEach it counts the returned items
+ * and has already stepped past the returned item, so that item may be detached or deleted. */
+typedef struct cJSON_Iterator
+{
+    cJSON *next;
+    size_t count;
+} cJSON_Iterator;
+CJSON_PUBLIC(void) cJSON_IteratorInit(cJSON_Iterator *iterator, const cJSON *array);
+/* Returns the next item, or NULL at the end. The returned item is at index iterator->count - 1. */
+CJSON_PUBLIC(cJSON *) cJSON_IteratorNext(cJSON_Iterator *iterator);
+
 /* malloc/free objects using the malloc/free functions that have been set with cJSON_InitHooks */
 CJSON_PUBLIC(void *) cJSON_malloc(size_t size);
 CJSON_PUBLIC(void) cJSON_free(void *object);
@@ -10,12 +10,29 @@
  *
  */
 
+#if !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "cson.h"
+#include "cson_internal.h"
 #include "cJSON.h"
+#include "limits.h"
 #include "stddef.h"
 #include "string.h"
 #include "stdio.h"
 
+#if CSON_POOL_THREAD_SAFE
+#include "stdatomic.h"
+#endif
+
+#if CSON_USING_MMAP
+#include "fcntl.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#endif
+
 /**
  * @brief 基本类型链表数据模型
  *
@@ -44,45 +61,339 @@ cson_model_t g_cson_basic_list_model[] =
  */
 static struct
 {
-    void *(*malloc)(int);
+    void *(*malloc)(size_t);
     void (*free)(void *);
 } s_cson;
 
+#if CSON_STATS_ENABLE
 /**
- * @brief CSON初始化
+ * @brief 统计计数
  *
- * @param malloc 内存分配函数
- * @param free 内存释放函数
+ * 线程计数仅由所属线程写入，使用普通的读-写更新；模型计数由多个线程共享，使用原子加
  */
-void cson_init(void *malloc_func, void *free_func)
+typedef struct
 {
-    s_cson.malloc = (void *(*)(int))malloc_func;
-    s_cson.free = (void (*)(void *))free_func;
-    cJSON_InitHooks(&(cJSON_Hooks){(void *(*)(size_t))s_cson.malloc, s_cson.free});
+    atomic_size_t alloc_count;
+    atomic_size_t free_count;
+    atomic_size_t alloc_bytes;
+    atomic_size_t free_bytes;
+    atomic_size_t peak_bytes;
+} cson_stats_counter_t;
+
+/**
+ * @brief 线程统计块，首次分配时挂入全局链表，线程退出后保留，其计数仍计入全局统计
+ *
+ */
+typedef struct
+{
+    cson_thread_node_t node;
+    cson_stats_counter_t counter;
+} cson_stats_thread_t;
+
+/**
+ * @brief 模型统计
+ *
+ */
+typedef struct
+{
+    _Atomic(cson_model_t *) model;
+    cson_stats_counter_t counter;
+} cson_stats_model_t;
+
+/**
+ * @brief 统计分配头部，记录分配大小及分配时所在的模型统计范围，释放时计入同一模型
+ *
+ */
+typedef union
+{
+    struct
+    {
+        size_t size;
+        cson_stats_model_t *scope;
+    } info;
+    max_align_t align;
+} cson_stats_head_t;
+
+/**
+ * @brief 内存统计
+ *
+ */
+static struct
+{
+    void *(*malloc)(size_t);
+    void (*free)(void *);
+    cson_thread_list_t threads;
+    cson_stats_model_t models[CSON_STATS_MODEL_MAX];
+} s_cson_stats;
+
+static CSON_TLS cson_thread_node_t *s_cson_stats_thread = NULL;
+
+/**
+ * @brief 当前线程所在的模型统计范围，最外层模型未注册时指向`s_cson_stats_untracked`
+ *
+ */
+static CSON_TLS cson_stats_model_t *s_cson_stats_scope = NULL;
+
+static cson_stats_model_t s_cson_stats_untracked;
+
+/**
+ * @brief 清零计数
+ *
+ * @param counter 计数
+ */
+static void _cson_stats_clear(cson_stats_counter_t *counter)
+{
+    atomic_store_explicit(&counter->alloc_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&counter->free_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&counter->alloc_bytes, 0, memory_order_relaxed);
+    atomic_store_explicit(&counter->free_bytes, 0, memory_order_relaxed);
+    atomic_store_explicit(&counter->peak_bytes, 0, memory_order_relaxed);
 }
 
-static signed char _cson_is_basic_list_model(cson_model_t *model)
+/**
+ * @brief 清零线程统计块
+ *
+ * @param node 线程统计块
+ */
+static void _cson_stats_clear_thread(cson_thread_node_t *node)
 {
-    return (model >= &g_cson_basic_list_model[0] && model <= &g_cson_basic_list_model[13]) ? 1 : 0;
+    _cson_stats_clear(&((cson_stats_thread_t *)node)->counter);
 }
 
 /**
- * @brief 解析JSON整型
+ * @brief 获取当前线程的统计块，全局清零后首次访问时清零计数
  *
- * @param json JSON对象
- * @param key key
- * @return int 解析出的整型数
+ * @return cson_stats_thread_t* 统计块
  */
-static int _cson_decode_number(cJSON *json, char *key)
+static cson_stats_thread_t *_cson_stats_local(void)
 {
-    cJSON *item = key ? cJSON_GetObjectItem(json, key) : json;
-    if (item && item->type == cJSON_Number)
+    return (cson_stats_thread_t *)cson_thread_local(&s_cson_stats.threads, &s_cson_stats_thread,
+                                                    sizeof(cson_stats_thread_t), _cson_stats_clear_thread);
+}
+
+/**
+ * @brief 更新线程计数
+ *
+ * @param counter 计数
+ * @param size 大小
+ * @param alloc 1分配，0释放
+ */
+static void _cson_stats_count_local(cson_stats_counter_t *counter, size_t size, char alloc)
+{
+    size_t alloc_bytes = atomic_load_explicit(&counter->alloc_bytes, memory_order_relaxed);
+    size_t free_bytes = atomic_load_explicit(&counter->free_bytes, memory_order_relaxed);
+
+    if (alloc)
     {
-        return item->valueint;
+        alloc_bytes += size;
+        atomic_store_explicit(&counter->alloc_bytes, alloc_bytes, memory_order_relaxed);
+        atomic_store_explicit(&counter->alloc_count,
+                              atomic_load_explicit(&counter->alloc_count, memory_order_relaxed) + 1,
+                              memory_order_relaxed);
+        if ((ptrdiff_t)(alloc_bytes - free_bytes) > (ptrdiff_t)atomic_load_explicit(&counter->peak_bytes, memory_order_relaxed))
+        {
+            atomic_store_explicit(&counter->peak_bytes, alloc_bytes - free_bytes, memory_order_relaxed);
+        }
     }
-    return 0;
+    else
+    {
+        atomic_store_explicit(&counter->free_bytes, free_bytes + size, memory_order_relaxed);
+        atomic_store_explicit(&counter->free_count,
+                              atomic_load_explicit(&counter->free_count, memory_order_relaxed) + 1,
+                              memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 更新模型计数
+ *
+ * @param counter 计数
+ * @param size 大小
+ * @param alloc 1分配，0释放
+ */
+static void _cson_stats_count_shared(cson_stats_counter_t *counter, size_t size, char alloc)
+{
+    size_t live;
+    size_t peak;
+
+    if (!alloc)
+    {
+        atomic_fetch_add_explicit(&counter->free_bytes, size, memory_order_relaxed);
+        atomic_fetch_add_explicit(&counter->free_count, 1, memory_order_relaxed);
+        return;
+    }
+    atomic_fetch_add_explicit(&counter->alloc_count, 1, memory_order_relaxed);
+    live = atomic_fetch_add_explicit(&counter->alloc_bytes, size, memory_order_relaxed) + size -
+           atomic_load_explicit(&counter->free_bytes, memory_order_relaxed);
+    peak = atomic_load_explicit(&counter->peak_bytes, memory_order_relaxed);
+    while ((ptrdiff_t)live > (ptrdiff_t)peak &&
+           !atomic_compare_exchange_weak_explicit(&counter->peak_bytes, &peak, live,
+                                                  memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief 统计内存分配
+ *
+ * @param size 大小
+ * @param scope 模型统计，为NULL时只计入线程
+ * @param alloc 1分配，0释放
+ */
+static void _cson_stats_count(size_t size, cson_stats_model_t *scope, char alloc)
+{
+    cson_stats_thread_t *local = _cson_stats_local();
+
+    if (local)
+    {
+        _cson_stats_count_local(&local->counter, size, alloc);
+    }
+    if (scope)
+    {
+        _cson_stats_count_shared(&scope->counter, size, alloc);
+    }
+}
+
+/**
+ * @brief 带统计的内存分配
+ *
+ * @param size 大小
+ * @return void* 内存
+ */
+static void *_cson_stats_malloc(size_t size)
+{
+    cson_stats_head_t *head = s_cson_stats.malloc(sizeof(cson_stats_head_t) + size);
+
+    if (!head)
+    {
+        return NULL;
+    }
+    head->info.size = size;
+    head->info.scope = s_cson_stats_scope != &s_cson_stats_untracked ? s_cson_stats_scope : NULL;
+    _cson_stats_count(size, head->info.scope, 1);
+    return head + 1;
+}
+
+/**
+ * @brief 带统计的内存释放
+ *
+ * @param ptr 内存
+ */
+static void _cson_stats_free(void *ptr)
+{
+    cson_stats_head_t *head;
+
+    if (!ptr)
+    {
+        return;
+    }
+    head = (cson_stats_head_t *)ptr - 1;
+    _cson_stats_count(head->info.size, head->info.scope, 0);
+    s_cson_stats.free(head);
+}
+
+/**
+ * @brief 读取计数
+ *
+ * @param counter 计数
+ * @param stats 累加到的统计
+ */
+static void _cson_stats_read(cson_stats_counter_t *counter, cson_stats_t *stats)
+{
+    size_t alloc_bytes = atomic_load_explicit(&counter->alloc_bytes, memory_order_relaxed);
+    size_t free_bytes = atomic_load_explicit(&counter->free_bytes, memory_order_relaxed);
+
+    stats->alloc_count += atomic_load_explicit(&counter->alloc_count, memory_order_relaxed);
+    stats->free_count += atomic_load_explicit(&counter->free_count, memory_order_relaxed);
+    stats->alloc_bytes += alloc_bytes;
+    stats->free_bytes += free_bytes;
+    stats->live_bytes += (ptrdiff_t)(alloc_bytes - free_bytes);
+    stats->peak_bytes += atomic_load_explicit(&counter->peak_bytes, memory_order_relaxed);
+}
+
+/**
+ * @brief 查找模型统计
+ *
+ * @param model 数据模型
+ * @return cson_stats_model_t* 模型统计，未注册时返回NULL
+ */
+static cson_stats_model_t *_cson_stats_find(cson_model_t *model)
+{
+    for (int i = 0; i < CSON_STATS_MODEL_MAX; i++)
+    {
+        cson_model_t *tracked = atomic_load_explicit(&s_cson_stats.models[i].model, memory_order_acquire);
+        if (tracked == model)
+        {
+            return &s_cson_stats.models[i];
+        }
+        if (!tracked)
+        {
+            break;
+        }
+    }
+    return NULL;
+}
+#endif
+
+#if CSON_PROFILE_ENABLE
+static void *(*s_cson_profile_malloc)(size_t);
+
+/**
+ * @brief 记录字段开销的内存分配
+ *
+ * @param size 大小
+ * @return void* 内存
+ */
+static void *_cson_profile_malloc(size_t size)
+{
+    cson_profile_alloc(size);
+    return s_cson_profile_malloc(size);
+}
+#endif
+
+/**
+ * @brief CSON初始化
+ *
+ * @param malloc 内存分配函数
+ * @param free 内存释放函数
+ * @note 启用`CSON_STATS_ENABLE`时，分配函数被包装为带统计的版本，
+ *       交由cson释放的内存须通过`cson_mem_alloc`或`cson_new_string`分配
+ */
+void cson_init(void *malloc_func, void *free_func)
+{
+    s_cson.malloc = (void *(*)(size_t))malloc_func;
+    s_cson.free = (void (*)(void *))free_func;
+#if CSON_STATS_ENABLE
+    s_cson_stats.malloc = s_cson.malloc;
+    s_cson_stats.free = s_cson.free;
+    s_cson.malloc = _cson_stats_malloc;
+    s_cson.free = _cson_stats_free;
+#endif
+#if CSON_PROFILE_ENABLE
+    s_cson_profile_malloc = s_cson.malloc;
+    s_cson.malloc = _cson_profile_malloc;
+#endif
+    cJSON_InitHooks(&(cJSON_Hooks){s_cson.malloc, s_cson.free});
 }
 
+/**
+ * @brief 解析/释放上下文
+ *
+ */
+typedef struct
+{
+    cson_pool_t *pool;       /**< 对象池，为NULL时从堆上分配 */
+    const char *borrow_base; /**< 可直接引用字符串的区域，为NULL时复制字符串 */
+    size_t borrow_len;       /**< 区域长度 */
+} cson_ctx_t;
+
+static void *_cson_decode_object(cJSON *json, cson_model_t *model, int model_size, cson_ctx_t *ctx);
+static void _cson_decode_into(cJSON *json, cson_model_t *model, int model_size, void *obj, cson_ctx_t *ctx);
+static cJSON *_cson_encode_object(void *obj, cson_model_t *model, int model_size);
+static void _cson_free_fields(void *obj, cson_model_t *model, int model_size, cson_ctx_t *ctx);
+static void *_cson_pool_alloc(cson_pool_t *pool, cson_model_t *model, int model_size);
+static void _cson_pool_put(void *obj);
+
 /**
  * @brief 解析JSON浮点型
  *
@@ -93,7 +404,7 @@ static int _cson_decode_number(cJSON *json, char *key)
 static double _cson_decode_double(cJSON *json, char *key)
 {
     cJSON *item = key ? cJSON_GetObjectItem(json, key) : json;
-    if (item && item->type == cJSON_Number)
+    if (item && (item->type & 0xFF) == cJSON_Number)
     {
         return item->valuedouble;
     }
@@ -105,17 +416,23 @@ static double _cson_decode_double(cJSON *json, char *key)
  *
  * @param json JSON对象
  * @param key key
+ * @param ctx 解析上下文
  * @return char* 解析出的字符串
  */
-static char *_cson_decode_string(cJSON *json, char *key)
+static char *_cson_decode_string(cJSON *json, char *key, cson_ctx_t *ctx)
 {
     char *p = NULL;
     char *str = NULL;
     short str_len = 0;
     cJSON *item = key ? cJSON_GetObjectItem(json, key) : json;
-    if (item && item->type == cJSON_String)
+    if (item && (item->type & 0xFF) == cJSON_String)
     {
         str = item->valuestring;
+        if (ctx && ctx->borrow_base && (item->type & cJSON_IsReference)
+            && str >= ctx->borrow_base && str < ctx->borrow_base + ctx->borrow_len)
+        {
+            return str;
+        }
         if (item->valuestring)
         {
             str_len = strlen(str);
@@ -131,6 +448,26 @@ static char *_cson_decode_string(cJSON *json, char *key)
     return NULL;
 }
 
+/**
+ * @brief 解析JSON字符串到定长字符数组
+ *
+ * @param json JSON对象
+ * @param field 定长字符数组数据模型
+ * @param dest 字符数组
+ */
+static void _cson_decode_chars(cJSON *json, cson_model_t *field, char *dest)
+{
+    cJSON *item = cJSON_GetObjectItem(json, field->key);
+    if (item && (item->type & 0xFF) == cJSON_String && item->valuestring)
+    {
+        cson_chars_assign(dest, field, item->valuestring, strlen(item->valuestring));
+    }
+    else
+    {
+        cson_chars_assign(dest, field, NULL, 0);
+    }
+}
+
 /**
  * @brief 解析JOSN布尔型数据
  *
@@ -141,44 +478,138 @@ static char *_cson_decode_string(cJSON *json, char *key)
 static char _cson_decode_bool(cJSON *json, char *key)
 {
     cJSON *item = cJSON_GetObjectItem(json, key);
-    if (item && item->type == cJSON_True)
+    if (item && (item->type & 0xFF) == cJSON_True)
     {
         return 1;
     }
     return 0;
 }
 
+/**
+ * @brief 解析基础类型值
+ *
+ * @param item JSON对象
+ * @param type 数据类型
+ * @param addr 数据地址
+ * @param ctx 解析上下文
+ */
+static void _cson_decode_value(cJSON *item, cson_type_t type, void *addr, cson_ctx_t *ctx)
+{
+    double num;
+
+    if (type == CSON_TYPE_STRING)
+    {
+        *(char **)addr = _cson_decode_string(item, NULL, ctx);
+        return;
+    }
+    num = _cson_decode_double(item, NULL);
+    cson_model_store_number(type, addr, cson_number_integer(num), num);
+}
+
+/**
+ * @brief 在链表头的尾节点后挂接节点
+ *
+ * @param list 链表头
+ * @param node 节点
+ */
+static void _cson_list_link(cson_list_head_t *list, cson_list_t *node)
+{
+    if (list->tail)
+    {
+        list->tail->next = node;
+    }
+    else
+    {
+        list->head = node;
+    }
+    list->tail = node;
+    list->count++;
+}
+
 /**
  * @brief 解析CsonList数据
  *
+ * 每个数组元素对应一个节点：基础类型链表的元素值直接写入节点，不再为每个元素分配对象；
+ * 结构体链表中null元素的节点对象为NULL，编码时跳过。节点经链表头挂接到尾部，
+ * 各自单独分配，解析结果仍由`cson_free`逐个释放
+ *
  * @param json JSON对象
  * @param key key
  * @param model CsonList成员数据模型
  * @param model_size SconList成员模型数量
+ * @param ctx 解析上下文
  * @return void* CsonList对象
  */
-static void *_cson_decode_list(cJSON *json, char *key, cson_model_t *model, int model_size)
+static void *_cson_decode_list(cJSON *json, char *key, cson_model_t *model, int model_size, cson_ctx_t *ctx)
 {
-    cson_list_t *list = NULL;
+    cson_pool_t *pool = ctx ? ctx->pool : NULL;
+    signed char basic = cson_model_is_basic(model);
+    cson_list_head_t list = CSON_LIST_HEAD_INIT;
+    cson_list_t *node;
     cJSON *array = cJSON_GetObjectItem(json, key);
+    cJSON *item;
 
-    if (array && array->type == cJSON_Array)
+    if (!array || (array->type & 0xFF) != cJSON_Array)
+    {
+        return NULL;
+    }
+    for (item = array->child; item; item = item->next)
     {
-        for (short i = 0; i < cJSON_GetArraySize(array); i++)
+        node = pool ? _cson_pool_alloc(pool, NULL, 0) : s_cson.malloc(sizeof(cson_list_t));
+        if (!node)
         {
-            void *obj = cson_decode_object(cJSON_GetArrayItem(array, i), model, model_size);
-            if (_cson_is_basic_list_model(model))
-            {
-                list = cson_list_add(list, (void *)(*((int *)obj)));
-                s_cson.free(obj);
-            }
-            else
-            {
-                list = cson_list_add(list, obj);
-            }
+            continue;
         }
+        memset(node, 0, sizeof(cson_list_t));
+        if (basic)
+        {
+            _cson_decode_value(item, model[1].type, &node->obj, ctx);
+        }
+        else
+        {
+            node->obj = _cson_decode_object(item, model, model_size, ctx);
+        }
+        _cson_list_link(&list, node);
     }
-    return list;
+    return list.head;
+}
+
+/**
+ * @brief 解析侵入式链表，元素直接通过next成员串联
+ *
+ * @param json JSON对象
+ * @param field 侵入式链表数据模型
+ * @param ctx 解析上下文
+ * @return void* 首元素
+ */
+static void *_cson_decode_ilist(cJSON *json, cson_model_t *field, cson_ctx_t *ctx)
+{
+    cJSON *array = cJSON_GetObjectItem(json, field->key);
+    void *head = NULL;
+    void **link = &head;
+    cJSON *item;
+    void *obj;
+
+    if (!array || (array->type & 0xFF) != cJSON_Array)
+    {
+        return NULL;
+    }
+    for (item = array->child; item; item = item->next)
+    {
+        if ((item->type & 0xFF) != cJSON_Object)
+        {
+            continue;
+        }
+        obj = _cson_decode_object(item, field->param.ilist.model, field->param.ilist.size, ctx);
+        if (!obj)
+        {
+            continue;
+        }
+        *link = obj;
+        link = (void **)((size_t)obj + field->param.ilist.next);
+        *link = NULL;
+    }
+    return head;
 }
 
 /**
@@ -189,133 +620,284 @@ static void *_cson_decode_list(cJSON *json, char *key, cson_model_t *model, int
  * @param base 数组基址
  * @param element_type 数组元素类型
  * @param array_size 数组大小
+ * @param ctx 解析上下文
  */
-static void _cson_decode_array(cJSON *json, char *key, void *base, cson_type_t element_type, short array_size)
+static void _cson_decode_array(cJSON *json, char *key, void *base, cson_type_t element_type, short array_size, cson_ctx_t *ctx)
 {
     cJSON *array = cJSON_GetObjectItem(json, key);
+    size_t ele_size = cson_model_type_size(element_type);
     cJSON *item;
-    char *str;
-    short str_len;
+    short i = 0;
 
-    if (array && array->type == cJSON_Array)
+    if (array && (array->type & 0xFF) == cJSON_Array)
     {
-        for (short i = 0; i < cJSON_GetArraySize(array); i++)
+        for (item = array->child; item && i < array_size; item = item->next, i++)
         {
-            item = cJSON_GetArrayItem(array, i);
-            switch (element_type)
-            {
-            case CSON_TYPE_CHAR:
-                *(char *)((size_t)base + (i * sizeof(char))) = (char)item->valueint;
-                break;
-            case CSON_TYPE_SHORT:
-                *(short *)((size_t)base + (i * sizeof(short))) = (short)item->valueint;
-                break;
-            case CSON_TYPE_INT:
-                *(int *)((size_t)base + (i * sizeof(int))) = (int)item->valueint;
-                break;
-            case CSON_TYPE_LONG:
-                *(long *)((size_t)base + (i * sizeof(long))) = (long)item->valueint;
-                break;
-            case CSON_TYPE_FLOAT:
-                *(float *)((size_t)base + (i * sizeof(float))) = (float)item->valuedouble;
-                break;
-            case CSON_TYPE_DOUBLE:
-                *(double *)((size_t)base + (i * sizeof(double))) = (double)item->valuedouble;
-                break;
-            case CSON_TYPE_STRING:
-                str_len = strlen(item->valuestring);
-                str = s_cson.malloc(str_len + 1);
-                memcpy(str, item->valuestring, str_len);
-                *(str + str_len) = 0;
-                *(size_t *)((size_t)base + (i * sizeof(size_t))) = (size_t)str;
-                break;
-            default:
-                break;
-            }
+            _cson_decode_value(item, element_type, (void *)((size_t)base + i * ele_size), ctx);
         }
     }
+    /* 未填充的元素清零，字符串数组释放时按容量逐个释放 */
+    if (i < array_size)
+    {
+        memset((void *)((size_t)base + i * ele_size), 0, (size_t)(array_size - i) * ele_size);
+    }
 }
 
 /**
- * @brief 解析JSON对象
+ * @brief 解析内嵌结构体数组，超出数组大小的元素被忽略，其余位置置零
  *
  * @param json JSON对象
- * @param model 数据模型
- * @param model_size 数据模型数量
- * @return void* 解析得到的对象
+ * @param obj 所属对象
+ * @param field 内嵌结构体数组数据模型
+ * @param ctx 解析上下文
  */
-void *cson_decode_object(cJSON *json, cson_model_t *model, int model_size)
+static void _cson_decode_embeds(cJSON *json, void *obj, cson_model_t *field, cson_ctx_t *ctx)
 {
-    CSON_ASSERT(json, return NULL);
+    cJSON *array = cJSON_GetObjectItem(json, field->key);
+    size_t ele_size = cson_model_obj_size(field->param.embeds.model, field->param.embeds.size);
+    void *base = (void *)((size_t)obj + field->offset);
+    cJSON *item;
+    int count = 0;
 
-    if (json->type == cJSON_NULL)
+    item = array && (array->type & 0xFF) == cJSON_Array ? array->child : NULL;
+    for (; item && count < field->param.embeds.capacity; item = item->next)
     {
-        return NULL;
+        _cson_decode_into(item, field->param.embeds.model, field->param.embeds.size,
+                          (void *)((size_t)base + count++ * ele_size), ctx);
     }
-
-    short obj_size = 0;
-    for (short i = 0; i < model_size; i++)
+    cson_embeds_set_count(obj, field, count);
+    for (int i = count; i < field->param.embeds.capacity; i++)
     {
-        if (model[i].type == CSON_TYPE_OBJ)
-        {
-            obj_size = model[i].param.obj_size;
-        }
+        memset((void *)((size_t)base + i * ele_size), 0, ele_size);
+        _cson_decode_into(NULL, field->param.embeds.model, field->param.embeds.size,
+                          (void *)((size_t)base + i * ele_size), ctx);
     }
-    void *obj = s_cson.malloc(obj_size);
-    CSON_ASSERT(obj, return NULL);
+}
 
-    for (short i = 0; i < model_size; i++)
-    {
-        switch (model[i].type)
-        {
-        case CSON_TYPE_CHAR:
-            *(char *)((size_t)obj + model[i].offset) = (char)_cson_decode_number(json, model[i].key);
-            break;
-        case CSON_TYPE_SHORT:
-            *(short *)((size_t)obj + model[i].offset) = (short)_cson_decode_number(json, model[i].key);
-            break;
-        case CSON_TYPE_INT:
-            *(int *)((size_t)obj + model[i].offset) = (int)_cson_decode_number(json, model[i].key);
-            break;
-        case CSON_TYPE_LONG:
-            *(long *)((size_t)obj + model[i].offset) = (long)_cson_decode_number(json, model[i].key);
-            break;
-        case CSON_TYPE_FLOAT:
-            *(float *)((size_t)obj + model[i].offset) = (float)_cson_decode_double(json, model[i].key);
-            break;
-        case CSON_TYPE_DOUBLE:
-            *(double *)((size_t)obj + model[i].offset) = _cson_decode_double(json, model[i].key);
-            break;
-        case CSON_TYPE_BOOL:
-            *(char *)((size_t)obj + model[i].offset) = (char)_cson_decode_bool(json, model[i].key);
+/**
+ * @brief 解析结构体成员
+ *
+ * @param json JSON对象
+ * @param key key
+ * @param model 结构体数据模型
+ * @param model_size 结构体数据模型数量
+ * @param ctx 解析上下文
+ * @return void* 结构体对象，key不存在时返回NULL
+ */
+static void *_cson_decode_struct(cJSON *json, char *key, cson_model_t *model, int model_size, cson_ctx_t *ctx)
+{
+    cJSON *item = cJSON_GetObjectItem(json, key);
+
+    return item ? _cson_decode_object(item, model, model_size, ctx) : NULL;
+}
+
+/**
+ * @brief 解析vector，按数组长度一次分配
+ *
+ * @param json JSON对象
+ * @param key key
+ * @param vec vector
+ * @param model 元素数据模型
+ * @param model_size 元素数据模型数量
+ * @param ctx 解析上下文
+ */
+static void _cson_decode_vector(cJSON *json, char *key, cson_vector_t *vec, cson_model_t *model, int model_size,
+                                cson_ctx_t *ctx)
+{
+    cJSON *array = cJSON_GetObjectItem(json, key);
+    size_t ele_size = cson_model_obj_size(model, model_size);
+    size_t count = 0;
+    cJSON *item;
+
+    vec->data = NULL;
+    vec->count = 0;
+    vec->cap = 0;
+    if (!array || (array->type & 0xFF) != cJSON_Array)
+    {
+        return;
+    }
+    count = (size_t)cJSON_GetArraySize(array);
+    if (!count || cson_vector_reserve(vec, model, model_size, count) != 0)
+    {
+        return;
+    }
+    for (item = array->child; item; item = item->next)
+    {
+        _cson_decode_into(item, model, model_size, (void *)((size_t)vec->data + vec->count++ * ele_size), ctx);
+    }
+}
+
+/**
+ * @brief 解析JSON对象到已分配的对象中
+ *
+ * @param json JSON对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param obj 对象
+ * @param ctx 解析上下文
+ */
+static void _cson_decode_into(cJSON *json, cson_model_t *model, int model_size, void *obj, cson_ctx_t *ctx)
+{
+    double num;
+
+    for (short i = 0; i < model_size; i++)
+    {
+        CSON_PROFILE_BEGIN(mark, !json || !cJSON_GetObjectItem(json, model[i].key));
+        switch (model[i].type)
+        {
+        case CSON_TYPE_CHAR:
+        case CSON_TYPE_SHORT:
+        case CSON_TYPE_INT:
+        case CSON_TYPE_LONG:
+        case CSON_TYPE_FLOAT:
+        case CSON_TYPE_DOUBLE:
+            num = _cson_decode_double(json, model[i].key);
+            cson_model_store_number(model[i].type, (void *)((size_t)obj + model[i].offset), cson_number_integer(num), num);
+            break;
+        case CSON_TYPE_BOOL:
+            *(char *)((size_t)obj + model[i].offset) = (char)_cson_decode_bool(json, model[i].key);
             break;
         case CSON_TYPE_STRING:
-            *(size_t *)((size_t)obj + model[i].offset) = (size_t)_cson_decode_string(json, model[i].key);
+            *(size_t *)((size_t)obj + model[i].offset) = (size_t)_cson_decode_string(json, model[i].key, ctx);
             break;
         case CSON_TYPE_LIST:
             *(size_t *)((size_t)obj + model[i].offset) = (size_t)_cson_decode_list(json,
-                                                                                   model[i].key, model[i].param.sub.model, model[i].param.sub.size);
+                                                                                   model[i].key, model[i].param.sub.model, model[i].param.sub.size, ctx);
             break;
         case CSON_TYPE_STRUCT:
-            *(size_t *)((size_t)obj + model[i].offset) = (size_t)cson_decode_object(
-                cJSON_GetObjectItem(json, model[i].key),
-                model[i].param.sub.model, model[i].param.sub.size);
+            *(size_t *)((size_t)obj + model[i].offset) = (size_t)_cson_decode_struct(json, model[i].key,
+                                                                                     model[i].param.sub.model, model[i].param.sub.size, ctx);
             break;
         case CSON_TYPE_ARRAY:
             _cson_decode_array(json, model[i].key, (void *)((size_t)obj + model[i].offset),
-                               model[i].param.array.ele_type, model[i].param.array.size);
+                               model[i].param.array.ele_type, model[i].param.array.size, ctx);
             break;
         case CSON_TYPE_JSON:
             *(size_t *)((size_t)obj + model[i].offset) = (size_t)cJSON_PrintUnformatted(
                 cJSON_GetObjectItem(json, model[i].key));
             break;
+        case CSON_TYPE_CHAR_ARRAY:
+            _cson_decode_chars(json, &model[i], (char *)((size_t)obj + model[i].offset));
+            break;
+        case CSON_TYPE_VECTOR:
+            _cson_decode_vector(json, model[i].key, (cson_vector_t *)((size_t)obj + model[i].offset),
+                                model[i].param.sub.model, model[i].param.sub.size, ctx);
+            break;
+        case CSON_TYPE_EMBED:
+            _cson_decode_into(cJSON_GetObjectItem(json, model[i].key), model[i].param.sub.model,
+                              model[i].param.sub.size, (void *)((size_t)obj + model[i].offset), ctx);
+            break;
+        case CSON_TYPE_EMBED_ARRAY:
+            _cson_decode_embeds(json, obj, &model[i], ctx);
+            break;
+        case CSON_TYPE_ILIST:
+            *(void **)((size_t)obj + model[i].offset) = _cson_decode_ilist(json, &model[i], ctx);
+            break;
         default:
             break;
         }
+        CSON_PROFILE_END(mark, DECODE, model, &model[i]);
+    }
+}
+
+/**
+ * @brief 解析JSON对象
+ *
+ * @param json JSON对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param ctx 解析上下文
+ * @return void* 解析得到的对象
+ */
+static void *_cson_decode_object(cJSON *json, cson_model_t *model, int model_size, cson_ctx_t *ctx)
+{
+    CSON_ASSERT(json, return NULL);
+
+    if ((json->type & 0xFF) == cJSON_NULL)
+    {
+        return NULL;
     }
+
+    void *obj = (ctx && ctx->pool) ? _cson_pool_alloc(ctx->pool, model, model_size)
+                                   : s_cson.malloc(cson_model_obj_size(model, model_size));
+    CSON_ASSERT(obj, return NULL);
+
+    _cson_decode_into(json, model, model_size, obj, ctx);
+    return obj;
+}
+
+/**
+ * @brief 解析JSON对象
+ *
+ * @param json JSON对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 解析得到的对象
+ */
+void *cson_decode_object(cJSON *json, cson_model_t *model, int model_size)
+{
+    void *obj;
+    CSON_STATS_ENTER(model);
+    CSON_PHASE_BEGIN(BIND);
+    obj = _cson_decode_object(json, model, model_size, NULL);
+    CSON_PHASE_END(BIND);
+    CSON_STATS_LEAVE();
     return obj;
 }
 
+/**
+ * @brief 将JSON字符串解析到临时arena中
+ *
+ * 解析得到的对象会复制全部字符串，cJSON树只在解析期间使用，整棵树放在一块arena中，用完一次释放；
+ * arena从默认大小的小块起步，按需倍增，创建arena失败时退回逐节点分配的`cJSON_Parse`
+ *
+ * @param json_str json字符串
+ * @param arena 创建的arena，解析失败或未使用arena时为NULL
+ * @return cJSON* cJSON树，使用后调用`_cson_release_transient`释放
+ */
+static cJSON *_cson_parse_transient(const char *json_str, cJSON_Arena **arena)
+{
+    size_t len;
+    cJSON *json;
+
+    *arena = NULL;
+    if (!json_str)
+    {
+        return NULL;
+    }
+    *arena = cJSON_CreateArena(0);
+    if (!*arena)
+    {
+        return cJSON_Parse(json_str);
+    }
+    len = strlen(json_str) + 1;
+    json = cJSON_ParseInArena(json_str, len, *arena);
+    if (!json)
+    {
+        cJSON_DeleteArena(*arena);
+        *arena = NULL;
+    }
+    return json;
+}
+
+/**
+ * @brief 释放`_cson_parse_transient`解析得到的cJSON树
+ *
+ * @param json cJSON树
+ * @param arena 解析时创建的arena
+ */
+static void _cson_release_transient(cJSON *json, cJSON_Arena *arena)
+{
+    if (arena)
+    {
+        cJSON_DeleteArena(arena);
+    }
+    else
+    {
+        cJSON_Delete(json);
+    }
+}
+
 /**
  * @brief 解析JSON字符串
  *
@@ -327,10 +909,20 @@ void *cson_decode_object(cJSON *json, cson_model_t *model, int model_size)
 void *cson_decode(const char *json_str, cson_model_t *model, int model_size)
 {
     void *obj;
-    cJSON *json = cJSON_Parse(json_str);
-    CSON_ASSERT(json, return NULL);
-    obj = cson_decode_object(json, model, model_size);
-    cJSON_Delete(json);
+    cJSON *json;
+    cJSON_Arena *arena;
+    CSON_STATS_ENTER(model);
+    CSON_PHASE_BEGIN(PARSE);
+    json = _cson_parse_transient(json_str, &arena);
+    CSON_PHASE_END(PARSE);
+    CSON_ASSERT(json, CSON_STATS_LEAVE(); return NULL);
+    CSON_PHASE_BEGIN(BIND);
+    obj = _cson_decode_object(json, model, model_size, NULL);
+    CSON_PHASE_END(BIND);
+    CSON_PHASE_BEGIN(DELETE);
+    _cson_release_transient(json, arena);
+    CSON_PHASE_END(DELETE);
+    CSON_STATS_LEAVE();
     return obj;
 }
 
@@ -375,6 +967,60 @@ static void _cson_encode_string(cJSON *json, char *key, char *str)
     }
 }
 
+/**
+ * @brief 定长字符数组编码成JSON字符串，未以'\0'结尾时按容量截取
+ *
+ * @param json json对象
+ * @param field 定长字符数组数据模型
+ * @param chars 字符数组
+ */
+static void _cson_encode_chars(cJSON *json, cson_model_t *field, char *chars)
+{
+    char *str;
+
+    if (memchr(chars, 0, field->param.chars.size))
+    {
+        cJSON_AddStringToObject(json, field->key, chars);
+        return;
+    }
+    str = s_cson.malloc(field->param.chars.size + 1);
+    CSON_ASSERT(str, return);
+    memcpy(str, chars, field->param.chars.size);
+    str[field->param.chars.size] = 0;
+    cJSON_AddStringToObject(json, field->key, str);
+    s_cson.free(str);
+}
+
+/**
+ * @brief 基础类型数据编码成JSON对象
+ *
+ * @param addr 数据地址
+ * @param type 数据类型
+ * @return cJSON* 编码得到的JSON对象，空字符串指针返回NULL
+ */
+static cJSON *_cson_encode_value(void *addr, cson_type_t type)
+{
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+        return cJSON_CreateNumber(*(char *)addr);
+    case CSON_TYPE_SHORT:
+        return cJSON_CreateNumber(*(short *)addr);
+    case CSON_TYPE_INT:
+        return cJSON_CreateNumber(*(int *)addr);
+    case CSON_TYPE_LONG:
+        return cJSON_CreateNumber(*(long *)addr);
+    case CSON_TYPE_FLOAT:
+        return cJSON_CreateNumber(*(float *)addr);
+    case CSON_TYPE_DOUBLE:
+        return cJSON_CreateNumber(*(double *)addr);
+    case CSON_TYPE_STRING:
+        return cJSON_CreateString((char *)*(size_t *)addr);
+    default:
+        return NULL;
+    }
+}
+
 /**
  * @brief CsonList编码成JSON对象
  *
@@ -391,18 +1037,16 @@ static cJSON *_cson_encode_list(cson_list_t *list, cson_model_t *model, int mode
 
     while (p)
     {
-        if (p->obj)
+        if (cson_model_is_basic(model))
         {
-            if (_cson_is_basic_list_model(model))
-            {
-                item = cson_encode_object(&(p->obj), model, model_size);
-            }
-            else
-            {
-                item = cson_encode_object(p->obj, model, model_size);
-            }
-            cJSON_AddItemToArray(root, item);
+            item = _cson_encode_value(&p->obj, model[1].type);
+        }
+        else
+        {
+            item = p->obj ? _cson_encode_object(p->obj, model, model_size) : NULL;
         }
+        if (item)
+            cJSON_AddItemToArray(root, item);
         p = p->next;
     }
     return root;
@@ -423,33 +1067,72 @@ static cJSON *_cson_encode_array(void *base, cson_type_t element_type, short arr
 
     for (short i = 0; i < array_size; i++)
     {
-        item = NULL;
-        switch (element_type)
-        {
-        case CSON_TYPE_CHAR:
-            item = cJSON_CreateNumber(*(char *)((size_t)base + (i * sizeof(char))));
-            break;
-        case CSON_TYPE_SHORT:
-            item = cJSON_CreateNumber(*(short *)((size_t)base + (i * sizeof(short))));
-            break;
-        case CSON_TYPE_INT:
-            item = cJSON_CreateNumber(*(int *)((size_t)base + (i * sizeof(int))));
-            break;
-        case CSON_TYPE_LONG:
-            item = cJSON_CreateNumber(*(long *)((size_t)base + (i * sizeof(long))));
-            break;
-        case CSON_TYPE_FLOAT:
-            item = cJSON_CreateNumber(*(float *)((size_t)base + (i * sizeof(float))));
-            break;
-        case CSON_TYPE_DOUBLE:
-            item = cJSON_CreateNumber(*(double *)((size_t)base + (i * sizeof(double))));
-            break;
-        case CSON_TYPE_STRING:
-            item = cJSON_CreateString((char *)*(size_t *)((size_t)base + (i * sizeof(size_t))));
-            break;
-        default:
-            break;
-        }
+        item = _cson_encode_value((void *)((size_t)base + i * cson_model_type_size(element_type)), element_type);
+        if (item)
+            cJSON_AddItemToArray(root, item);
+    }
+    return root;
+}
+
+/**
+ * @brief 内嵌结构体数组编码成JSON对象
+ *
+ * @param obj 所属对象
+ * @param field 内嵌结构体数组数据模型
+ * @return cJSON* 编码得到的JOSN对象
+ */
+static cJSON *_cson_encode_embeds(void *obj, cson_model_t *field)
+{
+    cJSON *root = cJSON_CreateArray();
+    size_t ele_size = cson_model_obj_size(field->param.embeds.model, field->param.embeds.size);
+    int count = cson_embeds_count(obj, field);
+
+    for (int i = 0; i < count; i++)
+    {
+        cJSON_AddItemToArray(root, _cson_encode_object((void *)((size_t)obj + field->offset + i * ele_size),
+                                                       field->param.embeds.model, field->param.embeds.size));
+    }
+    return root;
+}
+
+/**
+ * @brief 侵入式链表编码成JSON对象
+ *
+ * @param head 首元素
+ * @param field 侵入式链表数据模型
+ * @return cJSON* 编码得到的JOSN对象
+ */
+static cJSON *_cson_encode_ilist(void *head, cson_model_t *field)
+{
+    cJSON *root = cJSON_CreateArray();
+
+    for (void *p = head; p; p = *(void **)((size_t)p + field->param.ilist.next))
+    {
+        cJSON_AddItemToArray(root, _cson_encode_object(p, field->param.ilist.model, field->param.ilist.size));
+    }
+    return root;
+}
+
+/**
+ * @brief vector编码成JSON对象
+ *
+ * @param vec vector
+ * @param model 元素数据模型
+ * @param model_size 元素数据模型数量
+ * @return cJSON* 编码得到的JOSN对象
+ */
+static cJSON *_cson_encode_vector(cson_vector_t *vec, cson_model_t *model, int model_size)
+{
+    cJSON *root = cJSON_CreateArray();
+    size_t ele_size = cson_model_obj_size(model, model_size);
+    cJSON *item;
+    void *ele;
+
+    for (size_t i = 0; i < vec->count; i++)
+    {
+        ele = (void *)((size_t)vec->data + i * ele_size);
+        item = cson_model_is_basic(model) ? _cson_encode_value(ele, model[1].type)
+                                                : _cson_encode_object(ele, model, model_size);
         if (item)
             cJSON_AddItemToArray(root, item);
     }
@@ -464,7 +1147,7 @@ static cJSON *_cson_encode_array(void *base, cson_type_t element_type, short arr
  * @param model_size 数据模型数量
  * @return cJSON* 编码得到的json对象
  */
-cJSON *cson_encode_object(void *obj, cson_model_t *model, int model_size)
+static cJSON *_cson_encode_object(void *obj, cson_model_t *model, int model_size)
 {
     if (!obj)
     {
@@ -474,6 +1157,7 @@ cJSON *cson_encode_object(void *obj, cson_model_t *model, int model_size)
 
     for (short i = 0; i < model_size; i++)
     {
+        CSON_PROFILE_BEGIN(mark, 0);
         switch (model[i].type)
         {
         case CSON_TYPE_CHAR:
@@ -514,7 +1198,7 @@ cJSON *cson_encode_object(void *obj, cson_model_t *model, int model_size)
         case CSON_TYPE_STRUCT:
             if ((void *)(*(size_t *)((size_t)obj + model[i].offset)))
             {
-                cJSON_AddItemToObject(root, model[i].key, cson_encode_object((void *)(*(size_t *)((size_t)obj + model[i].offset)), model[i].param.sub.model, model[i].param.sub.size));
+                cJSON_AddItemToObject(root, model[i].key, _cson_encode_object((void *)(*(size_t *)((size_t)obj + model[i].offset)), model[i].param.sub.model, model[i].param.sub.size));
             }
             break;
         case CSON_TYPE_ARRAY:
@@ -527,13 +1211,56 @@ cJSON *cson_encode_object(void *obj, cson_model_t *model, int model_size)
                                       cJSON_Parse((char *)(*(size_t *)((size_t)obj + model[i].offset))));
             }
             break;
+        case CSON_TYPE_CHAR_ARRAY:
+            _cson_encode_chars(root, &model[i], (char *)((size_t)obj + model[i].offset));
+            break;
+        case CSON_TYPE_VECTOR:
+            cJSON_AddItemToObject(root, model[i].key,
+                                  _cson_encode_vector((cson_vector_t *)((size_t)obj + model[i].offset),
+                                                      model[i].param.sub.model, model[i].param.sub.size));
+            break;
+        case CSON_TYPE_EMBED:
+            cJSON_AddItemToObject(root, model[i].key,
+                                  _cson_encode_object((void *)((size_t)obj + model[i].offset),
+                                                      model[i].param.sub.model, model[i].param.sub.size));
+            break;
+        case CSON_TYPE_EMBED_ARRAY:
+            cJSON_AddItemToObject(root, model[i].key, _cson_encode_embeds(obj, &model[i]));
+            break;
+        case CSON_TYPE_ILIST:
+            if (*(void **)((size_t)obj + model[i].offset))
+            {
+                cJSON_AddItemToObject(root, model[i].key,
+                                      _cson_encode_ilist(*(void **)((size_t)obj + model[i].offset), &model[i]));
+            }
+            break;
         default:
             break;
         }
+        CSON_PROFILE_END(mark, ENCODE, model, &model[i]);
     }
     return root;
 }
 
+/**
+ * @brief 编码JSON对象
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return cJSON* 编码得到的json对象
+ */
+cJSON *cson_encode_object(void *obj, cson_model_t *model, int model_size)
+{
+    cJSON *json;
+    CSON_STATS_ENTER(model);
+    CSON_PHASE_BEGIN(BUILD);
+    json = _cson_encode_object(obj, model, model_size);
+    CSON_PHASE_END(BUILD);
+    CSON_STATS_LEAVE();
+    return json;
+}
+
 /**
  * @brief 编码成json字符串
  *
@@ -546,10 +1273,18 @@ cJSON *cson_encode_object(void *obj, cson_model_t *model, int model_size)
  */
 char *cson_encode(void *obj, cson_model_t *model, int model_size, int buffer_size, int fmt)
 {
-    cJSON *json = cson_encode_object(obj, model, model_size);
-    CSON_ASSERT(json, return NULL);
+    CSON_STATS_ENTER(model);
+    CSON_PHASE_BEGIN(BUILD);
+    cJSON *json = _cson_encode_object(obj, model, model_size);
+    CSON_PHASE_END(BUILD);
+    CSON_ASSERT(json, CSON_STATS_LEAVE(); return NULL);
+    CSON_PHASE_BEGIN(PRINT);
     char *json_str = cJSON_PrintBuffered(json, buffer_size, fmt);
+    CSON_PHASE_END(PRINT);
+    CSON_PHASE_BEGIN(DELETE);
     cJSON_Delete(json);
+    CSON_PHASE_END(DELETE);
+    CSON_STATS_LEAVE();
     return json_str;
 }
 
@@ -563,24 +1298,77 @@ char *cson_encode(void *obj, cson_model_t *model, int model_size, int buffer_siz
  */
 char *cson_encode_unformatted(void *obj, cson_model_t *model, int model_size)
 {
-    cJSON *json = cson_encode_object(obj, model, model_size);
-    CSON_ASSERT(json, return NULL);
+    CSON_STATS_ENTER(model);
+    CSON_PHASE_BEGIN(BUILD);
+    cJSON *json = _cson_encode_object(obj, model, model_size);
+    CSON_PHASE_END(BUILD);
+    CSON_ASSERT(json, CSON_STATS_LEAVE(); return NULL);
+    CSON_PHASE_BEGIN(PRINT);
     char *json_str = cJSON_PrintUnformatted(json);
+    CSON_PHASE_END(PRINT);
+    CSON_PHASE_BEGIN(DELETE);
     cJSON_Delete(json);
+    CSON_PHASE_END(DELETE);
+    CSON_STATS_LEAVE();
     return json_str;
 }
 
 /**
- * @brief 释放CSON解析出的对象
+ * @brief 释放字符串，跳过借用区域内的字符串
+ *
+ * @param str 字符串
+ * @param ctx 释放上下文
+ */
+static void _cson_free_string(void *str, cson_ctx_t *ctx)
+{
+    if (!str)
+    {
+        return;
+    }
+    if (ctx && ctx->borrow_base && (char *)str >= ctx->borrow_base && (char *)str < ctx->borrow_base + ctx->borrow_len)
+    {
+        return;
+    }
+    s_cson.free(str);
+}
+
+/**
+ * @brief 释放vector的元素及数组
+ *
+ * @param vec vector
+ * @param model 元素数据模型
+ * @param model_size 元素数据模型数量
+ * @param ctx 释放上下文
+ */
+static void _cson_free_vector(cson_vector_t *vec, cson_model_t *model, int model_size, cson_ctx_t *ctx)
+{
+    size_t ele_size = cson_model_obj_size(model, model_size);
+
+    for (size_t i = 0; i < vec->count; i++)
+    {
+        _cson_free_fields((void *)((size_t)vec->data + i * ele_size), model, model_size, ctx);
+    }
+    if (vec->data)
+    {
+        s_cson.free(vec->data);
+    }
+    vec->data = NULL;
+    vec->count = 0;
+    vec->cap = 0;
+}
+
+/**
+ * @brief 释放对象成员
  *
  * @param obj 对象
  * @param model 对象模型
  * @param model_size 对象模型数量
+ * @param ctx 释放上下文
  */
-void cson_free(void *obj, cson_model_t *model, int model_size)
+static void _cson_free_fields(void *obj, cson_model_t *model, int model_size, cson_ctx_t *ctx)
 {
     cson_list_t *list, *p;
-    size_t *tmp_node;
+    size_t ele_size;
 
     for (short i = 0; i < model_size; i++)
     {
@@ -595,7 +1383,7 @@ void cson_free(void *obj, cson_model_t *model, int model_size)
             break;
         case CSON_TYPE_STRING:
         case CSON_TYPE_JSON:
-            s_cson.free((char *)(*(size_t *)((size_t)obj + model[i].offset)));
+            _cson_free_string((char *)(*(size_t *)((size_t)obj + model[i].offset)), ctx);
             break;
         case CSON_TYPE_LIST:
             list = (cson_list_t *)*(size_t *)((size_t)obj + model[i].offset);
@@ -603,44 +1391,297 @@ void cson_free(void *obj, cson_model_t *model, int model_size)
             {
                 p = list;
                 list = list->next;
-                if (p->obj)
+                if (!cson_model_is_basic(model[i].param.sub.model))
                 {
-                    if (_cson_is_basic_list_model(model[i].param.sub.model))
-                    {
-                        tmp_node = s_cson.malloc(sizeof(size_t));
-                        *tmp_node = (size_t)(&(p->obj));
-                    }
-                    else
+                    if (p->obj)
                     {
-                        tmp_node = p->obj;
+                        _cson_free_fields(p->obj, model[i].param.sub.model, model[i].param.sub.size, ctx);
+                        s_cson.free(p->obj);
                     }
-                    cson_free(tmp_node,
-                              model[i].param.sub.model, model[i].param.sub.size);
+                }
+                else if (model[i].param.sub.model[1].type == CSON_TYPE_STRING)
+                {
+                    _cson_free_string(p->str, ctx);
                 }
                 s_cson.free(p);
             }
             break;
         case CSON_TYPE_STRUCT:
-            cson_free((void *)(*(size_t *)((size_t)obj + model[i].offset)),
-                      model[i].param.sub.model, model[i].param.sub.size);
+            if (*(size_t *)((size_t)obj + model[i].offset))
+            {
+                _cson_free_fields((void *)(*(size_t *)((size_t)obj + model[i].offset)),
+                                  model[i].param.sub.model, model[i].param.sub.size, ctx);
+                s_cson.free((void *)(*(size_t *)((size_t)obj + model[i].offset)));
+            }
             break;
         case CSON_TYPE_ARRAY:
             if (model[i].param.array.ele_type == CSON_TYPE_STRING)
             {
                 for (short j = 0; j < model[i].param.array.size; j++)
                 {
-                    if (*(size_t *)((size_t)obj + model[i].offset + (j * sizeof(size_t))))
-                    {
-                        s_cson.free((void *)*(size_t *)((size_t)obj + model[i].offset + (j * sizeof(size_t))));
-                    }
+                    _cson_free_string((void *)*(size_t *)((size_t)obj + model[i].offset + (j * sizeof(size_t))), ctx);
                 }
             }
             break;
+        case CSON_TYPE_VECTOR:
+            _cson_free_vector((cson_vector_t *)((size_t)obj + model[i].offset),
+                              model[i].param.sub.model, model[i].param.sub.size, ctx);
+            break;
+        case CSON_TYPE_EMBED:
+            _cson_free_fields((void *)((size_t)obj + model[i].offset),
+                              model[i].param.sub.model, model[i].param.sub.size, ctx);
+            break;
+        case CSON_TYPE_EMBED_ARRAY:
+            ele_size = cson_model_obj_size(model[i].param.embeds.model, model[i].param.embeds.size);
+            for (short j = 0; j < model[i].param.embeds.capacity; j++)
+            {
+                _cson_free_fields((void *)((size_t)obj + model[i].offset + j * ele_size),
+                                  model[i].param.embeds.model, model[i].param.embeds.size, ctx);
+            }
+            break;
+        case CSON_TYPE_ILIST:
+            for (void *p = *(void **)((size_t)obj + model[i].offset), *next; p; p = next)
+            {
+                next = *(void **)((size_t)p + model[i].param.ilist.next);
+                _cson_free_fields(p, model[i].param.ilist.model, model[i].param.ilist.size, ctx);
+                s_cson.free(p);
+            }
+            break;
         default:
             break;
         }
     }
+}
+
+/**
+ * @brief 释放CSON解析出的对象
+ *
+ * @param obj 对象
+ * @param model 对象模型
+ * @param model_size 对象模型数量
+ */
+void cson_free(void *obj, cson_model_t *model, int model_size)
+{
+    if (!obj)
+    {
+        return;
+    }
+    CSON_STATS_ENTER(model);
+    CSON_PHASE_BEGIN(FREE);
+    _cson_free_fields(obj, model, model_size, NULL);
     s_cson.free(obj);
+    CSON_PHASE_END(FREE);
+    CSON_STATS_LEAVE();
+}
+
+/**
+ * @brief 文件解析结果头部，位于对象之前
+ *
+ */
+typedef struct
+{
+    char *data;          /**< 文件内容，借用模式下保留 */
+    size_t len;          /**< 文件长度 */
+    unsigned char mapped; /**< 是否为内存映射 */
+} cson_file_head_t;
+
+/**
+ * @brief 加载文件
+ *
+ * @param path 文件路径
+ * @param writable 是否需要可写(写时复制)
+ * @param data 文件内容
+ * @param len 文件长度
+ * @param mapped 是否为内存映射
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_file_load(const char *path, char writable, char **data, size_t *len, unsigned char *mapped)
+{
+#if CSON_USING_MMAP
+    struct stat st;
+    void *addr;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return -1;
+    }
+    addr = mmap(NULL, (size_t)st.st_size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return -1;
+    }
+    posix_madvise(addr, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    posix_madvise(addr, (size_t)st.st_size, POSIX_MADV_WILLNEED);
+    *data = addr;
+    *len = (size_t)st.st_size;
+    *mapped = 1;
+    return 0;
+#else
+    FILE *fp = fopen(path, "rb");
+    long size;
+
+    (void)writable;
+    if (!fp)
+    {
+        return -1;
+    }
+    if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) <= 0 || fseek(fp, 0, SEEK_SET) != 0)
+    {
+        fclose(fp);
+        return -1;
+    }
+    *data = s_cson.malloc((size_t)size);
+    if (!*data || fread(*data, 1, (size_t)size, fp) != (size_t)size)
+    {
+        s_cson.free(*data);
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+    *len = (size_t)size;
+    *mapped = 0;
+    return 0;
+#endif
+}
+
+/**
+ * @brief 卸载文件
+ *
+ * @param data 文件内容
+ * @param len 文件长度
+ * @param mapped 是否为内存映射
+ */
+static void _cson_file_unload(char *data, size_t len, unsigned char mapped)
+{
+    if (!data)
+    {
+        return;
+    }
+#if CSON_USING_MMAP
+    if (mapped)
+    {
+        munmap(data, len);
+        return;
+    }
+#endif
+    (void)len;
+    (void)mapped;
+    s_cson.free(data);
+}
+
+/**
+ * @brief 解析JSON文件
+ *
+ * @param path 文件路径
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param flags 解析选项，见`CSON_FILE_BORROW`
+ * @return void* 解析得到的对象
+ */
+static void *_cson_decode_file(const char *path, cson_model_t *model, int model_size, int flags)
+{
+    char borrow = (flags & CSON_FILE_BORROW) ? 1 : 0;
+    cson_ctx_t ctx = {NULL, NULL, 0};
+    cson_file_head_t *head;
+    unsigned char mapped;
+    char *data;
+    size_t len;
+    cJSON *json;
+
+    CSON_ASSERT(path, return NULL);
+    if (_cson_file_load(path, borrow, &data, &len, &mapped) != 0)
+    {
+        return NULL;
+    }
+    CSON_PHASE_BEGIN(PARSE);
+    json = borrow ? cJSON_ParseInPlace(data, len) : cJSON_ParseWithLength(data, len);
+    CSON_PHASE_END(PARSE);
+    if (!json || (json->type & 0xFF) == cJSON_NULL)
+    {
+        cJSON_Delete(json);
+        _cson_file_unload(data, len, mapped);
+        return NULL;
+    }
+    head = s_cson.malloc(sizeof(cson_file_head_t) + cson_model_obj_size(model, model_size));
+    if (!head)
+    {
+        cJSON_Delete(json);
+        _cson_file_unload(data, len, mapped);
+        return NULL;
+    }
+    if (borrow)
+    {
+        ctx.borrow_base = data;
+        ctx.borrow_len = len;
+    }
+    CSON_PHASE_BEGIN(BIND);
+    _cson_decode_into(json, model, model_size, head + 1, &ctx);
+    CSON_PHASE_END(BIND);
+    CSON_PHASE_BEGIN(DELETE);
+    cJSON_Delete(json);
+    CSON_PHASE_END(DELETE);
+    if (!borrow)
+    {
+        _cson_file_unload(data, len, mapped);
+        data = NULL;
+    }
+    head->data = data;
+    head->len = len;
+    head->mapped = mapped;
+    return head + 1;
+}
+
+/**
+ * @brief 解析JSON文件
+ *
+ * @param path 文件路径
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param flags 解析选项，见`CSON_FILE_BORROW`
+ * @return void* 解析得到的对象
+ */
+void *cson_decode_file(const char *path, cson_model_t *model, int model_size, int flags)
+{
+    void *obj;
+    CSON_STATS_ENTER(model);
+    obj = _cson_decode_file(path, model, model_size, flags);
+    CSON_STATS_LEAVE();
+    return obj;
+}
+
+/**
+ * @brief 释放`cson_decode_file`解析出的对象
+ *
+ * @param obj 对象
+ * @param model 对象模型
+ * @param model_size 对象模型数量
+ */
+void cson_free_file(void *obj, cson_model_t *model, int model_size)
+{
+    cson_file_head_t *head;
+    cson_ctx_t ctx = {NULL, NULL, 0};
+
+    if (!obj)
+    {
+        return;
+    }
+    head = (cson_file_head_t *)obj - 1;
+    ctx.borrow_base = head->data;
+    ctx.borrow_len = head->len;
+    CSON_STATS_ENTER(model);
+    CSON_PHASE_BEGIN(FREE);
+    _cson_free_fields(obj, model, model_size, &ctx);
+    _cson_file_unload(head->data, head->len, head->mapped);
+    s_cson.free(head);
+    CSON_PHASE_END(FREE);
+    CSON_STATS_LEAVE();
 }
 
 /**
@@ -730,6 +1771,243 @@ cson_list_t *cson_list_delete(cson_list_t *list, void *obj, char free_mem)
     return head.next;
 }
 
+/**
+ * @brief 链表节点块
+ *
+ */
+struct cson_list_chunk
+{
+    struct cson_list_chunk *next;            /**< 下一个节点块 */
+    size_t used;                             /**< 已分配的节点数量 */
+    cson_list_t nodes[CSON_LIST_CHUNK_NODES]; /**< 节点 */
+};
+
+/**
+ * @brief 从链表头的节点块中分配节点，优先复用已移除的节点
+ *
+ * @param list 链表头
+ * @return cson_list_t* 节点，失败返回NULL
+ */
+static cson_list_t *_cson_list_node(cson_list_head_t *list)
+{
+    cson_list_chunk_t *chunk = list->chunks;
+    cson_list_t *node;
+
+    if (list->spare)
+    {
+        node = list->spare;
+        list->spare = node->next;
+        return node;
+    }
+    if (!chunk || chunk->used == CSON_LIST_CHUNK_NODES)
+    {
+        chunk = s_cson.malloc(sizeof(cson_list_chunk_t));
+        if (!chunk)
+        {
+            return NULL;
+        }
+        chunk->next = list->chunks;
+        chunk->used = 0;
+        list->chunks = chunk;
+    }
+    return &chunk->nodes[chunk->used++];
+}
+
+/**
+ * @brief 链表尾部追加节点
+ *
+ * @param list 链表头
+ * @param obj 节点对象
+ * @return cson_list_t* 新节点
+ */
+cson_list_t *cson_list_push(cson_list_head_t *list, void *obj)
+{
+    cson_list_t *node;
+
+    CSON_ASSERT(list, return NULL);
+    node = _cson_list_node(list);
+    CSON_ASSERT(node, return NULL);
+    memset(node, 0, sizeof(cson_list_t));
+    node->obj = obj;
+    _cson_list_link(list, node);
+    return node;
+}
+
+/**
+ * @brief 按序号获取节点
+ *
+ * @param list 链表头
+ * @param index 序号
+ * @return cson_list_t* 节点
+ */
+cson_list_t *cson_list_at(cson_list_head_t *list, size_t index)
+{
+    cson_list_t *node;
+    size_t i;
+
+    CSON_ASSERT(list, return NULL);
+    if (index >= list->count)
+    {
+        return NULL;
+    }
+    if (index == list->count - 1)
+    {
+        return list->tail;
+    }
+    if (list->cursor && list->cursor_index <= index)
+    {
+        node = list->cursor;
+        i = list->cursor_index;
+    }
+    else
+    {
+        node = list->head;
+        i = 0;
+    }
+    for (; i < index; i++)
+    {
+        node = node->next;
+    }
+    list->cursor = node;
+    list->cursor_index = index;
+    return node;
+}
+
+/**
+ * @brief 移除节点
+ *
+ * @param list 链表头
+ * @param prev 前一个节点，移除首节点时为NULL
+ * @param node 节点
+ * @return int 0成功，-1失败
+ */
+int cson_list_remove(cson_list_head_t *list, cson_list_t *prev, cson_list_t *node)
+{
+    cson_list_t **link;
+
+    CSON_ASSERT(list && node, return -1);
+    link = prev ? &prev->next : &list->head;
+    if (*link != node || !list->count)
+    {
+        return -1;
+    }
+    *link = node->next;
+    if (list->tail == node)
+    {
+        list->tail = prev;
+    }
+    list->count--;
+    list->cursor = NULL;
+    node->next = list->spare;
+    list->spare = node;
+    return 0;
+}
+
+/**
+ * @brief 释放链表头持有的节点
+ *
+ * @param list 链表头
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ */
+void cson_list_release(cson_list_head_t *list, cson_model_t *model, int model_size)
+{
+    cson_list_chunk_t *chunk, *next;
+
+    CSON_ASSERT(list, return);
+    for (cson_list_t *p = list->head; model && p; p = p->next)
+    {
+        if (!cson_model_is_basic(model))
+        {
+            cson_free(p->obj, model, model_size);
+        }
+        else if (model[1].type == CSON_TYPE_STRING)
+        {
+            _cson_free_string(p->str, NULL);
+        }
+    }
+    for (chunk = list->chunks; chunk; chunk = next)
+    {
+        next = chunk->next;
+        s_cson.free(chunk);
+    }
+    memset(list, 0, sizeof(cson_list_head_t));
+}
+
+/**
+ * @brief 预留vector容量
+ *
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ * @param cap 元素容量
+ * @return int 0成功，-1失败
+ */
+int cson_vector_reserve(cson_vector_t *vec, cson_model_t *model, int model_size, size_t cap)
+{
+    size_t ele_size;
+    void *data;
+
+    CSON_ASSERT(vec && model, return -1);
+    if (cap <= vec->cap)
+    {
+        return 0;
+    }
+    ele_size = cson_model_obj_size(model, model_size);
+    CSON_ASSERT(ele_size && cap <= (size_t)-1 / ele_size, return -1);
+    data = s_cson.malloc(cap * ele_size);
+    CSON_ASSERT(data, return -1);
+    if (vec->count)
+    {
+        memcpy(data, vec->data, vec->count * ele_size);
+    }
+    memset((void *)((size_t)data + vec->count * ele_size), 0, (cap - vec->count) * ele_size);
+    if (vec->data)
+    {
+        s_cson.free(vec->data);
+    }
+    vec->data = data;
+    vec->cap = cap;
+    return 0;
+}
+
+/**
+ * @brief vector尾部追加一个置零的元素，容量不足时按倍数扩容
+ *
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ * @return void* 新元素，失败返回NULL
+ */
+void *cson_vector_push(cson_vector_t *vec, cson_model_t *model, int model_size)
+{
+    size_t ele_size;
+    void *ele;
+
+    CSON_ASSERT(vec && model, return NULL);
+    if (vec->count == vec->cap && cson_vector_reserve(vec, model, model_size, vec->cap ? vec->cap * 2 : 4) != 0)
+    {
+        return NULL;
+    }
+    ele_size = cson_model_obj_size(model, model_size);
+    ele = (void *)((size_t)vec->data + vec->count++ * ele_size);
+    memset(ele, 0, ele_size);
+    return ele;
+}
+
+/**
+ * @brief 释放vector的元素及数组，并置为空
+ *
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ */
+void cson_vector_free(cson_vector_t *vec, cson_model_t *model, int model_size)
+{
+    CSON_ASSERT(vec && model, return);
+    _cson_free_vector(vec, model, model_size, NULL);
+}
+
 /**
  * @brief CSON新字符串
  *
@@ -745,3 +2023,874 @@ char *cson_new_string(const char *src)
     strcpy(dest, src);
     return dest;
 }
+
+/**
+ * @brief 按定长字符数组模型写入字符串
+ *
+ * @param dest 字符数组
+ * @param field 定长字符数组数据模型
+ * @param src 源字符串
+ * @param len 源字符串长度
+ * @return int 0完整写入，1已截断，-1超长被拒绝
+ */
+int cson_chars_assign(char *dest, const cson_model_t *field, const char *src, size_t len)
+{
+    size_t cap;
+    int ret = 0;
+
+    if (field->param.chars.size <= 0)
+    {
+        return -1;
+    }
+    cap = (size_t)field->param.chars.size - 1;
+    if (len > cap)
+    {
+        if (field->param.chars.policy == CSON_CHARS_REJECT)
+        {
+            dest[0] = 0;
+            return -1;
+        }
+        len = cap;
+        while (len > 0 && ((unsigned char)src[len] & 0xC0) == 0x80)
+        {
+            len--;
+        }
+        ret = 1;
+    }
+    if (len)
+    {
+        memcpy(dest, src, len);
+    }
+    dest[len] = 0;
+    return ret;
+}
+
+/**
+ * @brief 内嵌结构体数组的有效元素数量
+ *
+ * @param obj 所属对象
+ * @param field 内嵌结构体数组数据模型
+ * @return int 元素数量
+ */
+int cson_embeds_count(const void *obj, const cson_model_t *field)
+{
+    int count;
+
+    if (field->param.embeds.count < 0)
+    {
+        return field->param.embeds.capacity;
+    }
+    count = *(const int *)((size_t)obj + field->param.embeds.count);
+    return count < 0 ? 0 : (count > field->param.embeds.capacity ? field->param.embeds.capacity : count);
+}
+
+/**
+ * @brief 记录内嵌结构体数组的元素数量
+ *
+ * @param obj 所属对象
+ * @param field 内嵌结构体数组数据模型
+ * @param count 元素数量
+ */
+void cson_embeds_set_count(void *obj, const cson_model_t *field, int count)
+{
+    if (field->param.embeds.count >= 0)
+    {
+        *(int *)((size_t)obj + field->param.embeds.count) = count;
+    }
+}
+
+/**
+ * @brief 使用CSON内存分配函数分配内存
+ *
+ * @param size 分配大小
+ * @return void* 分配得到的内存
+ */
+void *cson_mem_alloc(size_t size)
+{
+    return s_cson.malloc(size);
+}
+
+/**
+ * @brief 使用CSON内存释放函数释放内存
+ *
+ * @param ptr 内存
+ */
+void cson_mem_free(void *ptr)
+{
+    if (ptr)
+    {
+        s_cson.free(ptr);
+    }
+}
+
+/**
+ * @brief 判断数据模型是否为基础类型链表模型
+ *
+ * @param model 数据模型
+ * @return char 是否为基础类型链表模型
+ */
+char cson_model_is_basic(const cson_model_t *model)
+{
+    return (model >= &g_cson_basic_list_model[0] && model <= &g_cson_basic_list_model[13]) ? 1 : 0;
+}
+
+/**
+ * @brief 基础类型数据大小
+ *
+ * @param type 数据类型
+ * @return size_t 类型大小，字符串和JSON为指针大小，非基础类型为0
+ */
+size_t cson_model_type_size(cson_type_t type)
+{
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+    case CSON_TYPE_BOOL:
+        return sizeof(char);
+    case CSON_TYPE_SHORT:
+        return sizeof(short);
+    case CSON_TYPE_INT:
+        return sizeof(int);
+    case CSON_TYPE_LONG:
+        return sizeof(long);
+    case CSON_TYPE_FLOAT:
+        return sizeof(float);
+    case CSON_TYPE_DOUBLE:
+        return sizeof(double);
+    case CSON_TYPE_STRING:
+    case CSON_TYPE_JSON:
+        return sizeof(char *);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief 获取模型对象大小
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return size_t 对象大小
+ */
+size_t cson_model_obj_size(const cson_model_t *model, int model_size)
+{
+    size_t obj_size = 0;
+    for (int i = 0; i < model_size; i++)
+    {
+        if (model[i].type == CSON_TYPE_OBJ)
+        {
+            obj_size = model[i].param.obj_size;
+        }
+    }
+    return obj_size;
+}
+
+/**
+ * @brief 按数据模型分配对象并清零
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 对象，分配失败返回NULL
+ */
+void *cson_model_new_obj(const cson_model_t *model, int model_size)
+{
+    size_t obj_size = cson_model_obj_size(model, model_size);
+    void *obj = s_cson.malloc(obj_size);
+
+    if (obj)
+    {
+        memset(obj, 0, obj_size);
+    }
+    return obj;
+}
+
+/**
+ * @brief 浮点数转整型，超出范围时取边界值，NaN取0
+ *
+ * @param num 浮点数
+ * @return long long 整型数
+ */
+long long cson_number_integer(double num)
+{
+    if (num >= (double)LLONG_MAX)
+    {
+        return LLONG_MAX;
+    }
+    if (num <= (double)LLONG_MIN)
+    {
+        return LLONG_MIN;
+    }
+    return num == num ? (long long)num : 0;
+}
+
+/**
+ * @brief 按数据类型写入数值
+ *
+ * CHAR/SHORT/INT与cJSON的valueint一致，先限制在int范围内再截断；LONG限制在long范围内；
+ * FLOAT/DOUBLE取浮点值；其余类型不写入
+ *
+ * @param type 数据类型
+ * @param addr 写入地址
+ * @param integer 整型值
+ * @param real 浮点值
+ */
+void cson_model_store_number(cson_type_t type, void *addr, long long integer, double real)
+{
+    long long clamped = integer > INT_MAX ? INT_MAX : (integer < INT_MIN ? INT_MIN : integer);
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+        *(char *)addr = (char)clamped;
+        break;
+    case CSON_TYPE_SHORT:
+        *(short *)addr = (short)clamped;
+        break;
+    case CSON_TYPE_INT:
+        *(int *)addr = (int)clamped;
+        break;
+    case CSON_TYPE_LONG:
+        *(long *)addr = integer > LONG_MAX ? LONG_MAX : (integer < LONG_MIN ? LONG_MIN : (long)integer);
+        break;
+    case CSON_TYPE_FLOAT:
+        *(float *)addr = (float)real;
+        break;
+    case CSON_TYPE_DOUBLE:
+        *(double *)addr = real;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 对象池块头，记录块所属分级
+ *
+ */
+typedef union cson_pool_head
+{
+    struct cson_pool_class *cls;
+    double align;
+} cson_pool_head_t;
+
+/**
+ * @brief 对象池chunk头
+ *
+ */
+typedef union cson_pool_chunk
+{
+    union cson_pool_chunk *next;
+    double align;
+} cson_pool_chunk_t;
+
+/**
+ * @brief 对象池空闲块
+ *
+ */
+typedef struct cson_pool_free
+{
+    struct cson_pool_free *next;
+} cson_pool_free_t;
+
+/**
+ * @brief 对象池分级，每个数据模型一个，链表节点单独一个
+ *
+ */
+typedef struct cson_pool_class
+{
+    struct cson_pool_class *next; /**< 下一个分级 */
+    cson_model_t *model;          /**< 数据模型，NULL表示链表节点 */
+    int model_size;               /**< 数据模型数量 */
+    int block_size;               /**< 块大小(含块头) */
+    int capacity;                 /**< 已分配的块数量 */
+    cson_pool_free_t *free;       /**< 空闲块 */
+#if CSON_POOL_THREAD_SAFE
+    _Atomic(cson_pool_free_t *) returned; /**< 归还的块 */
+#else
+    cson_pool_free_t *returned; /**< 归还的块 */
+#endif
+    cson_pool_chunk_t *chunks; /**< chunk链表 */
+} cson_pool_class_t;
+
+/**
+ * @brief 对象池
+ *
+ */
+struct cson_pool
+{
+    cson_pool_class_t *classes; /**< 分级链表，首个为顶层模型 */
+};
+
+/**
+ * @brief 查找模型对应的对象池分级
+ *
+ * @param pool 对象池
+ * @param model 数据模型，NULL表示链表节点
+ * @return cson_pool_class_t* 分级
+ */
+static cson_pool_class_t *_cson_pool_class(cson_pool_t *pool, cson_model_t *model)
+{
+    cson_pool_class_t *cls = pool->classes;
+    while (cls && cls->model != model)
+    {
+        cls = cls->next;
+    }
+    return cls;
+}
+
+static signed char _cson_pool_collect(cson_pool_t *pool, cson_model_t *model, int model_size);
+
+/**
+ * @brief 为模型成员中单独分配的子对象创建对象池分级
+ *
+ * 结构体、链表元素、vector元素及侵入式链表元素各自分配，需要分级；内嵌结构体及内嵌结构体数组
+ * 存放在所属对象内，只查找其成员
+ *
+ * @param pool 对象池
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_pool_collect_fields(cson_pool_t *pool, cson_model_t *model, int model_size)
+{
+    for (short i = 0; i < model_size; i++)
+    {
+        if (model[i].type == CSON_TYPE_LIST)
+        {
+            if (_cson_pool_collect(pool, NULL, 0) != 0)
+            {
+                return -1;
+            }
+        }
+        if ((model[i].type == CSON_TYPE_LIST || model[i].type == CSON_TYPE_STRUCT || model[i].type == CSON_TYPE_VECTOR)
+            && !cson_model_is_basic(model[i].param.sub.model))
+        {
+            if (_cson_pool_collect(pool, model[i].param.sub.model, model[i].param.sub.size) != 0)
+            {
+                return -1;
+            }
+        }
+        if (model[i].type == CSON_TYPE_ILIST
+            && _cson_pool_collect(pool, model[i].param.ilist.model, model[i].param.ilist.size) != 0)
+        {
+            return -1;
+        }
+        if (model[i].type == CSON_TYPE_EMBED
+            && _cson_pool_collect_fields(pool, model[i].param.sub.model, model[i].param.sub.size) != 0)
+        {
+            return -1;
+        }
+        if (model[i].type == CSON_TYPE_EMBED_ARRAY
+            && _cson_pool_collect_fields(pool, model[i].param.embeds.model, model[i].param.embeds.size) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 为模型及其子模型创建对象池分级
+ *
+ * @param pool 对象池
+ * @param model 数据模型，NULL表示链表节点
+ * @param model_size 数据模型数量
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_pool_collect(cson_pool_t *pool, cson_model_t *model, int model_size)
+{
+    cson_pool_class_t *cls, **tail;
+    size_t obj_size;
+
+    if (_cson_pool_class(pool, model))
+    {
+        return 0;
+    }
+    cls = s_cson.malloc(sizeof(cson_pool_class_t));
+    CSON_ASSERT(cls, return -1);
+    memset(cls, 0, sizeof(cson_pool_class_t));
+    cls->model = model;
+    cls->model_size = model_size;
+    obj_size = model ? cson_model_obj_size(model, model_size) : sizeof(cson_list_t);
+    if (obj_size < sizeof(cson_pool_free_t))
+    {
+        obj_size = sizeof(cson_pool_free_t);
+    }
+    cls->block_size = (sizeof(cson_pool_head_t) + obj_size + sizeof(cson_pool_head_t) - 1) & ~(sizeof(cson_pool_head_t) - 1);
+    for (tail = &pool->classes; *tail; tail = &(*tail)->next)
+        ;
+    *tail = cls;
+    return model ? _cson_pool_collect_fields(pool, model, model_size) : 0;
+}
+
+/**
+ * @brief 对象池分级扩容一个chunk
+ *
+ * @param cls 分级
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_pool_grow(cson_pool_class_t *cls)
+{
+    cson_pool_chunk_t *chunk = s_cson.malloc(sizeof(cson_pool_chunk_t) + cls->block_size * CSON_POOL_CHUNK_BLOCKS);
+    cson_pool_head_t *head;
+    cson_pool_free_t *block;
+
+    CSON_ASSERT(chunk, return -1);
+    chunk->next = cls->chunks;
+    cls->chunks = chunk;
+    for (short i = CSON_POOL_CHUNK_BLOCKS - 1; i >= 0; i--)
+    {
+        head = (cson_pool_head_t *)((size_t)(chunk + 1) + i * cls->block_size);
+        head->cls = cls;
+        block = (cson_pool_free_t *)(head + 1);
+        block->next = cls->free;
+        cls->free = block;
+    }
+    cls->capacity += CSON_POOL_CHUNK_BLOCKS;
+    return 0;
+}
+
+/**
+ * @brief 从对象池分配对象
+ *
+ * @param pool 对象池
+ * @param model 数据模型，NULL表示链表节点
+ * @param model_size 数据模型数量
+ * @return void* 对象
+ */
+static void *_cson_pool_alloc(cson_pool_t *pool, cson_model_t *model, int model_size)
+{
+    cson_pool_class_t *cls = _cson_pool_class(pool, model);
+    cson_pool_free_t *block;
+
+    (void)model_size;
+    CSON_ASSERT(cls, return NULL);
+    if (!cls->free)
+    {
+#if CSON_POOL_THREAD_SAFE
+        cls->free = atomic_exchange_explicit(&cls->returned, NULL, memory_order_acquire);
+#else
+        cls->free = cls->returned;
+        cls->returned = NULL;
+#endif
+        if (!cls->free && _cson_pool_grow(cls) != 0)
+        {
+            return NULL;
+        }
+    }
+    block = cls->free;
+    cls->free = block->next;
+    return block;
+}
+
+/**
+ * @brief 将对象归还到所属对象池分级
+ *
+ * @param obj 对象
+ */
+static void _cson_pool_put(void *obj)
+{
+    cson_pool_class_t *cls = ((cson_pool_head_t *)obj - 1)->cls;
+    cson_pool_free_t *block = obj;
+
+#if CSON_POOL_THREAD_SAFE
+    cson_pool_free_t *head = atomic_load_explicit(&cls->returned, memory_order_relaxed);
+    do
+    {
+        block->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&cls->returned, &head, block,
+                                                    memory_order_release, memory_order_relaxed));
+#else
+    block->next = cls->returned;
+    cls->returned = block;
+#endif
+}
+
+static void _cson_pool_release_object(void *obj, cson_model_t *model, int model_size);
+
+/**
+ * @brief 将对象成员归还到对象池，对象本身保留
+ *
+ * @param obj 对象
+ * @param model 对象模型
+ * @param model_size 对象模型数量
+ */
+static void _cson_pool_release_fields(void *obj, cson_model_t *model, int model_size)
+{
+    cson_list_t *list, *p;
+    cson_model_t *sub;
+    cson_vector_t *vec;
+    size_t ele_size;
+
+    for (short i = 0; i < model_size; i++)
+    {
+        switch ((int)model[i].type)
+        {
+        case CSON_TYPE_STRING:
+        case CSON_TYPE_JSON:
+            s_cson.free((char *)(*(size_t *)((size_t)obj + model[i].offset)));
+            break;
+        case CSON_TYPE_LIST:
+            sub = model[i].param.sub.model;
+            list = (cson_list_t *)*(size_t *)((size_t)obj + model[i].offset);
+            while (list)
+            {
+                p = list;
+                list = list->next;
+                if (p->str && sub == CSON_MODEL_STRING_LIST)
+                {
+                    s_cson.free(p->str);
+                }
+                else if (p->obj && !cson_model_is_basic(sub))
+                {
+                    _cson_pool_release_object(p->obj, sub, model[i].param.sub.size);
+                }
+                _cson_pool_put(p);
+            }
+            break;
+        case CSON_TYPE_STRUCT:
+            if (*(size_t *)((size_t)obj + model[i].offset))
+            {
+                _cson_pool_release_object((void *)(*(size_t *)((size_t)obj + model[i].offset)),
+                                          model[i].param.sub.model, model[i].param.sub.size);
+            }
+            break;
+        case CSON_TYPE_ARRAY:
+            if (model[i].param.array.ele_type == CSON_TYPE_STRING)
+            {
+                for (short j = 0; j < model[i].param.array.size; j++)
+                {
+                    s_cson.free((void *)*(size_t *)((size_t)obj + model[i].offset + (j * sizeof(size_t))));
+                }
+            }
+            break;
+        case CSON_TYPE_VECTOR:
+            vec = (cson_vector_t *)((size_t)obj + model[i].offset);
+            ele_size = cson_model_obj_size(model[i].param.sub.model, model[i].param.sub.size);
+            for (size_t j = 0; j < vec->count; j++)
+            {
+                _cson_pool_release_fields((void *)((size_t)vec->data + j * ele_size),
+                                          model[i].param.sub.model, model[i].param.sub.size);
+            }
+            if (vec->data)
+            {
+                s_cson.free(vec->data);
+            }
+            break;
+        case CSON_TYPE_EMBED:
+            _cson_pool_release_fields((void *)((size_t)obj + model[i].offset),
+                                      model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_ILIST:
+            for (void *p = *(void **)((size_t)obj + model[i].offset), *next; p; p = next)
+            {
+                next = *(void **)((size_t)p + model[i].param.ilist.next);
+                _cson_pool_release_object(p, model[i].param.ilist.model, model[i].param.ilist.size);
+            }
+            break;
+        case CSON_TYPE_EMBED_ARRAY:
+            ele_size = cson_model_obj_size(model[i].param.embeds.model, model[i].param.embeds.size);
+            for (short j = 0; j < model[i].param.embeds.capacity; j++)
+            {
+                _cson_pool_release_fields((void *)((size_t)obj + model[i].offset + j * ele_size),
+                                          model[i].param.embeds.model, model[i].param.embeds.size);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 将对象及其成员归还到对象池
+ *
+ * @param obj 对象
+ * @param model 对象模型
+ * @param model_size 对象模型数量
+ */
+static void _cson_pool_release_object(void *obj, cson_model_t *model, int model_size)
+{
+    _cson_pool_release_fields(obj, model, model_size);
+    _cson_pool_put(obj);
+}
+
+/**
+ * @brief 创建对象池
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return cson_pool_t* 对象池
+ */
+cson_pool_t *cson_pool_create(cson_model_t *model, int model_size)
+{
+    cson_pool_t *pool = s_cson.malloc(sizeof(cson_pool_t));
+    CSON_ASSERT(pool, return NULL);
+    pool->classes = NULL;
+    if (_cson_pool_collect(pool, model, model_size) != 0)
+    {
+        cson_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * @brief 对象池预热
+ *
+ * @param pool 对象池
+ * @param count 每个分级预分配的块数量
+ * @return int 0成功，-1失败
+ */
+int cson_pool_prewarm(cson_pool_t *pool, int count)
+{
+    CSON_ASSERT(pool, return -1);
+    for (cson_pool_class_t *cls = pool->classes; cls; cls = cls->next)
+    {
+        while (cls->capacity < count)
+        {
+            if (_cson_pool_grow(cls) != 0)
+            {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 使用对象池解析JSON对象
+ *
+ * @param pool 对象池
+ * @param json JSON对象
+ * @return void* 解析得到的对象
+ */
+void *cson_pool_decode_object(cson_pool_t *pool, cJSON *json)
+{
+    cson_ctx_t ctx = {pool, NULL, 0};
+    void *obj;
+
+    CSON_ASSERT(pool, return NULL);
+    CSON_STATS_ENTER(pool->classes->model);
+    CSON_PHASE_BEGIN(BIND);
+    obj = _cson_decode_object(json, pool->classes->model, pool->classes->model_size, &ctx);
+    CSON_PHASE_END(BIND);
+    CSON_STATS_LEAVE();
+    return obj;
+}
+
+/**
+ * @brief 使用对象池解析JSON字符串
+ *
+ * @param pool 对象池
+ * @param json_str json字符串
+ * @return void* 解析得到的对象
+ */
+void *cson_pool_decode(cson_pool_t *pool, const char *json_str)
+{
+    void *obj;
+    cJSON *json;
+    cJSON_Arena *arena;
+
+    CSON_ASSERT(pool, return NULL);
+    CSON_STATS_ENTER(pool->classes->model);
+    CSON_PHASE_BEGIN(PARSE);
+    json = _cson_parse_transient(json_str, &arena);
+    CSON_PHASE_END(PARSE);
+    CSON_ASSERT(json, CSON_STATS_LEAVE(); return NULL);
+    obj = cson_pool_decode_object(pool, json);
+    CSON_PHASE_BEGIN(DELETE);
+    _cson_release_transient(json, arena);
+    CSON_PHASE_END(DELETE);
+    CSON_STATS_LEAVE();
+    return obj;
+}
+
+/**
+ * @brief 将对象池解析出的对象归还到对象池
+ *
+ * @param obj 对象
+ */
+void cson_pool_release(void *obj)
+{
+    cson_pool_class_t *cls;
+
+    if (!obj)
+    {
+        return;
+    }
+    cls = ((cson_pool_head_t *)obj - 1)->cls;
+    CSON_STATS_ENTER(cls->model);
+    CSON_PHASE_BEGIN(FREE);
+    _cson_pool_release_object(obj, cls->model, cls->model_size);
+    CSON_PHASE_END(FREE);
+    CSON_STATS_LEAVE();
+}
+
+/**
+ * @brief 销毁对象池
+ *
+ * @param pool 对象池
+ */
+void cson_pool_destroy(cson_pool_t *pool)
+{
+    cson_pool_class_t *cls;
+    cson_pool_chunk_t *chunk;
+
+    CSON_ASSERT(pool, return);
+    while ((cls = pool->classes) != NULL)
+    {
+        pool->classes = cls->next;
+        while ((chunk = cls->chunks) != NULL)
+        {
+            cls->chunks = chunk->next;
+            s_cson.free(chunk);
+        }
+        s_cson.free(cls);
+    }
+    s_cson.free(pool);
+}
+
+/**
+ * @brief 获取内存统计
+ *
+ * @param stats 内存统计
+ * @param scope 统计范围
+ * @return int 0成功，-1未启用统计
+ */
+int cson_stats_get(cson_stats_t *stats, cson_stats_scope_t scope)
+{
+    CSON_ASSERT(stats, return -1);
+    memset(stats, 0, sizeof(cson_stats_t));
+#if CSON_STATS_ENABLE
+    if (scope == CSON_STATS_THREAD)
+    {
+        cson_stats_thread_t *local = _cson_stats_local();
+        if (local)
+        {
+            _cson_stats_read(&local->counter, stats);
+        }
+    }
+    else
+    {
+        CSON_THREAD_FOREACH(thread, &s_cson_stats.threads)
+        {
+            _cson_stats_read(&((cson_stats_thread_t *)thread)->counter, stats);
+        }
+    }
+    return 0;
+#else
+    (void)scope;
+    return -1;
+#endif
+}
+
+/**
+ * @brief 清零内存统计
+ *
+ * @param scope 统计范围
+ */
+void cson_stats_reset(cson_stats_scope_t scope)
+{
+#if CSON_STATS_ENABLE
+    if (scope == CSON_STATS_GLOBAL)
+    {
+        cson_thread_reset(&s_cson_stats.threads);
+        for (int i = 0; i < CSON_STATS_MODEL_MAX; i++)
+        {
+            _cson_stats_clear(&s_cson_stats.models[i].counter);
+        }
+    }
+    else if (s_cson_stats_thread)
+    {
+        _cson_stats_clear_thread(s_cson_stats_thread);
+    }
+    _cson_stats_local();
+#else
+    (void)scope;
+#endif
+}
+
+/**
+ * @brief 单独统计数据模型
+ *
+ * @param model 数据模型
+ * @return int 0成功，-1未启用统计或超过`CSON_STATS_MODEL_MAX`
+ */
+int cson_stats_track(cson_model_t *model)
+{
+    CSON_ASSERT(model, return -1);
+#if CSON_STATS_ENABLE
+    for (int i = 0; i < CSON_STATS_MODEL_MAX; i++)
+    {
+        cson_model_t *tracked = NULL;
+        if (atomic_compare_exchange_strong_explicit(&s_cson_stats.models[i].model, &tracked, model,
+                                                    memory_order_release, memory_order_acquire) ||
+            tracked == model)
+        {
+            return 0;
+        }
+    }
+#endif
+    return -1;
+}
+
+/**
+ * @brief 获取数据模型的内存统计
+ *
+ * @param model 数据模型
+ * @param stats 内存统计
+ * @return int 0成功，-1模型未注册
+ */
+int cson_stats_model_get(cson_model_t *model, cson_stats_t *stats)
+{
+    CSON_ASSERT(stats, return -1);
+    memset(stats, 0, sizeof(cson_stats_t));
+#if CSON_STATS_ENABLE
+    cson_stats_model_t *tracked = _cson_stats_find(model);
+    if (tracked)
+    {
+        _cson_stats_read(&tracked->counter, stats);
+        return 0;
+    }
+#else
+    (void)model;
+#endif
+    return -1;
+}
+
+/**
+ * @brief 进入数据模型统计范围，已处于统计范围内时不改变
+ *
+ * @param model 数据模型
+ * @return void* 外层统计范围
+ */
+void *cson_stats_enter(cson_model_t *model)
+{
+#if CSON_STATS_ENABLE
+    cson_stats_model_t *outer = s_cson_stats_scope;
+    if (!outer)
+    {
+        cson_stats_model_t *tracked = _cson_stats_find(model);
+        s_cson_stats_scope = tracked ? tracked : &s_cson_stats_untracked;
+    }
+    return outer;
+#else
+    (void)model;
+    return NULL;
+#endif
+}
+
+/**
+ * @brief 离开数据模型统计范围
+ *
+ * @param scope 外层统计范围
+ */
+void cson_stats_leave(void *scope)
+{
+#if CSON_STATS_ENABLE
+    s_cson_stats_scope = scope;
+#else
+    (void)scope;
+#endif
+}
@@ -16,6 +16,11 @@
 #include "stddef.h"
 #include "cJSON.h"
 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
 /**
  * @defgroup CSON cson
  * @brief json tools for C
@@ -23,6 +28,68 @@
  * @{
  */
 
+/**
+ * @brief 对象池是否线程安全
+ *
+ * 为1时对象可在任意线程归还，归还通过无锁队列完成；解析仍需在创建对象池的线程中进行
+ */
+#ifndef CSON_POOL_THREAD_SAFE
+#define CSON_POOL_THREAD_SAFE 1
+#endif
+
+/**
+ * @brief 对象池每次扩容分配的块数量
+ *
+ */
+#ifndef CSON_POOL_CHUNK_BLOCKS
+#define CSON_POOL_CHUNK_BLOCKS 32
+#endif
+
+/**
+ * @brief 是否使用内存映射加载文件
+ *
+ */
+#ifndef CSON_USING_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define CSON_USING_MMAP 1
+#else
+#define CSON_USING_MMAP 0
+#endif
+#endif
+
+/**
+ * @brief 是否启用内存统计
+ *
+ * 为1时`cson_init`在分配函数外包装一层计数，每次分配额外占用一个对齐头部记录大小；
+ * 统计依赖C11原子操作
+ */
+#ifndef CSON_STATS_ENABLE
+#define CSON_STATS_ENABLE 0
+#endif
+
+/**
+ * @brief 可单独统计的数据模型数量上限
+ *
+ */
+#ifndef CSON_STATS_MODEL_MAX
+#define CSON_STATS_MODEL_MAX 16
+#endif
+
+/**
+ * @brief 链表头每次扩容分配的节点数量
+ *
+ */
+#ifndef CSON_LIST_CHUNK_NODES
+#define CSON_LIST_CHUNK_NODES 32
+#endif
+
+/**
+ * @brief 文件解析选项: 字符串直接引用文件映射，不再复制
+ *
+ * 不含转义字符的字符串指向文件映射(写时复制)，对象释放前映射保持有效
+ */
+#define CSON_FILE_BORROW 0x01
+
 /**
  * @brief CSON数据类型定义
  *
@@ -42,8 +109,23 @@ typedef enum
         CSON_TYPE_LIST,
         CSON_TYPE_ARRAY,
         CSON_TYPE_JSON,
+        CSON_TYPE_CHAR_ARRAY,
+        CSON_TYPE_VECTOR,
+        CSON_TYPE_EMBED,
+        CSON_TYPE_EMBED_ARRAY,
+        CSON_TYPE_ILIST,
 } cson_type_t;
 
+/**
+ * @brief 定长字符数组超长处理策略
+ *
+ */
+typedef enum
+{
+        CSON_CHARS_TRUNCATE = 0, /**< 截断到容量以内，不拆分UTF-8字符 */
+        CSON_CHARS_REJECT,       /**< 视为类型不匹配，写入空字符串 */
+} cson_chars_policy_t;
+
 /**
  * @brief CSON数据模型定义
  *
@@ -65,6 +147,24 @@ typedef struct cson_model
                         cson_type_t ele_type; /**< 数组元素类型 */
                         short size;           /**< 数组大小 */
                 } array;                      /**< 数组 */
+                struct
+                {
+                        short size;                 /**< 数组容量，含结束符 */
+                        cson_chars_policy_t policy; /**< 超长处理策略 */
+                } chars;                            /**< 定长字符数组 */
+                struct
+                {
+                        struct cson_model *model; /**< 元素模型 */
+                        short size;               /**< 元素模型数量 */
+                        short capacity;           /**< 数组大小 */
+                        short count;              /**< 元素数量成员(int)的偏移，-1表示没有 */
+                } embeds;                         /**< 内嵌结构体数组 */
+                struct
+                {
+                        struct cson_model *model; /**< 元素模型 */
+                        short size;               /**< 元素模型数量 */
+                        short next;               /**< 元素中指向下一个元素的成员偏移 */
+                } ilist;                          /**< 侵入式链表 */
                 int obj_size;                 /**< 对象大小 */
                 cson_type_t basic_list_type;  /**< 基础数据链表类型 */
         } param;
@@ -73,14 +173,105 @@ typedef struct cson_model
 /**
  * @brief Cson链表
  *
+ * 基础类型链表(`CSON_MODEL_XXX_LIST`)的元素值直接存放在节点中，按元素类型读取对应成员，
+ * 例如int型链表读取`p->i`，string型链表读取`p->str`
  */
 typedef struct cson_list
 {
         struct cson_list *next; /**< 下一个元素 */
-        void *obj;              /**< 对象 */
+        union
+        {
+                void *obj;      /**< 对象 */
+                char c;         /**< char型元素 */
+                short s;        /**< short型元素 */
+                int i;          /**< int型元素 */
+                long l;         /**< long型元素 */
+                float f;        /**< float型元素 */
+                double d;       /**< double型元素 */
+                char *str;      /**< string型元素 */
+        };
 } cson_list_t;
 
-extern cson_model_t g_cson_basic_list_model[]; /**< 基础类型链表数据模型 */
+/**
+ * @brief 链表节点块
+ *
+ */
+typedef struct cson_list_chunk cson_list_chunk_t;
+
+/**
+ * @brief Cson链表头，记录首尾节点及节点数量
+ *
+ * 节点从链表头持有的节点块中分配，随`cson_list_release`一并释放；`head`为普通的节点链，
+ * 可直接赋给`CSON_MODEL_LIST`成员用于编码，但不能再交给`cson_free`释放
+ */
+typedef struct
+{
+        cson_list_t *head;         /**< 首节点 */
+        cson_list_t *tail;         /**< 尾节点 */
+        size_t count;              /**< 节点数量 */
+        cson_list_t *cursor;       /**< 最近一次按序号访问的节点 */
+        size_t cursor_index;       /**< cursor的序号 */
+        cson_list_chunk_t *chunks; /**< 节点块 */
+        cson_list_t *spare;        /**< 已移除待复用的节点 */
+} cson_list_head_t;
+
+/**
+ * @brief 链表头初始值
+ *
+ */
+#define CSON_LIST_HEAD_INIT {NULL, NULL, 0, NULL, 0, NULL, NULL}
+
+/**
+ * @brief 遍历链表
+ *
+ * @param node 节点变量
+ * @param list 链表头
+ */
+#define CSON_LIST_FOREACH(node, list) \
+        for (cson_list_t *node = (list)->head; node; node = node->next)
+
+/**
+ * @brief Cson连续数组，元素按模型大小依次存放
+ *
+ */
+typedef struct
+{
+        void *data;   /**< 元素数组 */
+        size_t count; /**< 元素数量 */
+        size_t cap;   /**< 已分配的元素容量 */
+} cson_vector_t;
+
+/**
+ * @brief CSON对象池
+ *
+ */
+typedef struct cson_pool cson_pool_t;
+
+/**
+ * @brief 内存统计
+ *
+ */
+typedef struct
+{
+        size_t alloc_count;   /**< 分配次数 */
+        size_t free_count;    /**< 释放次数 */
+        size_t alloc_bytes;   /**< 分配字节数 */
+        size_t free_bytes;    /**< 释放字节数 */
+        ptrdiff_t live_bytes; /**< 当前占用字节数，释放统计开始前分配的内存时可能为负 */
+        size_t peak_bytes;    /**< 占用峰值 */
+} cson_stats_t;
+
+/**
+ * @brief 内存统计范围
+ *
+ */
+typedef enum
+{
+        CSON_STATS_THREAD = 0, /**< 当前线程 */
+        CSON_STATS_GLOBAL,     /**< 全部线程 */
+} cson_stats_scope_t;
+
+extern cson_model_t g_cson_basic_list_model[14]; /**< 基础类型链表数据模型 */
 
 #define CSON_MODEL_CHAR_LIST &g_cson_basic_list_model[0]    /**< char型链表数据模型 */
 #define CSON_MODEL_SHORT_LIST &g_cson_basic_list_model[2]   /**< short型链表数据模型 */
@@ -183,6 +374,45 @@ extern cson_model_t g_cson_basic_list_model[]; /**< 基础类型链表数据模
 #define CSON_MODEL_STRUCT(type, key, submodel, subsize) \
         {CSON_TYPE_STRUCT, #key, offsetof(type, key), .param.sub.model = submodel, .param.sub.size = subsize}
 
+/**
+ * @brief 内嵌结构体型数据模型，成员为结构体本身而非指针
+ *
+ * 子对象直接解析到父对象的成员中，不单独分配内存；编码时总是输出该键值
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @param submodel 子结构体模型，需为数组以计算模型数量
+ */
+#define CSON_MODEL_EMBED(type, key, submodel) \
+        {CSON_TYPE_EMBED, #key, offsetof(type, key), .param.sub.model = submodel, .param.sub.size = sizeof(submodel) / sizeof(cson_model_t)}
+
+/**
+ * @brief 内嵌结构体数组型数据模型，成员为定长结构体数组
+ *
+ * 元素直接解析到数组中，超出数组大小的元素被忽略；编码时输出整个数组
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @param submodel 元素模型，需为数组以计算模型数量
+ * @param arraySize 数组大小
+ */
+#define CSON_MODEL_EMBED_ARRAY(type, key, submodel, arraySize) \
+        {CSON_TYPE_EMBED_ARRAY, #key, offsetof(type, key), .param.embeds.model = submodel, .param.embeds.size = sizeof(submodel) / sizeof(cson_model_t), .param.embeds.capacity = arraySize, .param.embeds.count = -1}
+
+/**
+ * @brief 带元素数量的内嵌结构体数组型数据模型
+ *
+ * 解析时将写入的元素数量保存到int型成员countKey中；编码时只输出前countKey个元素
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @param submodel 元素模型，需为数组以计算模型数量
+ * @param arraySize 数组大小
+ * @param countKey 元素数量成员，不参与解析及编码
+ */
+#define CSON_MODEL_EMBED_ARRAY_COUNT(type, key, submodel, arraySize, countKey) \
+        {CSON_TYPE_EMBED_ARRAY, #key, offsetof(type, key), .param.embeds.model = submodel, .param.embeds.size = sizeof(submodel) / sizeof(cson_model_t), .param.embeds.capacity = arraySize, .param.embeds.count = offsetof(type, countKey)}
+
 /**
  * @brief list型数据模型
  *
@@ -194,6 +424,35 @@ extern cson_model_t g_cson_basic_list_model[]; /**< 基础类型链表数据模
 #define CSON_MODEL_LIST(type, key, submodel, subsize) \
         {CSON_TYPE_LIST, #key, offsetof(type, key), .param.sub.model = submodel, .param.sub.size = subsize}
 
+/**
+ * @brief 侵入式链表型数据模型，成员为指向首元素的指针，元素通过自身的next成员串联
+ *
+ * 每个元素只分配一次，不再额外分配`cson_list_t`节点；非对象元素被忽略
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @param submodel 元素模型
+ * @param subsize 元素模型数量
+ * @param eleType 元素类型
+ * @param nextKey 元素中指向下一个元素的成员，不参与解析及编码
+ */
+#define CSON_MODEL_ILIST(type, key, submodel, subsize, eleType, nextKey) \
+        {CSON_TYPE_ILIST, #key, offsetof(type, key), .param.ilist.model = submodel, .param.ilist.size = subsize, .param.ilist.next = offsetof(eleType, nextKey)}
+
+/**
+ * @brief vector型数据模型，成员类型为`cson_vector_t`
+ *
+ * 基础类型元素使用`CSON_MODEL_INT_LIST`等链表模型描述，按原类型连续存放；
+ * 结构体元素直接存放在数组中，而非指针
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @param submodel 元素模型
+ * @param subsize 元素模型大小
+ */
+#define CSON_MODEL_VECTOR(type, key, submodel, subsize) \
+        {CSON_TYPE_VECTOR, #key, offsetof(type, key), .param.sub.model = submodel, .param.sub.size = subsize}
+
 /**
  * @brief list型数据模型
  *
@@ -205,6 +464,27 @@ extern cson_model_t g_cson_basic_list_model[]; /**< 基础类型链表数据模
 #define CSON_MODEL_ARRAY(type, key, elementType, arraySize) \
         {CSON_TYPE_ARRAY, #key, offsetof(type, key), .param.array.ele_type = elementType, .param.array.size = arraySize}
 
+/**
+ * @brief 定长字符数组数据模型，字符串直接存放在结构体内的`char[size]`中，超长时截断
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @param arraySize 数组容量，含结束符
+ */
+#define CSON_MODEL_CHAR_ARRAY(type, key, arraySize) \
+        CSON_MODEL_CHAR_ARRAY_POLICY(type, key, arraySize, CSON_CHARS_TRUNCATE)
+
+/**
+ * @brief 指定超长处理策略的定长字符数组数据模型
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @param arraySize 数组容量，含结束符
+ * @param charsPolicy 超长处理策略，见`cson_chars_policy_t`
+ */
+#define CSON_MODEL_CHAR_ARRAY_POLICY(type, key, arraySize, charsPolicy) \
+        {CSON_TYPE_CHAR_ARRAY, #key, offsetof(type, key), .param.chars.size = arraySize, .param.chars.policy = charsPolicy}
+
 /**
  * @brief 子json数据模型
  *
@@ -275,6 +555,30 @@ void *cson_decode(const char *json_str, cson_model_t *model, int model_size);
 #define cson_decode_ex(json_str, model) \
         cson_decode(json_str, model, sizeof(model) / sizeof(cson_model_t));
 
+/**
+ * @brief 解析JSON文件
+ *
+ * @param path 文件路径
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param flags 解析选项，见`CSON_FILE_BORROW`
+ * @return void* 解析得到的对象，使用`cson_free_file`释放
+ * @note 文件以只读方式映射并按顺序访问提示内核预读，直接在映射上按长度解析，
+ *       不再将整个文件读入堆中
+ */
+void *cson_decode_file(const char *path, cson_model_t *model, int model_size, int flags);
+
+/**
+ * @brief 解析JSON文件
+ *
+ * @param path 文件路径
+ * @param model 数据模型
+ * @param flags 解析选项
+ * @return void* 解析得到的对象
+ */
+#define cson_decode_file_ex(path, model, flags) \
+        cson_decode_file(path, model, sizeof(model) / sizeof(cson_model_t), flags)
+
 /**
  * @brief 编码成json字符串
  *
@@ -347,6 +651,24 @@ void cson_free(void *obj, cson_model_t *model, int model_size);
 #define cson_free_ex(obj, model) \
         cson_free(obj, model, sizeof(model) / sizeof(cson_model_t))
 
+/**
+ * @brief 释放`cson_decode_file`解析出的对象
+ *
+ * @param obj 对象
+ * @param model 对象模型
+ * @param model_size 对象模型数量
+ */
+void cson_free_file(void *obj, cson_model_t *model, int model_size);
+
+/**
+ * @brief 释放`cson_decode_file`解析出的对象
+ *
+ * @param obj 对象
+ * @param model 对象模型
+ */
+#define cson_free_file_ex(obj, model) \
+        cson_free_file(obj, model, sizeof(model) / sizeof(cson_model_t))
+
 /**
  * @brief 释放cson编码生成的json字符串
  *
@@ -360,6 +682,7 @@ void cson_free_json(const char *json_str);
  * @param list 链表
  * @param obj 节点对象
  * @return cson_list_t 链表
+ * @note 每次添加都需遍历整个链表，逐个构建较长的链表时使用`cson_list_push`
  */
 cson_list_t *cson_list_add(cson_list_t *list, void *obj);
 
@@ -373,6 +696,79 @@ cson_list_t *cson_list_add(cson_list_t *list, void *obj);
  */
 cson_list_t *cson_list_delete(cson_list_t *list, void *obj, char free_mem);
 
+/**
+ * @brief 链表尾部追加节点
+ *
+ * @param list 链表头
+ * @param obj 节点对象，基础类型链表传NULL，元素值随后写入返回的节点
+ * @return cson_list_t* 新节点，失败返回NULL
+ */
+cson_list_t *cson_list_push(cson_list_head_t *list, void *obj);
+
+/**
+ * @brief 按序号获取节点
+ *
+ * 从最近一次访问的节点继续向后查找，顺序访问及访问尾节点均为O(1)
+ *
+ * @param list 链表头
+ * @param index 序号
+ * @return cson_list_t* 节点，越界返回NULL
+ */
+cson_list_t *cson_list_at(cson_list_head_t *list, size_t index);
+
+/**
+ * @brief 移除节点，节点留待复用
+ *
+ * 由调用方给出前一个节点，移除为O(1)；遍历时记录前一个节点，或经`cson_list_at`取得
+ *
+ * @param list 链表头
+ * @param prev 前一个节点，移除首节点时为NULL
+ * @param node 节点
+ * @return int 0成功，-1`prev`的下一个节点不是`node`
+ * @note 节点对象不会被释放
+ */
+int cson_list_remove(cson_list_head_t *list, cson_list_t *prev, cson_list_t *node);
+
+/**
+ * @brief 释放链表头持有的全部节点，并重置为空链表
+ *
+ * @param list 链表头
+ * @param model 元素模型，不为NULL时按模型一并释放元素
+ * @param model_size 元素模型数量
+ */
+void cson_list_release(cson_list_head_t *list, cson_model_t *model, int model_size);
+
+/**
+ * @brief 预留vector容量
+ *
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ * @param cap 元素容量
+ * @return int 0成功，-1失败
+ */
+int cson_vector_reserve(cson_vector_t *vec, cson_model_t *model, int model_size, size_t cap);
+
+/**
+ * @brief vector尾部追加一个置零的元素，容量不足时按倍数扩容
+ *
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ * @return void* 新元素，失败返回NULL
+ * @note 扩容后之前取得的元素地址失效
+ */
+void *cson_vector_push(cson_vector_t *vec, cson_model_t *model, int model_size);
+
+/**
+ * @brief 释放vector的元素及数组，并置为空
+ *
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ */
+void cson_vector_free(cson_vector_t *vec, cson_model_t *model, int model_size);
+
 /**
  * @brief CSON新字符串
  *
@@ -383,8 +779,184 @@ cson_list_t *cson_list_delete(cson_list_t *list, void *obj, char free_mem);
  */
 char *cson_new_string(const char *src);
 
+/**
+ * @brief 按定长字符数组模型写入字符串
+ *
+ * @param dest 字符数组
+ * @param field 定长字符数组数据模型
+ * @param src 源字符串，可为NULL
+ * @param len 源字符串长度
+ * @return int 0完整写入，1已截断，-1超长被拒绝
+ * @note 结果总是以'\0'结尾；供各解析模块共用，保证超长处理一致
+ */
+int cson_chars_assign(char *dest, const cson_model_t *field, const char *src, size_t len);
+
+/**
+ * @brief 内嵌结构体数组的有效元素数量
+ *
+ * @param obj 所属对象
+ * @param field 内嵌结构体数组数据模型
+ * @return int 有元素数量成员时为其值，限制在0~数组大小之间；否则为数组大小
+ * @note 供各编码模块共用，保证输出的元素数量一致
+ */
+int cson_embeds_count(const void *obj, const cson_model_t *field);
+
+/**
+ * @brief 记录内嵌结构体数组的元素数量，没有元素数量成员时不做处理
+ *
+ * @param obj 所属对象
+ * @param field 内嵌结构体数组数据模型
+ * @param count 元素数量
+ */
+void cson_embeds_set_count(void *obj, const cson_model_t *field, int count);
+
+/**
+ * @brief 使用CSON内存分配函数分配内存
+ *
+ * @param size 分配大小
+ * @return void* 分配得到的内存
+ * @note 由此分配的内存可交由`cson_free`等函数释放
+ */
+void *cson_mem_alloc(size_t size);
+
+/**
+ * @brief 使用CSON内存释放函数释放内存
+ *
+ * @param ptr 内存
+ */
+void cson_mem_free(void *ptr);
+
+/**
+ * @brief 创建对象池
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return cson_pool_t* 对象池
+ * @note 对象池按模型为顶层对象、嵌套结构体及链表节点分别维护空闲链表，
+ *       对象池本身即线程缓存，多线程解析时每个线程创建各自的对象池
+ */
+cson_pool_t *cson_pool_create(cson_model_t *model, int model_size);
+
+/**
+ * @brief 创建对象池
+ *
+ * @param model 数据模型
+ * @return cson_pool_t* 对象池
+ */
+#define cson_pool_create_ex(model) \
+        cson_pool_create(model, sizeof(model) / sizeof(cson_model_t))
+
+/**
+ * @brief 对象池预热
+ *
+ * @param pool 对象池
+ * @param count 每个分级预分配的块数量
+ * @return int 0成功，-1失败
+ */
+int cson_pool_prewarm(cson_pool_t *pool, int count);
+
+/**
+ * @brief 使用对象池解析JSON对象
+ *
+ * @param pool 对象池
+ * @param json JSON对象
+ * @return void* 解析得到的对象，使用`cson_pool_release`释放
+ */
+void *cson_pool_decode_object(cson_pool_t *pool, cJSON *json);
+
+/**
+ * @brief 使用对象池解析JSON字符串
+ *
+ * @param pool 对象池
+ * @param json_str json字符串
+ * @return void* 解析得到的对象，使用`cson_pool_release`释放
+ */
+void *cson_pool_decode(cson_pool_t *pool, const char *json_str);
+
+/**
+ * @brief 将对象池解析出的对象归还到对象池
+ *
+ * @param obj 对象
+ * @note 结构体及链表节点归还到对象池，字符串仍通过`cson_init`指定的函数释放
+ */
+void cson_pool_release(void *obj);
+
+/**
+ * @brief 销毁对象池
+ *
+ * @param pool 对象池
+ * @note 销毁后由该对象池解析出的对象全部失效
+ */
+void cson_pool_destroy(cson_pool_t *pool);
+
+/**
+ * @brief 获取内存统计
+ *
+ * @param stats 内存统计
+ * @param scope 统计范围
+ * @return int 0成功，-1未启用统计
+ * @note 全局统计为各线程计数之和，读取时不加锁；其中峰值为各线程峰值之和，是全局峰值的上界
+ */
+int cson_stats_get(cson_stats_t *stats, cson_stats_scope_t scope);
+
+/**
+ * @brief 清零内存统计
+ *
+ * @param scope 统计范围，`CSON_STATS_GLOBAL`同时清零全部数据模型的统计
+ * @note 其他线程的计数在该线程下一次分配或释放时清零，此前不计入全局统计
+ */
+void cson_stats_reset(cson_stats_scope_t scope);
+
+/**
+ * @brief 单独统计数据模型
+ *
+ * 以该模型为参数调用的解析、编码、释放函数，期间的全部分配(包括cJSON树)计入该模型，
+ * 这些内存之后无论由哪个函数释放，均计入该模型；嵌套调用计入最外层的模型
+ *
+ * @param model 数据模型
+ * @return int 0成功，-1未启用统计或超过`CSON_STATS_MODEL_MAX`
+ */
+int cson_stats_track(cson_model_t *model);
+
+/**
+ * @brief 获取数据模型的内存统计
+ *
+ * @param model 数据模型
+ * @param stats 内存统计
+ * @return int 0成功，-1模型未通过`cson_stats_track`注册
+ */
+int cson_stats_model_get(cson_model_t *model, cson_stats_t *stats);
+
+/**
+ * @brief 进入数据模型统计范围
+ *
+ * @param model 数据模型
+ * @return void* 外层统计范围，传给`cson_stats_leave`
+ * @note 供解析/编码模块在公开函数入口调用，一般通过`CSON_STATS_ENTER`使用
+ */
+void *cson_stats_enter(cson_model_t *model);
+
+/**
+ * @brief 离开数据模型统计范围
+ *
+ * @param scope `cson_stats_enter`的返回值
+ */
+void cson_stats_leave(void *scope);
+
+#if CSON_STATS_ENABLE
+#define CSON_STATS_ENTER(model) void *_cson_stats_scope = cson_stats_enter(model)
+#define CSON_STATS_LEAVE() cson_stats_leave(_cson_stats_scope)
+#else
+#define CSON_STATS_ENTER(model)
+#define CSON_STATS_LEAVE()
+#endif
+
 /**
  * @}
  */
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -0,0 +1,1879 @@
+/**
+ * @file cson.hpp
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#ifndef __CSON_HPP__
+#define __CSON_HPP__
+
+#include "cson.h"
+
+#include <atomic>
+#include <cfloat>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @defgroup CSON_CPP cson c++
+ * @brief 基于编译期反射的C++编解码
+ *
+ * 字段通过`constexpr`成员指针表描述，每个结构体实例化出独立的解析及编码函数，
+ * 键值哈希在编译期计算，字段处理全部内联展开，没有虚函数及运行时模型遍历
+ *
+ * @code
+ * struct point_t { int x; int y; char *tag; };
+ *
+ * CSON_REFLECT(point_t,
+ *              CSON_FIELD(point_t, x),
+ *              CSON_FIELD(point_t, y),
+ *              CSON_FIELD(point_t, tag));
+ *
+ * point_t point;
+ * cson::decode("{\"x\":1,\"y\":2}", point);
+ * std::string json = cson::encode(point);
+ * cson::clear(point);
+ * @endcode
+ *
+ * 与C数据模型互通:
+ * - 字段可直接引用已有的`cson_model_t`，用于`cson_list_t *`链表、`cson_vector_t`连续数组或C模型描述的结构体指针
+ * - `cson::c_model<T>()`由反射信息生成`cson_model_t`，可交给`cson_decode`、MessagePack、CBOR、快照等C接口使用，
+ *   已反射的结构体成员对应`CSON_TYPE_EMBED`，其定长数组对应`CSON_TYPE_EMBED_ARRAY`
+ * - `cson::field("name", &T::name, cson::chars)`将`char[N]`成员按定长字符串处理，对应`CSON_TYPE_CHAR_ARRAY`
+ *
+ * 解析及编码结果与使用等价C模型的`cson_decode`/`cson_encode_unformatted`一致
+ *
+ * 成员也可使用标准库类型，解析时直接构造在成员中，由析构函数释放:
+ * - `std::string` 对应字符串，非字符串时为空串，编码时总是输出
+ * - `std::vector<E>` 对应数组，元素规则与定长数组相同，长度不受限制
+ * - `std::optional<E>`、`std::unique_ptr<E>` 对应可省略的值，JSON为null时为空，为空时编码省略该键值
+ *
+ * @addtogroup CSON_CPP
+ * @{
+ */
+
+namespace cson
+{
+
+/**
+ * @brief 结构体反射信息，通过`CSON_REFLECT`特化
+ *
+ * 特化需提供`static constexpr auto fields`，为`cson::field`组成的tuple
+ *
+ * @tparam T 结构体类型
+ */
+template <typename T>
+struct reflect;
+
+/**
+ * @brief 原始JSON字段标记，对应`CSON_TYPE_JSON`
+ *
+ */
+struct raw_json_t
+{
+};
+
+/**
+ * @brief 原始JSON字段标记
+ *
+ */
+inline constexpr raw_json_t raw_json{};
+
+/**
+ * @brief 定长字符串字段标记，对应`CSON_TYPE_CHAR_ARRAY`
+ *
+ */
+struct chars_t
+{
+    cson_chars_policy_t policy; /**< 超长处理策略 */
+};
+
+/**
+ * @brief 定长字符串字段标记，超长时截断
+ *
+ */
+inline constexpr chars_t chars{CSON_CHARS_TRUNCATE};
+
+namespace detail
+{
+
+/**
+ * @brief 键值哈希(ASCII大小写不敏感)，与cJSON_GetObjectItem的匹配规则一致
+ *
+ * @param key 键值
+ * @param len 键值长度
+ * @return uint32_t 哈希值
+ */
+constexpr uint32_t hash(const char *key, size_t len)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned char c = static_cast<unsigned char>(key[i]);
+        if (c >= 'A' && c <= 'Z')
+        {
+            c = static_cast<unsigned char>(c + 32);
+        }
+        h = (h ^ c) * 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief 键值哈希
+ *
+ * @param key 以0结尾的键值
+ * @return uint32_t 哈希值
+ */
+inline uint32_t hash(const char *key)
+{
+    return hash(key, std::strlen(key));
+}
+
+/**
+ * @brief 键值是否无需转义
+ *
+ * @param key 键值
+ * @param len 键值长度
+ * @return bool 是否无需转义
+ */
+constexpr bool plain(const char *key, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned char c = static_cast<unsigned char>(key[i]);
+        if (c < 32 || c == '\"' || c == '\\')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief 字段描述
+ *
+ * @tparam T 结构体类型
+ * @tparam M 成员类型
+ */
+template <typename T, typename M>
+struct field_t
+{
+    using object_type = T; /**< 结构体类型 */
+    using member_type = M; /**< 成员类型 */
+
+    const char *key;     /**< 键值 */
+    size_t len;          /**< 键值长度 */
+    M T::*member;        /**< 成员指针 */
+    uint32_t hash;       /**< 键值哈希 */
+    bool plain;          /**< 键值是否无需转义 */
+    bool json;           /**< 是否为原始JSON字段 */
+    cson_model_t *model; /**< C数据模型，不为NULL时使用C模型处理 */
+    short model_size;    /**< C数据模型数量 */
+    bool chars;          /**< 是否为定长字符串字段 */
+    cson_chars_policy_t policy; /**< 定长字符串超长处理策略 */
+};
+
+/**
+ * @brief 描述字段
+ *
+ * @param key 键值
+ * @param member 成员指针
+ * @return field_t<T, M> 字段描述
+ */
+template <typename T, typename M, size_t N>
+constexpr field_t<T, M> field(const char (&key)[N], M T::*member)
+{
+    return {key, N - 1, member, detail::hash(key, N - 1), detail::plain(key, N - 1), false, nullptr, 0, false,
+            CSON_CHARS_TRUNCATE};
+}
+
+/**
+ * @brief 描述原始JSON字段
+ *
+ * @param key 键值
+ * @param member 成员指针
+ * @return field_t<T, char *> 字段描述
+ */
+template <typename T, size_t N>
+constexpr field_t<T, char *> field(const char (&key)[N], char *T::*member, raw_json_t)
+{
+    return {key, N - 1, member, detail::hash(key, N - 1), detail::plain(key, N - 1), true, nullptr, 0, false,
+            CSON_CHARS_TRUNCATE};
+}
+
+/**
+ * @brief 描述定长字符串字段，`char[S]`成员按字符串而非数值数组处理
+ *
+ * @param key 键值
+ * @param member 成员指针
+ * @param tag `cson::chars`或指定超长处理策略的`cson::chars_t`
+ * @return field_t<T, char[S]> 字段描述
+ */
+template <typename T, size_t N, size_t S>
+constexpr field_t<T, char[S]> field(const char (&key)[N], char (T::*member)[S], chars_t tag)
+{
+    return {key, N - 1, member, detail::hash(key, N - 1), detail::plain(key, N - 1), false, nullptr, 0, true,
+            tag.policy};
+}
+
+/**
+ * @brief 描述使用C数据模型的字段
+ *
+ * 成员为`cson_list_t *`时按链表处理，为`cson_vector_t`时按连续数组处理，为其他指针时按结构体处理
+ *
+ * @param key 键值
+ * @param member 成员指针
+ * @param model C数据模型
+ * @param model_size C数据模型数量
+ * @return field_t<T, M> 字段描述
+ */
+template <typename T, typename M, size_t N>
+constexpr field_t<T, M> field(const char (&key)[N], M T::*member, cson_model_t *model, int model_size)
+{
+    static_assert(std::is_pointer_v<M> || std::is_same_v<M, cson_vector_t>,
+                  "C model fields must be pointers or cson_vector_t");
+    return {key, N - 1, member, detail::hash(key, N - 1), detail::plain(key, N - 1), false, model,
+            static_cast<short>(model_size), false, CSON_CHARS_TRUNCATE};
+}
+
+namespace detail
+{
+
+template <typename T, typename = void>
+struct is_reflected : std::false_type
+{
+};
+
+template <typename T>
+struct is_reflected<T, std::void_t<decltype(reflect<T>::fields)>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_reflected_v = is_reflected<T>::value;
+
+template <typename T>
+inline constexpr size_t field_count_v = std::tuple_size_v<std::remove_cv_t<decltype(reflect<T>::fields)>>;
+
+template <typename T, size_t I>
+using field_type = std::remove_cv_t<std::tuple_element_t<I, std::remove_cv_t<decltype(reflect<T>::fields)>>>;
+
+template <typename T>
+inline constexpr bool is_number_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+template <typename T>
+struct is_vector : std::false_type
+{
+};
+
+template <typename E, typename A>
+struct is_vector<std::vector<E, A>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_vector_v = is_vector<T>::value;
+
+template <typename T>
+struct is_optional : std::false_type
+{
+};
+
+template <typename E>
+struct is_optional<std::optional<E>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_optional_v = is_optional<T>::value;
+
+template <typename T>
+struct is_unique_ptr : std::false_type
+{
+};
+
+template <typename E, typename D>
+struct is_unique_ptr<std::unique_ptr<E, D>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_unique_ptr_v = is_unique_ptr<T>::value;
+
+/**
+ * @brief 是否为可省略的成员，为空时编码省略该键值
+ *
+ */
+template <typename T>
+inline constexpr bool is_nullable_v = is_optional_v<T> || is_unique_ptr_v<T>;
+
+/**
+ * @brief 键值比较(大小写不敏感)
+ *
+ * @param a 键值
+ * @param b 模型键值
+ * @return bool 是否相等
+ */
+inline bool key_equal(const char *a, const char *b)
+{
+    for (; std::tolower(static_cast<unsigned char>(*a)) == std::tolower(static_cast<unsigned char>(*b)); a++, b++)
+    {
+        if (!*a)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 是否为数值
+ *
+ * @param item JSON对象
+ * @return bool 是否为数值
+ */
+inline bool is_number(const cJSON *item)
+{
+    return (item->type & 0xFF) == cJSON_Number;
+}
+
+/**
+ * @brief 复制字符串，使用cson内存分配函数
+ *
+ * @param item JSON对象
+ * @return char* 新字符串，非字符串返回NULL
+ */
+inline char *dup_string(const cJSON *item)
+{
+    if ((item->type & 0xFF) != cJSON_String || !item->valuestring)
+    {
+        return nullptr;
+    }
+    size_t len = std::strlen(item->valuestring);
+    char *str = static_cast<char *>(cson_mem_alloc(len + 1));
+    if (str)
+    {
+        std::memcpy(str, item->valuestring, len + 1);
+    }
+    return str;
+}
+
+/**
+ * @brief 写入整型
+ *
+ * @param out 输出
+ * @param value 整型值
+ */
+inline void put_int(std::string &out, long long value)
+{
+    char tmp[24];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), value);
+    out.append(tmp, static_cast<size_t>(res.ptr - tmp));
+}
+
+/**
+ * @brief 写入数值，格式与cJSON一致
+ *
+ * @param out 输出
+ * @param d 数值
+ */
+inline void put_number(std::string &out, double d)
+{
+    char tmp[26];
+    double test = 0.0;
+    int len;
+
+    if (std::isnan(d) || std::isinf(d))
+    {
+        out.append("null", 4);
+        return;
+    }
+    if (d >= INT_MIN && d <= INT_MAX && d == static_cast<double>(static_cast<int>(d)))
+    {
+        put_int(out, static_cast<int>(d));
+        return;
+    }
+    if (std::fabs(d) <= 9007199254740992.0 && d == std::floor(d))
+    {
+        put_int(out, static_cast<long long>(d));
+        return;
+    }
+    len = std::snprintf(tmp, sizeof(tmp), "%1.15g", d);
+    if (std::sscanf(tmp, "%lg", &test) != 1
+        || std::fabs(test - d) > std::fmax(std::fabs(test), std::fabs(d)) * DBL_EPSILON)
+    {
+        len = std::snprintf(tmp, sizeof(tmp), "%1.17g", d);
+    }
+    out.append(tmp, static_cast<size_t>(len));
+}
+
+/**
+ * @brief 写入字符串，转义规则与cJSON一致
+ *
+ * @param out 输出
+ * @param str 字符串
+ * @param len 字符串长度
+ */
+inline void put_string(std::string &out, const char *str, size_t len)
+{
+    const char *run = str;
+    const char *end = str + len;
+
+    out += '\"';
+    for (const char *s = str; s < end; s++)
+    {
+        unsigned char c = static_cast<unsigned char>(*s);
+        if (c > 31 && c != '\"' && c != '\\')
+        {
+            continue;
+        }
+        out.append(run, static_cast<size_t>(s - run));
+        run = s + 1;
+        switch (c)
+        {
+        case '\\':
+            out.append("\\\\", 2);
+            break;
+        case '\"':
+            out.append("\\\"", 2);
+            break;
+        case '\b':
+            out.append("\\b", 2);
+            break;
+        case '\f':
+            out.append("\\f", 2);
+            break;
+        case '\n':
+            out.append("\\n", 2);
+            break;
+        case '\r':
+            out.append("\\r", 2);
+            break;
+        case '\t':
+            out.append("\\t", 2);
+            break;
+        default:
+        {
+            char esc[8];
+            std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+            out.append(esc, 6);
+            break;
+        }
+        }
+    }
+    out.append(run, static_cast<size_t>(end - run));
+    out += '\"';
+}
+
+/**
+ * @brief 写入键值，非首个成员前写入','
+ *
+ * @param out 输出
+ * @param first 是否为首个成员
+ * @param f 字段描述
+ */
+template <typename F>
+inline void put_key(std::string &out, bool &first, const F &f)
+{
+    if (!first)
+    {
+        out += ',';
+    }
+    first = false;
+    if (f.plain)
+    {
+        out += '\"';
+        out.append(f.key, f.len);
+        out.append("\":", 2);
+    }
+    else
+    {
+        put_string(out, f.key, f.len);
+        out += ':';
+    }
+}
+
+/**
+ * @brief 写入cJSON对象
+ *
+ * @param out 输出
+ * @param json cJSON对象
+ */
+inline void put_cjson(std::string &out, const cJSON *json)
+{
+    char *str = cJSON_PrintUnformatted(json);
+    if (str)
+    {
+        out.append(str);
+        cJSON_free(str);
+    }
+}
+
+/**
+ * @brief 是否为基础类型链表模型
+ *
+ * @param model 数据模型
+ * @return bool 是否为基础类型链表模型
+ */
+inline bool is_basic_list(const cson_model_t *model)
+{
+    return model >= &g_cson_basic_list_model[0] && model < &g_cson_basic_list_model[14];
+}
+
+/**
+ * @brief 读取定长字符串，规则与`cson_chars_assign`一致，非字符串时为空串
+ *
+ * @param item JSON对象
+ * @param dest 字符数组
+ * @param policy 超长处理策略
+ */
+template <size_t S>
+void read_chars(const cJSON *item, char (&dest)[S], cson_chars_policy_t policy)
+{
+    cson_model_t field{};
+    const char *str = (item->type & 0xFF) == cJSON_String ? item->valuestring : nullptr;
+
+    field.type = CSON_TYPE_CHAR_ARRAY;
+    field.param.chars.size = static_cast<short>(S);
+    field.param.chars.policy = policy;
+    cson_chars_assign(dest, &field, str, str ? std::strlen(str) : 0);
+}
+
+/**
+ * @brief 读取整型值，与`_cson_decode_number`/`_cson_decode_long`一致
+ *
+ * 不超过int宽度的类型取valueint，更宽的类型从valuedouble取值，超出范围时取边界值
+ *
+ * @param item JSON对象
+ * @return M 整型值，非数值返回0
+ */
+template <typename M>
+M read_integer(const cJSON *item)
+{
+    if (!is_number(item))
+    {
+        return M(0);
+    }
+    if constexpr (sizeof(M) <= sizeof(int))
+    {
+        return static_cast<M>(item->valueint);
+    }
+    else
+    {
+        double num = item->valuedouble;
+        if (num != num)
+        {
+            return M(0);
+        }
+        if (num >= static_cast<double>(std::numeric_limits<M>::max()))
+        {
+            return std::numeric_limits<M>::max();
+        }
+        if (num <= static_cast<double>(std::numeric_limits<M>::min()))
+        {
+            return std::numeric_limits<M>::min();
+        }
+        return static_cast<M>(num);
+    }
+}
+
+/**
+ * @brief 读取基础类型值
+ *
+ * @param item JSON对象
+ * @param type 值类型
+ * @param dest 存放值的地址，大小与类型一致
+ */
+inline void store_basic(const cJSON *item, cson_type_t type, void *dest)
+{
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+        *static_cast<char *>(dest) = is_number(item) ? static_cast<char>(item->valueint) : 0;
+        break;
+    case CSON_TYPE_SHORT:
+        *static_cast<short *>(dest) = is_number(item) ? static_cast<short>(item->valueint) : 0;
+        break;
+    case CSON_TYPE_INT:
+        *static_cast<int *>(dest) = is_number(item) ? item->valueint : 0;
+        break;
+    case CSON_TYPE_LONG:
+        *static_cast<long *>(dest) = read_integer<long>(item);
+        break;
+    case CSON_TYPE_FLOAT:
+        *static_cast<float *>(dest) = is_number(item) ? static_cast<float>(item->valuedouble) : 0.0f;
+        break;
+    case CSON_TYPE_DOUBLE:
+        *static_cast<double *>(dest) = is_number(item) ? item->valuedouble : 0.0;
+        break;
+    case CSON_TYPE_STRING:
+        *static_cast<char **>(dest) = dup_string(item);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 解析使用C数据模型的链表，与`cson_decode`一致每个元素对应一个节点，基础类型元素直接写入节点，
+ * 结构体链表中null元素的节点对象为NULL
+ *
+ * @param item JSON对象
+ * @param model 元素数据模型
+ * @param model_size 元素数据模型数量
+ * @return cson_list_t* 链表
+ */
+inline cson_list_t *read_list(const cJSON *item, cson_model_t *model, int model_size)
+{
+    cson_list_t *list = nullptr;
+    cson_list_t *tail = nullptr;
+
+    if ((item->type & 0xFF) != cJSON_Array)
+    {
+        return nullptr;
+    }
+    for (const cJSON *child = item->child; child; child = child->next)
+    {
+        cson_list_t *node = static_cast<cson_list_t *>(cson_mem_alloc(sizeof(cson_list_t)));
+        if (!node)
+        {
+            continue;
+        }
+        std::memset(node, 0, sizeof(cson_list_t));
+        if (is_basic_list(model))
+        {
+            store_basic(child, model[1].type, &node->obj);
+        }
+        else
+        {
+            node->obj = cson_decode_object(const_cast<cJSON *>(child), model, model_size);
+        }
+        if (tail)
+        {
+            tail->next = node;
+        }
+        else
+        {
+            list = node;
+        }
+        tail = node;
+    }
+    return list;
+}
+
+/**
+ * @brief 写入基础类型值
+ *
+ * @param out 输出
+ * @param src 值的地址
+ * @param type 值类型
+ */
+inline void write_basic(std::string &out, const void *src, cson_type_t type)
+{
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+        put_int(out, *static_cast<const char *>(src));
+        break;
+    case CSON_TYPE_SHORT:
+        put_int(out, *static_cast<const short *>(src));
+        break;
+    case CSON_TYPE_INT:
+        put_int(out, *static_cast<const int *>(src));
+        break;
+    case CSON_TYPE_LONG:
+        put_number(out, static_cast<double>(*static_cast<const long *>(src)));
+        break;
+    case CSON_TYPE_FLOAT:
+        put_number(out, *static_cast<const float *>(src));
+        break;
+    case CSON_TYPE_DOUBLE:
+        put_number(out, *static_cast<const double *>(src));
+        break;
+    case CSON_TYPE_STRING:
+        put_string(out, *static_cast<char *const *>(src), std::strlen(*static_cast<char *const *>(src)));
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 写入使用C数据模型的链表，跳过obj为NULL的节点
+ *
+ * @param out 输出
+ * @param list 链表
+ * @param model 元素数据模型
+ * @param model_size 元素数据模型数量
+ */
+inline void write_list(std::string &out, const cson_list_t *list, cson_model_t *model, int model_size)
+{
+    bool head = true;
+
+    out += '[';
+    for (const cson_list_t *p = list; p; p = p->next)
+    {
+        if (!p->obj && (!is_basic_list(model) || model[1].type == CSON_TYPE_STRING))
+        {
+            continue;
+        }
+        if (!head)
+        {
+            out += ',';
+        }
+        head = false;
+        if (!is_basic_list(model))
+        {
+            cJSON *json = cson_encode_object(p->obj, model, model_size);
+            put_cjson(out, json);
+            cJSON_Delete(json);
+            continue;
+        }
+        write_basic(out, &p->obj, model[1].type);
+    }
+    out += ']';
+}
+
+/**
+ * @brief 释放使用C数据模型的链表
+ *
+ * @param list 链表
+ * @param model 元素数据模型
+ * @param model_size 元素数据模型数量
+ */
+inline void free_list(cson_list_t *list, cson_model_t *model, int model_size)
+{
+    while (list)
+    {
+        cson_list_t *next = list->next;
+        if (!is_basic_list(model))
+        {
+            cson_free(list->obj, model, model_size);
+        }
+        else if (model[1].type == CSON_TYPE_STRING)
+        {
+            cson_mem_free(list->str);
+        }
+        cson_mem_free(list);
+        list = next;
+    }
+}
+
+/**
+ * @brief 解析使用C数据模型的vector，按数组长度一次分配
+ *
+ * @param item JSON对象
+ * @param vec vector
+ * @param model 元素数据模型
+ * @param model_size 元素数据模型数量
+ */
+inline void read_vector(const cJSON *item, cson_vector_t &vec, cson_model_t *model, int model_size)
+{
+    size_t count = 0;
+    size_t ele_size = static_cast<size_t>(model[0].param.obj_size);
+
+    vec = {nullptr, 0, 0};
+    if ((item->type & 0xFF) != cJSON_Array)
+    {
+        return;
+    }
+    for (const cJSON *child = item->child; child; child = child->next)
+    {
+        count++;
+    }
+    if (!count || cson_vector_reserve(&vec, model, model_size, count) != 0)
+    {
+        return;
+    }
+    for (const cJSON *child = item->child; child; child = child->next)
+    {
+        void *ele = static_cast<char *>(vec.data) + vec.count++ * ele_size;
+        if (is_basic_list(model))
+        {
+            store_basic(child, model[1].type, ele);
+            continue;
+        }
+        void *obj = cson_decode_object(const_cast<cJSON *>(child), model, model_size);
+        if (obj)
+        {
+            std::memcpy(ele, obj, ele_size);
+            cson_mem_free(obj);
+        }
+    }
+}
+
+/**
+ * @brief 写入使用C数据模型的vector，跳过为NULL的字符串元素
+ *
+ * @param out 输出
+ * @param vec vector
+ * @param model 元素数据模型
+ * @param model_size 元素数据模型数量
+ */
+inline void write_vector(std::string &out, const cson_vector_t &vec, cson_model_t *model, int model_size)
+{
+    size_t ele_size = static_cast<size_t>(model[0].param.obj_size);
+    bool head = true;
+
+    out += '[';
+    for (size_t i = 0; i < vec.count; i++)
+    {
+        void *ele = static_cast<char *>(vec.data) + i * ele_size;
+        if (is_basic_list(model) && model[1].type == CSON_TYPE_STRING && !*static_cast<char **>(ele))
+        {
+            continue;
+        }
+        if (!head)
+        {
+            out += ',';
+        }
+        head = false;
+        if (is_basic_list(model))
+        {
+            write_basic(out, ele, model[1].type);
+            continue;
+        }
+        cJSON *json = cson_encode_object(ele, model, model_size);
+        put_cjson(out, json);
+        cJSON_Delete(json);
+    }
+    out += ']';
+}
+
+template <typename T>
+void decode_into(const cJSON *json, T &obj);
+
+template <typename T>
+void encode_into(std::string &out, const T &obj);
+
+template <typename T>
+void clear_into(T &obj);
+
+template <typename E>
+void read_element(const cJSON *item, E &value);
+
+/**
+ * @brief 分配并初始化一个对象
+ *
+ * 平凡类型使用cson内存分配函数并清零，与C模型互通；其他类型使用`new`
+ *
+ * @return T* 对象
+ */
+template <typename T>
+T *new_object()
+{
+    if constexpr (std::is_trivial_v<T>)
+    {
+        void *p = cson_mem_alloc(sizeof(T));
+        if (p)
+        {
+            std::memset(p, 0, sizeof(T));
+        }
+        return static_cast<T *>(p);
+    }
+    else
+    {
+        return new T{};
+    }
+}
+
+/**
+ * @brief 释放对象及其成员
+ *
+ * @param obj 对象
+ */
+template <typename T>
+void delete_object(T *obj)
+{
+    if (obj)
+    {
+        clear_into(*obj);
+        if constexpr (std::is_trivial_v<T>)
+        {
+            cson_mem_free(obj);
+        }
+        else
+        {
+            delete obj;
+        }
+    }
+}
+
+/**
+ * @brief 读取带类型检查的值，与`_cson_decode_into`一致
+ *
+ * @param item JSON对象
+ * @param value 成员
+ */
+template <typename M>
+void read_value(const cJSON *item, M &value)
+{
+    if constexpr (std::is_same_v<M, bool>)
+    {
+        value = (item->type & 0xFF) == cJSON_True;
+    }
+    else if constexpr (std::is_integral_v<M>)
+    {
+        value = read_integer<M>(item);
+    }
+    else if constexpr (std::is_floating_point_v<M>)
+    {
+        value = is_number(item) ? static_cast<M>(item->valuedouble) : M(0);
+    }
+    else if constexpr (std::is_same_v<M, char *>)
+    {
+        value = dup_string(item);
+    }
+    else if constexpr (std::is_same_v<M, std::string>)
+    {
+        if ((item->type & 0xFF) == cJSON_String && item->valuestring)
+        {
+            value.assign(item->valuestring);
+        }
+        else
+        {
+            value.clear();
+        }
+    }
+    else if constexpr (is_vector_v<M>)
+    {
+        using E = typename M::value_type;
+        value.clear();
+        if ((item->type & 0xFF) != cJSON_Array)
+        {
+            return;
+        }
+        size_t n = 0;
+        for (const cJSON *child = item->child; child; child = child->next)
+        {
+            n++;
+        }
+        value.reserve(n);
+        for (const cJSON *child = item->child; child; child = child->next)
+        {
+            if constexpr (std::is_same_v<E, bool>)
+            {
+                bool b = false;
+                read_element(child, b);
+                value.push_back(b);
+            }
+            else
+            {
+                read_element(child, value.emplace_back());
+            }
+        }
+    }
+    else if constexpr (is_optional_v<M>)
+    {
+        value.reset();
+        if ((item->type & 0xFF) != cJSON_NULL)
+        {
+            read_value(item, value.emplace());
+        }
+    }
+    else if constexpr (is_unique_ptr_v<M>)
+    {
+        value.reset();
+        if ((item->type & 0xFF) != cJSON_NULL)
+        {
+            value.reset(new typename M::element_type{});
+            read_value(item, *value);
+        }
+    }
+    else if constexpr (std::is_pointer_v<M> && is_reflected_v<std::remove_pointer_t<M>>)
+    {
+        using U = std::remove_pointer_t<M>;
+        value = nullptr;
+        if ((item->type & 0xFF) != cJSON_NULL)
+        {
+            value = new_object<U>();
+            if (value)
+            {
+                decode_into(item, *value);
+            }
+        }
+    }
+    else if constexpr (is_reflected_v<M>)
+    {
+        if ((item->type & 0xFF) != cJSON_NULL)
+        {
+            decode_into(item, value);
+        }
+    }
+    else
+    {
+        static_assert(sizeof(M) == 0, "unsupported member type");
+    }
+}
+
+/**
+ * @brief 读取数组元素，数值不检查类型，与`_cson_decode_array`一致
+ *
+ * @param item JSON对象
+ * @param value 元素
+ */
+template <typename E>
+void read_element(const cJSON *item, E &value)
+{
+    if constexpr (is_number_v<E> && std::is_integral_v<E>)
+    {
+        value = sizeof(E) > sizeof(int) && is_number(item) ? read_integer<E>(item) : static_cast<E>(item->valueint);
+    }
+    else if constexpr (std::is_floating_point_v<E>)
+    {
+        value = static_cast<E>(item->valuedouble);
+    }
+    else
+    {
+        read_value(item, value);
+    }
+}
+
+/**
+ * @brief 写入值
+ *
+ * @param out 输出
+ * @param value 值
+ */
+template <typename M>
+void write_value(std::string &out, const M &value)
+{
+    if constexpr (std::is_same_v<M, bool>)
+    {
+        if (value)
+        {
+            out.append("true", 4);
+        }
+        else
+        {
+            out.append("false", 5);
+        }
+    }
+    else if constexpr (std::is_integral_v<M>)
+    {
+        if (static_cast<long double>(value) >= INT_MIN && static_cast<long double>(value) <= INT_MAX)
+        {
+            put_int(out, static_cast<long long>(value));
+        }
+        else
+        {
+            put_number(out, static_cast<double>(value));
+        }
+    }
+    else if constexpr (std::is_floating_point_v<M>)
+    {
+        put_number(out, static_cast<double>(value));
+    }
+    else if constexpr (std::is_same_v<M, char *>)
+    {
+        put_string(out, value, std::strlen(value));
+    }
+    else if constexpr (std::is_same_v<M, std::string>)
+    {
+        std::string_view str(value);
+        put_string(out, str.data(), str.size());
+    }
+    else if constexpr (is_vector_v<M>)
+    {
+        bool head = true;
+        out += '[';
+        for (const auto &element : value)
+        {
+            if constexpr (std::is_same_v<typename M::value_type, char *>)
+            {
+                if (!element)
+                {
+                    continue;
+                }
+            }
+            if (!head)
+            {
+                out += ',';
+            }
+            head = false;
+            write_value(out, static_cast<const typename M::value_type &>(element));
+        }
+        out += ']';
+    }
+    else if constexpr (is_nullable_v<M>)
+    {
+        if (value)
+        {
+            write_value(out, *value);
+        }
+        else
+        {
+            out.append("null", 4);
+        }
+    }
+    else if constexpr (std::is_pointer_v<M>)
+    {
+        encode_into(out, *value);
+    }
+    else
+    {
+        encode_into(out, value);
+    }
+}
+
+/**
+ * @brief 解析一个字段
+ *
+ * @param item 字段JSON对象
+ * @param obj 对象
+ */
+template <typename T, size_t I>
+void decode_field(const cJSON *item, T &obj)
+{
+    constexpr const auto &f = std::get<I>(reflect<T>::fields);
+    using M = typename field_type<T, I>::member_type;
+    auto &value = obj.*(f.member);
+
+    if constexpr (std::is_same_v<M, char *>)
+    {
+        value = f.json ? cJSON_PrintUnformatted(item) : dup_string(item);
+    }
+    else if constexpr (std::is_same_v<M, cson_vector_t>)
+    {
+        read_vector(item, value, f.model, f.model_size);
+    }
+    else if constexpr (std::is_pointer_v<M>)
+    {
+        if (f.model || !is_reflected_v<std::remove_pointer_t<M>>)
+        {
+            if constexpr (std::is_same_v<M, cson_list_t *>)
+            {
+                value = read_list(item, f.model, f.model_size);
+            }
+            else
+            {
+                value = static_cast<M>(cson_decode_object(const_cast<cJSON *>(item), f.model, f.model_size));
+            }
+        }
+        else if constexpr (is_reflected_v<std::remove_pointer_t<M>>)
+        {
+            read_value(item, value);
+        }
+    }
+    else if constexpr (std::is_array_v<M>)
+    {
+        if constexpr (std::is_same_v<std::remove_extent_t<M>, char>)
+        {
+            if (f.chars)
+            {
+                read_chars(item, value, f.policy);
+                return;
+            }
+        }
+        if ((item->type & 0xFF) == cJSON_Array)
+        {
+            size_t i = 0;
+            for (const cJSON *child = item->child; child && i < std::extent_v<M>; child = child->next, i++)
+            {
+                read_element(child, value[i]);
+            }
+        }
+    }
+    else
+    {
+        read_value(item, value);
+    }
+}
+
+/**
+ * @brief 按编译期哈希匹配字段并解析，各字段展开为独立的比较
+ *
+ * @return bool 是否匹配到字段
+ */
+template <typename T, size_t I>
+bool match_field(const cJSON *item, uint32_t h, T &obj, unsigned char *seen)
+{
+    constexpr const auto &f = std::get<I>(reflect<T>::fields);
+    if (h != f.hash || seen[I] || !key_equal(item->string, f.key))
+    {
+        return false;
+    }
+    seen[I] = 1;
+    decode_field<T, I>(item, obj);
+    return true;
+}
+
+template <typename T, size_t... I>
+void match_fields(const cJSON *item, T &obj, unsigned char *seen, std::index_sequence<I...>)
+{
+    uint32_t h = hash(item->string);
+    (void)(match_field<T, I>(item, h, obj, seen) || ...);
+}
+
+/**
+ * @brief 解析JSON对象到已清零的对象中
+ *
+ * @param json JSON对象
+ * @param obj 对象
+ */
+template <typename T>
+void decode_into(const cJSON *json, T &obj)
+{
+    constexpr size_t n = field_count_v<T>;
+    unsigned char seen[n ? n : 1] = {0};
+
+    for (const cJSON *item = json->child; item; item = item->next)
+    {
+        if (item->string)
+        {
+            match_fields(item, obj, seen, std::make_index_sequence<n>{});
+        }
+    }
+}
+
+/**
+ * @brief 编码一个字段，省略规则与`cson_encode_object`一致
+ *
+ * @param out 输出
+ * @param obj 对象
+ * @param first 是否为首个成员
+ */
+template <typename T, size_t I>
+void encode_field(std::string &out, const T &obj, bool &first)
+{
+    constexpr const auto &f = std::get<I>(reflect<T>::fields);
+    using M = typename field_type<T, I>::member_type;
+    const auto &value = obj.*(f.member);
+
+    if constexpr (std::is_same_v<M, cson_vector_t>)
+    {
+        put_key(out, first, f);
+        write_vector(out, value, f.model, f.model_size);
+    }
+    else if constexpr (std::is_pointer_v<M> && !std::is_same_v<M, char *>)
+    {
+        if (!value)
+        {
+            return;
+        }
+        if constexpr (is_reflected_v<std::remove_pointer_t<M>>)
+        {
+            if (!f.model)
+            {
+                put_key(out, first, f);
+                write_value(out, value);
+                return;
+            }
+        }
+        put_key(out, first, f);
+        if constexpr (std::is_same_v<M, cson_list_t *>)
+        {
+            write_list(out, value, f.model, f.model_size);
+        }
+        else
+        {
+            cJSON *json = cson_encode_object(value, f.model, f.model_size);
+            put_cjson(out, json);
+            cJSON_Delete(json);
+        }
+    }
+    else if constexpr (std::is_same_v<M, char *>)
+    {
+        if (!value)
+        {
+            return;
+        }
+        if (f.json)
+        {
+            cJSON *json = cJSON_Parse(value);
+            if (json)
+            {
+                put_key(out, first, f);
+                put_cjson(out, json);
+                cJSON_Delete(json);
+            }
+            return;
+        }
+        put_key(out, first, f);
+        write_value(out, value);
+    }
+    else if constexpr (is_nullable_v<M>)
+    {
+        if (!value)
+        {
+            return;
+        }
+        put_key(out, first, f);
+        write_value(out, *value);
+    }
+    else if constexpr (std::is_array_v<M>)
+    {
+        bool head = true;
+        put_key(out, first, f);
+        if constexpr (std::is_same_v<std::remove_extent_t<M>, char>)
+        {
+            if (f.chars)
+            {
+                const void *end = std::memchr(value, 0, std::extent_v<M>);
+                put_string(out, value, end ? static_cast<size_t>(static_cast<const char *>(end) - value)
+                                           : std::extent_v<M>);
+                return;
+            }
+        }
+        out += '[';
+        for (size_t i = 0; i < std::extent_v<M>; i++)
+        {
+            if constexpr (std::is_same_v<std::remove_extent_t<M>, char *>)
+            {
+                if (!value[i])
+                {
+                    continue;
+                }
+            }
+            if (!head)
+            {
+                out += ',';
+            }
+            head = false;
+            write_value(out, value[i]);
+        }
+        out += ']';
+    }
+    else
+    {
+        put_key(out, first, f);
+        write_value(out, value);
+    }
+}
+
+template <typename T, size_t... I>
+void encode_fields(std::string &out, const T &obj, std::index_sequence<I...>)
+{
+    bool first = true;
+    (encode_field<T, I>(out, obj, first), ...);
+}
+
+/**
+ * @brief 编码对象
+ *
+ * @param out 输出
+ * @param obj 对象
+ */
+template <typename T>
+void encode_into(std::string &out, const T &obj)
+{
+    out += '{';
+    encode_fields(out, obj, std::make_index_sequence<field_count_v<T>>{});
+    out += '}';
+}
+
+/**
+ * @brief 释放标准库类型成员持有的内存，元素中的C字符串及结构体一并释放
+ *
+ * @param value 成员
+ */
+template <typename M>
+void clear_value(M &value)
+{
+    if constexpr (std::is_same_v<M, char *>)
+    {
+        cson_mem_free(value);
+        value = nullptr;
+    }
+    else if constexpr (std::is_pointer_v<M> && is_reflected_v<std::remove_pointer_t<M>>)
+    {
+        delete_object(value);
+        value = nullptr;
+    }
+    else if constexpr (std::is_same_v<M, std::string>)
+    {
+        std::string().swap(value);
+    }
+    else if constexpr (is_vector_v<M>)
+    {
+        if constexpr (!std::is_same_v<typename M::value_type, bool>)
+        {
+            for (auto &element : value)
+            {
+                clear_value(element);
+            }
+        }
+        M().swap(value);
+    }
+    else if constexpr (is_nullable_v<M>)
+    {
+        if (value)
+        {
+            clear_value(*value);
+        }
+        value.reset();
+    }
+    else if constexpr (is_reflected_v<M>)
+    {
+        clear_into(value);
+    }
+}
+
+/**
+ * @brief 释放一个字段持有的内存
+ *
+ * @param obj 对象
+ */
+template <typename T, size_t I>
+void clear_field(T &obj)
+{
+    constexpr const auto &f = std::get<I>(reflect<T>::fields);
+    using M = typename field_type<T, I>::member_type;
+    auto &value = obj.*(f.member);
+
+    if constexpr (std::is_same_v<M, char *>)
+    {
+        cson_mem_free(value);
+        value = nullptr;
+    }
+    else if constexpr (std::is_same_v<M, cson_vector_t>)
+    {
+        cson_vector_free(&value, f.model, f.model_size);
+    }
+    else if constexpr (std::is_pointer_v<M>)
+    {
+        if (!value)
+        {
+            return;
+        }
+        if (f.model || !is_reflected_v<std::remove_pointer_t<M>>)
+        {
+            if constexpr (std::is_same_v<M, cson_list_t *>)
+            {
+                free_list(value, f.model, f.model_size);
+            }
+            else
+            {
+                cson_free(value, f.model, f.model_size);
+            }
+        }
+        else if constexpr (is_reflected_v<std::remove_pointer_t<M>>)
+        {
+            delete_object(value);
+        }
+        value = nullptr;
+    }
+    else if constexpr (std::is_array_v<M>)
+    {
+        if constexpr (std::is_same_v<std::remove_extent_t<M>, char *>)
+        {
+            for (auto &str : value)
+            {
+                cson_mem_free(str);
+                str = nullptr;
+            }
+        }
+        else if constexpr (is_reflected_v<std::remove_extent_t<M>>)
+        {
+            for (auto &element : value)
+            {
+                clear_value(element);
+            }
+        }
+    }
+    else if constexpr (is_reflected_v<M> || is_vector_v<M> || is_nullable_v<M> || std::is_same_v<M, std::string>)
+    {
+        clear_value(value);
+    }
+}
+
+template <typename T, size_t... I>
+void clear_fields(T &obj, std::index_sequence<I...>)
+{
+    (clear_field<T, I>(obj), ...);
+}
+
+/**
+ * @brief 释放对象成员持有的内存
+ *
+ * @param obj 对象
+ */
+template <typename T>
+void clear_into(T &obj)
+{
+    clear_fields(obj, std::make_index_sequence<field_count_v<T>>{});
+}
+
+/**
+ * @brief 成员类型对应的C数据类型
+ *
+ * @return cson_type_t 数据类型，无对应类型时返回CSON_TYPE_OBJ
+ */
+template <typename M>
+constexpr cson_type_t c_type()
+{
+    if constexpr (std::is_same_v<M, bool>)
+    {
+        return CSON_TYPE_BOOL;
+    }
+    else if constexpr (std::is_integral_v<M> && sizeof(M) == sizeof(char))
+    {
+        return CSON_TYPE_CHAR;
+    }
+    else if constexpr (std::is_integral_v<M> && sizeof(M) == sizeof(short))
+    {
+        return CSON_TYPE_SHORT;
+    }
+    else if constexpr (std::is_integral_v<M> && sizeof(M) == sizeof(int))
+    {
+        return CSON_TYPE_INT;
+    }
+    else if constexpr (std::is_integral_v<M> && sizeof(M) == sizeof(long))
+    {
+        return CSON_TYPE_LONG;
+    }
+    else if constexpr (std::is_same_v<M, float>)
+    {
+        return CSON_TYPE_FLOAT;
+    }
+    else if constexpr (std::is_same_v<M, double>)
+    {
+        return CSON_TYPE_DOUBLE;
+    }
+    else if constexpr (std::is_same_v<M, char *>)
+    {
+        return CSON_TYPE_STRING;
+    }
+    else
+    {
+        return CSON_TYPE_OBJ;
+    }
+}
+
+template <typename T>
+cson_model_t *c_model_data();
+
+/**
+ * @brief 生成一个字段的C数据模型
+ *
+ * @param model 数据模型
+ */
+template <typename T, size_t I>
+void fill_model(cson_model_t &model)
+{
+    constexpr const auto &f = std::get<I>(reflect<T>::fields);
+    using M = typename field_type<T, I>::member_type;
+    T probe{};
+
+    model.key = const_cast<char *>(f.key);
+    model.offset = static_cast<short>(reinterpret_cast<const char *>(&(probe.*(f.member)))
+                                      - reinterpret_cast<const char *>(&probe));
+    if constexpr (std::is_same_v<M, char *>)
+    {
+        model.type = f.json ? CSON_TYPE_JSON : CSON_TYPE_STRING;
+    }
+    else if constexpr (std::is_same_v<M, cson_vector_t>)
+    {
+        model.type = CSON_TYPE_VECTOR;
+        model.param.sub.model = f.model;
+        model.param.sub.size = f.model_size;
+    }
+    else if constexpr (std::is_pointer_v<M>)
+    {
+        model.type = std::is_same_v<M, cson_list_t *> ? CSON_TYPE_LIST : CSON_TYPE_STRUCT;
+        if constexpr (is_reflected_v<std::remove_pointer_t<M>>)
+        {
+            if (!f.model)
+            {
+                model.param.sub.model = c_model_data<std::remove_pointer_t<M>>();
+                model.param.sub.size = static_cast<short>(field_count_v<std::remove_pointer_t<M>> + 1);
+                return;
+            }
+        }
+        model.param.sub.model = f.model;
+        model.param.sub.size = f.model_size;
+    }
+    else if constexpr (std::is_array_v<M> && is_reflected_v<std::remove_extent_t<M>>)
+    {
+        static_assert(std::rank_v<M> == 1, "array element has no C model equivalent");
+        model.type = CSON_TYPE_EMBED_ARRAY;
+        model.param.embeds.model = c_model_data<std::remove_extent_t<M>>();
+        model.param.embeds.size = static_cast<short>(field_count_v<std::remove_extent_t<M>> + 1);
+        model.param.embeds.capacity = static_cast<short>(std::extent_v<M>);
+        model.param.embeds.count = -1;
+    }
+    else if constexpr (std::is_array_v<M>)
+    {
+        static_assert(std::rank_v<M> == 1 && c_type<std::remove_extent_t<M>>() != CSON_TYPE_OBJ
+                          && c_type<std::remove_extent_t<M>>() != CSON_TYPE_BOOL,
+                      "array element has no C model equivalent");
+        if (std::is_same_v<std::remove_extent_t<M>, char> && f.chars)
+        {
+            model.type = CSON_TYPE_CHAR_ARRAY;
+            model.param.chars.size = static_cast<short>(std::extent_v<M>);
+            model.param.chars.policy = f.policy;
+            return;
+        }
+        model.type = CSON_TYPE_ARRAY;
+        model.param.array.ele_type = c_type<std::remove_extent_t<M>>();
+        model.param.array.size = static_cast<short>(std::extent_v<M>);
+    }
+    else if constexpr (is_reflected_v<M>)
+    {
+        model.type = CSON_TYPE_EMBED;
+        model.param.sub.model = c_model_data<M>();
+        model.param.sub.size = static_cast<short>(field_count_v<M> + 1);
+    }
+    else
+    {
+        static_assert(c_type<M>() != CSON_TYPE_OBJ, "member type has no C model equivalent");
+        model.type = c_type<M>();
+    }
+}
+
+template <typename T, size_t... I>
+void fill_models(cson_model_t *model, std::index_sequence<I...>)
+{
+    (fill_model<T, I>(model[I + 1]), ...);
+}
+
+/**
+ * @brief 生成C数据模型时使用的锁，允许自引用模型递归生成
+ *
+ * @return std::recursive_mutex& 锁
+ */
+inline std::recursive_mutex &model_mutex()
+{
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
+/**
+ * @brief C数据模型存储
+ *
+ */
+template <typename T>
+struct model_table
+{
+    static_assert(std::is_trivial_v<T> && std::is_standard_layout_v<T>,
+                  "C models require trivial standard-layout types");
+
+    inline static cson_model_t data[field_count_v<T> + 1];
+    inline static bool started = false;
+    inline static std::atomic<bool> ready{false};
+};
+
+/**
+ * @brief 获取C数据模型，首次调用时生成
+ *
+ * 生成过程中被递归引用时直接返回存储地址，子模型随后填充
+ *
+ * @return cson_model_t* 数据模型
+ */
+template <typename T>
+cson_model_t *c_model_data()
+{
+    using table = model_table<T>;
+    if (table::ready.load(std::memory_order_acquire))
+    {
+        return table::data;
+    }
+    std::lock_guard<std::recursive_mutex> lock(model_mutex());
+    if (!table::started)
+    {
+        table::started = true;
+        std::memset(table::data, 0, sizeof(table::data));
+        table::data[0].type = CSON_TYPE_OBJ;
+        table::data[0].param.obj_size = sizeof(T);
+        fill_models<T>(table::data, std::make_index_sequence<field_count_v<T>>{});
+        table::ready.store(true, std::memory_order_release);
+    }
+    return table::data;
+}
+
+} // namespace detail
+
+/**
+ * @brief 解析JSON对象
+ *
+ * @param json JSON对象
+ * @param obj 对象，先被重置为`T{}`；裸指针成员持有内存时需先调用`cson::clear`
+ * @return bool 是否得到对象，JSON为null时返回false
+ */
+template <typename T>
+bool decode(const cJSON *json, T &obj)
+{
+    obj = T{};
+    if (!json || (json->type & 0xFF) == cJSON_NULL)
+    {
+        return false;
+    }
+    detail::decode_into(json, obj);
+    return true;
+}
+
+/**
+ * @brief 解析JSON字符串
+ *
+ * @param json_str json字符串
+ * @param obj 对象
+ * @return bool 是否得到对象，解析失败或JSON为null时返回false
+ */
+template <typename T>
+bool decode(const char *json_str, T &obj)
+{
+    cJSON *json = cJSON_Parse(json_str);
+    bool ret = decode(json, obj);
+    cJSON_Delete(json);
+    return ret;
+}
+
+/**
+ * @brief 解析JSON字符串到新分配的对象
+ *
+ * @param json_str json字符串
+ * @return T* 对象，使用`cson::free`释放；平凡类型的内存布局与C模型一致，也可使用`cson_free`释放
+ */
+template <typename T>
+T *decode(const char *json_str)
+{
+    cJSON *json = cJSON_Parse(json_str);
+    T *obj = nullptr;
+
+    if (json && (json->type & 0xFF) != cJSON_NULL)
+    {
+        obj = detail::new_object<T>();
+        if (obj)
+        {
+            detail::decode_into(json, *obj);
+        }
+    }
+    cJSON_Delete(json);
+    return obj;
+}
+
+/**
+ * @brief 编码成json字符串
+ *
+ * @param obj 对象
+ * @return std::string json字符串，与`cson_encode_unformatted`输出一致
+ */
+template <typename T>
+std::string encode(const T &obj)
+{
+    std::string out;
+    out.reserve(256);
+    detail::encode_into(out, obj);
+    return out;
+}
+
+/**
+ * @brief 释放对象成员持有的内存，成员被置为NULL
+ *
+ * @param obj 对象
+ */
+template <typename T>
+void clear(T &obj)
+{
+    detail::clear_into(obj);
+}
+
+/**
+ * @brief 释放`cson::decode<T>`得到的对象
+ *
+ * @param obj 对象
+ */
+template <typename T>
+void free(T *obj)
+{
+    detail::delete_object(obj);
+}
+
+/**
+ * @brief `cson::free`删除器
+ *
+ */
+template <typename T>
+struct deleter
+{
+    void operator()(T *obj) const
+    {
+        cson::free(obj);
+    }
+};
+
+/**
+ * @brief 持有`cson::decode<T>`得到的对象，析构时释放对象及其成员
+ *
+ * @code
+ * cson::unique_ptr<user_t> user(cson::decode<user_t>(json_str));
+ * @endcode
+ */
+template <typename T>
+using unique_ptr = std::unique_ptr<T, deleter<T>>;
+
+/**
+ * @brief 由反射信息生成的C数据模型
+ *
+ * 生成的模型可用于`cson_decode`、`cson_msgpack_encode`等C接口，或被C模型的子结构体引用
+ *
+ * @return cson_model_t* 数据模型
+ */
+template <typename T>
+cson_model_t *c_model()
+{
+    return detail::c_model_data<T>();
+}
+
+/**
+ * @brief C数据模型数量
+ *
+ * @return int 数据模型数量
+ */
+template <typename T>
+constexpr int c_model_size()
+{
+    return static_cast<int>(detail::field_count_v<T> + 1);
+}
+
+} // namespace cson
+
+/**
+ * @brief 描述字段，键值与成员名相同
+ *
+ * @param type 结构体类型
+ * @param member 成员
+ */
+#define CSON_FIELD(type, member) \
+        ::cson::field(#member, &type::member)
+
+/**
+ * @brief 声明结构体的反射信息
+ *
+ * @param type 结构体类型
+ * @param ... 字段描述，见`CSON_FIELD`及`cson::field`
+ */
+#define CSON_REFLECT(type, ...) \
+        template <> \
+        struct cson::reflect<type> \
+        { \
+                static constexpr auto fields = std::make_tuple(__VA_ARGS__); \
+        }
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,1490 @@
+/**
+ * @file cson_cbor.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#include "cson_cbor.h"
+#include "cson_internal.h"
+#include "cJSON.h"
+#include "stddef.h"
+#include "string.h"
+#include "stdio.h"
+#include "limits.h"
+#include "ctype.h"
+#include "math.h"
+
+/**
+ * @brief CBOR值类型
+ *
+ */
+typedef enum
+{
+    CSON_CB_NULL = 0,
+    CSON_CB_BOOL,
+    CSON_CB_INT,
+    CSON_CB_FLOAT,
+    CSON_CB_BYTES,
+    CSON_CB_TEXT,
+    CSON_CB_ARRAY,
+    CSON_CB_MAP,
+    CSON_CB_SIMPLE,
+} cson_cb_kind_t;
+
+/**
+ * @brief CBOR值头部
+ *
+ */
+typedef struct
+{
+    cson_cb_kind_t kind;       /**< 值类型 */
+    long long i;               /**< 整型值/布尔值 */
+    double d;                  /**< 浮点值 */
+    size_t size;               /**< 字符串长度/数组及map成员数量 */
+    const unsigned char *ptr;  /**< 定长字符串数据 */
+    unsigned char indefinite;  /**< 是否为不定长 */
+} cson_cb_value_t;
+
+/**
+ * @brief 编码输出
+ *
+ */
+typedef struct
+{
+    unsigned char *buf;      /**< 缓冲 */
+    size_t len;              /**< 缓冲中的数据长度 */
+    size_t cap;              /**< 缓冲容量 */
+    cson_cbor_write_t write; /**< 流式输出函数，为NULL时缓冲按需扩容 */
+    void *user;              /**< 输出函数用户数据 */
+    int flags;               /**< 编码选项 */
+    signed char error;       /**< 是否出错 */
+} cson_cb_writer_t;
+
+/**
+ * @brief 解码游标
+ *
+ */
+typedef struct
+{
+    const unsigned char *data; /**< 数据 */
+    size_t len;                /**< 数据长度 */
+    size_t pos;                /**< 当前位置 */
+    signed char error;         /**< 是否出错 */
+} cson_cb_reader_t;
+
+/**
+ * @brief 输出缓冲中的数据
+ *
+ * @param w 编码输出
+ */
+static void _cson_cb_flush(cson_cb_writer_t *w)
+{
+    if (w->write && w->len && !w->error)
+    {
+        if (w->write(w->user, w->buf, w->len) != 0)
+        {
+            w->error = 1;
+        }
+        w->len = 0;
+    }
+}
+
+/**
+ * @brief 写入数据
+ *
+ * @param w 编码输出
+ * @param data 数据
+ * @param n 数据长度
+ */
+static void _cson_cb_put(cson_cb_writer_t *w, const void *data, size_t n)
+{
+    const unsigned char *src = data;
+    size_t k;
+
+    while (n && !w->error)
+    {
+        if (w->len == w->cap)
+        {
+            if (w->write)
+            {
+                _cson_cb_flush(w);
+                continue;
+            }
+            size_t cap = w->cap ? w->cap * 2 : CSON_CBOR_STREAM_BUFFER;
+            unsigned char *p;
+            while (cap < w->len + n)
+            {
+                cap *= 2;
+            }
+            p = cson_mem_alloc(cap);
+            if (!p)
+            {
+                w->error = 1;
+                return;
+            }
+            if (w->buf)
+            {
+                memcpy(p, w->buf, w->len);
+                cson_mem_free(w->buf);
+            }
+            w->buf = p;
+            w->cap = cap;
+        }
+        k = w->cap - w->len < n ? w->cap - w->len : n;
+        memcpy(w->buf + w->len, src, k);
+        w->len += k;
+        src += k;
+        n -= k;
+    }
+}
+
+/**
+ * @brief 写入初始字节及参数
+ *
+ * @param w 编码输出
+ * @param major 主类型
+ * @param arg 参数
+ */
+static void _cson_cb_write_head(cson_cb_writer_t *w, unsigned char major, unsigned long long arg)
+{
+    unsigned char head[9];
+    int bytes;
+
+    if (arg < 24)
+    {
+        head[0] = (unsigned char)((major << 5) | arg);
+        _cson_cb_put(w, head, 1);
+        return;
+    }
+    bytes = arg <= 0xff ? 1 : (arg <= 0xffff ? 2 : (arg <= 0xffffffffULL ? 4 : 8));
+    head[0] = (unsigned char)((major << 5) | (bytes == 1 ? 24 : (bytes == 2 ? 25 : (bytes == 4 ? 26 : 27))));
+    for (int i = bytes; i > 0; i--)
+    {
+        head[i] = (unsigned char)arg;
+        arg >>= 8;
+    }
+    _cson_cb_put(w, head, 1 + bytes);
+}
+
+/**
+ * @brief 写入简单值
+ *
+ * @param w 编码输出
+ * @param value 简单值(0xf4 false，0xf5 true，0xf6 null，0xff break)
+ */
+static void _cson_cb_write_byte(cson_cb_writer_t *w, unsigned char value)
+{
+    _cson_cb_put(w, &value, 1);
+}
+
+/**
+ * @brief 写入整型
+ *
+ * @param w 编码输出
+ * @param value 整型值
+ */
+static void _cson_cb_write_int(cson_cb_writer_t *w, long long value)
+{
+    if (value >= 0)
+    {
+        _cson_cb_write_head(w, 0, (unsigned long long)value);
+    }
+    else
+    {
+        _cson_cb_write_head(w, 1, (unsigned long long)(-(value + 1)));
+    }
+}
+
+/**
+ * @brief 写入单精度浮点
+ *
+ * @param w 编码输出
+ * @param value 浮点值
+ */
+static void _cson_cb_write_float(cson_cb_writer_t *w, float value)
+{
+    unsigned char head[5] = {0xfa};
+    unsigned int bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 4; i > 0; i--)
+    {
+        head[i] = (unsigned char)bits;
+        bits >>= 8;
+    }
+    _cson_cb_put(w, head, sizeof(head));
+}
+
+/**
+ * @brief 写入双精度浮点
+ *
+ * @param w 编码输出
+ * @param value 浮点值
+ */
+static void _cson_cb_write_double(cson_cb_writer_t *w, double value)
+{
+    unsigned char head[9] = {0xfb};
+    unsigned long long bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 8; i > 0; i--)
+    {
+        head[i] = (unsigned char)bits;
+        bits >>= 8;
+    }
+    _cson_cb_put(w, head, sizeof(head));
+}
+
+/**
+ * @brief 写入文本字符串
+ *
+ * @param w 编码输出
+ * @param str 字符串
+ */
+static void _cson_cb_write_text(cson_cb_writer_t *w, const char *str)
+{
+    size_t len = strlen(str);
+    _cson_cb_write_head(w, 3, len);
+    _cson_cb_put(w, str, len);
+}
+
+/**
+ * @brief cJSON对象编码成CBOR
+ *
+ * @param w 编码输出
+ * @param item cJSON对象
+ */
+static void _cson_cb_write_cjson(cson_cb_writer_t *w, cJSON *item)
+{
+    cJSON *child;
+
+    switch (item->type & 0xFF)
+    {
+    case cJSON_False:
+        _cson_cb_write_byte(w, 0xf4);
+        break;
+    case cJSON_True:
+        _cson_cb_write_byte(w, 0xf5);
+        break;
+    case cJSON_Number:
+        if (item->valuedouble >= -9.2e18 && item->valuedouble <= 9.2e18
+            && item->valuedouble == (double)(long long)item->valuedouble)
+        {
+            _cson_cb_write_int(w, (long long)item->valuedouble);
+        }
+        else
+        {
+            _cson_cb_write_double(w, item->valuedouble);
+        }
+        break;
+    case cJSON_String:
+    case cJSON_Raw:
+        _cson_cb_write_text(w, item->valuestring ? item->valuestring : "");
+        break;
+    case cJSON_Array:
+    case cJSON_Object:
+        _cson_cb_write_head(w, (item->type & 0xFF) == cJSON_Object ? 5 : 4, (size_t)cJSON_GetArraySize(item));
+        for (child = item->child; child; child = child->next)
+        {
+            if ((item->type & 0xFF) == cJSON_Object)
+            {
+                _cson_cb_write_text(w, child->string ? child->string : "");
+            }
+            _cson_cb_write_cjson(w, child);
+        }
+        break;
+    default:
+        _cson_cb_write_byte(w, 0xf6);
+        break;
+    }
+}
+
+/**
+ * @brief 基础类型编码成CBOR
+ *
+ * @param w 编码输出
+ * @param type 数据类型
+ * @param addr 数据地址
+ */
+static void _cson_cb_write_scalar(cson_cb_writer_t *w, cson_type_t type, void *addr)
+{
+    cJSON *json;
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+        _cson_cb_write_int(w, *(char *)addr);
+        break;
+    case CSON_TYPE_SHORT:
+        _cson_cb_write_int(w, *(short *)addr);
+        break;
+    case CSON_TYPE_INT:
+        _cson_cb_write_int(w, *(int *)addr);
+        break;
+    case CSON_TYPE_LONG:
+        _cson_cb_write_int(w, *(long *)addr);
+        break;
+    case CSON_TYPE_FLOAT:
+        _cson_cb_write_float(w, *(float *)addr);
+        break;
+    case CSON_TYPE_DOUBLE:
+        _cson_cb_write_double(w, *(double *)addr);
+        break;
+    case CSON_TYPE_BOOL:
+        _cson_cb_write_byte(w, *(char *)addr ? 0xf5 : 0xf4);
+        break;
+    case CSON_TYPE_STRING:
+        if (*(char **)addr)
+            _cson_cb_write_text(w, *(char **)addr);
+        else
+            _cson_cb_write_byte(w, 0xf6);
+        break;
+    case CSON_TYPE_JSON:
+        json = *(char **)addr ? cJSON_Parse(*(char **)addr) : NULL;
+        if (json)
+        {
+            _cson_cb_write_cjson(w, json);
+            cJSON_Delete(json);
+        }
+        else
+        {
+            _cson_cb_write_byte(w, 0xf6);
+        }
+        break;
+    default:
+        _cson_cb_write_byte(w, 0xf6);
+        break;
+    }
+}
+
+static void _cson_cb_write_object(cson_cb_writer_t *w, void *obj, cson_model_t *model, int model_size);
+
+/**
+ * @brief CsonList编码成CBOR数组
+ *
+ * @param w 编码输出
+ * @param list 链表
+ * @param model 链表元素模型
+ * @param model_size 链表元素模型数量
+ */
+static void _cson_cb_write_list(cson_cb_writer_t *w, cson_list_t *list, cson_model_t *model, int model_size)
+{
+    char basic = cson_model_is_basic(model);
+    size_t count = 0;
+    cson_list_t *p;
+
+    if (w->flags & CSON_CBOR_INDEFINITE)
+    {
+        _cson_cb_write_byte(w, 0x9f);
+    }
+    else
+    {
+        for (p = list; p; p = p->next)
+        {
+            if (basic || p->obj)
+            {
+                count++;
+            }
+        }
+        _cson_cb_write_head(w, 4, count);
+    }
+    for (p = list; p && !w->error; p = p->next)
+    {
+        if (basic)
+        {
+            _cson_cb_write_scalar(w, model[1].type, &p->obj);
+        }
+        else if (p->obj)
+        {
+            _cson_cb_write_object(w, p->obj, model, model_size);
+        }
+    }
+    if (w->flags & CSON_CBOR_INDEFINITE)
+    {
+        _cson_cb_write_byte(w, 0xff);
+    }
+}
+
+/**
+ * @brief 侵入式链表编码成CBOR数组
+ *
+ * @param w 编码输出
+ * @param head 首元素
+ * @param field 字段模型
+ */
+static void _cson_cb_write_ilist(cson_cb_writer_t *w, void *head, cson_model_t *field)
+{
+    size_t count = 0;
+    void *p;
+
+    if (w->flags & CSON_CBOR_INDEFINITE)
+    {
+        _cson_cb_write_byte(w, 0x9f);
+    }
+    else
+    {
+        for (p = head; p; p = *(void **)((size_t)p + field->param.ilist.next))
+        {
+            count++;
+        }
+        _cson_cb_write_head(w, 4, count);
+    }
+    for (p = head; p && !w->error; p = *(void **)((size_t)p + field->param.ilist.next))
+    {
+        _cson_cb_write_object(w, p, field->param.ilist.model, field->param.ilist.size);
+    }
+    if (w->flags & CSON_CBOR_INDEFINITE)
+    {
+        _cson_cb_write_byte(w, 0xff);
+    }
+}
+
+/**
+ * @brief vector编码成CBOR数组
+ *
+ * @param w 编码输出
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ */
+static void _cson_cb_write_vector(cson_cb_writer_t *w, cson_vector_t *vec, cson_model_t *model, int model_size)
+{
+    size_t ele_size = cson_model_obj_size(model, model_size);
+    void *ele;
+
+    _cson_cb_write_head(w, 4, vec->count);
+    for (size_t i = 0; i < vec->count && !w->error; i++)
+    {
+        ele = (void *)((size_t)vec->data + i * ele_size);
+        if (cson_model_is_basic(model))
+        {
+            _cson_cb_write_scalar(w, model[1].type, ele);
+        }
+        else
+        {
+            _cson_cb_write_object(w, ele, model, model_size);
+        }
+    }
+}
+
+/**
+ * @brief 对象编码成CBOR map
+ *
+ * @param w 编码输出
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ */
+static void _cson_cb_write_object(cson_cb_writer_t *w, void *obj, cson_model_t *model, int model_size)
+{
+    size_t count = 0;
+    size_t ele_size;
+    size_t len;
+    void *addr;
+    char *end;
+
+    if (!obj)
+    {
+        _cson_cb_write_byte(w, 0xf6);
+        return;
+    }
+    for (short i = 0; i < model_size; i++)
+    {
+        if (model[i].type != CSON_TYPE_OBJ && model[i].key)
+        {
+            count++;
+        }
+    }
+    _cson_cb_write_head(w, 5, count);
+    for (short i = 0; i < model_size && !w->error; i++)
+    {
+        if (model[i].type == CSON_TYPE_OBJ || !model[i].key)
+        {
+            continue;
+        }
+        _cson_cb_write_text(w, model[i].key);
+        addr = (void *)((size_t)obj + model[i].offset);
+        switch (model[i].type)
+        {
+        case CSON_TYPE_STRUCT:
+            _cson_cb_write_object(w, *(void **)addr, model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_LIST:
+            if (*(cson_list_t **)addr)
+                _cson_cb_write_list(w, *(cson_list_t **)addr, model[i].param.sub.model, model[i].param.sub.size);
+            else
+                _cson_cb_write_byte(w, 0xf6);
+            break;
+        case CSON_TYPE_VECTOR:
+            _cson_cb_write_vector(w, (cson_vector_t *)addr, model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_ILIST:
+            if (*(void **)addr)
+                _cson_cb_write_ilist(w, *(void **)addr, &model[i]);
+            else
+                _cson_cb_write_byte(w, 0xf6);
+            break;
+        case CSON_TYPE_EMBED:
+            _cson_cb_write_object(w, addr, model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_EMBED_ARRAY:
+            ele_size = cson_model_obj_size(model[i].param.embeds.model, model[i].param.embeds.size);
+            count = (size_t)cson_embeds_count(obj, &model[i]);
+            _cson_cb_write_head(w, 4, count);
+            for (size_t j = 0; j < count; j++)
+            {
+                _cson_cb_write_object(w, (void *)((size_t)addr + j * ele_size), model[i].param.embeds.model,
+                                      model[i].param.embeds.size);
+            }
+            break;
+        case CSON_TYPE_CHAR_ARRAY:
+            end = memchr(addr, 0, model[i].param.chars.size);
+            len = end ? (size_t)(end - (char *)addr) : (size_t)model[i].param.chars.size;
+            _cson_cb_write_head(w, 3, len);
+            _cson_cb_put(w, addr, len);
+            break;
+        case CSON_TYPE_ARRAY:
+            ele_size = cson_model_type_size(model[i].param.array.ele_type);
+            _cson_cb_write_head(w, 4, model[i].param.array.size);
+            for (short j = 0; j < model[i].param.array.size; j++)
+            {
+                _cson_cb_write_scalar(w, model[i].param.array.ele_type, (void *)((size_t)addr + j * ele_size));
+            }
+            break;
+        default:
+            _cson_cb_write_scalar(w, model[i].type, addr);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 编码成CBOR
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param len 编码长度
+ * @param flags 编码选项，见`CSON_CBOR_INDEFINITE`
+ * @return unsigned char* 编码得到的数据，使用`cson_cbor_free`释放
+ */
+unsigned char *cson_cbor_encode(void *obj, cson_model_t *model, int model_size, size_t *len, int flags)
+{
+    cson_cb_writer_t w = {NULL, 0, 0, NULL, NULL, flags, 0};
+
+    CSON_STATS_ENTER(model);
+    _cson_cb_write_object(&w, obj, model, model_size);
+    if (w.error)
+    {
+        cson_mem_free(w.buf);
+        CSON_STATS_LEAVE();
+        return NULL;
+    }
+    CSON_STATS_LEAVE();
+    if (len)
+    {
+        *len = w.len;
+    }
+    return w.buf;
+}
+
+/**
+ * @brief 流式编码成CBOR
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param write 输出函数
+ * @param user 传给输出函数的用户数据
+ * @param flags 编码选项，见`CSON_CBOR_INDEFINITE`
+ * @return int 0成功，-1失败
+ */
+int cson_cbor_encode_stream(void *obj, cson_model_t *model, int model_size,
+                            cson_cbor_write_t write, void *user, int flags)
+{
+    unsigned char buf[CSON_CBOR_STREAM_BUFFER];
+    cson_cb_writer_t w = {buf, 0, sizeof(buf), write, user, flags, 0};
+
+    CSON_ASSERT(write, return -1);
+    _cson_cb_write_object(&w, obj, model, model_size);
+    _cson_cb_flush(&w);
+    return w.error ? -1 : 0;
+}
+
+/**
+ * @brief 释放编码生成的数据
+ *
+ * @param data 数据
+ */
+void cson_cbor_free(unsigned char *data)
+{
+    cson_mem_free(data);
+}
+
+/**
+ * @brief 半精度浮点转换为双精度
+ *
+ * @param half 半精度浮点
+ * @return double 浮点值
+ */
+static double _cson_cb_half(unsigned int half)
+{
+    int exp = (half >> 10) & 0x1f;
+    int mant = half & 0x3ff;
+    double value;
+
+    if (exp == 0)
+    {
+        value = mant / 16777216.0;
+    }
+    else if (exp != 31)
+    {
+        value = (mant + 1024) / 1024.0;
+        for (; exp > 15; exp--)
+            value *= 2;
+        for (; exp < 15; exp++)
+            value /= 2;
+    }
+    else
+    {
+        value = mant == 0 ? INFINITY : NAN;
+    }
+    return (half & 0x8000) ? -value : value;
+}
+
+/**
+ * @brief 读取值头部，定长字符串数据一并跳过，容器成员及分段字符串不读取
+ *
+ * @param r 解码游标
+ * @param v 值头部
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_cb_read(cson_cb_reader_t *r, cson_cb_value_t *v)
+{
+    unsigned char head, major, info;
+    unsigned long long arg;
+    float f;
+
+    memset(v, 0, sizeof(cson_cb_value_t));
+    do
+    {
+        if (r->error || r->pos >= r->len)
+        {
+            r->error = 1;
+            return -1;
+        }
+        head = r->data[r->pos++];
+        major = head >> 5;
+        info = head & 0x1f;
+        arg = info;
+        if (info >= 24 && info <= 27)
+        {
+            int bytes = 1 << (info - 24);
+            if (r->len - r->pos < (size_t)bytes)
+            {
+                r->error = 1;
+                return -1;
+            }
+            for (arg = 0; bytes > 0; bytes--)
+            {
+                arg = (arg << 8) | r->data[r->pos++];
+            }
+        }
+        else if (info == 31)
+        {
+            if (major < 2 || major == 6 || major == 7)
+            {
+                r->error = 1;
+                return -1;
+            }
+            v->indefinite = 1;
+        }
+        else if (info > 27)
+        {
+            r->error = 1;
+            return -1;
+        }
+    } while (major == 6);
+
+    switch (major)
+    {
+    case 0:
+        v->kind = CSON_CB_INT;
+        v->i = arg > (unsigned long long)LLONG_MAX ? LLONG_MAX : (long long)arg;
+        v->d = (double)arg;
+        break;
+    case 1:
+        v->kind = CSON_CB_INT;
+        v->i = arg > (unsigned long long)LLONG_MAX ? LLONG_MIN : -1 - (long long)arg;
+        v->d = -1.0 - (double)arg;
+        break;
+    case 2:
+    case 3:
+        v->kind = major == 2 ? CSON_CB_BYTES : CSON_CB_TEXT;
+        if (!v->indefinite)
+        {
+            if (r->len - r->pos < arg)
+            {
+                r->error = 1;
+                return -1;
+            }
+            v->size = (size_t)arg;
+            v->ptr = r->data + r->pos;
+            r->pos += (size_t)arg;
+        }
+        break;
+    case 4:
+    case 5:
+        v->kind = major == 4 ? CSON_CB_ARRAY : CSON_CB_MAP;
+        v->size = v->indefinite ? 0 : (size_t)arg;
+        break;
+    default:
+        switch (info)
+        {
+        case 20:
+        case 21:
+            v->kind = CSON_CB_BOOL;
+            v->i = info == 21;
+            break;
+        case 22:
+        case 23:
+            v->kind = CSON_CB_NULL;
+            break;
+        case 25:
+            v->kind = CSON_CB_FLOAT;
+            v->d = _cson_cb_half((unsigned int)arg);
+            break;
+        case 26:
+            v->kind = CSON_CB_FLOAT;
+            {
+                unsigned int bits = (unsigned int)arg;
+                memcpy(&f, &bits, sizeof(f));
+            }
+            v->d = f;
+            break;
+        case 27:
+            v->kind = CSON_CB_FLOAT;
+            memcpy(&v->d, &arg, sizeof(double));
+            break;
+        default:
+            v->kind = CSON_CB_SIMPLE;
+            break;
+        }
+        break;
+    }
+    return 0;
+}
+
+/**
+ * @brief 容器/分段字符串是否还有下一个成员
+ *
+ * @param r 解码游标
+ * @param v 容器头部
+ * @param index 已读取的成员数量
+ * @return char 是否还有成员
+ */
+static char _cson_cb_next(cson_cb_reader_t *r, cson_cb_value_t *v, size_t index)
+{
+    if (r->error)
+    {
+        return 0;
+    }
+    if (!v->indefinite)
+    {
+        return index < v->size;
+    }
+    if (r->pos >= r->len)
+    {
+        r->error = 1;
+        return 0;
+    }
+    if (r->data[r->pos] == 0xff)
+    {
+        r->pos++;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief 跳过已读取头部的值的剩余部分
+ *
+ * @param r 解码游标
+ * @param v 值头部
+ * @param depth 嵌套深度
+ */
+static void _cson_cb_skip(cson_cb_reader_t *r, cson_cb_value_t *v, int depth)
+{
+    cson_cb_value_t item;
+
+    if (depth > CSON_CBOR_DEPTH_MAX)
+    {
+        r->error = 1;
+        return;
+    }
+    switch (v->kind)
+    {
+    case CSON_CB_BYTES:
+    case CSON_CB_TEXT:
+        for (size_t i = 0; v->indefinite && _cson_cb_next(r, v, i); i++)
+        {
+            if (_cson_cb_read(r, &item) != 0 || item.kind != v->kind || item.indefinite)
+            {
+                r->error = 1;
+            }
+        }
+        break;
+    case CSON_CB_ARRAY:
+    case CSON_CB_MAP:
+        for (size_t i = 0; _cson_cb_next(r, v, i); i++)
+        {
+            for (int k = v->kind == CSON_CB_MAP ? 2 : 1; k > 0 && !r->error; k--)
+            {
+                if (_cson_cb_read(r, &item) == 0)
+                {
+                    _cson_cb_skip(r, &item, depth + 1);
+                }
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 复制文本字符串，分段字符串合并为一个
+ *
+ * @param r 解码游标
+ * @param v 值头部
+ * @return char* 新字符串
+ */
+static char *_cson_cb_text(cson_cb_reader_t *r, cson_cb_value_t *v)
+{
+    cson_cb_value_t chunk;
+    size_t start = r->pos;
+    size_t total = 0;
+    char *str;
+
+    if (v->indefinite)
+    {
+        for (size_t i = 0; _cson_cb_next(r, v, i); i++)
+        {
+            if (_cson_cb_read(r, &chunk) != 0 || chunk.kind != v->kind || chunk.indefinite)
+            {
+                r->error = 1;
+                return NULL;
+            }
+            total += chunk.size;
+        }
+    }
+    else
+    {
+        total = v->size;
+    }
+    if (r->error)
+    {
+        return NULL;
+    }
+    str = cson_mem_alloc(total + 1);
+    if (!str)
+    {
+        r->error = 1;
+        return NULL;
+    }
+    if (!v->indefinite)
+    {
+        if (total)
+        {
+            memcpy(str, v->ptr, total);
+        }
+    }
+    else
+    {
+        size_t end = r->pos;
+        total = 0;
+        r->pos = start;
+        while (r->pos < end && r->data[r->pos] != 0xff)
+        {
+            _cson_cb_read(r, &chunk);
+            if (chunk.size)
+            {
+                memcpy(str + total, chunk.ptr, chunk.size);
+            }
+            total += chunk.size;
+        }
+        r->pos = end;
+    }
+    str[total] = 0;
+    return str;
+}
+
+/**
+ * @brief CBOR值解码成cJSON对象
+ *
+ * @param r 解码游标
+ * @param v 值头部
+ * @param depth 嵌套深度
+ * @return cJSON* cJSON对象
+ */
+static cJSON *_cson_cb_read_cjson(cson_cb_reader_t *r, cson_cb_value_t *v, int depth)
+{
+    cson_cb_value_t key, item;
+    cJSON *json, *child;
+    char *str;
+
+    if (depth > CSON_CBOR_DEPTH_MAX)
+    {
+        r->error = 1;
+        return NULL;
+    }
+    switch (v->kind)
+    {
+    case CSON_CB_BOOL:
+        return cJSON_CreateBool((cJSON_bool)v->i);
+    case CSON_CB_INT:
+    case CSON_CB_FLOAT:
+        return cJSON_CreateNumber(v->d);
+    case CSON_CB_TEXT:
+        str = _cson_cb_text(r, v);
+        json = str ? cJSON_CreateString(str) : NULL;
+        cson_mem_free(str);
+        return json;
+    case CSON_CB_ARRAY:
+    case CSON_CB_MAP:
+        json = v->kind == CSON_CB_MAP ? cJSON_CreateObject() : cJSON_CreateArray();
+        for (size_t i = 0; json && _cson_cb_next(r, v, i); i++)
+        {
+            str = NULL;
+            if (v->kind == CSON_CB_MAP)
+            {
+                if (_cson_cb_read(r, &key) != 0)
+                {
+                    break;
+                }
+                if (key.kind != CSON_CB_TEXT)
+                {
+                    _cson_cb_skip(r, &key, depth + 1);
+                    if (_cson_cb_read(r, &item) == 0)
+                    {
+                        _cson_cb_skip(r, &item, depth + 1);
+                    }
+                    continue;
+                }
+                str = _cson_cb_text(r, &key);
+            }
+            if (_cson_cb_read(r, &item) != 0)
+            {
+                cson_mem_free(str);
+                break;
+            }
+            child = _cson_cb_read_cjson(r, &item, depth + 1);
+            if (!child)
+            {
+                r->error = 1;
+            }
+            else if (v->kind == CSON_CB_MAP)
+            {
+                cJSON_AddItemToObject(json, str ? str : "", child);
+            }
+            else
+            {
+                cJSON_AddItemToArray(json, child);
+            }
+            cson_mem_free(str);
+        }
+        return json;
+    default:
+        _cson_cb_skip(r, v, depth);
+        return cJSON_CreateNull();
+    }
+}
+
+/**
+ * @brief 将值写入基础类型地址
+ *
+ * @param r 解码游标
+ * @param type 数据类型
+ * @param addr 写入地址
+ * @param v 值头部
+ * @param depth 嵌套深度
+ */
+static void _cson_cb_store(cson_cb_reader_t *r, cson_type_t type, void *addr, cson_cb_value_t *v, int depth)
+{
+    char number = v->kind == CSON_CB_INT || v->kind == CSON_CB_FLOAT;
+    cJSON *json;
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+    case CSON_TYPE_SHORT:
+    case CSON_TYPE_INT:
+    case CSON_TYPE_LONG:
+    case CSON_TYPE_FLOAT:
+    case CSON_TYPE_DOUBLE:
+        if (number)
+            cson_model_store_number(type, addr, v->kind == CSON_CB_INT ? v->i : cson_number_integer(v->d), v->d);
+        else
+            cson_model_store_number(type, addr, 0, 0.0);
+        break;
+    case CSON_TYPE_BOOL:
+        *(char *)addr = v->kind == CSON_CB_BOOL ? (char)v->i : 0;
+        break;
+    case CSON_TYPE_STRING:
+        if (v->kind == CSON_CB_TEXT && !*(char **)addr)
+        {
+            *(char **)addr = _cson_cb_text(r, v);
+            return;
+        }
+        break;
+    case CSON_TYPE_JSON:
+        if (v->kind != CSON_CB_NULL && !*(char **)addr)
+        {
+            json = _cson_cb_read_cjson(r, v, depth);
+            *(char **)addr = json ? cJSON_PrintUnformatted(json) : NULL;
+            cJSON_Delete(json);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    _cson_cb_skip(r, v, depth);
+}
+
+/**
+ * @brief 查找键值对应的字段
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param hint 优先尝试的字段
+ * @param key 键值
+ * @param key_len 键值长度
+ * @return int 字段下标，-1表示无对应字段
+ */
+static int _cson_cb_field(cson_model_t *model, int model_size, int hint, const unsigned char *key, size_t key_len)
+{
+    const unsigned char *a;
+    size_t n;
+
+    for (int k = 0; k < model_size; k++)
+    {
+        int i = (hint + k) % model_size;
+        if (model[i].type == CSON_TYPE_OBJ || !model[i].key)
+        {
+            continue;
+        }
+        a = (const unsigned char *)model[i].key;
+        for (n = 0; n < key_len && a[n] && tolower(a[n]) == tolower(key[n]); n++)
+        {
+        }
+        if (n == key_len && !a[n])
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void _cson_cb_read_object(cson_cb_reader_t *r, cson_cb_value_t *v, cson_model_t *model, int model_size,
+                                 void *obj, int depth);
+
+/**
+ * @brief 解码链表
+ *
+ * @param r 解码游标
+ * @param v 数组头部
+ * @param field 字段模型
+ * @param addr 字段地址
+ * @param depth 嵌套深度
+ */
+static void _cson_cb_read_list(cson_cb_reader_t *r, cson_cb_value_t *v, cson_model_t *field, void *addr, int depth)
+{
+    cson_model_t *model = field->param.sub.model;
+    char basic = cson_model_is_basic(model);
+    cson_list_t **tail = (cson_list_t **)addr;
+    cson_list_t *node;
+    cson_cb_value_t item;
+    void *obj;
+
+    while (*tail)
+    {
+        tail = &(*tail)->next;
+    }
+    for (size_t i = 0; _cson_cb_next(r, v, i); i++)
+    {
+        if (_cson_cb_read(r, &item) != 0)
+        {
+            break;
+        }
+        obj = NULL;
+        if (!basic)
+        {
+            if (item.kind != CSON_CB_MAP)
+            {
+                _cson_cb_skip(r, &item, depth + 1);
+                continue;
+            }
+            obj = cson_model_new_obj(model, field->param.sub.size);
+            if (!obj)
+            {
+                r->error = 1;
+                break;
+            }
+        }
+        node = cson_mem_alloc(sizeof(cson_list_t));
+        if (!node)
+        {
+            cson_mem_free(obj);
+            r->error = 1;
+            break;
+        }
+        memset(node, 0, sizeof(cson_list_t));
+        *tail = node;
+        tail = &node->next;
+        if (basic)
+        {
+            _cson_cb_store(r, model[1].type, &node->obj, &item, depth + 1);
+        }
+        else
+        {
+            node->obj = obj;
+            _cson_cb_read_object(r, &item, model, field->param.sub.size, obj, depth + 1);
+        }
+    }
+}
+
+/**
+ * @brief 解码侵入式链表，追加到已有元素之后
+ *
+ * @param r 解码游标
+ * @param v 数组头部
+ * @param field 字段模型
+ * @param addr 字段地址
+ * @param depth 嵌套深度
+ */
+static void _cson_cb_read_ilist(cson_cb_reader_t *r, cson_cb_value_t *v, cson_model_t *field, void *addr, int depth)
+{
+    void **tail = (void **)addr;
+    cson_cb_value_t item;
+    void *obj;
+
+    while (*tail)
+    {
+        tail = (void **)((size_t)*tail + field->param.ilist.next);
+    }
+    for (size_t i = 0; _cson_cb_next(r, v, i); i++)
+    {
+        if (_cson_cb_read(r, &item) != 0)
+        {
+            break;
+        }
+        if (item.kind != CSON_CB_MAP)
+        {
+            _cson_cb_skip(r, &item, depth + 1);
+            continue;
+        }
+        obj = cson_model_new_obj(field->param.ilist.model, field->param.ilist.size);
+        if (!obj)
+        {
+            r->error = 1;
+            break;
+        }
+        *tail = obj;
+        tail = (void **)((size_t)obj + field->param.ilist.next);
+        _cson_cb_read_object(r, &item, field->param.ilist.model, field->param.ilist.size, obj, depth + 1);
+    }
+}
+
+/**
+ * @brief 解码vector，定长数组按长度一次分配，不定长数组按倍数扩容
+ *
+ * @param r 解码游标
+ * @param v 数组头部
+ * @param field 字段模型
+ * @param vec vector
+ * @param depth 嵌套深度
+ */
+static void _cson_cb_read_vector(cson_cb_reader_t *r, cson_cb_value_t *v, cson_model_t *field, cson_vector_t *vec,
+                                 int depth)
+{
+    cson_model_t *model = field->param.sub.model;
+    cson_cb_value_t item;
+    void *ele;
+
+    if (!v->indefinite
+        && (v->size > r->len - r->pos || cson_vector_reserve(vec, model, field->param.sub.size, v->size) != 0))
+    {
+        r->error = 1;
+        return;
+    }
+    for (size_t i = 0; _cson_cb_next(r, v, i); i++)
+    {
+        if (_cson_cb_read(r, &item) != 0)
+        {
+            break;
+        }
+        ele = cson_vector_push(vec, model, field->param.sub.size);
+        if (!ele)
+        {
+            r->error = 1;
+            break;
+        }
+        if (cson_model_is_basic(model))
+        {
+            _cson_cb_store(r, model[1].type, ele, &item, depth + 1);
+        }
+        else if (item.kind == CSON_CB_MAP)
+        {
+            _cson_cb_read_object(r, &item, model, field->param.sub.size, ele, depth + 1);
+        }
+        else
+        {
+            _cson_cb_skip(r, &item, depth + 1);
+        }
+    }
+}
+
+/**
+ * @brief 解码文本字符串到定长字符数组
+ *
+ * @param r 解码游标
+ * @param v 值头部
+ * @param field 字段模型
+ * @param dest 字符数组
+ */
+static void _cson_cb_read_chars(cson_cb_reader_t *r, cson_cb_value_t *v, cson_model_t *field, char *dest)
+{
+    char *str;
+
+    if (!v->indefinite)
+    {
+        cson_chars_assign(dest, field, (const char *)v->ptr, v->size);
+        return;
+    }
+    str = _cson_cb_text(r, v);
+    if (str)
+    {
+        cson_chars_assign(dest, field, str, strlen(str));
+        cson_mem_free(str);
+    }
+}
+
+/**
+ * @brief 解码字段
+ *
+ * @param r 解码游标
+ * @param field 字段模型
+ * @param addr 字段地址
+ * @param depth 嵌套深度
+ */
+static void _cson_cb_read_field(cson_cb_reader_t *r, cson_model_t *field, void *addr, int depth)
+{
+    cson_cb_value_t v, item;
+    size_t ele_size;
+
+    if (_cson_cb_read(r, &v) != 0)
+    {
+        return;
+    }
+    switch (field->type)
+    {
+    case CSON_TYPE_STRUCT:
+        if (v.kind == CSON_CB_MAP && !*(void **)addr)
+        {
+            *(void **)addr = cson_model_new_obj(field->param.sub.model, field->param.sub.size);
+            if (!*(void **)addr)
+            {
+                r->error = 1;
+                return;
+            }
+            _cson_cb_read_object(r, &v, field->param.sub.model, field->param.sub.size, *(void **)addr, depth + 1);
+            return;
+        }
+        break;
+    case CSON_TYPE_LIST:
+        if (v.kind == CSON_CB_ARRAY)
+        {
+            _cson_cb_read_list(r, &v, field, addr, depth);
+            return;
+        }
+        break;
+    case CSON_TYPE_ILIST:
+        if (v.kind == CSON_CB_ARRAY)
+        {
+            _cson_cb_read_ilist(r, &v, field, addr, depth);
+            return;
+        }
+        break;
+    case CSON_TYPE_VECTOR:
+        if (v.kind == CSON_CB_ARRAY && !((cson_vector_t *)addr)->count)
+        {
+            _cson_cb_read_vector(r, &v, field, (cson_vector_t *)addr, depth);
+            return;
+        }
+        break;
+    case CSON_TYPE_EMBED:
+        if (v.kind == CSON_CB_MAP)
+        {
+            _cson_cb_read_object(r, &v, field->param.sub.model, field->param.sub.size, addr, depth + 1);
+            return;
+        }
+        break;
+    case CSON_TYPE_EMBED_ARRAY:
+        if (v.kind == CSON_CB_ARRAY)
+        {
+            size_t i;
+            ele_size = cson_model_obj_size(field->param.embeds.model, field->param.embeds.size);
+            for (i = 0; _cson_cb_next(r, &v, i); i++)
+            {
+                if (_cson_cb_read(r, &item) != 0)
+                {
+                    break;
+                }
+                if (i < (size_t)field->param.embeds.capacity && item.kind == CSON_CB_MAP)
+                {
+                    _cson_cb_read_object(r, &item, field->param.embeds.model, field->param.embeds.size,
+                                         (void *)((size_t)addr + i * ele_size), depth + 1);
+                }
+                else
+                {
+                    _cson_cb_skip(r, &item, depth + 1);
+                }
+            }
+            cson_embeds_set_count((void *)((size_t)addr - field->offset), field,
+                                  i < (size_t)field->param.embeds.capacity ? (int)i : field->param.embeds.capacity);
+            return;
+        }
+        break;
+    case CSON_TYPE_CHAR_ARRAY:
+        if (v.kind == CSON_CB_TEXT && !*(char *)addr)
+        {
+            _cson_cb_read_chars(r, &v, field, addr);
+            return;
+        }
+        break;
+    case CSON_TYPE_ARRAY:
+        if (v.kind == CSON_CB_ARRAY)
+        {
+            ele_size = cson_model_type_size(field->param.array.ele_type);
+            for (size_t i = 0; _cson_cb_next(r, &v, i); i++)
+            {
+                if (_cson_cb_read(r, &item) != 0)
+                {
+                    break;
+                }
+                if (i < (size_t)field->param.array.size && ele_size)
+                {
+                    _cson_cb_store(r, field->param.array.ele_type, (void *)((size_t)addr + i * ele_size), &item, depth + 1);
+                }
+                else
+                {
+                    _cson_cb_skip(r, &item, depth + 1);
+                }
+            }
+            return;
+        }
+        break;
+    default:
+        _cson_cb_store(r, field->type, addr, &v, depth + 1);
+        return;
+    }
+    _cson_cb_skip(r, &v, depth);
+}
+
+/**
+ * @brief 解码map到对象
+ *
+ * @param r 解码游标
+ * @param v map头部
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param obj 对象
+ * @param depth 嵌套深度
+ */
+static void _cson_cb_read_object(cson_cb_reader_t *r, cson_cb_value_t *v, cson_model_t *model, int model_size,
+                                 void *obj, int depth)
+{
+    cson_cb_value_t key, item;
+    char *text;
+    int hint = 0;
+    int field;
+
+    if (depth > CSON_CBOR_DEPTH_MAX)
+    {
+        r->error = 1;
+        return;
+    }
+    for (size_t i = 0; _cson_cb_next(r, v, i); i++)
+    {
+        if (_cson_cb_read(r, &key) != 0)
+        {
+            break;
+        }
+        field = -1;
+        if (key.kind == CSON_CB_TEXT && !key.indefinite)
+        {
+            field = _cson_cb_field(model, model_size, hint, key.ptr, key.size);
+        }
+        else if (key.kind == CSON_CB_TEXT)
+        {
+            text = _cson_cb_text(r, &key);
+            if (text)
+            {
+                field = _cson_cb_field(model, model_size, hint, (const unsigned char *)text, strlen(text));
+                cson_mem_free(text);
+            }
+        }
+        else
+        {
+            _cson_cb_skip(r, &key, depth + 1);
+        }
+        if (field < 0)
+        {
+            if (_cson_cb_read(r, &item) == 0)
+            {
+                _cson_cb_skip(r, &item, depth + 1);
+            }
+            continue;
+        }
+        hint = field + 1;
+        _cson_cb_read_field(r, &model[field], (void *)((size_t)obj + model[field].offset), depth);
+    }
+}
+
+/**
+ * @brief 解析CBOR
+ *
+ * @param data 数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 解析得到的对象，使用`cson_free`释放
+ */
+void *cson_cbor_decode(const unsigned char *data, size_t len, cson_model_t *model, int model_size)
+{
+    cson_cb_reader_t r = {data, len, 0, 0};
+    cson_cb_value_t v;
+    void *obj;
+
+    CSON_ASSERT(data, return NULL);
+    if (_cson_cb_read(&r, &v) != 0 || v.kind != CSON_CB_MAP)
+    {
+        return NULL;
+    }
+    CSON_STATS_ENTER(model);
+    obj = cson_model_new_obj(model, model_size);
+    CSON_ASSERT(obj, CSON_STATS_LEAVE(); return NULL);
+    _cson_cb_read_object(&r, &v, model, model_size, obj, 0);
+    if (r.error)
+    {
+        cson_free(obj, model, model_size);
+        obj = NULL;
+    }
+    CSON_STATS_LEAVE();
+    return obj;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file cson_cbor.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#ifndef __CSON_CBOR_H__
+#define __CSON_CBOR_H__
+
+#include "cson.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @defgroup CSON_CBOR cson cbor
+ * @brief 基于数据模型的CBOR(RFC 8949)编解码
+ *
+ * 结构体编码为以字段键值为key的map，float/double分别编码为单精度/双精度浮点，
+ * 字符串带长度前缀；解码支持不定长数组、map及分段字符串
+ *
+ * 链表较大时可使用流式输出，配合`CSON_CBOR_INDEFINITE`无需预先统计链表长度:
+ * @code
+ * static int write_socket(void *user, const unsigned char *data, size_t len)
+ * {
+ *     return send(*(int *)user, data, len, 0) == (ssize_t)len ? 0 : -1;
+ * }
+ *
+ * cson_cbor_encode_stream_ex(log, log_model, write_socket, &fd, CSON_CBOR_INDEFINITE);
+ * @endcode
+ *
+ * @addtogroup CSON_CBOR
+ * @{
+ */
+
+/**
+ * @brief 解码时最大嵌套深度
+ *
+ */
+#ifndef CSON_CBOR_DEPTH_MAX
+#define CSON_CBOR_DEPTH_MAX 32
+#endif
+
+/**
+ * @brief 流式输出缓冲大小
+ *
+ */
+#ifndef CSON_CBOR_STREAM_BUFFER
+#define CSON_CBOR_STREAM_BUFFER 512
+#endif
+
+/**
+ * @brief 编码选项: 链表编码为不定长数组
+ *
+ */
+#define CSON_CBOR_INDEFINITE 0x01
+
+/**
+ * @brief 流式输出函数
+ *
+ * @param user 用户数据
+ * @param data 数据
+ * @param len 数据长度
+ * @return int 0成功，其他值中止编码
+ */
+typedef int (*cson_cbor_write_t)(void *user, const unsigned char *data, size_t len);
+
+/**
+ * @brief 编码成CBOR
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param len 编码长度
+ * @param flags 编码选项，见`CSON_CBOR_INDEFINITE`
+ * @return unsigned char* 编码得到的数据，使用`cson_cbor_free`释放
+ */
+unsigned char *cson_cbor_encode(void *obj, cson_model_t *model, int model_size, size_t *len, int flags);
+
+/**
+ * @brief 编码成CBOR
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param len 编码长度
+ * @param flags 编码选项
+ * @return unsigned char* 编码得到的数据
+ */
+#define cson_cbor_encode_ex(obj, model, len, flags) \
+        cson_cbor_encode(obj, model, sizeof(model) / sizeof(cson_model_t), len, flags)
+
+/**
+ * @brief 流式编码成CBOR
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param write 输出函数
+ * @param user 传给输出函数的用户数据
+ * @param flags 编码选项，见`CSON_CBOR_INDEFINITE`
+ * @return int 0成功，-1失败
+ * @note 编码数据经`CSON_CBOR_STREAM_BUFFER`大小的栈上缓冲分批输出，不分配堆内存
+ */
+int cson_cbor_encode_stream(void *obj, cson_model_t *model, int model_size,
+                            cson_cbor_write_t write, void *user, int flags);
+
+/**
+ * @brief 流式编码成CBOR
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param write 输出函数
+ * @param user 用户数据
+ * @param flags 编码选项
+ * @return int 0成功，-1失败
+ */
+#define cson_cbor_encode_stream_ex(obj, model, write, user, flags) \
+        cson_cbor_encode_stream(obj, model, sizeof(model) / sizeof(cson_model_t), write, user, flags)
+
+/**
+ * @brief 解析CBOR
+ *
+ * @param data 数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 解析得到的对象，使用`cson_free`释放
+ * @note 未知字段及类型不匹配的值会被跳过，语义标签被忽略，数据不完整时返回NULL
+ */
+void *cson_cbor_decode(const unsigned char *data, size_t len, cson_model_t *model, int model_size);
+
+/**
+ * @brief 解析CBOR
+ *
+ * @param data 数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @return void* 解析得到的对象
+ */
+#define cson_cbor_decode_ex(data, len, model) \
+        cson_cbor_decode(data, len, model, sizeof(model) / sizeof(cson_model_t))
+
+/**
+ * @brief 释放编码生成的数据
+ *
+ * @param data 数据
+ */
+void cson_cbor_free(unsigned char *data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
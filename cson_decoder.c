@@ -0,0 +1,1339 @@
+/**
+ * @file cson_decoder.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#include "cson_decoder.h"
+#include "cson_internal.h"
+#include "cJSON.h"
+#include "stddef.h"
+#include "string.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "limits.h"
+#include "ctype.h"
+
+/**
+ * @brief 词法状态
+ *
+ */
+typedef enum
+{
+    CSON_LEX_VALUE = 0, /**< 等待值 */
+    CSON_LEX_STRING,    /**< 字符串 */
+    CSON_LEX_ESCAPE,    /**< 字符串转义 */
+    CSON_LEX_HEX,       /**< \uXXXX */
+    CSON_LEX_LOW_SLASH, /**< 代理对低位的'\' */
+    CSON_LEX_LOW_U,     /**< 代理对低位的'u' */
+    CSON_LEX_NUMBER,    /**< 数字 */
+    CSON_LEX_LITERAL,   /**< true/false/null */
+    CSON_LEX_KEY,       /**< 等待对象键值 */
+    CSON_LEX_COLON,     /**< 等待':' */
+    CSON_LEX_NEXT,      /**< 等待','或结束符 */
+    CSON_LEX_DONE,      /**< 解析完成 */
+    CSON_LEX_ERROR,     /**< 解析出错 */
+} cson_lex_t;
+
+/**
+ * @brief 容器绑定类型
+ *
+ */
+typedef enum
+{
+    CSON_BIND_NONE = 0, /**< 不绑定，仅跳过 */
+    CSON_BIND_OBJECT,   /**< 绑定结构体 */
+    CSON_BIND_LIST,     /**< 绑定cson_list_t */
+    CSON_BIND_ARRAY,    /**< 绑定数组 */
+    CSON_BIND_VECTOR,   /**< 绑定cson_vector_t */
+    CSON_BIND_EMBEDS,   /**< 绑定内嵌结构体数组 */
+    CSON_BIND_ILIST,    /**< 绑定侵入式链表 */
+} cson_bind_t;
+
+/**
+ * @brief 值的JSON类型
+ *
+ */
+typedef enum
+{
+    CSON_JSON_NULL = 0,
+    CSON_JSON_FALSE,
+    CSON_JSON_TRUE,
+    CSON_JSON_NUMBER,
+    CSON_JSON_STRING,
+    CSON_JSON_CONTAINER,
+} cson_json_t;
+
+/**
+ * @brief 容器栈帧
+ *
+ */
+typedef struct
+{
+    unsigned char array; /**< 是否为数组 */
+    unsigned char empty; /**< 尚无成员 */
+    unsigned char bind;  /**< 绑定类型 */
+    cson_model_t *model; /**< 结构体/链表元素模型 */
+    int model_size;      /**< 模型数量 */
+    void *obj;           /**< 结构体对象 */
+    int field;           /**< 当前字段，-1表示无对应字段 */
+    cson_list_t **tail;  /**< 链表尾部链接位置 */
+    cson_vector_t *vector; /**< vector */
+    void *base;          /**< 数组基址 */
+    cson_type_t ele_type; /**< 数组元素类型 */
+    short size;          /**< 数组大小 */
+    short index;         /**< 当前数组下标 */
+    cson_model_t *owner; /**< 内嵌结构体数组/侵入式链表字段模型 */
+    size_t ele_size;     /**< 内嵌结构体数组元素大小 */
+    void **link;         /**< 侵入式链表尾部链接位置 */
+    size_t seen;         /**< 已出现字段位图的起始位 */
+} cson_frame_t;
+
+/**
+ * @brief 值写入目标
+ *
+ */
+typedef struct
+{
+    enum
+    {
+        CSON_TARGET_NONE = 0,
+        CSON_TARGET_ROOT,
+        CSON_TARGET_FIELD,
+        CSON_TARGET_LIST,
+        CSON_TARGET_ARRAY,
+        CSON_TARGET_VECTOR,
+        CSON_TARGET_EMBEDS,
+        CSON_TARGET_ILIST,
+    } kind;
+    cson_model_t *field; /**< 字段模型 */
+    void *addr;          /**< 字段/数组元素地址 */
+    cson_frame_t *frame; /**< 所在容器 */
+} cson_target_t;
+
+/**
+ * @brief 推送式解析器
+ *
+ */
+struct cson_decoder
+{
+    cson_model_t *model;                        /**< 数据模型 */
+    int model_size;                             /**< 数据模型数量 */
+    void *result;                               /**< 解析结果 */
+    cson_lex_t lex;                             /**< 词法状态 */
+    cson_frame_t stack[CSON_DECODER_DEPTH_MAX]; /**< 容器栈 */
+    int depth;                                  /**< 当前深度 */
+    char *buf;                                  /**< 字符串/数字缓冲 */
+    size_t buf_len;                             /**< 缓冲长度 */
+    size_t buf_cap;                             /**< 缓冲容量 */
+    unsigned char is_key;                       /**< 当前字符串为键值 */
+    unsigned char hex_count;                    /**< 已读取的十六进制位数 */
+    unsigned int hex;                           /**< 十六进制值 */
+    unsigned int high;                          /**< 代理对高位 */
+    const char *literal;                        /**< 正在匹配的字面量 */
+    unsigned char literal_pos;                  /**< 字面量匹配位置 */
+    char *capture;                              /**< 子json原文 */
+    size_t capture_len;                         /**< 原文长度 */
+    size_t capture_cap;                         /**< 原文容量 */
+    unsigned char capturing;                    /**< 是否正在截取子json */
+    int capture_depth;                          /**< 截取开始时的深度 */
+    size_t consumed;                            /**< 最近一次送入数据的消费长度 */
+    unsigned char *seen;                        /**< 各层结构体已出现字段的位图 */
+    size_t seen_cap;                            /**< 位图容量(字节) */
+    int skip;                                   /**< 跳过的子树内的嵌套深度 */
+    unsigned char skip_empty;                   /**< 跳过的最内层容器尚无成员 */
+    unsigned char skip_array[CSON_DECODER_SKIP_DEPTH_MAX / 8 + 1]; /**< 跳过的各层容器是否为数组 */
+};
+
+/**
+ * @brief 追加字节到缓冲
+ *
+ * @param buf 缓冲
+ * @param len 缓冲长度
+ * @param cap 缓冲容量
+ * @param c 字节
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_append(char **buf, size_t *len, size_t *cap, char c)
+{
+    if (*len + 1 >= *cap)
+    {
+        size_t new_cap = *cap ? *cap * 2 : 64;
+        char *p = cson_mem_alloc(new_cap);
+        if (!p)
+        {
+            return -1;
+        }
+        if (*buf)
+        {
+            memcpy(p, *buf, *len);
+            cson_mem_free(*buf);
+        }
+        *buf = p;
+        *cap = new_cap;
+    }
+    (*buf)[(*len)++] = c;
+    (*buf)[*len] = 0;
+    return 0;
+}
+
+/**
+ * @brief 追加UTF-8编码的码点到缓冲
+ *
+ * @param dec 解析器
+ * @param codepoint 码点
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_append_utf8(cson_decoder_t *dec, unsigned long codepoint)
+{
+    unsigned char out[4];
+    unsigned char len;
+
+    if (codepoint < 0x80)
+    {
+        out[0] = (unsigned char)codepoint;
+        len = 1;
+    }
+    else if (codepoint < 0x800)
+    {
+        out[0] = (unsigned char)(0xC0 | (codepoint >> 6));
+        out[1] = (unsigned char)(0x80 | (codepoint & 0x3F));
+        len = 2;
+    }
+    else if (codepoint < 0x10000)
+    {
+        out[0] = (unsigned char)(0xE0 | (codepoint >> 12));
+        out[1] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+        out[2] = (unsigned char)(0x80 | (codepoint & 0x3F));
+        len = 3;
+    }
+    else
+    {
+        out[0] = (unsigned char)(0xF0 | (codepoint >> 18));
+        out[1] = (unsigned char)(0x80 | ((codepoint >> 12) & 0x3F));
+        out[2] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+        out[3] = (unsigned char)(0x80 | (codepoint & 0x3F));
+        len = 4;
+    }
+    for (unsigned char i = 0; i < len; i++)
+    {
+        if (_cson_decoder_append(&dec->buf, &dec->buf_len, &dec->buf_cap, (char)out[i]) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 复制字符串缓冲
+ *
+ * @param dec 解析器
+ * @return char* 新字符串
+ */
+static char *_cson_decoder_dup(cson_decoder_t *dec)
+{
+    char *str = cson_mem_alloc(dec->buf_len + 1);
+    if (str)
+    {
+        memcpy(str, dec->buf ? dec->buf : "", dec->buf_len);
+        str[dec->buf_len] = 0;
+    }
+    return str;
+}
+
+/**
+ * @brief 将值写入基础类型地址
+ *
+ * @param dec 解析器
+ * @param type 数据类型
+ * @param addr 写入地址
+ * @param json 值的JSON类型
+ * @param num 数值
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_store(cson_decoder_t *dec, cson_type_t type, void *addr,
+                                       cson_json_t json, double num)
+{
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+    case CSON_TYPE_SHORT:
+    case CSON_TYPE_INT:
+    case CSON_TYPE_LONG:
+    case CSON_TYPE_FLOAT:
+    case CSON_TYPE_DOUBLE:
+        if (json == CSON_JSON_NUMBER)
+            cson_model_store_number(type, addr, cson_number_integer(num), num);
+        else
+            cson_model_store_number(type, addr, 0, 0.0);
+        break;
+    case CSON_TYPE_BOOL:
+        *(char *)addr = json == CSON_JSON_TRUE ? 1 : 0;
+        break;
+    case CSON_TYPE_STRING:
+        if (json == CSON_JSON_STRING && !*(char **)addr)
+        {
+            *(char **)addr = _cson_decoder_dup(dec);
+            if (!*(char **)addr)
+            {
+                return -1;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取当前值的写入目标
+ *
+ * @param dec 解析器
+ * @return cson_target_t 写入目标
+ */
+static cson_target_t _cson_decoder_target(cson_decoder_t *dec)
+{
+    cson_target_t target = {CSON_TARGET_NONE, NULL, NULL, NULL};
+    cson_frame_t *frame;
+
+    if (dec->capturing || dec->skip)
+    {
+        return target;
+    }
+    if (dec->depth == 0)
+    {
+        target.kind = CSON_TARGET_ROOT;
+        return target;
+    }
+    frame = &dec->stack[dec->depth - 1];
+    target.frame = frame;
+    switch (frame->bind)
+    {
+    case CSON_BIND_OBJECT:
+        if (frame->field >= 0)
+        {
+            target.kind = CSON_TARGET_FIELD;
+            target.field = &frame->model[frame->field];
+            target.addr = (void *)((size_t)frame->obj + target.field->offset);
+        }
+        break;
+    case CSON_BIND_LIST:
+        target.kind = CSON_TARGET_LIST;
+        break;
+    case CSON_BIND_VECTOR:
+        target.kind = CSON_TARGET_VECTOR;
+        break;
+    case CSON_BIND_ARRAY:
+        if (frame->index < frame->size)
+        {
+            target.kind = CSON_TARGET_ARRAY;
+            target.addr = (void *)((size_t)frame->base + frame->index * cson_model_type_size(frame->ele_type));
+        }
+        break;
+    case CSON_BIND_EMBEDS:
+        if (frame->index < frame->size)
+        {
+            target.kind = CSON_TARGET_EMBEDS;
+            target.addr = (void *)((size_t)frame->base + frame->index * frame->ele_size);
+        }
+        break;
+    case CSON_BIND_ILIST:
+        target.kind = CSON_TARGET_ILIST;
+        break;
+    default:
+        break;
+    }
+    return target;
+}
+
+/**
+ * @brief 在链表尾部追加节点
+ *
+ * @param frame 链表容器
+ * @param obj 节点对象，基础类型链表为NULL，元素值随后写入节点
+ * @return cson_list_t* 新节点，失败返回NULL
+ */
+static cson_list_t *_cson_decoder_list_append(cson_frame_t *frame, void *obj)
+{
+    cson_list_t *node = cson_mem_alloc(sizeof(cson_list_t));
+    if (!node)
+    {
+        return NULL;
+    }
+    memset(node, 0, sizeof(cson_list_t));
+    node->obj = obj;
+    *frame->tail = node;
+    frame->tail = &node->next;
+    return node;
+}
+
+/**
+ * @brief 标量值解析完成，写入目标
+ *
+ * @param dec 解析器
+ * @param json 值的JSON类型
+ * @param num 数值
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_scalar(cson_decoder_t *dec, cson_json_t json, double num)
+{
+    cson_target_t target = _cson_decoder_target(dec);
+    cson_list_t *node;
+    void *obj;
+
+    switch (target.kind)
+    {
+    case CSON_TARGET_ROOT:
+        if (json != CSON_JSON_NULL)
+        {
+            dec->result = cson_model_new_obj(dec->model, dec->model_size);
+            return dec->result ? 0 : -1;
+        }
+        break;
+    case CSON_TARGET_FIELD:
+        switch (target.field->type)
+        {
+        case CSON_TYPE_STRUCT:
+            if (json != CSON_JSON_NULL && !*(void **)target.addr)
+            {
+                *(void **)target.addr = cson_model_new_obj(target.field->param.sub.model,
+                                                              target.field->param.sub.size);
+                return *(void **)target.addr ? 0 : -1;
+            }
+            break;
+        case CSON_TYPE_CHAR_ARRAY:
+            if (json == CSON_JSON_STRING && !*(char *)target.addr)
+            {
+                cson_chars_assign(target.addr, target.field, dec->buf ? dec->buf : "", dec->buf_len);
+            }
+            break;
+        case CSON_TYPE_LIST:
+        case CSON_TYPE_ARRAY:
+        case CSON_TYPE_VECTOR:
+        case CSON_TYPE_EMBED:
+        case CSON_TYPE_EMBED_ARRAY:
+        case CSON_TYPE_ILIST:
+        case CSON_TYPE_JSON:
+            break;
+        default:
+            return _cson_decoder_store(dec, target.field->type, target.addr, json, num);
+        }
+        break;
+    case CSON_TARGET_LIST:
+        obj = NULL;
+        if (!cson_model_is_basic(target.frame->model) && json != CSON_JSON_NULL)
+        {
+            obj = cson_model_new_obj(target.frame->model, target.frame->model_size);
+            if (!obj)
+            {
+                return -1;
+            }
+        }
+        node = _cson_decoder_list_append(target.frame, obj);
+        if (!node)
+        {
+            cson_mem_free(obj);
+            return -1;
+        }
+        if (cson_model_is_basic(target.frame->model))
+        {
+            return _cson_decoder_store(dec, target.frame->model[1].type, &node->obj, json, num);
+        }
+        break;
+    case CSON_TARGET_ARRAY:
+        return _cson_decoder_store(dec, target.frame->ele_type, target.addr, json, num);
+    case CSON_TARGET_VECTOR:
+        obj = cson_vector_push(target.frame->vector, target.frame->model, target.frame->model_size);
+        if (!obj)
+        {
+            return -1;
+        }
+        if (cson_model_is_basic(target.frame->model))
+        {
+            return _cson_decoder_store(dec, target.frame->model[1].type, obj, json, num);
+        }
+        break;
+    default:
+        break;
+    }
+    return 0;
+}
+
+/**
+ * @brief 进入跳过的子树中的容器，只记录容器类型，不占用容器栈
+ *
+ * @param dec 解析器
+ * @param array 是否为数组
+ * @return signed char 0成功，-1超过`CSON_DECODER_SKIP_DEPTH_MAX`
+ */
+static signed char _cson_decoder_skip(cson_decoder_t *dec, unsigned char array)
+{
+    if (dec->skip >= CSON_DECODER_SKIP_DEPTH_MAX)
+    {
+        return -1;
+    }
+    if (array)
+    {
+        dec->skip_array[dec->skip / 8] |= (unsigned char)(1u << (dec->skip % 8));
+    }
+    else
+    {
+        dec->skip_array[dec->skip / 8] &= (unsigned char)~(1u << (dec->skip % 8));
+    }
+    dec->skip++;
+    dec->skip_empty = 1;
+    dec->lex = array ? CSON_LEX_VALUE : CSON_LEX_KEY;
+    return 0;
+}
+
+/**
+ * @brief 为新容器分配已出现字段位图，结构体容器的位图清零
+ *
+ * @param dec 解析器
+ * @param frame 新容器
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_seen_open(cson_decoder_t *dec, cson_frame_t *frame)
+{
+    cson_frame_t *parent = dec->depth ? &dec->stack[dec->depth - 1] : NULL;
+    size_t bits, bytes, new_cap;
+    unsigned char *p;
+
+    frame->seen = parent ? parent->seen + (parent->bind == CSON_BIND_OBJECT ? (size_t)parent->model_size : 0) : 0;
+    if (frame->bind != CSON_BIND_OBJECT)
+    {
+        return 0;
+    }
+    bits = frame->seen + (size_t)frame->model_size;
+    bytes = (bits + 7) / 8;
+    if (bytes > dec->seen_cap)
+    {
+        for (new_cap = dec->seen_cap ? dec->seen_cap * 2 : 16; new_cap < bytes; new_cap *= 2)
+        {
+        }
+        p = cson_mem_alloc(new_cap);
+        if (!p)
+        {
+            return -1;
+        }
+        if (dec->seen)
+        {
+            memcpy(p, dec->seen, dec->seen_cap);
+            cson_mem_free(dec->seen);
+        }
+        dec->seen = p;
+        dec->seen_cap = new_cap;
+    }
+    for (size_t i = frame->seen; i < bits; i++)
+    {
+        dec->seen[i / 8] &= (unsigned char)~(1u << (i % 8));
+    }
+    return 0;
+}
+
+/**
+ * @brief 容器开始，压栈并确定绑定
+ *
+ * @param dec 解析器
+ * @param array 是否为数组
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_open(cson_decoder_t *dec, unsigned char array)
+{
+    cson_target_t target;
+    cson_frame_t *frame;
+    void *obj;
+
+    if (dec->skip || (dec->depth && dec->stack[dec->depth - 1].bind == CSON_BIND_NONE))
+    {
+        return _cson_decoder_skip(dec, array);
+    }
+    if (dec->depth >= CSON_DECODER_DEPTH_MAX)
+    {
+        return -1;
+    }
+    target = _cson_decoder_target(dec);
+    frame = &dec->stack[dec->depth];
+    memset(frame, 0, sizeof(cson_frame_t));
+    frame->array = array;
+    frame->empty = 1;
+    frame->field = -1;
+
+    if (target.kind == CSON_TARGET_ROOT && !array)
+    {
+        dec->result = cson_model_new_obj(dec->model, dec->model_size);
+        frame->bind = CSON_BIND_OBJECT;
+        frame->model = dec->model;
+        frame->model_size = dec->model_size;
+        frame->obj = dec->result;
+    }
+    else if (target.kind == CSON_TARGET_FIELD && !array && target.field->type == CSON_TYPE_STRUCT)
+    {
+        if (!*(void **)target.addr)
+        {
+            *(void **)target.addr = cson_model_new_obj(target.field->param.sub.model,
+                                                          target.field->param.sub.size);
+            frame->bind = CSON_BIND_OBJECT;
+            frame->model = target.field->param.sub.model;
+            frame->model_size = target.field->param.sub.size;
+            frame->obj = *(void **)target.addr;
+        }
+    }
+    else if (target.kind == CSON_TARGET_FIELD && !array && target.field->type == CSON_TYPE_EMBED)
+    {
+        frame->bind = CSON_BIND_OBJECT;
+        frame->model = target.field->param.sub.model;
+        frame->model_size = target.field->param.sub.size;
+        frame->obj = target.addr;
+    }
+    else if (target.kind == CSON_TARGET_FIELD && array && target.field->type == CSON_TYPE_LIST)
+    {
+        if (!*(void **)target.addr)
+        {
+            frame->bind = CSON_BIND_LIST;
+            frame->model = target.field->param.sub.model;
+            frame->model_size = target.field->param.sub.size;
+            frame->tail = (cson_list_t **)target.addr;
+        }
+    }
+    else if (target.kind == CSON_TARGET_FIELD && array && target.field->type == CSON_TYPE_VECTOR)
+    {
+        if (!((cson_vector_t *)target.addr)->count)
+        {
+            frame->bind = CSON_BIND_VECTOR;
+            frame->model = target.field->param.sub.model;
+            frame->model_size = target.field->param.sub.size;
+            frame->vector = (cson_vector_t *)target.addr;
+        }
+    }
+    else if (target.kind == CSON_TARGET_FIELD && array && target.field->type == CSON_TYPE_EMBED_ARRAY)
+    {
+        frame->bind = CSON_BIND_EMBEDS;
+        frame->model = target.field->param.embeds.model;
+        frame->model_size = target.field->param.embeds.size;
+        frame->obj = target.frame->obj;
+        frame->owner = target.field;
+        frame->base = target.addr;
+        frame->size = target.field->param.embeds.capacity;
+        frame->ele_size = cson_model_obj_size(frame->model, frame->model_size);
+        cson_embeds_set_count(frame->obj, frame->owner, 0);
+    }
+    else if (target.kind == CSON_TARGET_FIELD && array && target.field->type == CSON_TYPE_ILIST)
+    {
+        if (!*(void **)target.addr)
+        {
+            frame->bind = CSON_BIND_ILIST;
+            frame->model = target.field->param.ilist.model;
+            frame->model_size = target.field->param.ilist.size;
+            frame->owner = target.field;
+            frame->link = (void **)target.addr;
+        }
+    }
+    else if (target.kind == CSON_TARGET_FIELD && array && target.field->type == CSON_TYPE_ARRAY)
+    {
+        frame->bind = CSON_BIND_ARRAY;
+        frame->base = target.addr;
+        frame->ele_type = target.field->param.array.ele_type;
+        frame->size = target.field->param.array.size;
+    }
+    else if (target.kind == CSON_TARGET_LIST && !array && !cson_model_is_basic(target.frame->model))
+    {
+        obj = cson_model_new_obj(target.frame->model, target.frame->model_size);
+        if (!obj || !_cson_decoder_list_append(target.frame, obj))
+        {
+            cson_mem_free(obj);
+            return -1;
+        }
+        frame->bind = CSON_BIND_OBJECT;
+        frame->model = target.frame->model;
+        frame->model_size = target.frame->model_size;
+        frame->obj = obj;
+    }
+    else if (target.kind == CSON_TARGET_ILIST && !array)
+    {
+        obj = cson_model_new_obj(target.frame->model, target.frame->model_size);
+        if (!obj)
+        {
+            return -1;
+        }
+        *target.frame->link = obj;
+        target.frame->link = (void **)((size_t)obj + target.frame->owner->param.ilist.next);
+        frame->bind = CSON_BIND_OBJECT;
+        frame->model = target.frame->model;
+        frame->model_size = target.frame->model_size;
+        frame->obj = obj;
+    }
+    else if (target.kind == CSON_TARGET_EMBEDS && !array)
+    {
+        frame->bind = CSON_BIND_OBJECT;
+        frame->model = target.frame->model;
+        frame->model_size = target.frame->model_size;
+        frame->obj = target.addr;
+    }
+    else if (target.kind == CSON_TARGET_VECTOR && !array && !cson_model_is_basic(target.frame->model))
+    {
+        frame->bind = CSON_BIND_OBJECT;
+        frame->model = target.frame->model;
+        frame->model_size = target.frame->model_size;
+        frame->obj = cson_vector_push(target.frame->vector, target.frame->model, target.frame->model_size);
+    }
+    else if (_cson_decoder_scalar(dec, CSON_JSON_CONTAINER, 0) != 0)
+    {
+        return -1;
+    }
+
+    if (frame->bind == CSON_BIND_OBJECT && !frame->obj)
+    {
+        return -1;
+    }
+    if (_cson_decoder_seen_open(dec, frame) != 0)
+    {
+        return -1;
+    }
+    dec->depth++;
+    dec->lex = array ? CSON_LEX_VALUE : CSON_LEX_KEY;
+    return 0;
+}
+
+/**
+ * @brief 截取的子json完成，规范化后写入字段
+ *
+ * @param dec 解析器
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_capture_done(cson_decoder_t *dec)
+{
+    cson_target_t target;
+    cJSON *json;
+
+    dec->capturing = 0;
+    target = _cson_decoder_target(dec);
+    if (target.kind != CSON_TARGET_FIELD || *(char **)target.addr)
+    {
+        return 0;
+    }
+    json = cJSON_ParseWithLength(dec->capture, dec->capture_len);
+    if (!json)
+    {
+        return -1;
+    }
+    *(char **)target.addr = cJSON_PrintUnformatted(json);
+    cJSON_Delete(json);
+    return 0;
+}
+
+/**
+ * @brief 一个值解析完成
+ *
+ * @param dec 解析器
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_value_done(cson_decoder_t *dec)
+{
+    cson_frame_t *frame;
+
+    if (dec->skip)
+    {
+        dec->lex = CSON_LEX_NEXT;
+        return 0;
+    }
+    if (dec->capturing && dec->depth == dec->capture_depth)
+    {
+        if (_cson_decoder_capture_done(dec) != 0)
+        {
+            return -1;
+        }
+    }
+    if (dec->depth == 0)
+    {
+        dec->lex = CSON_LEX_DONE;
+        return 0;
+    }
+    frame = &dec->stack[dec->depth - 1];
+    if (frame->array && frame->index < frame->size)
+    {
+        frame->index++;
+        if (frame->bind == CSON_BIND_EMBEDS)
+        {
+            cson_embeds_set_count(frame->obj, frame->owner, frame->index);
+        }
+    }
+    dec->lex = CSON_LEX_NEXT;
+    return 0;
+}
+
+/**
+ * @brief 对象键值解析完成，查找对应字段
+ *
+ * @param dec 解析器
+ */
+static void _cson_decoder_key(cson_decoder_t *dec)
+{
+    cson_frame_t *frame = &dec->stack[dec->depth - 1];
+    const unsigned char *a, *b;
+    size_t bit;
+
+    frame->field = -1;
+    if (dec->skip || frame->bind != CSON_BIND_OBJECT)
+    {
+        return;
+    }
+    for (short i = 0; i < frame->model_size; i++)
+    {
+        if (frame->model[i].type == CSON_TYPE_OBJ || !frame->model[i].key)
+        {
+            continue;
+        }
+        a = (const unsigned char *)frame->model[i].key;
+        b = (const unsigned char *)(dec->buf ? dec->buf : "");
+        while (*a && tolower(*a) == tolower(*b))
+        {
+            a++;
+            b++;
+        }
+        if (!*a && !*b)
+        {
+            /* 同名字段取第一个，与cJSON查找及cson_decode一致 */
+            bit = frame->seen + (size_t)i;
+            if (dec->seen[bit / 8] & (1u << (bit % 8)))
+            {
+                return;
+            }
+            dec->seen[bit / 8] |= (unsigned char)(1u << (bit % 8));
+            frame->field = i;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 字符是否可以出现在数字中
+ *
+ * @param c 字符
+ * @return char 是否为数字字符
+ */
+static char _cson_decoder_is_number(char c)
+{
+    return (c >= '0' && c <= '9') || c == '+' || c == '-' || c == 'e' || c == 'E' || c == '.';
+}
+
+/**
+ * @brief 数字解析完成
+ *
+ * @param dec 解析器
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_number_done(cson_decoder_t *dec)
+{
+    char *end;
+    double num = strtod(dec->buf, &end);
+
+    if (end != dec->buf + dec->buf_len)
+    {
+        return -1;
+    }
+    if (_cson_decoder_scalar(dec, CSON_JSON_NUMBER, num) != 0)
+    {
+        return -1;
+    }
+    return _cson_decoder_value_done(dec);
+}
+
+/**
+ * @brief 字符串解析完成
+ *
+ * @param dec 解析器
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_string_done(cson_decoder_t *dec)
+{
+    if (dec->is_key)
+    {
+        _cson_decoder_key(dec);
+        dec->lex = CSON_LEX_COLON;
+        return 0;
+    }
+    if (_cson_decoder_scalar(dec, CSON_JSON_STRING, 0) != 0)
+    {
+        return -1;
+    }
+    return _cson_decoder_value_done(dec);
+}
+
+/**
+ * @brief 解析十六进制字符
+ *
+ * @param c 字符
+ * @return int 数值，-1表示非法
+ */
+static int _cson_decoder_hex(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief 开始解析一个值
+ *
+ * @param dec 解析器
+ * @param c 值的首字符
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_value(cson_decoder_t *dec, char c)
+{
+    cson_target_t target = _cson_decoder_target(dec);
+
+    if (target.kind == CSON_TARGET_FIELD && target.field->type == CSON_TYPE_JSON)
+    {
+        dec->capturing = 1;
+        dec->capture_depth = dec->depth;
+        dec->capture_len = 0;
+        if (_cson_decoder_append(&dec->capture, &dec->capture_len, &dec->capture_cap, c) != 0)
+        {
+            return -1;
+        }
+    }
+
+    dec->buf_len = 0;
+    switch (c)
+    {
+    case '{':
+        return _cson_decoder_open(dec, 0);
+    case '[':
+        return _cson_decoder_open(dec, 1);
+    case '\"':
+        dec->is_key = 0;
+        dec->lex = CSON_LEX_STRING;
+        return 0;
+    case 't':
+        dec->literal = "true";
+        break;
+    case 'f':
+        dec->literal = "false";
+        break;
+    case 'n':
+        dec->literal = "null";
+        break;
+    default:
+        if (c == '-' || (c >= '0' && c <= '9'))
+        {
+            dec->lex = CSON_LEX_NUMBER;
+            return _cson_decoder_append(&dec->buf, &dec->buf_len, &dec->buf_cap, c);
+        }
+        return -1;
+    }
+    dec->literal_pos = 1;
+    dec->lex = CSON_LEX_LITERAL;
+    return 0;
+}
+
+/**
+ * @brief 当前容器是否为数组
+ *
+ * @param dec 解析器
+ * @return unsigned char 是否为数组
+ */
+static unsigned char _cson_decoder_in_array(cson_decoder_t *dec)
+{
+    if (dec->skip)
+    {
+        return (dec->skip_array[(dec->skip - 1) / 8] >> ((dec->skip - 1) % 8)) & 1;
+    }
+    return dec->depth ? dec->stack[dec->depth - 1].array : 0;
+}
+
+/**
+ * @brief 获取当前容器尚无成员的标记
+ *
+ * @param dec 解析器，深度不为0
+ * @return unsigned char* 标记
+ */
+static unsigned char *_cson_decoder_empty(cson_decoder_t *dec)
+{
+    return dec->skip ? &dec->skip_empty : &dec->stack[dec->depth - 1].empty;
+}
+
+/**
+ * @brief 当前容器结束
+ *
+ * @param dec 解析器
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_close(cson_decoder_t *dec)
+{
+    if (dec->skip)
+    {
+        dec->skip--;
+        dec->skip_empty = 0;
+    }
+    else
+    {
+        dec->depth--;
+    }
+    return _cson_decoder_value_done(dec);
+}
+
+/**
+ * @brief 处理一个字符
+ *
+ * @param dec 解析器
+ * @param c 字符
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_decoder_step(cson_decoder_t *dec, char c)
+{
+    int hex;
+
+    switch (dec->lex)
+    {
+    case CSON_LEX_VALUE:
+        if ((unsigned char)c <= 32)
+        {
+            return 0;
+        }
+        if (c == ']' && _cson_decoder_in_array(dec) && *_cson_decoder_empty(dec))
+        {
+            return _cson_decoder_close(dec);
+        }
+        if (dec->depth)
+        {
+            *_cson_decoder_empty(dec) = 0;
+        }
+        return _cson_decoder_value(dec, c);
+    case CSON_LEX_KEY:
+        if ((unsigned char)c <= 32)
+        {
+            return 0;
+        }
+        if (c == '}' && *_cson_decoder_empty(dec))
+        {
+            return _cson_decoder_close(dec);
+        }
+        if (c != '\"')
+        {
+            return -1;
+        }
+        *_cson_decoder_empty(dec) = 0;
+        dec->is_key = 1;
+        dec->buf_len = 0;
+        dec->lex = CSON_LEX_STRING;
+        return 0;
+    case CSON_LEX_COLON:
+        if ((unsigned char)c <= 32)
+        {
+            return 0;
+        }
+        if (c != ':')
+        {
+            return -1;
+        }
+        dec->lex = CSON_LEX_VALUE;
+        return 0;
+    case CSON_LEX_NEXT:
+        if ((unsigned char)c <= 32)
+        {
+            return 0;
+        }
+        if (c == ',')
+        {
+            dec->lex = _cson_decoder_in_array(dec) ? CSON_LEX_VALUE : CSON_LEX_KEY;
+            return 0;
+        }
+        if (c == (_cson_decoder_in_array(dec) ? ']' : '}'))
+        {
+            return _cson_decoder_close(dec);
+        }
+        return -1;
+    case CSON_LEX_STRING:
+        if (c == '\"')
+        {
+            return _cson_decoder_string_done(dec);
+        }
+        if (c == '\\')
+        {
+            dec->lex = CSON_LEX_ESCAPE;
+            return 0;
+        }
+        return _cson_decoder_append(&dec->buf, &dec->buf_len, &dec->buf_cap, c);
+    case CSON_LEX_ESCAPE:
+        dec->lex = CSON_LEX_STRING;
+        switch (c)
+        {
+        case 'b':
+            c = '\b';
+            break;
+        case 'f':
+            c = '\f';
+            break;
+        case 'n':
+            c = '\n';
+            break;
+        case 'r':
+            c = '\r';
+            break;
+        case 't':
+            c = '\t';
+            break;
+        case '\"':
+        case '\\':
+        case '/':
+            break;
+        case 'u':
+            dec->lex = CSON_LEX_HEX;
+            dec->hex = 0;
+            dec->hex_count = 0;
+            return 0;
+        default:
+            return -1;
+        }
+        return _cson_decoder_append(&dec->buf, &dec->buf_len, &dec->buf_cap, c);
+    case CSON_LEX_HEX:
+        hex = _cson_decoder_hex(c);
+        if (hex < 0)
+        {
+            return -1;
+        }
+        dec->hex = (dec->hex << 4) | (unsigned int)hex;
+        if (++dec->hex_count < 4)
+        {
+            return 0;
+        }
+        dec->lex = CSON_LEX_STRING;
+        if (dec->high)
+        {
+            unsigned int high = dec->high;
+            dec->high = 0;
+            if (dec->hex < 0xDC00 || dec->hex > 0xDFFF)
+            {
+                return -1;
+            }
+            return _cson_decoder_append_utf8(dec, 0x10000 + (((unsigned long)(high & 0x3FF) << 10) | (dec->hex & 0x3FF)));
+        }
+        if (dec->hex >= 0xDC00 && dec->hex <= 0xDFFF)
+        {
+            return -1;
+        }
+        if (dec->hex >= 0xD800 && dec->hex <= 0xDBFF)
+        {
+            dec->high = dec->hex;
+            dec->lex = CSON_LEX_LOW_SLASH;
+            return 0;
+        }
+        return _cson_decoder_append_utf8(dec, dec->hex);
+    case CSON_LEX_LOW_SLASH:
+        dec->lex = CSON_LEX_LOW_U;
+        return c == '\\' ? 0 : -1;
+    case CSON_LEX_LOW_U:
+        dec->lex = CSON_LEX_HEX;
+        dec->hex = 0;
+        dec->hex_count = 0;
+        return c == 'u' ? 0 : -1;
+    case CSON_LEX_NUMBER:
+        if (dec->buf_len >= 63)
+        {
+            return -1;
+        }
+        return _cson_decoder_append(&dec->buf, &dec->buf_len, &dec->buf_cap, c);
+    case CSON_LEX_LITERAL:
+        if (c != dec->literal[dec->literal_pos])
+        {
+            return -1;
+        }
+        if (dec->literal[++dec->literal_pos])
+        {
+            return 0;
+        }
+        if (_cson_decoder_scalar(dec, dec->literal[0] == 't'   ? CSON_JSON_TRUE
+                                      : dec->literal[0] == 'f' ? CSON_JSON_FALSE
+                                                               : CSON_JSON_NULL,
+                                 0) != 0)
+        {
+            return -1;
+        }
+        return _cson_decoder_value_done(dec);
+    default:
+        return -1;
+    }
+}
+
+/**
+ * @brief 创建推送式解析器
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return cson_decoder_t* 解析器
+ */
+cson_decoder_t *cson_decoder_create(cson_model_t *model, int model_size)
+{
+    cson_decoder_t *dec;
+    CSON_STATS_ENTER(model);
+    dec = cson_mem_alloc(sizeof(cson_decoder_t));
+    CSON_ASSERT(dec, CSON_STATS_LEAVE(); return NULL);
+    memset(dec, 0, sizeof(cson_decoder_t));
+    dec->model = model;
+    dec->model_size = model_size;
+    CSON_STATS_LEAVE();
+    return dec;
+}
+
+/**
+ * @brief 送入一段JSON数据
+ *
+ * @param dec 解析器
+ * @param chunk 数据
+ * @param len 数据长度
+ * @return cson_decoder_status_t 解析状态
+ */
+cson_decoder_status_t cson_decoder_feed(cson_decoder_t *dec, const char *chunk, size_t len)
+{
+    size_t pos = 0;
+    char c;
+
+    CSON_ASSERT(dec, return CSON_DECODER_ERROR);
+    CSON_STATS_ENTER(dec->model);
+    dec->consumed = 0;
+    while (pos < len && dec->lex != CSON_LEX_DONE && dec->lex != CSON_LEX_ERROR)
+    {
+        c = chunk[pos];
+        if (dec->lex == CSON_LEX_NUMBER && !_cson_decoder_is_number(c))
+        {
+            if (_cson_decoder_number_done(dec) != 0)
+            {
+                dec->lex = CSON_LEX_ERROR;
+            }
+            continue;
+        }
+        if (dec->capturing && _cson_decoder_append(&dec->capture, &dec->capture_len, &dec->capture_cap, c) != 0)
+        {
+            dec->lex = CSON_LEX_ERROR;
+            break;
+        }
+        if (_cson_decoder_step(dec, c) != 0)
+        {
+            dec->lex = CSON_LEX_ERROR;
+            break;
+        }
+        pos++;
+    }
+    dec->consumed = pos;
+    CSON_STATS_LEAVE();
+    if (dec->lex == CSON_LEX_ERROR)
+    {
+        return CSON_DECODER_ERROR;
+    }
+    return dec->lex == CSON_LEX_DONE ? CSON_DECODER_DONE : CSON_DECODER_NEED_MORE;
+}
+
+/**
+ * @brief 数据已全部送入，结束解析
+ *
+ * @param dec 解析器
+ * @return cson_decoder_status_t 解析状态
+ */
+cson_decoder_status_t cson_decoder_finish(cson_decoder_t *dec)
+{
+    CSON_ASSERT(dec, return CSON_DECODER_ERROR);
+    CSON_STATS_ENTER(dec->model);
+    /* 顶层数字没有结束符，到数据末尾才能确定 */
+    if (dec->lex == CSON_LEX_NUMBER && dec->depth == 0 && _cson_decoder_number_done(dec) != 0)
+    {
+        dec->lex = CSON_LEX_ERROR;
+    }
+    if (dec->lex != CSON_LEX_DONE)
+    {
+        dec->lex = CSON_LEX_ERROR;
+    }
+    CSON_STATS_LEAVE();
+    return dec->lex == CSON_LEX_DONE ? CSON_DECODER_DONE : CSON_DECODER_ERROR;
+}
+
+/**
+ * @brief 获取最近一次送入数据中已消费的长度
+ *
+ * @param dec 解析器
+ * @return size_t 已消费长度
+ */
+size_t cson_decoder_consumed(cson_decoder_t *dec)
+{
+    CSON_ASSERT(dec, return 0);
+    return dec->consumed;
+}
+
+/**
+ * @brief 取出解析结果
+ *
+ * @param dec 解析器
+ * @return void* 解析得到的对象
+ */
+void *cson_decoder_result(cson_decoder_t *dec)
+{
+    void *obj;
+
+    CSON_ASSERT(dec, return NULL);
+    if (dec->lex != CSON_LEX_DONE)
+    {
+        return NULL;
+    }
+    obj = dec->result;
+    dec->result = NULL;
+    return obj;
+}
+
+/**
+ * @brief 重置解析器，准备解析下一个报文
+ *
+ * @param dec 解析器
+ */
+void cson_decoder_reset(cson_decoder_t *dec)
+{
+    CSON_ASSERT(dec, return);
+    CSON_STATS_ENTER(dec->model);
+    if (dec->result)
+    {
+        cson_free(dec->result, dec->model, dec->model_size);
+        dec->result = NULL;
+    }
+    dec->lex = CSON_LEX_VALUE;
+    dec->depth = 0;
+    dec->skip = 0;
+    dec->buf_len = 0;
+    dec->high = 0;
+    dec->capturing = 0;
+    dec->capture_len = 0;
+    dec->consumed = 0;
+    CSON_STATS_LEAVE();
+}
+
+/**
+ * @brief 销毁推送式解析器
+ *
+ * @param dec 解析器
+ */
+void cson_decoder_destroy(cson_decoder_t *dec)
+{
+    CSON_ASSERT(dec, return);
+    CSON_STATS_ENTER(dec->model);
+    cson_decoder_reset(dec);
+    cson_mem_free(dec->buf);
+    cson_mem_free(dec->capture);
+    cson_mem_free(dec->seen);
+    cson_mem_free(dec);
+    CSON_STATS_LEAVE();
+}
@@ -0,0 +1,156 @@
+/**
+ * @file cson_decoder.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#ifndef __CSON_DECODER_H__
+#define __CSON_DECODER_H__
+
+#include "cson.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @defgroup CSON_DECODER cson decoder
+ * @brief 可恢复的推送式解析器
+ *
+ * JSON文本可按任意长度分段送入，解析状态跨调用保存，字段解析完成后立即写入目标结构体，
+ * 无需先缓存完整报文；占用内存只与嵌套深度及单个字符串长度有关
+ *
+ * @code
+ * cson_decoder_t *dec = cson_decoder_create_ex(user_model);
+ * while ((len = recv(fd, buf, sizeof(buf), 0)) > 0)
+ * {
+ *     if (cson_decoder_feed(dec, buf, len) != CSON_DECODER_NEED_MORE)
+ *         break;
+ * }
+ * user_t *user = cson_decoder_result(dec);
+ * cson_decoder_destroy(dec);
+ * @endcode
+ *
+ * @addtogroup CSON_DECODER
+ * @{
+ */
+
+/**
+ * @brief 绑定到数据模型的容器的最大嵌套深度
+ *
+ */
+#ifndef CSON_DECODER_DEPTH_MAX
+#define CSON_DECODER_DEPTH_MAX 32
+#endif
+
+/**
+ * @brief 跳过的子树(无对应字段的值)内的最大嵌套深度，与cJSON的`CJSON_NESTING_LIMIT`一致
+ *
+ * 跳过的容器不占用容器栈，每层只记录1位
+ */
+#ifndef CSON_DECODER_SKIP_DEPTH_MAX
+#define CSON_DECODER_SKIP_DEPTH_MAX 1000
+#endif
+
+/**
+ * @brief 解析状态
+ *
+ */
+typedef enum
+{
+        CSON_DECODER_ERROR = -1,    /**< 解析出错 */
+        CSON_DECODER_NEED_MORE = 0, /**< 需要更多数据 */
+        CSON_DECODER_DONE = 1,      /**< 解析完成 */
+} cson_decoder_status_t;
+
+/**
+ * @brief 推送式解析器
+ *
+ */
+typedef struct cson_decoder cson_decoder_t;
+
+/**
+ * @brief 创建推送式解析器
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return cson_decoder_t* 解析器
+ */
+cson_decoder_t *cson_decoder_create(cson_model_t *model, int model_size);
+
+/**
+ * @brief 创建推送式解析器
+ *
+ * @param model 数据模型
+ * @return cson_decoder_t* 解析器
+ */
+#define cson_decoder_create_ex(model) \
+        cson_decoder_create(model, sizeof(model) / sizeof(cson_model_t))
+
+/**
+ * @brief 送入一段JSON数据
+ *
+ * @param dec 解析器
+ * @param chunk 数据
+ * @param len 数据长度
+ * @return cson_decoder_status_t 解析状态
+ * @note 返回`CSON_DECODER_DONE`后，本段数据中属于下一个报文的部分不会被消费，
+ *       可通过`cson_decoder_consumed`获取本段已消费的长度；同名字段取第一个，与`cson_decode`一致
+ */
+cson_decoder_status_t cson_decoder_feed(cson_decoder_t *dec, const char *chunk, size_t len);
+
+/**
+ * @brief 数据已全部送入，结束解析
+ *
+ * 顶层为数字时没有结束符，只有在此确定数字结束；报文不完整时返回`CSON_DECODER_ERROR`
+ *
+ * @param dec 解析器
+ * @return cson_decoder_status_t 解析完成返回`CSON_DECODER_DONE`，否则返回`CSON_DECODER_ERROR`
+ */
+cson_decoder_status_t cson_decoder_finish(cson_decoder_t *dec);
+
+/**
+ * @brief 获取最近一次送入数据中已消费的长度
+ *
+ * @param dec 解析器
+ * @return size_t 已消费长度
+ */
+size_t cson_decoder_consumed(cson_decoder_t *dec);
+
+/**
+ * @brief 取出解析结果
+ *
+ * @param dec 解析器
+ * @return void* 解析得到的对象，使用`cson_free`释放，未完成时返回NULL
+ */
+void *cson_decoder_result(cson_decoder_t *dec);
+
+/**
+ * @brief 重置解析器，准备解析下一个报文
+ *
+ * @param dec 解析器
+ * @note 未取出的解析结果会被释放
+ */
+void cson_decoder_reset(cson_decoder_t *dec);
+
+/**
+ * @brief 销毁推送式解析器
+ *
+ * @param dec 解析器
+ */
+void cson_decoder_destroy(cson_decoder_t *dec);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,193 @@
+/**
+ * @file cson_internal.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#ifndef __CSON_INTERNAL_H__
+#define __CSON_INTERNAL_H__
+
+#include "cson.h"
+#include "cson_phase.h"
+#include "cson_profile.h"
+
+/**
+ * @defgroup CSON_INTERNAL cson internal
+ * @brief cson各模块共用的内部定义，不属于公开接口
+ *
+ * @addtogroup CSON_INTERNAL
+ * @{
+ */
+
+/**
+ * @brief 判断数据模型是否为基础类型链表模型
+ *
+ * @param model 数据模型
+ * @return char 是否为基础类型链表模型
+ */
+char cson_model_is_basic(const cson_model_t *model);
+
+/**
+ * @brief 基础类型数据大小
+ *
+ * @param type 数据类型
+ * @return size_t 类型大小，字符串和JSON为指针大小，非基础类型为0
+ */
+size_t cson_model_type_size(cson_type_t type);
+
+/**
+ * @brief 获取模型对象大小
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return size_t 对象大小
+ */
+size_t cson_model_obj_size(const cson_model_t *model, int model_size);
+
+/**
+ * @brief 按数据模型分配对象并清零
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 对象，分配失败返回NULL
+ */
+void *cson_model_new_obj(const cson_model_t *model, int model_size);
+
+/**
+ * @brief 浮点数转整型，超出范围时取边界值，NaN取0
+ *
+ * @param num 浮点数
+ * @return long long 整型数
+ */
+long long cson_number_integer(double num);
+
+/**
+ * @brief 按数据类型写入数值，各编解码器共用，保证与JSON路径的截断规则一致
+ *
+ * @param type 数据类型
+ * @param addr 写入地址
+ * @param integer 整型值
+ * @param real 浮点值
+ */
+void cson_model_store_number(cson_type_t type, void *addr, long long integer, double real);
+
+#if CSON_STATS_ENABLE || CSON_PHASE_ENABLE || CSON_PROFILE_ENABLE
+#include "stdatomic.h"
+#include "stdlib.h"
+#include "time.h"
+
+#if defined(_MSC_VER)
+#define CSON_TLS __declspec(thread)
+#elif defined(__GNUC__)
+#define CSON_TLS __thread
+#else
+#define CSON_TLS _Thread_local
+#endif
+
+/**
+ * @brief 单调时钟
+ *
+ * @return unsigned long long 时间(ns)
+ */
+static inline unsigned long long cson_clock_now(void)
+{
+    struct timespec ts;
+#if defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+/**
+ * @brief 线程块链表节点，作为各模块线程块的首个成员
+ *
+ */
+typedef struct cson_thread_node
+{
+        struct cson_thread_node *next;
+        atomic_uint epoch; /**< 所属的清零周期，与全局周期不一致时视为已清零 */
+} cson_thread_node_t;
+
+/**
+ * @brief 线程块链表
+ *
+ * 线程块仅由所属线程写入，首次访问时挂入链表，线程退出后保留，其计数仍计入全局汇总；
+ * 全局清零只递增周期，各线程在下一次访问时自行清零，汇总时跳过周期不一致的线程块
+ */
+typedef struct
+{
+        _Atomic(cson_thread_node_t *) head;
+        atomic_uint epoch;
+} cson_thread_list_t;
+
+/**
+ * @brief 获取当前线程的线程块，首次访问时分配并挂入链表，全局清零后首次访问时清零
+ *
+ * @param list 线程块链表
+ * @param local 保存当前线程线程块的线程局部变量
+ * @param size 线程块大小
+ * @param clear 清零线程块计数
+ * @return cson_thread_node_t* 线程块，分配失败返回NULL
+ * @note 线程块使用calloc分配，不经过`cson_init`指定的分配函数，避免统计自身
+ */
+static inline cson_thread_node_t *cson_thread_local(cson_thread_list_t *list, cson_thread_node_t **local,
+                                                    size_t size, void (*clear)(cson_thread_node_t *))
+{
+    cson_thread_node_t *node = *local;
+    unsigned int epoch = atomic_load_explicit(&list->epoch, memory_order_relaxed);
+
+    if (!node)
+    {
+        node = calloc(1, size);
+        if (!node)
+        {
+            return NULL;
+        }
+        atomic_init(&node->epoch, epoch);
+        node->next = atomic_load_explicit(&list->head, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&list->head, &node->next, node,
+                                                      memory_order_release, memory_order_relaxed))
+        {
+        }
+        *local = node;
+    }
+    else if (atomic_load_explicit(&node->epoch, memory_order_relaxed) != epoch)
+    {
+        clear(node);
+        atomic_store_explicit(&node->epoch, epoch, memory_order_release);
+    }
+    return node;
+}
+
+/**
+ * @brief 清零全部线程块，各线程在下一次访问时生效
+ *
+ * @param list 线程块链表
+ */
+static inline void cson_thread_reset(cson_thread_list_t *list)
+{
+    atomic_fetch_add_explicit(&list->epoch, 1, memory_order_relaxed);
+}
+
+/**
+ * @brief 遍历当前清零周期内的线程块
+ *
+ * @param node 线程块变量
+ * @param list 线程块链表
+ */
+#define CSON_THREAD_FOREACH(node, list) \
+        for (cson_thread_node_t *node = atomic_load_explicit(&(list)->head, memory_order_acquire); node; node = node->next) \
+                if (atomic_load_explicit(&node->epoch, memory_order_acquire) == atomic_load_explicit(&(list)->epoch, memory_order_relaxed))
+#endif
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,1316 @@
+/**
+ * @file cson_msgpack.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#include "cson_msgpack.h"
+#include "cson_internal.h"
+#include "cJSON.h"
+#include "stddef.h"
+#include "string.h"
+#include "stdio.h"
+#include "limits.h"
+#include "ctype.h"
+
+/**
+ * @brief MessagePack值类型
+ *
+ */
+typedef enum
+{
+    CSON_MP_NIL = 0,
+    CSON_MP_BOOL,
+    CSON_MP_INT,
+    CSON_MP_FLOAT,
+    CSON_MP_STR,
+    CSON_MP_BIN,
+    CSON_MP_ARRAY,
+    CSON_MP_MAP,
+    CSON_MP_EXT,
+} cson_mp_kind_t;
+
+/**
+ * @brief MessagePack值头部
+ *
+ */
+typedef struct
+{
+    cson_mp_kind_t kind;      /**< 值类型 */
+    long long i;              /**< 整型值/布尔值 */
+    double d;                 /**< 浮点值 */
+    size_t size;              /**< 字符串长度/数组及map成员数量 */
+    const unsigned char *ptr; /**< 字符串/二进制数据 */
+} cson_mp_value_t;
+
+/**
+ * @brief 编码缓冲
+ *
+ */
+typedef struct
+{
+    unsigned char *buf; /**< 缓冲 */
+    size_t len;         /**< 已写入长度 */
+    size_t cap;         /**< 缓冲容量 */
+    signed char error;  /**< 是否出错 */
+} cson_mp_writer_t;
+
+/**
+ * @brief 解码游标
+ *
+ */
+typedef struct
+{
+    const unsigned char *data; /**< 数据 */
+    size_t len;                /**< 数据长度 */
+    size_t pos;                /**< 当前位置 */
+    signed char error;         /**< 是否出错 */
+} cson_mp_reader_t;
+
+/**
+ * @brief 预留编码缓冲空间
+ *
+ * @param w 编码缓冲
+ * @param n 需要的字节数
+ * @return unsigned char* 写入位置，失败返回NULL
+ */
+static unsigned char *_cson_mp_reserve(cson_mp_writer_t *w, size_t n)
+{
+    if (w->error)
+    {
+        return NULL;
+    }
+    if (w->len + n > w->cap)
+    {
+        size_t cap = w->cap ? w->cap : CSON_MSGPACK_BUFFER_SIZE;
+        unsigned char *p;
+        while (cap < w->len + n)
+        {
+            cap *= 2;
+        }
+        p = cson_mem_alloc(cap);
+        if (!p)
+        {
+            w->error = 1;
+            return NULL;
+        }
+        if (w->buf)
+        {
+            memcpy(p, w->buf, w->len);
+            cson_mem_free(w->buf);
+        }
+        w->buf = p;
+        w->cap = cap;
+    }
+    w->len += n;
+    return w->buf + w->len - n;
+}
+
+/**
+ * @brief 写入类型标记及大端序数值
+ *
+ * @param w 编码缓冲
+ * @param tag 类型标记
+ * @param value 数值
+ * @param bytes 数值字节数
+ */
+static void _cson_mp_write_be(cson_mp_writer_t *w, unsigned char tag, unsigned long long value, int bytes)
+{
+    unsigned char *p = _cson_mp_reserve(w, 1 + bytes);
+    if (!p)
+    {
+        return;
+    }
+    *p = tag;
+    for (int i = bytes; i > 0; i--)
+    {
+        p[i] = (unsigned char)value;
+        value >>= 8;
+    }
+}
+
+/**
+ * @brief 写入nil
+ *
+ * @param w 编码缓冲
+ */
+static void _cson_mp_write_nil(cson_mp_writer_t *w)
+{
+    _cson_mp_write_be(w, 0xc0, 0, 0);
+}
+
+/**
+ * @brief 写入整型，使用最短编码
+ *
+ * @param w 编码缓冲
+ * @param value 整型值
+ */
+static void _cson_mp_write_int(cson_mp_writer_t *w, long long value)
+{
+    if (value >= 0)
+    {
+        if (value < 0x80)
+            _cson_mp_write_be(w, (unsigned char)value, 0, 0);
+        else if (value <= 0xff)
+            _cson_mp_write_be(w, 0xcc, (unsigned long long)value, 1);
+        else if (value <= 0xffff)
+            _cson_mp_write_be(w, 0xcd, (unsigned long long)value, 2);
+        else if (value <= 0xffffffffLL)
+            _cson_mp_write_be(w, 0xce, (unsigned long long)value, 4);
+        else
+            _cson_mp_write_be(w, 0xcf, (unsigned long long)value, 8);
+    }
+    else
+    {
+        if (value >= -32)
+            _cson_mp_write_be(w, (unsigned char)(value & 0xff), 0, 0);
+        else if (value >= -128)
+            _cson_mp_write_be(w, 0xd0, (unsigned long long)value, 1);
+        else if (value >= -32768)
+            _cson_mp_write_be(w, 0xd1, (unsigned long long)value, 2);
+        else if (value >= -2147483647LL - 1)
+            _cson_mp_write_be(w, 0xd2, (unsigned long long)value, 4);
+        else
+            _cson_mp_write_be(w, 0xd3, (unsigned long long)value, 8);
+    }
+}
+
+/**
+ * @brief 写入float32
+ *
+ * @param w 编码缓冲
+ * @param value 浮点值
+ */
+static void _cson_mp_write_float(cson_mp_writer_t *w, float value)
+{
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    _cson_mp_write_be(w, 0xca, bits, 4);
+}
+
+/**
+ * @brief 写入float64
+ *
+ * @param w 编码缓冲
+ * @param value 浮点值
+ */
+static void _cson_mp_write_double(cson_mp_writer_t *w, double value)
+{
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+    _cson_mp_write_be(w, 0xcb, bits, 8);
+}
+
+/**
+ * @brief 写入字符串
+ *
+ * @param w 编码缓冲
+ * @param str 字符串
+ * @param len 字符串长度
+ */
+static void _cson_mp_write_str(cson_mp_writer_t *w, const char *str, size_t len)
+{
+    unsigned char *p;
+
+    if (len < 32)
+        _cson_mp_write_be(w, (unsigned char)(0xa0 | len), 0, 0);
+    else if (len <= 0xff)
+        _cson_mp_write_be(w, 0xd9, len, 1);
+    else if (len <= 0xffff)
+        _cson_mp_write_be(w, 0xda, len, 2);
+    else
+        _cson_mp_write_be(w, 0xdb, len, 4);
+    p = _cson_mp_reserve(w, len);
+    if (p && len)
+    {
+        memcpy(p, str, len);
+    }
+}
+
+/**
+ * @brief 写入容器头部
+ *
+ * @param w 编码缓冲
+ * @param map 是否为map
+ * @param count 成员数量
+ */
+static void _cson_mp_write_container(cson_mp_writer_t *w, char map, size_t count)
+{
+    if (count < 16)
+        _cson_mp_write_be(w, (unsigned char)((map ? 0x80 : 0x90) | count), 0, 0);
+    else if (count <= 0xffff)
+        _cson_mp_write_be(w, map ? 0xde : 0xdc, count, 2);
+    else
+        _cson_mp_write_be(w, map ? 0xdf : 0xdd, count, 4);
+}
+
+/**
+ * @brief cJSON对象编码成MessagePack
+ *
+ * @param w 编码缓冲
+ * @param item cJSON对象
+ */
+static void _cson_mp_write_cjson(cson_mp_writer_t *w, cJSON *item)
+{
+    cJSON *child;
+
+    switch (item->type & 0xFF)
+    {
+    case cJSON_False:
+    case cJSON_True:
+        _cson_mp_write_be(w, (item->type & 0xFF) == cJSON_True ? 0xc3 : 0xc2, 0, 0);
+        break;
+    case cJSON_Number:
+        if (item->valuedouble >= -9.2e18 && item->valuedouble <= 9.2e18
+            && item->valuedouble == (double)(long long)item->valuedouble)
+        {
+            _cson_mp_write_int(w, (long long)item->valuedouble);
+        }
+        else
+        {
+            _cson_mp_write_double(w, item->valuedouble);
+        }
+        break;
+    case cJSON_String:
+    case cJSON_Raw:
+        _cson_mp_write_str(w, item->valuestring ? item->valuestring : "",
+                           item->valuestring ? strlen(item->valuestring) : 0);
+        break;
+    case cJSON_Array:
+    case cJSON_Object:
+        _cson_mp_write_container(w, (item->type & 0xFF) == cJSON_Object, (size_t)cJSON_GetArraySize(item));
+        for (child = item->child; child; child = child->next)
+        {
+            if ((item->type & 0xFF) == cJSON_Object)
+            {
+                _cson_mp_write_str(w, child->string ? child->string : "",
+                                   child->string ? strlen(child->string) : 0);
+            }
+            _cson_mp_write_cjson(w, child);
+        }
+        break;
+    default:
+        _cson_mp_write_nil(w);
+        break;
+    }
+}
+
+/**
+ * @brief 基础类型编码成MessagePack
+ *
+ * @param w 编码缓冲
+ * @param type 数据类型
+ * @param addr 数据地址
+ */
+static void _cson_mp_write_scalar(cson_mp_writer_t *w, cson_type_t type, void *addr)
+{
+    char *str;
+    cJSON *json;
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+        _cson_mp_write_int(w, *(char *)addr);
+        break;
+    case CSON_TYPE_SHORT:
+        _cson_mp_write_int(w, *(short *)addr);
+        break;
+    case CSON_TYPE_INT:
+        _cson_mp_write_int(w, *(int *)addr);
+        break;
+    case CSON_TYPE_LONG:
+        _cson_mp_write_int(w, *(long *)addr);
+        break;
+    case CSON_TYPE_FLOAT:
+        _cson_mp_write_float(w, *(float *)addr);
+        break;
+    case CSON_TYPE_DOUBLE:
+        _cson_mp_write_double(w, *(double *)addr);
+        break;
+    case CSON_TYPE_BOOL:
+        _cson_mp_write_be(w, *(char *)addr ? 0xc3 : 0xc2, 0, 0);
+        break;
+    case CSON_TYPE_STRING:
+        str = *(char **)addr;
+        if (str)
+            _cson_mp_write_str(w, str, strlen(str));
+        else
+            _cson_mp_write_nil(w);
+        break;
+    case CSON_TYPE_JSON:
+        json = *(char **)addr ? cJSON_Parse(*(char **)addr) : NULL;
+        if (json)
+        {
+            _cson_mp_write_cjson(w, json);
+            cJSON_Delete(json);
+        }
+        else
+        {
+            _cson_mp_write_nil(w);
+        }
+        break;
+    default:
+        _cson_mp_write_nil(w);
+        break;
+    }
+}
+
+static void _cson_mp_write_object(cson_mp_writer_t *w, void *obj, cson_model_t *model, int model_size);
+
+/**
+ * @brief CsonList编码成MessagePack数组
+ *
+ * @param w 编码缓冲
+ * @param list 链表
+ * @param model 链表元素模型
+ * @param model_size 链表元素模型数量
+ */
+static void _cson_mp_write_list(cson_mp_writer_t *w, cson_list_t *list, cson_model_t *model, int model_size)
+{
+    char basic = cson_model_is_basic(model);
+    size_t count = 0;
+    cson_list_t *p;
+
+    for (p = list; p; p = p->next)
+    {
+        if (basic || p->obj)
+        {
+            count++;
+        }
+    }
+    _cson_mp_write_container(w, 0, count);
+    for (p = list; p; p = p->next)
+    {
+        if (basic)
+        {
+            _cson_mp_write_scalar(w, model[1].type, &p->obj);
+        }
+        else if (p->obj)
+        {
+            _cson_mp_write_object(w, p->obj, model, model_size);
+        }
+    }
+}
+
+/**
+ * @brief vector编码成MessagePack数组
+ *
+ * @param w 编码缓冲
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ */
+static void _cson_mp_write_vector(cson_mp_writer_t *w, cson_vector_t *vec, cson_model_t *model, int model_size)
+{
+    size_t ele_size = cson_model_obj_size(model, model_size);
+    void *ele;
+
+    _cson_mp_write_container(w, 0, vec->count);
+    for (size_t i = 0; i < vec->count && !w->error; i++)
+    {
+        ele = (void *)((size_t)vec->data + i * ele_size);
+        if (cson_model_is_basic(model))
+        {
+            _cson_mp_write_scalar(w, model[1].type, ele);
+        }
+        else
+        {
+            _cson_mp_write_object(w, ele, model, model_size);
+        }
+    }
+}
+
+/**
+ * @brief 侵入式链表编码成MessagePack数组
+ *
+ * @param w 编码缓冲
+ * @param head 首元素
+ * @param field 字段模型
+ */
+static void _cson_mp_write_ilist(cson_mp_writer_t *w, void *head, cson_model_t *field)
+{
+    size_t count = 0;
+    void *p;
+
+    for (p = head; p; p = *(void **)((size_t)p + field->param.ilist.next))
+    {
+        count++;
+    }
+    _cson_mp_write_container(w, 0, count);
+    for (p = head; p && !w->error; p = *(void **)((size_t)p + field->param.ilist.next))
+    {
+        _cson_mp_write_object(w, p, field->param.ilist.model, field->param.ilist.size);
+    }
+}
+
+/**
+ * @brief 对象编码成MessagePack map
+ *
+ * @param w 编码缓冲
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ */
+static void _cson_mp_write_object(cson_mp_writer_t *w, void *obj, cson_model_t *model, int model_size)
+{
+    size_t count = 0;
+    void *addr;
+    size_t ele_size;
+    char *end;
+
+    if (!obj)
+    {
+        _cson_mp_write_nil(w);
+        return;
+    }
+    for (short i = 0; i < model_size; i++)
+    {
+        if (model[i].type != CSON_TYPE_OBJ && model[i].key)
+        {
+            count++;
+        }
+    }
+    _cson_mp_write_container(w, 1, count);
+    for (short i = 0; i < model_size && !w->error; i++)
+    {
+        if (model[i].type == CSON_TYPE_OBJ || !model[i].key)
+        {
+            continue;
+        }
+        _cson_mp_write_str(w, model[i].key, strlen(model[i].key));
+        addr = (void *)((size_t)obj + model[i].offset);
+        switch (model[i].type)
+        {
+        case CSON_TYPE_STRUCT:
+            _cson_mp_write_object(w, *(void **)addr, model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_LIST:
+            if (*(cson_list_t **)addr)
+                _cson_mp_write_list(w, *(cson_list_t **)addr, model[i].param.sub.model, model[i].param.sub.size);
+            else
+                _cson_mp_write_nil(w);
+            break;
+        case CSON_TYPE_VECTOR:
+            _cson_mp_write_vector(w, (cson_vector_t *)addr, model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_ILIST:
+            if (*(void **)addr)
+                _cson_mp_write_ilist(w, *(void **)addr, &model[i]);
+            else
+                _cson_mp_write_nil(w);
+            break;
+        case CSON_TYPE_EMBED:
+            _cson_mp_write_object(w, addr, model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_EMBED_ARRAY:
+            ele_size = cson_model_obj_size(model[i].param.embeds.model, model[i].param.embeds.size);
+            count = (size_t)cson_embeds_count(obj, &model[i]);
+            _cson_mp_write_container(w, 0, count);
+            for (size_t j = 0; j < count; j++)
+            {
+                _cson_mp_write_object(w, (void *)((size_t)addr + j * ele_size), model[i].param.embeds.model,
+                                      model[i].param.embeds.size);
+            }
+            break;
+        case CSON_TYPE_CHAR_ARRAY:
+            end = memchr(addr, 0, model[i].param.chars.size);
+            _cson_mp_write_str(w, (char *)addr, end ? (size_t)(end - (char *)addr) : (size_t)model[i].param.chars.size);
+            break;
+        case CSON_TYPE_ARRAY:
+            ele_size = cson_model_type_size(model[i].param.array.ele_type);
+            _cson_mp_write_container(w, 0, model[i].param.array.size);
+            for (short j = 0; j < model[i].param.array.size; j++)
+            {
+                _cson_mp_write_scalar(w, model[i].param.array.ele_type, (void *)((size_t)addr + j * ele_size));
+            }
+            break;
+        default:
+            _cson_mp_write_scalar(w, model[i].type, addr);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 编码成MessagePack
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param len 编码长度
+ * @return unsigned char* 编码得到的数据，使用`cson_msgpack_free`释放
+ */
+unsigned char *cson_msgpack_encode(void *obj, cson_model_t *model, int model_size, size_t *len)
+{
+    cson_mp_writer_t w = {NULL, 0, 0, 0};
+
+    CSON_STATS_ENTER(model);
+    _cson_mp_write_object(&w, obj, model, model_size);
+    if (w.error)
+    {
+        cson_mem_free(w.buf);
+        CSON_STATS_LEAVE();
+        return NULL;
+    }
+    CSON_STATS_LEAVE();
+    if (len)
+    {
+        *len = w.len;
+    }
+    return w.buf;
+}
+
+/**
+ * @brief 释放编码生成的数据
+ *
+ * @param data 数据
+ */
+void cson_msgpack_free(unsigned char *data)
+{
+    cson_mem_free(data);
+}
+
+/**
+ * @brief 读取大端序数值
+ *
+ * @param r 解码游标
+ * @param bytes 字节数
+ * @return unsigned long long 数值
+ */
+static unsigned long long _cson_mp_read_be(cson_mp_reader_t *r, int bytes)
+{
+    unsigned long long value = 0;
+
+    if (r->error || r->len - r->pos < (size_t)bytes)
+    {
+        r->error = 1;
+        return 0;
+    }
+    for (int i = 0; i < bytes; i++)
+    {
+        value = (value << 8) | r->data[r->pos++];
+    }
+    return value;
+}
+
+/**
+ * @brief 读取变长数据
+ *
+ * @param r 解码游标
+ * @param v 值头部
+ * @param kind 值类型
+ * @param size 数据长度
+ */
+static void _cson_mp_read_payload(cson_mp_reader_t *r, cson_mp_value_t *v, cson_mp_kind_t kind, size_t size)
+{
+    v->kind = kind;
+    v->size = size;
+    if (r->error || r->len - r->pos < size)
+    {
+        r->error = 1;
+        return;
+    }
+    v->ptr = r->data + r->pos;
+    r->pos += size;
+}
+
+/**
+ * @brief 读取值头部，字符串等变长数据一并跳过，容器成员不读取
+ *
+ * @param r 解码游标
+ * @param v 值头部
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_mp_read(cson_mp_reader_t *r, cson_mp_value_t *v)
+{
+    unsigned char tag;
+    unsigned long long u;
+
+    memset(v, 0, sizeof(cson_mp_value_t));
+    if (r->error || r->pos >= r->len)
+    {
+        r->error = 1;
+        return -1;
+    }
+    tag = r->data[r->pos++];
+    if (tag < 0x80 || tag >= 0xe0)
+    {
+        v->kind = CSON_MP_INT;
+        v->i = tag < 0x80 ? (long long)tag : (long long)(signed char)tag;
+    }
+    else if (tag < 0xa0)
+    {
+        v->kind = tag < 0x90 ? CSON_MP_MAP : CSON_MP_ARRAY;
+        v->size = tag & 0x0f;
+    }
+    else if (tag < 0xc0)
+    {
+        _cson_mp_read_payload(r, v, CSON_MP_STR, tag & 0x1f);
+    }
+    else
+    {
+        switch (tag)
+        {
+        case 0xc0:
+            v->kind = CSON_MP_NIL;
+            break;
+        case 0xc2:
+        case 0xc3:
+            v->kind = CSON_MP_BOOL;
+            v->i = tag & 0x01;
+            break;
+        case 0xc4:
+        case 0xc5:
+        case 0xc6:
+            u = _cson_mp_read_be(r, 1 << (tag - 0xc4));
+            _cson_mp_read_payload(r, v, CSON_MP_BIN, (size_t)u);
+            break;
+        case 0xc7:
+        case 0xc8:
+        case 0xc9:
+            u = _cson_mp_read_be(r, 1 << (tag - 0xc7));
+            _cson_mp_read_payload(r, v, CSON_MP_EXT, (size_t)u + 1);
+            break;
+        case 0xca:
+            {
+                unsigned int bits = (unsigned int)_cson_mp_read_be(r, 4);
+                float f;
+                memcpy(&f, &bits, sizeof(f));
+                v->kind = CSON_MP_FLOAT;
+                v->d = f;
+            }
+            break;
+        case 0xcb:
+            u = _cson_mp_read_be(r, 8);
+            v->kind = CSON_MP_FLOAT;
+            memcpy(&v->d, &u, sizeof(double));
+            break;
+        case 0xcc:
+        case 0xcd:
+        case 0xce:
+        case 0xcf:
+            u = _cson_mp_read_be(r, 1 << (tag - 0xcc));
+            v->kind = CSON_MP_INT;
+            v->i = u > (unsigned long long)LLONG_MAX ? LLONG_MAX : (long long)u;
+            break;
+        case 0xd0:
+            v->kind = CSON_MP_INT;
+            v->i = (signed char)_cson_mp_read_be(r, 1);
+            break;
+        case 0xd1:
+            v->kind = CSON_MP_INT;
+            v->i = (short)_cson_mp_read_be(r, 2);
+            break;
+        case 0xd2:
+            v->kind = CSON_MP_INT;
+            v->i = (int)_cson_mp_read_be(r, 4);
+            break;
+        case 0xd3:
+            v->kind = CSON_MP_INT;
+            v->i = (long long)_cson_mp_read_be(r, 8);
+            break;
+        case 0xd4:
+        case 0xd5:
+        case 0xd6:
+        case 0xd7:
+        case 0xd8:
+            _cson_mp_read_payload(r, v, CSON_MP_EXT, ((size_t)1 << (tag - 0xd4)) + 1);
+            break;
+        case 0xd9:
+        case 0xda:
+        case 0xdb:
+            u = _cson_mp_read_be(r, 1 << (tag - 0xd9));
+            _cson_mp_read_payload(r, v, CSON_MP_STR, (size_t)u);
+            break;
+        case 0xdc:
+        case 0xdd:
+            v->kind = CSON_MP_ARRAY;
+            v->size = (size_t)_cson_mp_read_be(r, tag == 0xdc ? 2 : 4);
+            break;
+        case 0xde:
+        case 0xdf:
+            v->kind = CSON_MP_MAP;
+            v->size = (size_t)_cson_mp_read_be(r, tag == 0xde ? 2 : 4);
+            break;
+        default:
+            r->error = 1;
+            break;
+        }
+    }
+    if (v->kind == CSON_MP_INT)
+    {
+        v->d = (double)v->i;
+    }
+    return r->error ? -1 : 0;
+}
+
+/**
+ * @brief 跳过已读取头部的值的剩余部分
+ *
+ * @param r 解码游标
+ * @param v 值头部
+ * @return signed char 0成功，-1失败
+ */
+static signed char _cson_mp_skip(cson_mp_reader_t *r, cson_mp_value_t *v)
+{
+    cson_mp_value_t item;
+    size_t pending = v->kind == CSON_MP_MAP ? v->size * 2 : (v->kind == CSON_MP_ARRAY ? v->size : 0);
+
+    while (pending && !r->error)
+    {
+        if (pending > r->len - r->pos)
+        {
+            r->error = 1;
+            break;
+        }
+        pending--;
+        if (_cson_mp_read(r, &item) != 0)
+        {
+            break;
+        }
+        pending += item.kind == CSON_MP_MAP ? item.size * 2 : (item.kind == CSON_MP_ARRAY ? item.size : 0);
+    }
+    return r->error ? -1 : 0;
+}
+
+/**
+ * @brief 复制MessagePack字符串
+ *
+ * @param v 值头部
+ * @return char* 新字符串
+ */
+static char *_cson_mp_dup(cson_mp_value_t *v)
+{
+    char *str = cson_mem_alloc(v->size + 1);
+    if (str)
+    {
+        if (v->size)
+        {
+            memcpy(str, v->ptr, v->size);
+        }
+        str[v->size] = 0;
+    }
+    return str;
+}
+
+/**
+ * @brief MessagePack值解码成cJSON对象
+ *
+ * @param r 解码游标
+ * @param v 值头部
+ * @param depth 嵌套深度
+ * @return cJSON* cJSON对象
+ */
+static cJSON *_cson_mp_read_cjson(cson_mp_reader_t *r, cson_mp_value_t *v, int depth)
+{
+    cson_mp_value_t key, item;
+    cJSON *json = NULL, *child;
+    char *str;
+
+    if (depth > CSON_MSGPACK_DEPTH_MAX)
+    {
+        r->error = 1;
+        return NULL;
+    }
+    switch (v->kind)
+    {
+    case CSON_MP_BOOL:
+        return cJSON_CreateBool((cJSON_bool)v->i);
+    case CSON_MP_INT:
+    case CSON_MP_FLOAT:
+        return cJSON_CreateNumber(v->d);
+    case CSON_MP_STR:
+        str = _cson_mp_dup(v);
+        json = str ? cJSON_CreateString(str) : NULL;
+        cson_mem_free(str);
+        return json;
+    case CSON_MP_ARRAY:
+    case CSON_MP_MAP:
+        json = v->kind == CSON_MP_MAP ? cJSON_CreateObject() : cJSON_CreateArray();
+        for (size_t i = 0; json && i < v->size && !r->error; i++)
+        {
+            str = NULL;
+            if (v->kind == CSON_MP_MAP)
+            {
+                if (_cson_mp_read(r, &key) != 0)
+                {
+                    break;
+                }
+                if (key.kind != CSON_MP_STR)
+                {
+                    _cson_mp_skip(r, &key);
+                    if (_cson_mp_read(r, &item) == 0)
+                    {
+                        _cson_mp_skip(r, &item);
+                    }
+                    continue;
+                }
+                str = _cson_mp_dup(&key);
+            }
+            if (_cson_mp_read(r, &item) != 0)
+            {
+                cson_mem_free(str);
+                break;
+            }
+            child = _cson_mp_read_cjson(r, &item, depth + 1);
+            if (!child)
+            {
+                r->error = 1;
+            }
+            else if (v->kind == CSON_MP_MAP)
+            {
+                cJSON_AddItemToObject(json, str ? str : "", child);
+            }
+            else
+            {
+                cJSON_AddItemToArray(json, child);
+            }
+            cson_mem_free(str);
+        }
+        return json;
+    default:
+        _cson_mp_skip(r, v);
+        return cJSON_CreateNull();
+    }
+}
+
+/**
+ * @brief 将值写入基础类型地址
+ *
+ * @param r 解码游标
+ * @param type 数据类型
+ * @param addr 写入地址
+ * @param v 值头部
+ * @param depth 嵌套深度
+ */
+static void _cson_mp_store(cson_mp_reader_t *r, cson_type_t type, void *addr, cson_mp_value_t *v, int depth)
+{
+    char number = v->kind == CSON_MP_INT || v->kind == CSON_MP_FLOAT;
+    cJSON *json;
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+    case CSON_TYPE_SHORT:
+    case CSON_TYPE_INT:
+    case CSON_TYPE_LONG:
+    case CSON_TYPE_FLOAT:
+    case CSON_TYPE_DOUBLE:
+        if (number)
+            cson_model_store_number(type, addr, v->kind == CSON_MP_INT ? v->i : cson_number_integer(v->d), v->d);
+        else
+            cson_model_store_number(type, addr, 0, 0.0);
+        break;
+    case CSON_TYPE_BOOL:
+        *(char *)addr = v->kind == CSON_MP_BOOL ? (char)v->i : 0;
+        break;
+    case CSON_TYPE_STRING:
+        if (v->kind == CSON_MP_STR && !*(char **)addr)
+        {
+            *(char **)addr = _cson_mp_dup(v);
+            r->error = *(char **)addr ? r->error : 1;
+        }
+        break;
+    case CSON_TYPE_JSON:
+        if (v->kind != CSON_MP_NIL && !*(char **)addr)
+        {
+            json = _cson_mp_read_cjson(r, v, depth);
+            *(char **)addr = json ? cJSON_PrintUnformatted(json) : NULL;
+            cJSON_Delete(json);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    _cson_mp_skip(r, v);
+}
+
+/**
+ * @brief 查找键值对应的字段
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param hint 优先尝试的字段
+ * @param key 键值
+ * @return int 字段下标，-1表示无对应字段
+ */
+static int _cson_mp_field(cson_model_t *model, int model_size, int hint, cson_mp_value_t *key)
+{
+    const unsigned char *a, *b;
+    size_t n;
+
+    for (int k = 0; k < model_size; k++)
+    {
+        int i = (hint + k) % model_size;
+        if (model[i].type == CSON_TYPE_OBJ || !model[i].key)
+        {
+            continue;
+        }
+        a = (const unsigned char *)model[i].key;
+        b = key->ptr;
+        for (n = 0; n < key->size && a[n] && tolower(a[n]) == tolower(b[n]); n++)
+        {
+        }
+        if (n == key->size && !a[n])
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void _cson_mp_read_object(cson_mp_reader_t *r, cson_mp_value_t *v, cson_model_t *model, int model_size,
+                                 void *obj, int depth);
+
+/**
+ * @brief 解码链表
+ *
+ * @param r 解码游标
+ * @param v 数组头部
+ * @param field 字段模型
+ * @param addr 字段地址
+ * @param depth 嵌套深度
+ */
+static void _cson_mp_read_list(cson_mp_reader_t *r, cson_mp_value_t *v, cson_model_t *field, void *addr, int depth)
+{
+    cson_model_t *model = field->param.sub.model;
+    char basic = cson_model_is_basic(model);
+    cson_list_t **tail = (cson_list_t **)addr;
+    cson_list_t *node;
+    cson_mp_value_t item;
+    void *obj;
+
+    while (*tail)
+    {
+        tail = &(*tail)->next;
+    }
+    for (size_t i = 0; i < v->size && !r->error; i++)
+    {
+        if (_cson_mp_read(r, &item) != 0)
+        {
+            break;
+        }
+        obj = NULL;
+        if (!basic)
+        {
+            if (item.kind != CSON_MP_MAP)
+            {
+                _cson_mp_skip(r, &item);
+                continue;
+            }
+            obj = cson_model_new_obj(model, field->param.sub.size);
+            if (!obj)
+            {
+                r->error = 1;
+                break;
+            }
+        }
+        node = cson_mem_alloc(sizeof(cson_list_t));
+        if (!node)
+        {
+            cson_mem_free(obj);
+            r->error = 1;
+            break;
+        }
+        memset(node, 0, sizeof(cson_list_t));
+        *tail = node;
+        tail = &node->next;
+        if (basic)
+        {
+            _cson_mp_store(r, model[1].type, &node->obj, &item, depth + 1);
+        }
+        else
+        {
+            node->obj = obj;
+            _cson_mp_read_object(r, &item, model, field->param.sub.size, obj, depth + 1);
+        }
+    }
+}
+
+/**
+ * @brief 解码侵入式链表，追加到已有元素之后
+ *
+ * @param r 解码游标
+ * @param v 数组头部
+ * @param field 字段模型
+ * @param addr 字段地址
+ * @param depth 嵌套深度
+ */
+static void _cson_mp_read_ilist(cson_mp_reader_t *r, cson_mp_value_t *v, cson_model_t *field, void *addr, int depth)
+{
+    void **tail = (void **)addr;
+    cson_mp_value_t item;
+    void *obj;
+
+    while (*tail)
+    {
+        tail = (void **)((size_t)*tail + field->param.ilist.next);
+    }
+    for (size_t i = 0; i < v->size && !r->error; i++)
+    {
+        if (_cson_mp_read(r, &item) != 0)
+        {
+            break;
+        }
+        if (item.kind != CSON_MP_MAP)
+        {
+            _cson_mp_skip(r, &item);
+            continue;
+        }
+        obj = cson_model_new_obj(field->param.ilist.model, field->param.ilist.size);
+        if (!obj)
+        {
+            r->error = 1;
+            break;
+        }
+        *tail = obj;
+        tail = (void **)((size_t)obj + field->param.ilist.next);
+        _cson_mp_read_object(r, &item, field->param.ilist.model, field->param.ilist.size, obj, depth + 1);
+    }
+}
+
+/**
+ * @brief 解码vector，按数组长度一次分配
+ *
+ * @param r 解码游标
+ * @param v 数组头部
+ * @param field 字段模型
+ * @param vec vector
+ * @param depth 嵌套深度
+ */
+static void _cson_mp_read_vector(cson_mp_reader_t *r, cson_mp_value_t *v, cson_model_t *field, cson_vector_t *vec,
+                                 int depth)
+{
+    cson_model_t *model = field->param.sub.model;
+    size_t ele_size = cson_model_obj_size(model, field->param.sub.size);
+    cson_mp_value_t item;
+    void *ele;
+
+    if (v->size > r->len - r->pos
+        || cson_vector_reserve(vec, model, field->param.sub.size, vec->count + v->size) != 0)
+    {
+        r->error = 1;
+        return;
+    }
+    for (size_t i = 0; i < v->size && !r->error; i++)
+    {
+        if (_cson_mp_read(r, &item) != 0)
+        {
+            break;
+        }
+        ele = (void *)((size_t)vec->data + vec->count++ * ele_size);
+        if (cson_model_is_basic(model))
+        {
+            _cson_mp_store(r, model[1].type, ele, &item, depth + 1);
+        }
+        else if (item.kind == CSON_MP_MAP)
+        {
+            _cson_mp_read_object(r, &item, model, field->param.sub.size, ele, depth + 1);
+        }
+        else
+        {
+            _cson_mp_skip(r, &item);
+        }
+    }
+}
+
+/**
+ * @brief 解码字段
+ *
+ * @param r 解码游标
+ * @param field 字段模型
+ * @param addr 字段地址
+ * @param depth 嵌套深度
+ */
+static void _cson_mp_read_field(cson_mp_reader_t *r, cson_model_t *field, void *addr, int depth)
+{
+    cson_mp_value_t v, item;
+    size_t ele_size;
+
+    if (_cson_mp_read(r, &v) != 0)
+    {
+        return;
+    }
+    switch (field->type)
+    {
+    case CSON_TYPE_STRUCT:
+        if (v.kind == CSON_MP_MAP && !*(void **)addr)
+        {
+            *(void **)addr = cson_model_new_obj(field->param.sub.model, field->param.sub.size);
+            if (!*(void **)addr)
+            {
+                r->error = 1;
+                return;
+            }
+            _cson_mp_read_object(r, &v, field->param.sub.model, field->param.sub.size, *(void **)addr, depth + 1);
+            return;
+        }
+        break;
+    case CSON_TYPE_LIST:
+        if (v.kind == CSON_MP_ARRAY)
+        {
+            _cson_mp_read_list(r, &v, field, addr, depth);
+            return;
+        }
+        break;
+    case CSON_TYPE_ILIST:
+        if (v.kind == CSON_MP_ARRAY)
+        {
+            _cson_mp_read_ilist(r, &v, field, addr, depth);
+            return;
+        }
+        break;
+    case CSON_TYPE_VECTOR:
+        if (v.kind == CSON_MP_ARRAY && !((cson_vector_t *)addr)->count)
+        {
+            _cson_mp_read_vector(r, &v, field, (cson_vector_t *)addr, depth);
+            return;
+        }
+        break;
+    case CSON_TYPE_EMBED:
+        if (v.kind == CSON_MP_MAP)
+        {
+            _cson_mp_read_object(r, &v, field->param.sub.model, field->param.sub.size, addr, depth + 1);
+            return;
+        }
+        break;
+    case CSON_TYPE_EMBED_ARRAY:
+        if (v.kind == CSON_MP_ARRAY)
+        {
+            ele_size = cson_model_obj_size(field->param.embeds.model, field->param.embeds.size);
+            for (size_t i = 0; i < v.size && !r->error; i++)
+            {
+                if (_cson_mp_read(r, &item) != 0)
+                {
+                    break;
+                }
+                if (i < (size_t)field->param.embeds.capacity && item.kind == CSON_MP_MAP)
+                {
+                    _cson_mp_read_object(r, &item, field->param.embeds.model, field->param.embeds.size,
+                                         (void *)((size_t)addr + i * ele_size), depth + 1);
+                }
+                else
+                {
+                    _cson_mp_skip(r, &item);
+                }
+            }
+            cson_embeds_set_count((void *)((size_t)addr - field->offset), field,
+                                  v.size < (size_t)field->param.embeds.capacity ? (int)v.size : field->param.embeds.capacity);
+            return;
+        }
+        break;
+    case CSON_TYPE_CHAR_ARRAY:
+        if (v.kind == CSON_MP_STR && !*(char *)addr)
+        {
+            cson_chars_assign(addr, field, (const char *)v.ptr, v.size);
+        }
+        break;
+    case CSON_TYPE_ARRAY:
+        if (v.kind == CSON_MP_ARRAY)
+        {
+            ele_size = cson_model_type_size(field->param.array.ele_type);
+            for (size_t i = 0; i < v.size && !r->error; i++)
+            {
+                if (_cson_mp_read(r, &item) != 0)
+                {
+                    break;
+                }
+                if (i < (size_t)field->param.array.size && ele_size)
+                {
+                    _cson_mp_store(r, field->param.array.ele_type, (void *)((size_t)addr + i * ele_size), &item, depth + 1);
+                }
+                else
+                {
+                    _cson_mp_skip(r, &item);
+                }
+            }
+            return;
+        }
+        break;
+    default:
+        _cson_mp_store(r, field->type, addr, &v, depth + 1);
+        return;
+    }
+    _cson_mp_skip(r, &v);
+}
+
+/**
+ * @brief 解码map到对象
+ *
+ * @param r 解码游标
+ * @param v map头部
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param obj 对象
+ * @param depth 嵌套深度
+ */
+static void _cson_mp_read_object(cson_mp_reader_t *r, cson_mp_value_t *v, cson_model_t *model, int model_size,
+                                 void *obj, int depth)
+{
+    cson_mp_value_t key, item;
+    int hint = 0;
+    int field;
+
+    if (depth > CSON_MSGPACK_DEPTH_MAX)
+    {
+        r->error = 1;
+        return;
+    }
+    for (size_t i = 0; i < v->size && !r->error; i++)
+    {
+        if (_cson_mp_read(r, &key) != 0)
+        {
+            break;
+        }
+        field = key.kind == CSON_MP_STR ? _cson_mp_field(model, model_size, hint, &key) : -1;
+        if (field < 0)
+        {
+            _cson_mp_skip(r, &key);
+            if (_cson_mp_read(r, &item) == 0)
+            {
+                _cson_mp_skip(r, &item);
+            }
+            continue;
+        }
+        hint = field + 1;
+        _cson_mp_read_field(r, &model[field], (void *)((size_t)obj + model[field].offset), depth);
+    }
+}
+
+/**
+ * @brief 解析MessagePack
+ *
+ * @param data 数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 解析得到的对象，使用`cson_free`释放
+ */
+void *cson_msgpack_decode(const unsigned char *data, size_t len, cson_model_t *model, int model_size)
+{
+    cson_mp_reader_t r = {data, len, 0, 0};
+    cson_mp_value_t v;
+    void *obj;
+
+    CSON_ASSERT(data, return NULL);
+    if (_cson_mp_read(&r, &v) != 0 || v.kind != CSON_MP_MAP)
+    {
+        return NULL;
+    }
+    CSON_STATS_ENTER(model);
+    obj = cson_model_new_obj(model, model_size);
+    CSON_ASSERT(obj, CSON_STATS_LEAVE(); return NULL);
+    _cson_mp_read_object(&r, &v, model, model_size, obj, 0);
+    if (r.error)
+    {
+        cson_free(obj, model, model_size);
+        obj = NULL;
+    }
+    CSON_STATS_LEAVE();
+    return obj;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file cson_msgpack.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#ifndef __CSON_MSGPACK_H__
+#define __CSON_MSGPACK_H__
+
+#include "cson.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @defgroup CSON_MSGPACK cson msgpack
+ * @brief 基于数据模型的MessagePack编解码
+ *
+ * 与JSON共用同一份`cson_model_t`，结构体编码为以字段键值为key的map，
+ * 编解码过程直接读写二进制，不构建中间DOM
+ *
+ * @code
+ * size_t len;
+ * unsigned char *buf = cson_msgpack_encode_ex(user, user_model, &len);
+ * user_t *copy = cson_msgpack_decode_ex(buf, len, user_model);
+ * cson_msgpack_free(buf);
+ * cson_free_ex(copy, user_model);
+ * @endcode
+ *
+ * @addtogroup CSON_MSGPACK
+ * @{
+ */
+
+/**
+ * @brief 解码时最大嵌套深度
+ *
+ */
+#ifndef CSON_MSGPACK_DEPTH_MAX
+#define CSON_MSGPACK_DEPTH_MAX 32
+#endif
+
+/**
+ * @brief 编码缓冲初始大小
+ *
+ */
+#ifndef CSON_MSGPACK_BUFFER_SIZE
+#define CSON_MSGPACK_BUFFER_SIZE 256
+#endif
+
+/**
+ * @brief 编码成MessagePack
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param len 编码长度
+ * @return unsigned char* 编码得到的数据，使用`cson_msgpack_free`释放
+ */
+unsigned char *cson_msgpack_encode(void *obj, cson_model_t *model, int model_size, size_t *len);
+
+/**
+ * @brief 编码成MessagePack
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param len 编码长度
+ * @return unsigned char* 编码得到的数据
+ */
+#define cson_msgpack_encode_ex(obj, model, len) \
+        cson_msgpack_encode(obj, model, sizeof(model) / sizeof(cson_model_t), len)
+
+/**
+ * @brief 解析MessagePack
+ *
+ * @param data 数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 解析得到的对象，使用`cson_free`释放
+ * @note 未知字段及类型不匹配的值会被跳过，数据不完整时返回NULL
+ */
+void *cson_msgpack_decode(const unsigned char *data, size_t len, cson_model_t *model, int model_size);
+
+/**
+ * @brief 解析MessagePack
+ *
+ * @param data 数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @return void* 解析得到的对象
+ */
+#define cson_msgpack_decode_ex(data, len, model) \
+        cson_msgpack_decode(data, len, model, sizeof(model) / sizeof(cson_model_t))
+
+/**
+ * @brief 释放编码生成的数据
+ *
+ * @param data 数据
+ */
+void cson_msgpack_free(unsigned char *data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
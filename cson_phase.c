@@ -0,0 +1,360 @@
+/**
+ * @file cson_phase.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#if !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "cson_phase.h"
+#include "cson_internal.h"
+#include "stdio.h"
+#include "string.h"
+
+#if CSON_PHASE_ENABLE
+#define CSON_PHASE_MAX_NS ((1ULL << 40) - 1)
+
+/**
+ * @brief 线程直方图，仅由所属线程写入，读取时不加锁
+ *
+ */
+typedef struct
+{
+    atomic_ullong count;
+    atomic_ullong sum;
+    atomic_ullong min;
+    atomic_ullong max;
+    atomic_ullong buckets[CSON_PHASE_BUCKETS];
+} cson_phase_counter_t;
+
+/**
+ * @brief 线程统计块，首次计时时挂入全局链表，线程退出后保留
+ *
+ */
+typedef struct
+{
+    cson_thread_node_t node;
+    unsigned int ticks[CSON_PHASE_MAX]; /**< 各阶段的采样计数 */
+    cson_phase_counter_t phases[CSON_PHASE_MAX];
+} cson_phase_thread_t;
+
+static struct
+{
+    cson_thread_list_t threads;
+    atomic_uint interval;
+} s_cson_phase = {{NULL, 0}, CSON_PHASE_SAMPLE};
+
+static CSON_TLS cson_thread_node_t *s_cson_phase_thread = NULL;
+#endif
+
+static const char *s_cson_phase_name[CSON_PHASE_MAX] = {"parse", "bind", "build", "print", "delete", "free"};
+
+/**
+ * @brief 阶段名称
+ *
+ * @param phase 阶段
+ * @return const char* 名称，超出范围时为"unknown"
+ */
+const char *cson_phase_name(cson_phase_t phase)
+{
+    return phase < CSON_PHASE_MAX ? s_cson_phase_name[phase] : "unknown";
+}
+
+#if CSON_PHASE_ENABLE
+/**
+ * @brief 耗时所在的桶
+ *
+ * 小于2^SUB_BITS的值各占一个桶，其余按最高位所在的2的幂区间再均分为2^SUB_BITS个子桶
+ *
+ * @param ns 耗时
+ * @return int 桶序号
+ */
+static int _cson_phase_bucket(unsigned long long ns)
+{
+    int msb = 0;
+
+    if (ns < (1ULL << CSON_PHASE_SUB_BITS))
+    {
+        return (int)ns;
+    }
+    if (ns > CSON_PHASE_MAX_NS)
+    {
+        ns = CSON_PHASE_MAX_NS;
+    }
+    for (unsigned long long v = ns; v >>= 1;)
+    {
+        msb++;
+    }
+    return ((msb - CSON_PHASE_SUB_BITS + 1) << CSON_PHASE_SUB_BITS)
+           + (int)((ns >> (msb - CSON_PHASE_SUB_BITS)) & ((1ULL << CSON_PHASE_SUB_BITS) - 1));
+}
+
+/**
+ * @brief 清零线程直方图
+ *
+ * @param node 线程统计块
+ */
+static void _cson_phase_clear(cson_thread_node_t *node)
+{
+    cson_phase_thread_t *local = (cson_phase_thread_t *)node;
+
+    for (int i = 0; i < CSON_PHASE_MAX; i++)
+    {
+        cson_phase_counter_t *counter = &local->phases[i];
+        atomic_store_explicit(&counter->count, 0, memory_order_relaxed);
+        atomic_store_explicit(&counter->sum, 0, memory_order_relaxed);
+        atomic_store_explicit(&counter->min, 0, memory_order_relaxed);
+        atomic_store_explicit(&counter->max, 0, memory_order_relaxed);
+        for (int j = 0; j < CSON_PHASE_BUCKETS; j++)
+        {
+            atomic_store_explicit(&counter->buckets[j], 0, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief 获取当前线程的统计块，全局清零后首次访问时清零
+ *
+ * @return cson_phase_thread_t* 统计块
+ */
+static cson_phase_thread_t *_cson_phase_local(void)
+{
+    return (cson_phase_thread_t *)cson_thread_local(&s_cson_phase.threads, &s_cson_phase_thread,
+                                                    sizeof(cson_phase_thread_t), _cson_phase_clear);
+}
+
+/**
+ * @brief 读取线程直方图
+ *
+ * @param counter 线程直方图
+ * @param hist 直方图
+ */
+static void _cson_phase_read(cson_phase_counter_t *counter, cson_phase_hist_t *hist)
+{
+    hist->count = atomic_load_explicit(&counter->count, memory_order_relaxed);
+    hist->sum = atomic_load_explicit(&counter->sum, memory_order_relaxed);
+    hist->min = atomic_load_explicit(&counter->min, memory_order_relaxed);
+    hist->max = atomic_load_explicit(&counter->max, memory_order_relaxed);
+    for (int i = 0; i < CSON_PHASE_BUCKETS; i++)
+    {
+        hist->buckets[i] = atomic_load_explicit(&counter->buckets[i], memory_order_relaxed);
+    }
+}
+#endif
+
+/**
+ * @brief 设置采样间隔，对全部线程生效
+ *
+ * @param interval 每interval次计时一次，0视为1
+ */
+void cson_phase_sample(unsigned int interval)
+{
+#if CSON_PHASE_ENABLE
+    atomic_store_explicit(&s_cson_phase.interval, interval ? interval : 1, memory_order_relaxed);
+#else
+    (void)interval;
+#endif
+}
+
+/**
+ * @brief 开始计时，按阶段各自的计数采样
+ *
+ * @param phase 阶段
+ * @return unsigned long long 开始时间(ns)，未采样时为0
+ */
+unsigned long long cson_phase_begin(cson_phase_t phase)
+{
+#if CSON_PHASE_ENABLE
+    cson_phase_thread_t *local = _cson_phase_local();
+
+    if (!local || phase >= CSON_PHASE_MAX
+        || ++local->ticks[phase] < atomic_load_explicit(&s_cson_phase.interval, memory_order_relaxed))
+    {
+        return 0;
+    }
+    local->ticks[phase] = 0;
+    return cson_clock_now();
+#else
+    (void)phase;
+    return 0;
+#endif
+}
+
+/**
+ * @brief 结束计时，记录到当前线程的直方图
+ *
+ * @param phase 阶段
+ * @param start 开始时间，为0时不记录
+ */
+void cson_phase_end(cson_phase_t phase, unsigned long long start)
+{
+#if CSON_PHASE_ENABLE
+    cson_phase_thread_t *local = (cson_phase_thread_t *)s_cson_phase_thread;
+    cson_phase_counter_t *counter;
+    unsigned long long ns;
+    unsigned long long count;
+    atomic_ullong *bucket;
+
+    if (!start || !local || phase >= CSON_PHASE_MAX)
+    {
+        return;
+    }
+    ns = cson_clock_now() - start;
+    counter = &local->phases[phase];
+    count = atomic_load_explicit(&counter->count, memory_order_relaxed);
+    if (!count || ns < atomic_load_explicit(&counter->min, memory_order_relaxed))
+    {
+        atomic_store_explicit(&counter->min, ns, memory_order_relaxed);
+    }
+    if (ns > atomic_load_explicit(&counter->max, memory_order_relaxed))
+    {
+        atomic_store_explicit(&counter->max, ns, memory_order_relaxed);
+    }
+    bucket = &counter->buckets[_cson_phase_bucket(ns)];
+    atomic_store_explicit(bucket, atomic_load_explicit(bucket, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_store_explicit(&counter->sum, atomic_load_explicit(&counter->sum, memory_order_relaxed) + ns,
+                          memory_order_relaxed);
+    atomic_store_explicit(&counter->count, count + 1, memory_order_relaxed);
+#else
+    (void)phase;
+    (void)start;
+#endif
+}
+
+/**
+ * @brief 获取阶段耗时直方图
+ *
+ * @param phase 阶段
+ * @param scope 统计范围
+ * @param hist 直方图
+ * @return int 0成功，-1未启用统计
+ */
+int cson_phase_snapshot(cson_phase_t phase, cson_stats_scope_t scope, cson_phase_hist_t *hist)
+{
+    CSON_ASSERT(hist, return -1);
+    memset(hist, 0, sizeof(cson_phase_hist_t));
+#if CSON_PHASE_ENABLE
+    CSON_ASSERT(phase < CSON_PHASE_MAX, return -1);
+    if (scope == CSON_STATS_THREAD)
+    {
+        cson_phase_thread_t *local = _cson_phase_local();
+        if (local)
+        {
+            _cson_phase_read(&local->phases[phase], hist);
+        }
+    }
+    else
+    {
+        cson_phase_hist_t part;
+        CSON_THREAD_FOREACH(thread, &s_cson_phase.threads)
+        {
+            _cson_phase_read(&((cson_phase_thread_t *)thread)->phases[phase], &part);
+            cson_phase_merge(hist, &part);
+        }
+    }
+    return 0;
+#else
+    (void)phase;
+    (void)scope;
+    return -1;
+#endif
+}
+
+/**
+ * @brief 合并直方图
+ *
+ * @param dst 目标直方图
+ * @param src 源直方图
+ */
+void cson_phase_merge(cson_phase_hist_t *dst, const cson_phase_hist_t *src)
+{
+    CSON_ASSERT(dst && src, return);
+    if (!src->count)
+    {
+        return;
+    }
+    if (!dst->count || src->min < dst->min)
+    {
+        dst->min = src->min;
+    }
+    if (src->max > dst->max)
+    {
+        dst->max = src->max;
+    }
+    dst->count += src->count;
+    dst->sum += src->sum;
+    for (int i = 0; i < CSON_PHASE_BUCKETS; i++)
+    {
+        dst->buckets[i] += src->buckets[i];
+    }
+}
+
+/**
+ * @brief 计算百分位
+ *
+ * @param hist 直方图
+ * @param q 分位(0~1)
+ * @return unsigned long long 分位所在桶的上界(ns)
+ */
+unsigned long long cson_phase_percentile(const cson_phase_hist_t *hist, double q)
+{
+    unsigned long long rank;
+    unsigned long long seen = 0;
+
+    CSON_ASSERT(hist, return 0);
+    if (!hist->count)
+    {
+        return 0;
+    }
+    rank = q <= 0 ? 1 : (unsigned long long)(q * (double)hist->count + 0.5);
+    rank = rank < 1 ? 1 : (rank > hist->count ? hist->count : rank);
+    for (int i = 0; i < CSON_PHASE_BUCKETS; i++)
+    {
+        seen += hist->buckets[i];
+        if (seen >= rank)
+        {
+            unsigned long long upper;
+            if (i < (1 << CSON_PHASE_SUB_BITS))
+            {
+                upper = (unsigned long long)i;
+            }
+            else
+            {
+                int msb = (i >> CSON_PHASE_SUB_BITS) + CSON_PHASE_SUB_BITS - 1;
+                unsigned long long low = ((1ULL << CSON_PHASE_SUB_BITS) + (unsigned long long)(i & ((1 << CSON_PHASE_SUB_BITS) - 1)))
+                                         << (msb - CSON_PHASE_SUB_BITS);
+                upper = low + (1ULL << (msb - CSON_PHASE_SUB_BITS)) - 1;
+            }
+            return upper < hist->max ? upper : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+/**
+ * @brief 清零直方图
+ *
+ * @param scope 统计范围
+ */
+void cson_phase_reset(cson_stats_scope_t scope)
+{
+#if CSON_PHASE_ENABLE
+    if (scope == CSON_STATS_GLOBAL)
+    {
+        cson_thread_reset(&s_cson_phase.threads);
+    }
+    else if (s_cson_phase_thread)
+    {
+        _cson_phase_clear(s_cson_phase_thread);
+    }
+    _cson_phase_local();
+#else
+    (void)scope;
+#endif
+}
@@ -0,0 +1,181 @@
+/**
+ * @file cson_phase.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#ifndef __CSON_PHASE_H__
+#define __CSON_PHASE_H__
+
+#include "cson.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @defgroup CSON_PHASE cson phase
+ * @brief 分阶段耗时统计
+ *
+ * 分别记录JSON解析(`cJSON_Parse`)、绑定到结构体、构建cJSON树、输出字符串(`cJSON_Print*`)、
+ * 释放cJSON树及释放结构体各阶段的耗时，样本写入每个线程独立的对数-线性直方图，
+ * 写入不加锁，读取时按需汇总:
+ * @code
+ * cson_phase_sample(16);                         // 每16次采样一次
+ * ...
+ * cson_phase_hist_t hist;
+ * cson_phase_snapshot(CSON_PHASE_PARSE, CSON_STATS_GLOBAL, &hist);
+ * printf("parse p99: %llu ns\n", cson_phase_percentile(&hist, 0.99));
+ * @endcode
+ *
+ * @addtogroup CSON_PHASE
+ * @{
+ */
+
+/**
+ * @brief 是否启用分阶段耗时统计
+ *
+ * 为0时各阶段不计时，直方图始终为空；统计依赖C11原子操作
+ */
+#ifndef CSON_PHASE_ENABLE
+#define CSON_PHASE_ENABLE 0
+#endif
+
+/**
+ * @brief 默认采样间隔，每N次计时一次
+ *
+ */
+#ifndef CSON_PHASE_SAMPLE
+#define CSON_PHASE_SAMPLE 1
+#endif
+
+/**
+ * @brief 每个2的幂区间划分的子桶数量(以2为底的对数)，相对误差不超过1/16
+ *
+ */
+#define CSON_PHASE_SUB_BITS 4
+
+/**
+ * @brief 直方图桶数量，覆盖0 ~ 2^40ns
+ *
+ */
+#define CSON_PHASE_BUCKETS ((40 - CSON_PHASE_SUB_BITS + 1) << CSON_PHASE_SUB_BITS)
+
+/**
+ * @brief 处理阶段
+ *
+ */
+typedef enum
+{
+        CSON_PHASE_PARSE = 0, /**< 解析JSON字符串为cJSON树 */
+        CSON_PHASE_BIND,      /**< cJSON树绑定到结构体 */
+        CSON_PHASE_BUILD,     /**< 结构体构建cJSON树 */
+        CSON_PHASE_PRINT,     /**< cJSON树输出为字符串 */
+        CSON_PHASE_DELETE,    /**< 释放cJSON树 */
+        CSON_PHASE_FREE,      /**< 释放结构体 */
+        CSON_PHASE_MAX,
+} cson_phase_t;
+
+/**
+ * @brief 耗时直方图
+ *
+ */
+typedef struct
+{
+        unsigned long long count;                       /**< 样本数量 */
+        unsigned long long sum;                         /**< 耗时总和(ns) */
+        unsigned long long min;                         /**< 最小耗时(ns) */
+        unsigned long long max;                         /**< 最大耗时(ns) */
+        unsigned long long buckets[CSON_PHASE_BUCKETS]; /**< 各桶样本数量 */
+} cson_phase_hist_t;
+
+/**
+ * @brief 阶段名称
+ *
+ * @param phase 阶段
+ * @return const char* 名称
+ */
+const char *cson_phase_name(cson_phase_t phase);
+
+/**
+ * @brief 设置采样间隔
+ *
+ * @param interval 每interval次计时一次，0视为1
+ */
+void cson_phase_sample(unsigned int interval);
+
+/**
+ * @brief 开始计时
+ *
+ * 每个阶段独立计数采样，各阶段均按采样间隔记录
+ *
+ * @param phase 阶段
+ * @return unsigned long long 开始时间，本次未被采样时返回0
+ * @note 一般通过`CSON_PHASE_BEGIN`使用
+ */
+unsigned long long cson_phase_begin(cson_phase_t phase);
+
+/**
+ * @brief 结束计时，记录到当前线程的直方图
+ *
+ * @param phase 阶段
+ * @param start `cson_phase_begin`的返回值
+ */
+void cson_phase_end(cson_phase_t phase, unsigned long long start);
+
+/**
+ * @brief 获取阶段耗时直方图
+ *
+ * @param phase 阶段
+ * @param scope 统计范围，`CSON_STATS_GLOBAL`汇总全部线程
+ * @param hist 直方图
+ * @return int 0成功，-1未启用统计
+ */
+int cson_phase_snapshot(cson_phase_t phase, cson_stats_scope_t scope, cson_phase_hist_t *hist);
+
+/**
+ * @brief 合并直方图
+ *
+ * @param dst 目标直方图
+ * @param src 源直方图
+ */
+void cson_phase_merge(cson_phase_hist_t *dst, const cson_phase_hist_t *src);
+
+/**
+ * @brief 计算百分位
+ *
+ * @param hist 直方图
+ * @param q 分位(0~1)
+ * @return unsigned long long 分位所在桶的上界(ns)，不超过最大耗时
+ */
+unsigned long long cson_phase_percentile(const cson_phase_hist_t *hist, double q);
+
+/**
+ * @brief 清零直方图
+ *
+ * @param scope 统计范围，其他线程的直方图在该线程下一次计时时清零，此前不计入全局统计
+ */
+void cson_phase_reset(cson_stats_scope_t scope);
+
+#if CSON_PHASE_ENABLE
+#define CSON_PHASE_BEGIN(phase) unsigned long long _cson_phase_##phase = cson_phase_begin(CSON_PHASE_##phase)
+#define CSON_PHASE_END(phase) cson_phase_end(CSON_PHASE_##phase, _cson_phase_##phase)
+#else
+#define CSON_PHASE_BEGIN(phase)
+#define CSON_PHASE_END(phase)
+#endif
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
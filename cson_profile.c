@@ -0,0 +1,470 @@
+/**
+ * @file cson_profile.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#if !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "cson_profile.h"
+#include "cson_internal.h"
+#include "stdio.h"
+#include "string.h"
+
+#if CSON_PROFILE_ENABLE
+
+/**
+ * @brief 一种操作的计数
+ *
+ */
+typedef struct
+{
+    atomic_ullong count;
+    atomic_ullong time;
+    atomic_ullong alloc_count;
+    atomic_ullong alloc_bytes;
+    atomic_ullong miss;
+} cson_profile_counter_t;
+
+/**
+ * @brief 字段统计槽，以字段模型地址为键开放寻址，占用后不再释放
+ *
+ */
+typedef struct
+{
+    _Atomic(const cson_model_t *) field;
+    _Atomic(const cson_model_t *) model;
+    cson_profile_counter_t ops[CSON_PROFILE_OP_MAX];
+} cson_profile_slot_t;
+
+/**
+ * @brief 排序用的字段统计
+ *
+ */
+typedef struct
+{
+    double score;
+    cson_profile_entry_t entry;
+} cson_profile_rank_t;
+
+static struct
+{
+    cson_profile_slot_t slots[CSON_PROFILE_FIELD_MAX];
+    struct
+    {
+        _Atomic(const cson_model_t *) model;
+        const char *name;
+    } models[CSON_PROFILE_MODEL_MAX];
+    atomic_int named;
+} s_cson_profile;
+
+/**
+ * @brief 线程分配计数，字段开销为计时前后的差值
+ *
+ */
+static CSON_TLS struct
+{
+    unsigned long long count;
+    unsigned long long bytes;
+} s_cson_profile_alloc;
+
+/**
+ * @brief 查找字段统计槽，不存在时占用一个空槽
+ *
+ * @param model 所属数据模型
+ * @param field 字段模型
+ * @return cson_profile_slot_t* 统计槽，已满时返回NULL
+ */
+static cson_profile_slot_t *_cson_profile_slot(const cson_model_t *model, const cson_model_t *field)
+{
+    size_t start = ((size_t)field / sizeof(cson_model_t)) % CSON_PROFILE_FIELD_MAX;
+
+    for (size_t n = 0; n < CSON_PROFILE_FIELD_MAX; n++)
+    {
+        cson_profile_slot_t *slot = &s_cson_profile.slots[(start + n) % CSON_PROFILE_FIELD_MAX];
+        const cson_model_t *cur = atomic_load_explicit(&slot->field, memory_order_acquire);
+        if (cur == field)
+        {
+            return slot;
+        }
+        if (!cur)
+        {
+            if (atomic_compare_exchange_strong_explicit(&slot->field, &cur, field,
+                                                        memory_order_acq_rel, memory_order_acquire))
+            {
+                atomic_store_explicit(&slot->model, model, memory_order_release);
+                return slot;
+            }
+            if (cur == field)
+            {
+                return slot;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 查找数据模型名称
+ *
+ * @param model 数据模型
+ * @return const char* 名称，未命名时返回NULL
+ */
+static const char *_cson_profile_model_name(const cson_model_t *model)
+{
+    int named = atomic_load_explicit(&s_cson_profile.named, memory_order_acquire);
+
+    for (int i = 0; i < named && i < CSON_PROFILE_MODEL_MAX; i++)
+    {
+        if (atomic_load_explicit(&s_cson_profile.models[i].model, memory_order_acquire) == model)
+        {
+            return s_cson_profile.models[i].name;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 读取一种操作的计数
+ *
+ * @param counter 计数
+ * @param cost 开销
+ */
+static void _cson_profile_read(cson_profile_counter_t *counter, cson_profile_cost_t *cost)
+{
+    cost->count = atomic_load_explicit(&counter->count, memory_order_relaxed);
+    cost->time = atomic_load_explicit(&counter->time, memory_order_relaxed);
+    cost->alloc_count = atomic_load_explicit(&counter->alloc_count, memory_order_relaxed);
+    cost->alloc_bytes = atomic_load_explicit(&counter->alloc_bytes, memory_order_relaxed);
+    cost->miss = atomic_load_explicit(&counter->miss, memory_order_relaxed);
+}
+
+/**
+ * @brief 排序依据
+ *
+ * @param entry 字段统计
+ * @param sort 排序方式
+ * @return double 排序值
+ */
+static double _cson_profile_score(const cson_profile_entry_t *entry, cson_profile_sort_t sort)
+{
+    switch (sort)
+    {
+    case CSON_PROFILE_SORT_BYTES:
+        return (double)(entry->decode.alloc_bytes + entry->encode.alloc_bytes);
+    case CSON_PROFILE_SORT_ALLOCS:
+        return (double)(entry->decode.alloc_count + entry->encode.alloc_count);
+    case CSON_PROFILE_SORT_MISS_RATE:
+        return cson_profile_miss_rate(entry);
+    case CSON_PROFILE_SORT_COUNT:
+        return (double)(entry->decode.count + entry->encode.count);
+    default:
+        return (double)(entry->decode.time + entry->encode.time);
+    }
+}
+
+/**
+ * @brief 降序比较，排序值相同时按键值排列
+ *
+ * @param a 字段统计
+ * @param b 字段统计
+ * @return int 比较结果
+ */
+static int _cson_profile_compare(const void *a, const void *b)
+{
+    const cson_profile_rank_t *x = a;
+    const cson_profile_rank_t *y = b;
+
+    if (x->score != y->score)
+    {
+        return x->score < y->score ? 1 : -1;
+    }
+    return strcmp(x->entry.key, y->entry.key);
+}
+
+/**
+ * @brief 收集并排序全部字段统计
+ *
+ * @param sort 排序方式
+ * @param count 字段数量
+ * @return cson_profile_rank_t* 排序后的统计，使用free释放
+ */
+static cson_profile_rank_t *_cson_profile_collect(cson_profile_sort_t sort, int *count)
+{
+    cson_profile_rank_t *ranks = malloc(sizeof(cson_profile_rank_t) * CSON_PROFILE_FIELD_MAX);
+    int n = 0;
+
+    *count = 0;
+    if (!ranks)
+    {
+        return NULL;
+    }
+    for (int i = 0; i < CSON_PROFILE_FIELD_MAX; i++)
+    {
+        cson_profile_slot_t *slot = &s_cson_profile.slots[i];
+        cson_profile_entry_t *entry = &ranks[n].entry;
+        entry->field = atomic_load_explicit(&slot->field, memory_order_acquire);
+        entry->model = atomic_load_explicit(&slot->model, memory_order_acquire);
+        if (!entry->field || !entry->model)
+        {
+            continue;
+        }
+        entry->name = _cson_profile_model_name(entry->model);
+        entry->key = entry->field->key;
+        _cson_profile_read(&slot->ops[CSON_PROFILE_DECODE], &entry->decode);
+        _cson_profile_read(&slot->ops[CSON_PROFILE_ENCODE], &entry->encode);
+        if (!entry->decode.count && !entry->encode.count)
+        {
+            continue;
+        }
+        ranks[n].score = _cson_profile_score(entry, sort);
+        n++;
+    }
+    qsort(ranks, (size_t)n, sizeof(cson_profile_rank_t), _cson_profile_compare);
+    *count = n;
+    return ranks;
+}
+
+/**
+ * @brief 一种操作的开销转换为json对象
+ *
+ * @param cost 开销
+ * @param decode 是否为解析
+ * @return cJSON* json对象
+ */
+static cJSON *_cson_profile_cost_json(const cson_profile_cost_t *cost, char decode)
+{
+    cJSON *json = cJSON_CreateObject();
+
+    cJSON_AddNumberToObject(json, "count", (double)cost->count);
+    cJSON_AddNumberToObject(json, "time", (double)cost->time);
+    cJSON_AddNumberToObject(json, "alloc_count", (double)cost->alloc_count);
+    cJSON_AddNumberToObject(json, "alloc_bytes", (double)cost->alloc_bytes);
+    if (decode)
+    {
+        cJSON_AddNumberToObject(json, "miss", (double)cost->miss);
+        cJSON_AddNumberToObject(json, "miss_rate", cost->count ? (double)cost->miss / (double)cost->count : 0.0);
+    }
+    return json;
+}
+#endif
+
+/**
+ * @brief 为数据模型命名
+ *
+ * @param model 数据模型
+ * @param name 名称
+ * @return int 0成功，-1已满或未启用统计
+ */
+int cson_profile_name(const cson_model_t *model, const char *name)
+{
+#if CSON_PROFILE_ENABLE
+    int index;
+
+    CSON_ASSERT(model && name, return -1);
+    index = atomic_fetch_add_explicit(&s_cson_profile.named, 1, memory_order_relaxed);
+    if (index >= CSON_PROFILE_MODEL_MAX)
+    {
+        atomic_fetch_sub_explicit(&s_cson_profile.named, 1, memory_order_relaxed);
+        return -1;
+    }
+    s_cson_profile.models[index].name = name;
+    atomic_store_explicit(&s_cson_profile.models[index].model, model, memory_order_release);
+    return 0;
+#else
+    (void)model;
+    (void)name;
+    return -1;
+#endif
+}
+
+/**
+ * @brief 开始计时，记录当前线程的分配计数
+ *
+ * @param mark 计时起点
+ * @param miss 键值是否缺失
+ */
+void cson_profile_begin(cson_profile_mark_t *mark, int miss)
+{
+#if CSON_PROFILE_ENABLE
+    mark->miss = miss;
+    mark->alloc_count = s_cson_profile_alloc.count;
+    mark->alloc_bytes = s_cson_profile_alloc.bytes;
+    mark->time = cson_clock_now();
+#else
+    (void)mark;
+    (void)miss;
+#endif
+}
+
+/**
+ * @brief 结束计时，记录到字段统计
+ *
+ * @param mark 计时起点
+ * @param op 操作
+ * @param model 所属数据模型
+ * @param field 字段模型
+ */
+void cson_profile_end(const cson_profile_mark_t *mark, cson_profile_op_t op,
+                      const cson_model_t *model, const cson_model_t *field)
+{
+#if CSON_PROFILE_ENABLE
+    unsigned long long ns = cson_clock_now() - mark->time;
+    cson_profile_counter_t *counter;
+    cson_profile_slot_t *slot;
+
+    if (!field->key || field->type == CSON_TYPE_OBJ || op >= CSON_PROFILE_OP_MAX)
+    {
+        return;
+    }
+    slot = _cson_profile_slot(model, field);
+    if (!slot)
+    {
+        return;
+    }
+    counter = &slot->ops[op];
+    atomic_fetch_add_explicit(&counter->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counter->time, ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counter->alloc_count, s_cson_profile_alloc.count - mark->alloc_count,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&counter->alloc_bytes, s_cson_profile_alloc.bytes - mark->alloc_bytes,
+                              memory_order_relaxed);
+    if (mark->miss)
+    {
+        atomic_fetch_add_explicit(&counter->miss, 1, memory_order_relaxed);
+    }
+#else
+    (void)mark;
+    (void)op;
+    (void)model;
+    (void)field;
+#endif
+}
+
+/**
+ * @brief 记录当前线程的一次内存分配
+ *
+ * @param size 分配字节数
+ */
+void cson_profile_alloc(size_t size)
+{
+#if CSON_PROFILE_ENABLE
+    s_cson_profile_alloc.count++;
+    s_cson_profile_alloc.bytes += size;
+#else
+    (void)size;
+#endif
+}
+
+/**
+ * @brief 获取排序后的字段统计
+ *
+ * @param entries 输出的字段统计
+ * @param max 最多输出的数量
+ * @param sort 排序方式
+ * @return int 输出的数量，-1未启用统计
+ */
+int cson_profile_report(cson_profile_entry_t *entries, int max, cson_profile_sort_t sort)
+{
+#if CSON_PROFILE_ENABLE
+    cson_profile_rank_t *ranks;
+    int count;
+
+    CSON_ASSERT(entries || max <= 0, return -1);
+    ranks = _cson_profile_collect(sort, &count);
+    CSON_ASSERT(ranks, return -1);
+    count = count < max ? count : (max > 0 ? max : 0);
+    for (int i = 0; i < count; i++)
+    {
+        entries[i] = ranks[i].entry;
+    }
+    free(ranks);
+    return count;
+#else
+    (void)entries;
+    (void)max;
+    (void)sort;
+    return -1;
+#endif
+}
+
+/**
+ * @brief 解析时键值缺失的比例
+ *
+ * @param entry 字段统计
+ * @return double 缺失比例(0~1)
+ */
+double cson_profile_miss_rate(const cson_profile_entry_t *entry)
+{
+    CSON_ASSERT(entry, return 0.0);
+    return entry->decode.count ? (double)entry->decode.miss / (double)entry->decode.count : 0.0;
+}
+
+/**
+ * @brief 输出排序后的字段统计为json字符串
+ *
+ * @param sort 排序方式
+ * @return char* json字符串，未启用统计时为NULL
+ */
+char *cson_profile_dump(cson_profile_sort_t sort)
+{
+#if CSON_PROFILE_ENABLE
+    cson_profile_rank_t *ranks;
+    cJSON *root, *fields, *item;
+    char *str;
+    int count;
+
+    ranks = _cson_profile_collect(sort, &count);
+    CSON_ASSERT(ranks, return NULL);
+    root = cJSON_CreateObject();
+    fields = cJSON_AddArrayToObject(root, "fields");
+    for (int i = 0; i < count; i++)
+    {
+        cson_profile_entry_t *entry = &ranks[i].entry;
+        item = cJSON_CreateObject();
+        if (entry->name)
+        {
+            cJSON_AddStringToObject(item, "model", entry->name);
+        }
+        cJSON_AddStringToObject(item, "key", entry->key);
+        cJSON_AddItemToObject(item, "decode", _cson_profile_cost_json(&entry->decode, 1));
+        cJSON_AddItemToObject(item, "encode", _cson_profile_cost_json(&entry->encode, 0));
+        cJSON_AddItemToArray(fields, item);
+    }
+    free(ranks);
+    str = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return str;
+#else
+    (void)sort;
+    return NULL;
+#endif
+}
+
+/**
+ * @brief 清零全部字段统计，命名保留
+ *
+ */
+void cson_profile_reset(void)
+{
+#if CSON_PROFILE_ENABLE
+    for (int i = 0; i < CSON_PROFILE_FIELD_MAX; i++)
+    {
+        for (int j = 0; j < CSON_PROFILE_OP_MAX; j++)
+        {
+            cson_profile_counter_t *counter = &s_cson_profile.slots[i].ops[j];
+            atomic_store_explicit(&counter->count, 0, memory_order_relaxed);
+            atomic_store_explicit(&counter->time, 0, memory_order_relaxed);
+            atomic_store_explicit(&counter->alloc_count, 0, memory_order_relaxed);
+            atomic_store_explicit(&counter->alloc_bytes, 0, memory_order_relaxed);
+            atomic_store_explicit(&counter->miss, 0, memory_order_relaxed);
+        }
+    }
+#endif
+}
@@ -0,0 +1,215 @@
+/**
+ * @file cson_profile.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#ifndef __CSON_PROFILE_H__
+#define __CSON_PROFILE_H__
+
+#include "cson.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @defgroup CSON_PROFILE cson profile
+ * @brief 字段级耗时统计
+ *
+ * 按数据模型中的字段分别记录`cson_decode_object`/`cson_encode_object`(及基于它们的`cson_decode`、`cson_encode`等)
+ * 处理该字段的次数、耗时、内存分配次数及字节数，解析时另外记录键值缺失的次数，用于找出开销最大的字段:
+ * @code
+ * cson_profile_name(user_model, "user");
+ * ...
+ * cson_profile_entry_t entries[16];
+ * int n = cson_profile_report(entries, 16, CSON_PROFILE_SORT_TIME);
+ * for (int i = 0; i < n; i++)
+ *     printf("%s %llu ns\n", entries[i].key, entries[i].decode.time + entries[i].encode.time);
+ * @endcode
+ *
+ * @addtogroup CSON_PROFILE
+ * @{
+ */
+
+/**
+ * @brief 是否启用字段级耗时统计
+ *
+ * 为0时不计时，报告始终为空；统计依赖C11原子操作，多线程同时处理同一字段时计数存在竞争开销，仅用于性能分析
+ */
+#ifndef CSON_PROFILE_ENABLE
+#define CSON_PROFILE_ENABLE 0
+#endif
+
+/**
+ * @brief 最多统计的字段数量，超出的字段不再记录
+ *
+ */
+#ifndef CSON_PROFILE_FIELD_MAX
+#define CSON_PROFILE_FIELD_MAX 1024
+#endif
+
+/**
+ * @brief 最多可命名的数据模型数量
+ *
+ */
+#ifndef CSON_PROFILE_MODEL_MAX
+#define CSON_PROFILE_MODEL_MAX 64
+#endif
+
+/**
+ * @brief 统计的操作
+ *
+ */
+typedef enum
+{
+        CSON_PROFILE_DECODE = 0, /**< 解析 */
+        CSON_PROFILE_ENCODE,     /**< 编码 */
+        CSON_PROFILE_OP_MAX,
+} cson_profile_op_t;
+
+/**
+ * @brief 报告排序方式，均按解析与编码之和降序
+ *
+ */
+typedef enum
+{
+        CSON_PROFILE_SORT_TIME = 0,  /**< 耗时 */
+        CSON_PROFILE_SORT_BYTES,     /**< 分配字节数 */
+        CSON_PROFILE_SORT_ALLOCS,    /**< 分配次数 */
+        CSON_PROFILE_SORT_MISS_RATE, /**< 解析时键值缺失的比例 */
+        CSON_PROFILE_SORT_COUNT,     /**< 处理次数 */
+} cson_profile_sort_t;
+
+/**
+ * @brief 一种操作的开销
+ *
+ */
+typedef struct
+{
+        unsigned long long count;       /**< 处理次数 */
+        unsigned long long time;        /**< 耗时(ns)，包含嵌套字段的耗时 */
+        unsigned long long alloc_count; /**< 分配次数，包含cJSON节点 */
+        unsigned long long alloc_bytes; /**< 分配字节数 */
+        unsigned long long miss;        /**< 键值缺失次数，仅解析 */
+} cson_profile_cost_t;
+
+/**
+ * @brief 字段统计
+ *
+ */
+typedef struct
+{
+        const cson_model_t *model;  /**< 所属数据模型 */
+        const cson_model_t *field;  /**< 字段模型 */
+        const char *name;           /**< 数据模型名称，未命名时为NULL */
+        const char *key;            /**< 字段键值 */
+        cson_profile_cost_t decode; /**< 解析开销 */
+        cson_profile_cost_t encode; /**< 编码开销 */
+} cson_profile_entry_t;
+
+/**
+ * @brief 计时起点
+ *
+ */
+typedef struct
+{
+        unsigned long long time;        /**< 开始时间 */
+        unsigned long long alloc_count; /**< 开始时本线程的分配次数 */
+        unsigned long long alloc_bytes; /**< 开始时本线程的分配字节数 */
+        int miss;                       /**< 键值是否缺失 */
+} cson_profile_mark_t;
+
+/**
+ * @brief 为数据模型命名，用于报告及JSON输出
+ *
+ * @param model 数据模型
+ * @param name 名称，须在统计期间保持有效
+ * @return int 0成功，-1已满或未启用统计
+ */
+int cson_profile_name(const cson_model_t *model, const char *name);
+
+/**
+ * @brief 开始计时
+ *
+ * @param mark 计时起点
+ * @param miss 键值是否缺失
+ * @note 供解析/编码模块使用，一般通过`CSON_PROFILE_BEGIN`使用
+ */
+void cson_profile_begin(cson_profile_mark_t *mark, int miss);
+
+/**
+ * @brief 结束计时，记录到字段统计
+ *
+ * @param mark `cson_profile_begin`记录的起点
+ * @param op 操作
+ * @param model 所属数据模型
+ * @param field 字段模型，无键值的字段不记录
+ */
+void cson_profile_end(const cson_profile_mark_t *mark, cson_profile_op_t op,
+                      const cson_model_t *model, const cson_model_t *field);
+
+/**
+ * @brief 记录一次内存分配
+ *
+ * @param size 分配字节数
+ * @note 由`cson_init`包装的分配函数调用
+ */
+void cson_profile_alloc(size_t size);
+
+/**
+ * @brief 获取排序后的字段统计
+ *
+ * @param entries 输出的字段统计
+ * @param max 最多输出的数量
+ * @param sort 排序方式
+ * @return int 输出的数量，未启用统计时返回-1
+ */
+int cson_profile_report(cson_profile_entry_t *entries, int max, cson_profile_sort_t sort);
+
+/**
+ * @brief 解析时键值缺失的比例
+ *
+ * @param entry 字段统计
+ * @return double 缺失比例(0~1)
+ */
+double cson_profile_miss_rate(const cson_profile_entry_t *entry);
+
+/**
+ * @brief 输出排序后的字段统计为json字符串
+ *
+ * @param sort 排序方式
+ * @return char* json字符串，使用`cson_free_json`释放，未启用统计时返回NULL
+ */
+char *cson_profile_dump(cson_profile_sort_t sort);
+
+/**
+ * @brief 清零全部字段统计，命名保留
+ *
+ */
+void cson_profile_reset(void);
+
+#if CSON_PROFILE_ENABLE
+#define CSON_PROFILE_BEGIN(mark, miss) \
+        cson_profile_mark_t mark;      \
+        cson_profile_begin(&mark, miss)
+#define CSON_PROFILE_END(mark, op, model, field) cson_profile_end(&mark, CSON_PROFILE_##op, model, field)
+#else
+#define CSON_PROFILE_BEGIN(mark, miss)
+#define CSON_PROFILE_END(mark, op, model, field)
+#endif
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
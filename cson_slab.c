@@ -0,0 +1,555 @@
+/**
+ * @file cson_slab.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#include "cson_slab.h"
+#include "cJSON.h"
+#include "stdlib.h"
+#include "string.h"
+
+#if CSON_SLAB_MULTI_THREAD
+#include "stdatomic.h"
+#if defined(_MSC_VER)
+#define CSON_SLAB_TLS __declspec(thread)
+#elif defined(__GNUC__)
+#define CSON_SLAB_TLS __thread
+#else
+#define CSON_SLAB_TLS _Thread_local
+#endif
+#endif
+
+/**
+ * @brief 块头，记录块所属chunk，大块内存为NULL
+ *
+ */
+typedef union
+{
+    struct slab_chunk *chunk;
+    double align;
+} slab_tag_t;
+
+/**
+ * @brief 空闲块链表节点(复用块负载空间)
+ *
+ */
+typedef struct slab_free_node
+{
+    struct slab_free_node *next;
+} slab_free_node_t;
+
+/**
+ * @brief slab chunk
+ *
+ */
+typedef struct slab_chunk
+{
+    struct slab_chunk *next;         /**< 同一分级下所有chunk */
+    struct slab_chunk *next_partial; /**< 同一分级下尚有空闲块的chunk */
+    struct slab_pool *owner;         /**< 所属池 */
+    slab_free_node_t *free;          /**< 本线程释放的空闲块 */
+    char *bump;                      /**< 未切分区域起始 */
+    char *end;                       /**< chunk结束 */
+    unsigned int used;               /**< 使用中的块数量 */
+    unsigned int carved;             /**< 已切分的块数量 */
+    unsigned char cls;               /**< 大小分级 */
+    unsigned char in_partial;        /**< 是否位于partial链表 */
+} slab_chunk_t;
+
+/**
+ * @brief slab池，每个线程一个
+ *
+ */
+typedef struct slab_pool
+{
+    slab_chunk_t *chunks[CSON_SLAB_CLASS_NUM];  /**< 所有chunk */
+    slab_chunk_t *partial[CSON_SLAB_CLASS_NUM]; /**< 尚可分配的chunk */
+#if CSON_SLAB_MULTI_THREAD
+    _Atomic(slab_free_node_t *) remote; /**< 其他线程释放的块 */
+    struct slab_pool *next;             /**< 孤立池链表 */
+#endif
+    cson_slab_stats_t stats; /**< 统计信息 */
+} slab_pool_t;
+
+/**
+ * @brief 各分级的负载大小
+ *
+ */
+static const size_t s_slab_class_size[CSON_SLAB_CLASS_NUM] = {sizeof(cJSON), 16, 32, 64, CSON_SLAB_STRING_MAX};
+
+/**
+ * @brief 后端分配器
+ *
+ */
+static struct
+{
+    void *(*malloc)(size_t);
+    void (*free)(void *);
+} s_slab = {malloc, free};
+
+#if CSON_SLAB_MULTI_THREAD
+static CSON_SLAB_TLS slab_pool_t *s_slab_pool;
+
+/**
+ * @brief 已退出线程留下的池，其中仍有使用中的块
+ *
+ */
+static slab_pool_t *s_slab_orphans;
+
+/**
+ * @brief 孤立池链表锁
+ *
+ */
+static atomic_flag s_slab_orphan_lock = ATOMIC_FLAG_INIT;
+#else
+static slab_pool_t s_slab_pool_storage;
+static slab_pool_t *s_slab_pool = &s_slab_pool_storage;
+#endif
+
+/**
+ * @brief 设置slab后端分配器
+ *
+ * @param malloc_func 内存分配函数，用于chunk及大块内存
+ * @param free_func 内存释放函数
+ */
+void cson_slab_init(void *malloc_func, void *free_func)
+{
+    s_slab.malloc = malloc_func ? (void *(*)(size_t))malloc_func : malloc;
+    s_slab.free = free_func ? (void (*)(void *))free_func : free;
+}
+
+/**
+ * @brief 获取块步长
+ *
+ * @param cls 大小分级
+ * @return size_t 块步长
+ */
+static size_t _slab_stride(unsigned char cls)
+{
+    return (sizeof(slab_tag_t) + s_slab_class_size[cls] + sizeof(slab_tag_t) - 1) & ~(sizeof(slab_tag_t) - 1);
+}
+
+/**
+ * @brief 获取分配大小对应的分级
+ *
+ * @param size 分配大小
+ * @return int 分级，-1表示不走slab
+ */
+static int _slab_class(size_t size)
+{
+    if (size == sizeof(cJSON))
+    {
+        return 0;
+    }
+    for (int i = 1; i < CSON_SLAB_CLASS_NUM; i++)
+    {
+        if (size <= s_slab_class_size[i])
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 获取当前线程的slab池
+ *
+ * @param create 不存在时是否创建
+ * @return slab_pool_t* slab池
+ */
+static slab_pool_t *_slab_pool(char create)
+{
+#if CSON_SLAB_MULTI_THREAD
+    if (!s_slab_pool && create)
+    {
+        s_slab_pool = s_slab.malloc(sizeof(slab_pool_t));
+        if (s_slab_pool)
+        {
+            memset(s_slab_pool, 0, sizeof(slab_pool_t));
+            atomic_init(&s_slab_pool->remote, NULL);
+        }
+    }
+#else
+    (void)create;
+#endif
+    return s_slab_pool;
+}
+
+/**
+ * @brief 将块归还到所属chunk
+ *
+ * @param pool slab池
+ * @param chunk 块所属chunk
+ * @param node 块
+ */
+static void _slab_release(slab_pool_t *pool, slab_chunk_t *chunk, slab_free_node_t *node)
+{
+    node->next = chunk->free;
+    chunk->free = node;
+    chunk->used--;
+    pool->stats.class_used[chunk->cls]--;
+    if (!chunk->in_partial)
+    {
+        chunk->next_partial = pool->partial[chunk->cls];
+        pool->partial[chunk->cls] = chunk;
+        chunk->in_partial = 1;
+    }
+}
+
+/**
+ * @brief 回收其他线程释放的块
+ *
+ * @param pool slab池
+ * @return char 是否回收到块
+ */
+static char _slab_drain_remote(slab_pool_t *pool)
+{
+#if CSON_SLAB_MULTI_THREAD
+    slab_free_node_t *node, *next;
+
+    if (!atomic_load_explicit(&pool->remote, memory_order_relaxed))
+    {
+        return 0;
+    }
+    node = atomic_exchange_explicit(&pool->remote, NULL, memory_order_acquire);
+    while (node)
+    {
+        next = node->next;
+        _slab_release(pool, ((slab_tag_t *)node - 1)->chunk, node);
+        node = next;
+    }
+    return 1;
+#else
+    (void)pool;
+    return 0;
+#endif
+}
+
+/**
+ * @brief 新建chunk
+ *
+ * @param pool slab池
+ * @param cls 大小分级
+ * @return slab_chunk_t* chunk
+ */
+static slab_chunk_t *_slab_new_chunk(slab_pool_t *pool, unsigned char cls)
+{
+    size_t header = (sizeof(slab_chunk_t) + sizeof(slab_tag_t) - 1) & ~(sizeof(slab_tag_t) - 1);
+    slab_chunk_t *chunk = s_slab.malloc(CSON_SLAB_CHUNK_SIZE);
+    if (!chunk)
+    {
+        return NULL;
+    }
+    chunk->owner = pool;
+    chunk->free = NULL;
+    chunk->bump = (char *)chunk + header;
+    chunk->end = (char *)chunk + CSON_SLAB_CHUNK_SIZE;
+    chunk->used = 0;
+    chunk->carved = 0;
+    chunk->cls = cls;
+    chunk->in_partial = 1;
+    chunk->next = pool->chunks[cls];
+    pool->chunks[cls] = chunk;
+    chunk->next_partial = pool->partial[cls];
+    pool->partial[cls] = chunk;
+    pool->stats.chunk_count++;
+    pool->stats.chunk_bytes += CSON_SLAB_CHUNK_SIZE;
+    return chunk;
+}
+
+/**
+ * @brief 从分级中分配一个块
+ *
+ * @param pool slab池
+ * @param cls 大小分级
+ * @return void* 块负载
+ */
+static void *_slab_alloc(slab_pool_t *pool, unsigned char cls)
+{
+    size_t stride = _slab_stride(cls);
+    slab_chunk_t *chunk;
+    slab_tag_t *tag;
+
+    for (char retry = 0; retry < 2; retry++)
+    {
+        while ((chunk = pool->partial[cls]) != NULL)
+        {
+            if (chunk->free)
+            {
+                slab_free_node_t *node = chunk->free;
+                chunk->free = node->next;
+                chunk->used++;
+                pool->stats.class_used[cls]++;
+                return node;
+            }
+            if (chunk->bump + stride <= chunk->end)
+            {
+                tag = (slab_tag_t *)chunk->bump;
+                tag->chunk = chunk;
+                chunk->bump += stride;
+                chunk->carved++;
+                chunk->used++;
+                pool->stats.class_used[cls]++;
+                pool->stats.class_blocks[cls]++;
+                return tag + 1;
+            }
+            pool->partial[cls] = chunk->next_partial;
+            chunk->in_partial = 0;
+        }
+        if (retry || !_slab_drain_remote(pool))
+        {
+            break;
+        }
+    }
+    if (!_slab_new_chunk(pool, cls))
+    {
+        return NULL;
+    }
+    return _slab_alloc(pool, cls);
+}
+
+/**
+ * @brief slab分配
+ *
+ * @param size 分配大小
+ * @return void* 分配得到的内存
+ */
+void *cson_slab_malloc(size_t size)
+{
+    slab_pool_t *pool = _slab_pool(1);
+    slab_tag_t *tag;
+    int cls = _slab_class(size);
+
+    if (!pool)
+    {
+        return NULL;
+    }
+    pool->stats.alloc_count++;
+    if (cls >= 0)
+    {
+        return _slab_alloc(pool, (unsigned char)cls);
+    }
+    pool->stats.large_count++;
+    tag = s_slab.malloc(sizeof(slab_tag_t) + size);
+    if (!tag)
+    {
+        return NULL;
+    }
+    tag->chunk = NULL;
+    return tag + 1;
+}
+
+/**
+ * @brief slab释放
+ *
+ * @param ptr 由`cson_slab_malloc`分配的内存
+ */
+void cson_slab_free(void *ptr)
+{
+    slab_pool_t *pool;
+    slab_tag_t *tag;
+    slab_chunk_t *chunk;
+
+    if (!ptr)
+    {
+        return;
+    }
+    pool = _slab_pool(0);
+    if (pool)
+    {
+        pool->stats.free_count++;
+    }
+    tag = (slab_tag_t *)ptr - 1;
+    chunk = tag->chunk;
+    if (!chunk)
+    {
+        s_slab.free(tag);
+        return;
+    }
+    if (chunk->owner == pool)
+    {
+        _slab_release(pool, chunk, ptr);
+        return;
+    }
+#if CSON_SLAB_MULTI_THREAD
+    slab_free_node_t *node = ptr;
+    slab_free_node_t *head = atomic_load_explicit(&chunk->owner->remote, memory_order_relaxed);
+    do
+    {
+        node->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&chunk->owner->remote, &head, node,
+                                                    memory_order_release, memory_order_relaxed));
+    if (pool)
+    {
+        pool->stats.remote_free_count++;
+    }
+#endif
+}
+
+/**
+ * @brief 获取当前线程的slab统计信息
+ *
+ * @param stats 统计信息
+ */
+void cson_slab_stats(cson_slab_stats_t *stats)
+{
+    slab_pool_t *pool = _slab_pool(0);
+
+    if (!stats)
+    {
+        return;
+    }
+    if (pool)
+    {
+        _slab_drain_remote(pool);
+        *stats = pool->stats;
+    }
+    else
+    {
+        memset(stats, 0, sizeof(cson_slab_stats_t));
+    }
+}
+
+/**
+ * @brief 回收其他线程释放的块，并归还池中完全空闲的chunk
+ *
+ * @param pool slab池
+ * @return size_t 释放的字节数
+ */
+static size_t _slab_trim(slab_pool_t *pool)
+{
+    slab_chunk_t **p, *chunk;
+    size_t released = 0;
+
+    _slab_drain_remote(pool);
+    for (unsigned char cls = 0; cls < CSON_SLAB_CLASS_NUM; cls++)
+    {
+        pool->partial[cls] = NULL;
+        p = &pool->chunks[cls];
+        while ((chunk = *p) != NULL)
+        {
+            if (chunk->used == 0)
+            {
+                *p = chunk->next;
+                pool->stats.class_blocks[cls] -= chunk->carved;
+                pool->stats.chunk_count--;
+                pool->stats.chunk_bytes -= CSON_SLAB_CHUNK_SIZE;
+                released += CSON_SLAB_CHUNK_SIZE;
+                s_slab.free(chunk);
+                continue;
+            }
+            chunk->in_partial = 0;
+            if (chunk->free || chunk->bump + _slab_stride(cls) <= chunk->end)
+            {
+                chunk->next_partial = pool->partial[cls];
+                pool->partial[cls] = chunk;
+                chunk->in_partial = 1;
+            }
+            p = &chunk->next;
+        }
+    }
+    return released;
+}
+
+#if CSON_SLAB_MULTI_THREAD
+/**
+ * @brief 将池挂入孤立池链表
+ *
+ * @param pool slab池
+ */
+static void _slab_orphan(slab_pool_t *pool)
+{
+    while (atomic_flag_test_and_set_explicit(&s_slab_orphan_lock, memory_order_acquire))
+    {
+    }
+    pool->next = s_slab_orphans;
+    s_slab_orphans = pool;
+    atomic_flag_clear_explicit(&s_slab_orphan_lock, memory_order_release);
+}
+
+/**
+ * @brief 回收孤立池
+ *
+ * 取下整个孤立池链表后逐个回收其他线程释放的块并归还空闲chunk，chunk全部归还的池随之释放，
+ * 其余重新挂回。块在其释放被回收前一直计为使用中，因此chunk全部归还后不会再有线程向该池归还块
+ *
+ * @return size_t 释放的字节数
+ */
+static size_t _slab_collect_orphans(void)
+{
+    slab_pool_t *pool, *next;
+    size_t released = 0;
+
+    while (atomic_flag_test_and_set_explicit(&s_slab_orphan_lock, memory_order_acquire))
+    {
+    }
+    pool = s_slab_orphans;
+    s_slab_orphans = NULL;
+    atomic_flag_clear_explicit(&s_slab_orphan_lock, memory_order_release);
+    for (; pool; pool = next)
+    {
+        next = pool->next;
+        released += _slab_trim(pool);
+        if (pool->stats.chunk_count)
+        {
+            _slab_orphan(pool);
+            continue;
+        }
+        released += sizeof(slab_pool_t);
+        s_slab.free(pool);
+    }
+    return released;
+}
+#endif
+
+/**
+ * @brief 归还当前线程中完全空闲的chunk给后端分配器
+ *
+ * @return size_t 释放的字节数
+ */
+size_t cson_slab_trim(void)
+{
+    slab_pool_t *pool = _slab_pool(0);
+    size_t released = 0;
+
+#if CSON_SLAB_MULTI_THREAD
+    released = _slab_collect_orphans();
+#endif
+    if (pool)
+    {
+        released += _slab_trim(pool);
+    }
+    return released;
+}
+
+/**
+ * @brief 线程退出前释放当前线程的slab池
+ *
+ * @return size_t 释放的字节数
+ */
+size_t cson_slab_thread_exit(void)
+{
+    size_t released = cson_slab_trim();
+#if CSON_SLAB_MULTI_THREAD
+    slab_pool_t *pool = s_slab_pool;
+
+    if (!pool)
+    {
+        return released;
+    }
+    s_slab_pool = NULL;
+    if (pool->stats.chunk_count)
+    {
+        _slab_orphan(pool);
+        return released;
+    }
+    released += sizeof(slab_pool_t);
+    s_slab.free(pool);
+#endif
+    return released;
+}
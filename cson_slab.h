@@ -0,0 +1,145 @@
+/**
+ * @file cson_slab.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#ifndef __CSON_SLAB_H__
+#define __CSON_SLAB_H__
+
+#include "stddef.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @defgroup CSON_SLAB cson slab
+ * @brief cJSON节点及短字符串的线程局部slab分配器
+ *
+ * 分配函数与malloc/free签名一致，直接传给`cson_init`即可同时作用于
+ * cJSON解析(`cJSON_Parse`)与`cson_encode_object`构建的节点:
+ * @code
+ * cson_init(cson_slab_malloc, cson_slab_free);
+ * @endcode
+ *
+ * 固定大小的cJSON节点与不超过`CSON_SLAB_STRING_MAX`字节的键/值字符串
+ * 从按大小分级的chunk中分配，其余请求回落到后端分配器
+ *
+ * @addtogroup CSON_SLAB
+ * @{
+ */
+
+/**
+ * @brief 是否支持多线程
+ *
+ * 为1时每个线程持有独立的slab池，跨线程释放通过无锁队列归还给所属线程；
+ * 为0时使用单一全局池，适用于单线程/裸机环境
+ */
+#ifndef CSON_SLAB_MULTI_THREAD
+#define CSON_SLAB_MULTI_THREAD 1
+#endif
+
+/**
+ * @brief 单个chunk大小(字节)
+ *
+ */
+#ifndef CSON_SLAB_CHUNK_SIZE
+#define CSON_SLAB_CHUNK_SIZE (16 * 1024)
+#endif
+
+/**
+ * @brief 走slab分配的最大字符串长度(含结束符)
+ *
+ */
+#define CSON_SLAB_STRING_MAX 128
+
+/**
+ * @brief slab大小分级数量(cJSON节点 + 16/32/64/128字节字符串)
+ *
+ */
+#define CSON_SLAB_CLASS_NUM 5
+
+/**
+ * @brief slab统计信息
+ *
+ */
+typedef struct
+{
+        size_t alloc_count;                       /**< 分配次数 */
+        size_t free_count;                        /**< 释放次数 */
+        size_t large_count;                       /**< 回落到后端分配器的次数 */
+        size_t remote_free_count;                 /**< 跨线程释放次数 */
+        size_t chunk_count;                       /**< 当前持有的chunk数量 */
+        size_t chunk_bytes;                       /**< 当前持有的chunk字节数 */
+        size_t class_used[CSON_SLAB_CLASS_NUM];   /**< 各分级正在使用的块数量 */
+        size_t class_blocks[CSON_SLAB_CLASS_NUM]; /**< 各分级已切分的块数量 */
+} cson_slab_stats_t;
+
+/**
+ * @brief 设置slab后端分配器
+ *
+ * @param malloc_func 内存分配函数，用于chunk及大块内存
+ * @param free_func 内存释放函数
+ * @note 需在第一次分配之前调用，默认使用malloc/free
+ */
+void cson_slab_init(void *malloc_func, void *free_func);
+
+/**
+ * @brief slab分配
+ *
+ * @param size 分配大小
+ * @return void* 分配得到的内存
+ */
+void *cson_slab_malloc(size_t size);
+
+/**
+ * @brief slab释放
+ *
+ * @param ptr 由`cson_slab_malloc`分配的内存
+ * @note 可在任意线程释放
+ */
+void cson_slab_free(void *ptr);
+
+/**
+ * @brief 获取当前线程的slab统计信息
+ *
+ * @param stats 统计信息
+ */
+void cson_slab_stats(cson_slab_stats_t *stats);
+
+/**
+ * @brief 归还当前线程中完全空闲的chunk给后端分配器
+ *
+ * 同时回收已退出线程留下的池：归还其他线程已释放的块，chunk全部空闲的池随之释放
+ *
+ * @return size_t 释放的字节数
+ */
+size_t cson_slab_trim(void);
+
+/**
+ * @brief 线程退出前释放当前线程的slab池
+ *
+ * 回收其他线程释放的块并归还空闲chunk后释放池；仍有块在使用时池转为孤立池，
+ * 这些块可在任意线程继续释放，之后由任一线程的`cson_slab_trim`或`cson_slab_thread_exit`回收。
+ * 多线程模式下每个使用过slab的线程都应在退出前调用，否则池及其chunk泄漏；
+ * 调用后本线程再次分配时会新建池
+ *
+ * @return size_t 释放的字节数
+ */
+size_t cson_slab_thread_exit(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
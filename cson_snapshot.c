@@ -0,0 +1,981 @@
+/**
+ * @file cson_snapshot.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#include "cson_snapshot.h"
+#include "cson_internal.h"
+#include "stddef.h"
+#include "string.h"
+#include "stdio.h"
+
+/**
+ * @brief 快照魔数
+ *
+ */
+static const unsigned char s_snap_magic[4] = {'C', 'S', 'N', 'P'};
+
+/**
+ * @brief 空字符串长度标记
+ *
+ */
+#define CSON_SNAP_NULL_STRING 0xffffffffUL
+
+/**
+ * @brief 编码缓冲
+ *
+ */
+typedef struct
+{
+    unsigned char *buf; /**< 缓冲 */
+    size_t len;         /**< 已写入长度 */
+    size_t cap;         /**< 缓冲容量 */
+    signed char error;  /**< 是否出错 */
+} cson_snap_writer_t;
+
+/**
+ * @brief 解码游标
+ *
+ */
+typedef struct
+{
+    const unsigned char *data; /**< 数据 */
+    size_t len;                /**< 数据长度 */
+    size_t pos;                /**< 当前位置 */
+    signed char error;         /**< 是否出错 */
+} cson_snap_reader_t;
+
+/**
+ * @brief 计算指纹时正在访问的模型路径
+ *
+ */
+typedef struct
+{
+    cson_model_t *model[CSON_SNAPSHOT_DEPTH_MAX]; /**< 模型 */
+    int depth;                                    /**< 深度 */
+} cson_snap_path_t;
+
+/**
+ * @brief 当前平台是否为小端序
+ *
+ * @return char 是否为小端序
+ */
+static char _cson_snap_little_endian(void)
+{
+    const unsigned short one = 1;
+    return *(const unsigned char *)&one;
+}
+
+/**
+ * @brief FNV-1a累加
+ *
+ * @param hash 当前哈希
+ * @param data 数据
+ * @param len 数据长度
+ * @return unsigned long long 新哈希
+ */
+static unsigned long long _cson_snap_hash(unsigned long long hash, const void *data, size_t len)
+{
+    const unsigned char *p = data;
+    while (len--)
+    {
+        hash ^= *p++;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief FNV-1a累加整数
+ *
+ * @param hash 当前哈希
+ * @param value 整数
+ * @return unsigned long long 新哈希
+ */
+static unsigned long long _cson_snap_hash_int(unsigned long long hash, long value)
+{
+    unsigned char bytes[4];
+    for (int i = 0; i < 4; i++)
+    {
+        bytes[i] = (unsigned char)(value >> (i * 8));
+    }
+    return _cson_snap_hash(hash, bytes, sizeof(bytes));
+}
+
+/**
+ * @brief 累加模型布局
+ *
+ * @param hash 当前哈希
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param path 访问路径，用于处理自引用模型
+ * @return unsigned long long 新哈希
+ */
+static unsigned long long _cson_snap_hash_model(unsigned long long hash, cson_model_t *model, int model_size,
+                                                cson_snap_path_t *path)
+{
+    for (int i = 0; i < path->depth; i++)
+    {
+        if (path->model[i] == model)
+        {
+            hash = _cson_snap_hash(hash, "^", 1);
+            return _cson_snap_hash_int(hash, path->depth - i);
+        }
+    }
+    if (path->depth >= CSON_SNAPSHOT_DEPTH_MAX)
+    {
+        return _cson_snap_hash(hash, "!", 1);
+    }
+    path->model[path->depth++] = model;
+    hash = _cson_snap_hash(hash, "{", 1);
+    for (short i = 0; i < model_size; i++)
+    {
+        hash = _cson_snap_hash_int(hash, model[i].type);
+        hash = _cson_snap_hash_int(hash, model[i].offset);
+        if (model[i].key)
+        {
+            hash = _cson_snap_hash(hash, model[i].key, strlen(model[i].key) + 1);
+        }
+        switch (model[i].type)
+        {
+        case CSON_TYPE_OBJ:
+            hash = _cson_snap_hash_int(hash, model[i].param.obj_size);
+            break;
+        case CSON_TYPE_STRUCT:
+        case CSON_TYPE_LIST:
+        case CSON_TYPE_VECTOR:
+        case CSON_TYPE_EMBED:
+            hash = _cson_snap_hash_model(hash, model[i].param.sub.model, model[i].param.sub.size, path);
+            break;
+        case CSON_TYPE_ARRAY:
+            hash = _cson_snap_hash_int(hash, model[i].param.array.ele_type);
+            hash = _cson_snap_hash_int(hash, model[i].param.array.size);
+            break;
+        case CSON_TYPE_CHAR_ARRAY:
+            hash = _cson_snap_hash_int(hash, model[i].param.chars.size);
+            break;
+        case CSON_TYPE_EMBED_ARRAY:
+            hash = _cson_snap_hash_int(hash, model[i].param.embeds.capacity);
+            hash = _cson_snap_hash_int(hash, model[i].param.embeds.count);
+            hash = _cson_snap_hash_model(hash, model[i].param.embeds.model, model[i].param.embeds.size, path);
+            break;
+        case CSON_TYPE_ILIST:
+            hash = _cson_snap_hash_int(hash, model[i].param.ilist.next);
+            hash = _cson_snap_hash_model(hash, model[i].param.ilist.model, model[i].param.ilist.size, path);
+            break;
+        case CSON_TYPE_STRING:
+        case CSON_TYPE_JSON:
+            hash = _cson_snap_hash_int(hash, 0);
+            break;
+        default:
+            hash = _cson_snap_hash_int(hash, (long)cson_model_type_size(model[i].type));
+            break;
+        }
+    }
+    path->depth--;
+    return _cson_snap_hash(hash, "}", 1);
+}
+
+/**
+ * @brief 计算模型布局指纹
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return unsigned long long 指纹
+ */
+unsigned long long cson_snapshot_fingerprint(cson_model_t *model, int model_size)
+{
+    cson_snap_path_t path;
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+
+    path.depth = 0;
+    hash = _cson_snap_hash_int(hash, CSON_SNAPSHOT_VERSION);
+    hash = _cson_snap_hash_int(hash, sizeof(void *));
+    hash = _cson_snap_hash_int(hash, sizeof(long));
+    return _cson_snap_hash_model(hash, model, model_size, &path);
+}
+
+/**
+ * @brief 写入数据
+ *
+ * @param w 编码缓冲
+ * @param data 数据
+ * @param n 数据长度
+ * @return unsigned char* 写入位置，失败返回NULL
+ */
+static unsigned char *_cson_snap_put(cson_snap_writer_t *w, const void *data, size_t n)
+{
+    unsigned char *p;
+
+    if (w->error)
+    {
+        return NULL;
+    }
+    if (w->len + n > w->cap)
+    {
+        size_t cap = w->cap ? w->cap : 1024;
+        while (cap < w->len + n)
+        {
+            cap *= 2;
+        }
+        p = cson_mem_alloc(cap);
+        if (!p)
+        {
+            w->error = 1;
+            return NULL;
+        }
+        if (w->buf)
+        {
+            memcpy(p, w->buf, w->len);
+            cson_mem_free(w->buf);
+        }
+        w->buf = p;
+        w->cap = cap;
+    }
+    p = w->buf + w->len;
+    if (data && n)
+    {
+        memcpy(p, data, n);
+    }
+    w->len += n;
+    return p;
+}
+
+/**
+ * @brief 以小端序写入数值
+ *
+ * @param w 编码缓冲
+ * @param value 数值地址
+ * @param size 数值大小
+ * @param count 数值个数
+ */
+static void _cson_snap_put_le(cson_snap_writer_t *w, const void *value, size_t size, size_t count)
+{
+    const unsigned char *src = value;
+    unsigned char *p;
+
+    if (_cson_snap_little_endian() || size == 1)
+    {
+        _cson_snap_put(w, value, size * count);
+        return;
+    }
+    p = _cson_snap_put(w, NULL, size * count);
+    for (size_t i = 0; p && i < count; i++)
+    {
+        for (size_t j = 0; j < size; j++)
+        {
+            p[i * size + j] = src[i * size + size - 1 - j];
+        }
+    }
+}
+
+/**
+ * @brief 写入32位无符号整数
+ *
+ * @param w 编码缓冲
+ * @param value 数值
+ */
+static void _cson_snap_put_u32(cson_snap_writer_t *w, unsigned long value)
+{
+    unsigned char bytes[4];
+    for (int i = 0; i < 4; i++)
+    {
+        bytes[i] = (unsigned char)(value >> (i * 8));
+    }
+    _cson_snap_put(w, bytes, sizeof(bytes));
+}
+
+/**
+ * @brief 写入字符串
+ *
+ * @param w 编码缓冲
+ * @param str 字符串
+ */
+static void _cson_snap_put_string(cson_snap_writer_t *w, const char *str)
+{
+    size_t len;
+
+    if (!str)
+    {
+        _cson_snap_put_u32(w, CSON_SNAP_NULL_STRING);
+        return;
+    }
+    len = strlen(str);
+    _cson_snap_put_u32(w, (unsigned long)len);
+    _cson_snap_put(w, str, len);
+}
+
+static void _cson_snap_put_object(cson_snap_writer_t *w, void *obj, cson_model_t *model, int model_size);
+
+/**
+ * @brief 写入链表
+ *
+ * @param w 编码缓冲
+ * @param list 链表
+ * @param model 链表元素模型
+ * @param model_size 链表元素模型数量
+ */
+static void _cson_snap_put_list(cson_snap_writer_t *w, cson_list_t *list, cson_model_t *model, int model_size)
+{
+    char basic = cson_model_is_basic(model);
+    unsigned long count = 0;
+    cson_list_t *p;
+
+    for (p = list; p; p = p->next)
+    {
+        if (basic || p->obj)
+        {
+            count++;
+        }
+    }
+    _cson_snap_put_u32(w, count);
+    for (p = list; p && !w->error; p = p->next)
+    {
+        if (!basic)
+        {
+            if (p->obj)
+            {
+                _cson_snap_put_object(w, p->obj, model, model_size);
+            }
+        }
+        else if (model[1].type == CSON_TYPE_STRING)
+        {
+            _cson_snap_put_string(w, p->str);
+        }
+        else
+        {
+            _cson_snap_put_le(w, &p->obj, cson_model_type_size(model[1].type), 1);
+        }
+    }
+}
+
+/**
+ * @brief 写入vector，基础类型元素整体写入
+ *
+ * @param w 编码缓冲
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ */
+static void _cson_snap_put_vector(cson_snap_writer_t *w, cson_vector_t *vec, cson_model_t *model, int model_size)
+{
+    size_t ele_size = cson_model_obj_size(model, model_size);
+
+    _cson_snap_put_u32(w, (unsigned long)vec->count);
+    if (cson_model_is_basic(model) && model[1].type != CSON_TYPE_STRING)
+    {
+        _cson_snap_put_le(w, vec->data, cson_model_type_size(model[1].type), vec->count);
+        return;
+    }
+    for (size_t i = 0; i < vec->count && !w->error; i++)
+    {
+        if (cson_model_is_basic(model))
+        {
+            _cson_snap_put_string(w, ((char **)vec->data)[i]);
+        }
+        else
+        {
+            _cson_snap_put_object(w, (void *)((size_t)vec->data + i * ele_size), model, model_size);
+        }
+    }
+}
+
+/**
+ * @brief 写入对象字段
+ *
+ * @param w 编码缓冲
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ */
+static void _cson_snap_put_object(cson_snap_writer_t *w, void *obj, cson_model_t *model, int model_size)
+{
+    unsigned char present;
+    size_t ele_size;
+    int count;
+    void *addr;
+
+    for (short i = 0; i < model_size && !w->error; i++)
+    {
+        addr = (void *)((size_t)obj + model[i].offset);
+        switch (model[i].type)
+        {
+        case CSON_TYPE_OBJ:
+            break;
+        case CSON_TYPE_STRING:
+        case CSON_TYPE_JSON:
+            _cson_snap_put_string(w, *(char **)addr);
+            break;
+        case CSON_TYPE_STRUCT:
+            present = *(void **)addr ? 1 : 0;
+            _cson_snap_put(w, &present, 1);
+            if (present)
+            {
+                _cson_snap_put_object(w, *(void **)addr, model[i].param.sub.model, model[i].param.sub.size);
+            }
+            break;
+        case CSON_TYPE_LIST:
+            _cson_snap_put_list(w, *(cson_list_t **)addr, model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_VECTOR:
+            _cson_snap_put_vector(w, (cson_vector_t *)addr, model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_EMBED:
+            _cson_snap_put_object(w, addr, model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_EMBED_ARRAY:
+            ele_size = cson_model_obj_size(model[i].param.embeds.model, model[i].param.embeds.size);
+            count = cson_embeds_count(obj, &model[i]);
+            _cson_snap_put_u32(w, (unsigned long)count);
+            for (int j = 0; j < count && !w->error; j++)
+            {
+                _cson_snap_put_object(w, (void *)((size_t)addr + j * ele_size), model[i].param.embeds.model,
+                                      model[i].param.embeds.size);
+            }
+            break;
+        case CSON_TYPE_ILIST:
+            count = 0;
+            for (void *p = *(void **)addr; p; p = *(void **)((size_t)p + model[i].param.ilist.next))
+            {
+                count++;
+            }
+            _cson_snap_put_u32(w, (unsigned long)count);
+            for (void *p = *(void **)addr; p && !w->error; p = *(void **)((size_t)p + model[i].param.ilist.next))
+            {
+                _cson_snap_put_object(w, p, model[i].param.ilist.model, model[i].param.ilist.size);
+            }
+            break;
+        case CSON_TYPE_CHAR_ARRAY:
+            _cson_snap_put(w, addr, model[i].param.chars.size);
+            break;
+        case CSON_TYPE_ARRAY:
+            if (model[i].param.array.ele_type == CSON_TYPE_STRING)
+            {
+                for (short j = 0; j < model[i].param.array.size; j++)
+                {
+                    _cson_snap_put_string(w, ((char **)addr)[j]);
+                }
+            }
+            else
+            {
+                _cson_snap_put_le(w, addr, cson_model_type_size(model[i].param.array.ele_type),
+                                  model[i].param.array.size);
+            }
+            break;
+        default:
+            _cson_snap_put_le(w, addr, cson_model_type_size(model[i].type), 1);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 对象编码成快照
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param len 快照长度
+ * @return unsigned char* 快照数据，使用`cson_snapshot_free`释放
+ */
+unsigned char *cson_snapshot_encode(void *obj, cson_model_t *model, int model_size, size_t *len)
+{
+    cson_snap_writer_t w = {NULL, 0, 0, 0};
+    unsigned long long fingerprint = cson_snapshot_fingerprint(model, model_size);
+    unsigned long long payload;
+    unsigned char *head;
+
+    CSON_ASSERT(obj, return NULL);
+    CSON_STATS_ENTER(model);
+    _cson_snap_put(&w, NULL, CSON_SNAPSHOT_HEAD_SIZE);
+    _cson_snap_put_object(&w, obj, model, model_size);
+    if (w.error)
+    {
+        cson_mem_free(w.buf);
+        CSON_STATS_LEAVE();
+        return NULL;
+    }
+    CSON_STATS_LEAVE();
+    head = w.buf;
+    payload = w.len - CSON_SNAPSHOT_HEAD_SIZE;
+    memcpy(head, s_snap_magic, sizeof(s_snap_magic));
+    head[4] = CSON_SNAPSHOT_VERSION & 0xff;
+    head[5] = (CSON_SNAPSHOT_VERSION >> 8) & 0xff;
+    head[6] = 0;
+    head[7] = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        head[8 + i] = (unsigned char)(fingerprint >> (i * 8));
+        head[16 + i] = (unsigned char)(payload >> (i * 8));
+    }
+    if (len)
+    {
+        *len = w.len;
+    }
+    return w.buf;
+}
+
+/**
+ * @brief 释放快照数据
+ *
+ * @param data 快照数据
+ */
+void cson_snapshot_free(unsigned char *data)
+{
+    cson_mem_free(data);
+}
+
+/**
+ * @brief 读取数据
+ *
+ * @param r 解码游标
+ * @param n 数据长度
+ * @return const unsigned char* 数据，越界时返回NULL
+ */
+static const unsigned char *_cson_snap_get(cson_snap_reader_t *r, size_t n)
+{
+    const unsigned char *p;
+
+    if (r->error || r->len - r->pos < n)
+    {
+        r->error = 1;
+        return NULL;
+    }
+    p = r->data + r->pos;
+    r->pos += n;
+    return p;
+}
+
+/**
+ * @brief 读取小端序数值
+ *
+ * @param r 解码游标
+ * @param value 数值地址
+ * @param size 数值大小
+ * @param count 数值个数
+ */
+static void _cson_snap_get_le(cson_snap_reader_t *r, void *value, size_t size, size_t count)
+{
+    const unsigned char *p = _cson_snap_get(r, size * count);
+    unsigned char *dst = value;
+
+    if (!p)
+    {
+        return;
+    }
+    if (_cson_snap_little_endian() || size == 1)
+    {
+        memcpy(value, p, size * count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t j = 0; j < size; j++)
+        {
+            dst[i * size + j] = p[i * size + size - 1 - j];
+        }
+    }
+}
+
+/**
+ * @brief 读取32位无符号整数
+ *
+ * @param r 解码游标
+ * @return unsigned long 数值
+ */
+static unsigned long _cson_snap_get_u32(cson_snap_reader_t *r)
+{
+    const unsigned char *p = _cson_snap_get(r, 4);
+    if (!p)
+    {
+        return 0;
+    }
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+/**
+ * @brief 读取字符串
+ *
+ * @param r 解码游标
+ * @return char* 新字符串，空字符串标记返回NULL
+ */
+static char *_cson_snap_get_string(cson_snap_reader_t *r)
+{
+    unsigned long len = _cson_snap_get_u32(r);
+    const unsigned char *p;
+    char *str;
+
+    if (r->error || len == CSON_SNAP_NULL_STRING)
+    {
+        return NULL;
+    }
+    p = _cson_snap_get(r, len);
+    if (!p)
+    {
+        return NULL;
+    }
+    str = cson_mem_alloc(len + 1);
+    if (!str)
+    {
+        r->error = 1;
+        return NULL;
+    }
+    memcpy(str, p, len);
+    str[len] = 0;
+    return str;
+}
+
+static void _cson_snap_get_object(cson_snap_reader_t *r, void *obj, cson_model_t *model, int model_size, int depth);
+
+/**
+ * @brief 读取链表
+ *
+ * @param r 解码游标
+ * @param addr 链表字段地址
+ * @param model 链表元素模型
+ * @param model_size 链表元素模型数量
+ * @param depth 嵌套深度
+ */
+static void _cson_snap_get_list(cson_snap_reader_t *r, cson_list_t **addr, cson_model_t *model, int model_size,
+                                int depth)
+{
+    char basic = cson_model_is_basic(model);
+    unsigned long count = _cson_snap_get_u32(r);
+    cson_list_t **tail = addr;
+    cson_list_t *node;
+    void *obj;
+
+    if (count > r->len - r->pos)
+    {
+        r->error = 1;
+        return;
+    }
+    for (unsigned long i = 0; i < count && !r->error; i++)
+    {
+        node = cson_mem_alloc(sizeof(cson_list_t));
+        if (!node)
+        {
+            r->error = 1;
+            return;
+        }
+        memset(node, 0, sizeof(cson_list_t));
+        *tail = node;
+        tail = &node->next;
+        if (!basic)
+        {
+            obj = cson_model_new_obj(model, model_size);
+            if (!obj)
+            {
+                r->error = 1;
+                return;
+            }
+            node->obj = obj;
+            _cson_snap_get_object(r, obj, model, model_size, depth + 1);
+        }
+        else if (model[1].type == CSON_TYPE_STRING)
+        {
+            node->str = _cson_snap_get_string(r);
+        }
+        else
+        {
+            _cson_snap_get_le(r, &node->obj, cson_model_type_size(model[1].type), 1);
+        }
+    }
+}
+
+/**
+ * @brief 读取侵入式链表
+ *
+ * @param r 解码游标
+ * @param addr 首元素指针地址
+ * @param field 字段模型
+ * @param depth 嵌套深度
+ */
+static void _cson_snap_get_ilist(cson_snap_reader_t *r, void **addr, cson_model_t *field, int depth)
+{
+    unsigned long count = _cson_snap_get_u32(r);
+    void **tail = addr;
+    void *obj;
+
+    if (count > r->len - r->pos)
+    {
+        r->error = 1;
+        return;
+    }
+    for (unsigned long i = 0; i < count && !r->error; i++)
+    {
+        obj = cson_model_new_obj(field->param.ilist.model, field->param.ilist.size);
+        if (!obj)
+        {
+            r->error = 1;
+            return;
+        }
+        *tail = obj;
+        tail = (void **)((size_t)obj + field->param.ilist.next);
+        _cson_snap_get_object(r, obj, field->param.ilist.model, field->param.ilist.size, depth + 1);
+    }
+}
+
+/**
+ * @brief 读取vector，按元素数量一次分配
+ *
+ * @param r 解码游标
+ * @param vec vector
+ * @param model 元素模型
+ * @param model_size 元素模型数量
+ * @param depth 嵌套深度
+ */
+static void _cson_snap_get_vector(cson_snap_reader_t *r, cson_vector_t *vec, cson_model_t *model, int model_size,
+                                  int depth)
+{
+    size_t ele_size = cson_model_obj_size(model, model_size);
+    unsigned long count = _cson_snap_get_u32(r);
+
+    if (r->error || !count)
+    {
+        return;
+    }
+    if (count > r->len - r->pos || cson_vector_reserve(vec, model, model_size, count) != 0)
+    {
+        r->error = 1;
+        return;
+    }
+    vec->count = count;
+    if (cson_model_is_basic(model) && model[1].type != CSON_TYPE_STRING)
+    {
+        _cson_snap_get_le(r, vec->data, cson_model_type_size(model[1].type), count);
+        return;
+    }
+    for (unsigned long i = 0; i < count && !r->error; i++)
+    {
+        if (cson_model_is_basic(model))
+        {
+            ((char **)vec->data)[i] = _cson_snap_get_string(r);
+        }
+        else
+        {
+            _cson_snap_get_object(r, (void *)((size_t)vec->data + i * ele_size), model, model_size, depth + 1);
+        }
+    }
+}
+
+/**
+ * @brief 读取对象字段
+ *
+ * @param r 解码游标
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param depth 嵌套深度
+ */
+static void _cson_snap_get_object(cson_snap_reader_t *r, void *obj, cson_model_t *model, int model_size, int depth)
+{
+    const unsigned char *present;
+    const unsigned char *chars;
+    size_t ele_size;
+    unsigned long count;
+    void *addr;
+
+    if (depth > CSON_SNAPSHOT_DEPTH_MAX)
+    {
+        r->error = 1;
+        return;
+    }
+    for (short i = 0; i < model_size && !r->error; i++)
+    {
+        addr = (void *)((size_t)obj + model[i].offset);
+        switch (model[i].type)
+        {
+        case CSON_TYPE_OBJ:
+            break;
+        case CSON_TYPE_STRING:
+        case CSON_TYPE_JSON:
+            *(char **)addr = _cson_snap_get_string(r);
+            break;
+        case CSON_TYPE_STRUCT:
+            present = _cson_snap_get(r, 1);
+            if (present && *present)
+            {
+                *(void **)addr = cson_model_new_obj(model[i].param.sub.model, model[i].param.sub.size);
+                if (!*(void **)addr)
+                {
+                    r->error = 1;
+                    return;
+                }
+                _cson_snap_get_object(r, *(void **)addr, model[i].param.sub.model, model[i].param.sub.size, depth + 1);
+            }
+            break;
+        case CSON_TYPE_LIST:
+            _cson_snap_get_list(r, (cson_list_t **)addr, model[i].param.sub.model, model[i].param.sub.size, depth);
+            break;
+        case CSON_TYPE_VECTOR:
+            _cson_snap_get_vector(r, (cson_vector_t *)addr, model[i].param.sub.model, model[i].param.sub.size, depth);
+            break;
+        case CSON_TYPE_EMBED:
+            _cson_snap_get_object(r, addr, model[i].param.sub.model, model[i].param.sub.size, depth + 1);
+            break;
+        case CSON_TYPE_EMBED_ARRAY:
+            ele_size = cson_model_obj_size(model[i].param.embeds.model, model[i].param.embeds.size);
+            count = _cson_snap_get_u32(r);
+            if (count > (unsigned long)model[i].param.embeds.capacity)
+            {
+                r->error = 1;
+                return;
+            }
+            for (unsigned long j = 0; j < count && !r->error; j++)
+            {
+                _cson_snap_get_object(r, (void *)((size_t)addr + j * ele_size), model[i].param.embeds.model,
+                                      model[i].param.embeds.size, depth + 1);
+            }
+            cson_embeds_set_count(obj, &model[i], (int)count);
+            break;
+        case CSON_TYPE_ILIST:
+            _cson_snap_get_ilist(r, (void **)addr, &model[i], depth);
+            break;
+        case CSON_TYPE_CHAR_ARRAY:
+            chars = _cson_snap_get(r, model[i].param.chars.size);
+            if (chars && model[i].param.chars.size > 0)
+            {
+                memcpy(addr, chars, model[i].param.chars.size - 1);
+                ((char *)addr)[model[i].param.chars.size - 1] = 0;
+            }
+            break;
+        case CSON_TYPE_ARRAY:
+            if (model[i].param.array.ele_type == CSON_TYPE_STRING)
+            {
+                for (short j = 0; j < model[i].param.array.size && !r->error; j++)
+                {
+                    ((char **)addr)[j] = _cson_snap_get_string(r);
+                }
+            }
+            else
+            {
+                _cson_snap_get_le(r, addr, cson_model_type_size(model[i].param.array.ele_type),
+                                  model[i].param.array.size);
+            }
+            break;
+        default:
+            _cson_snap_get_le(r, addr, cson_model_type_size(model[i].type), 1);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 从快照数据恢复对象
+ *
+ * @param data 快照数据
+ * @param len 快照长度
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 恢复得到的对象，使用`cson_free`释放；指纹不匹配或数据损坏时返回NULL
+ */
+void *cson_snapshot_decode(const unsigned char *data, size_t len, cson_model_t *model, int model_size)
+{
+    cson_snap_reader_t r = {data, len, CSON_SNAPSHOT_HEAD_SIZE, 0};
+    unsigned long long fingerprint = 0, payload = 0;
+    void *obj;
+
+    CSON_ASSERT(data, return NULL);
+    if (len < CSON_SNAPSHOT_HEAD_SIZE || memcmp(data, s_snap_magic, sizeof(s_snap_magic)) != 0
+        || (data[4] | (data[5] << 8)) != CSON_SNAPSHOT_VERSION)
+    {
+        return NULL;
+    }
+    for (int i = 7; i >= 0; i--)
+    {
+        fingerprint = (fingerprint << 8) | data[8 + i];
+        payload = (payload << 8) | data[16 + i];
+    }
+    if (fingerprint != cson_snapshot_fingerprint(model, model_size) || payload != len - CSON_SNAPSHOT_HEAD_SIZE)
+    {
+        return NULL;
+    }
+    CSON_STATS_ENTER(model);
+    obj = cson_model_new_obj(model, model_size);
+    CSON_ASSERT(obj, CSON_STATS_LEAVE(); return NULL);
+    _cson_snap_get_object(&r, obj, model, model_size, 0);
+    if (r.error || r.pos != len)
+    {
+        cson_free(obj, model, model_size);
+        obj = NULL;
+    }
+    CSON_STATS_LEAVE();
+    return obj;
+}
+
+/**
+ * @brief 将对象写入快照文件
+ *
+ * @param path 文件路径
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return int 0成功，-1失败
+ */
+int cson_snapshot_write(const char *path, void *obj, cson_model_t *model, int model_size)
+{
+    unsigned char *data;
+    size_t len = 0;
+    FILE *fp;
+    int ret = -1;
+
+    CSON_ASSERT(path, return -1);
+    data = cson_snapshot_encode(obj, model, model_size, &len);
+    if (!data)
+    {
+        return -1;
+    }
+    fp = fopen(path, "wb");
+    if (fp)
+    {
+        ret = fwrite(data, 1, len, fp) == len ? 0 : -1;
+        if (fclose(fp) != 0)
+        {
+            ret = -1;
+        }
+    }
+    cson_snapshot_free(data);
+    return ret;
+}
+
+/**
+ * @brief 从快照文件恢复对象
+ *
+ * @param path 文件路径
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 恢复得到的对象，使用`cson_free`释放；指纹不匹配或文件损坏时返回NULL
+ */
+void *cson_snapshot_read(const char *path, cson_model_t *model, int model_size)
+{
+    unsigned char *data;
+    void *obj = NULL;
+    FILE *fp;
+    long size;
+
+    CSON_ASSERT(path, return NULL);
+    fp = fopen(path, "rb");
+    if (!fp)
+    {
+        return NULL;
+    }
+    if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) < CSON_SNAPSHOT_HEAD_SIZE || fseek(fp, 0, SEEK_SET) != 0)
+    {
+        fclose(fp);
+        return NULL;
+    }
+    data = cson_mem_alloc((size_t)size);
+    if (data && fread(data, 1, (size_t)size, fp) == (size_t)size)
+    {
+        obj = cson_snapshot_decode(data, (size_t)size, model, model_size);
+    }
+    cson_mem_free(data);
+    fclose(fp);
+    return obj;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file cson_snapshot.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#ifndef __CSON_SNAPSHOT_H__
+#define __CSON_SNAPSHOT_H__
+
+#include "cson.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @defgroup CSON_SNAPSHOT cson snapshot
+ * @brief 基于数据模型的二进制快照
+ *
+ * 快照按模型顺序存放字段，不保存键值；数值统一为小端序，字符串带长度前缀，
+ * 基础类型数组整块存放。快照头部记录模型布局指纹(字段类型、偏移、大小及键值)，
+ * 模型发生变化后读取旧快照会被拒绝
+ *
+ * @code
+ * cson_snapshot_write_ex("catalog.snap", catalog, catalog_model);
+ * catalog_t *catalog = cson_snapshot_read_ex("catalog.snap", catalog_model);
+ * @endcode
+ *
+ * 快照仅用于同一程序的持久化，不同平台间`long`及指针大小不同时指纹亦不同
+ *
+ * @addtogroup CSON_SNAPSHOT
+ * @{
+ */
+
+/**
+ * @brief 快照格式版本
+ *
+ */
+#define CSON_SNAPSHOT_VERSION 1
+
+/**
+ * @brief 快照头部大小
+ *
+ */
+#define CSON_SNAPSHOT_HEAD_SIZE 24
+
+/**
+ * @brief 读取时最大嵌套深度
+ *
+ */
+#ifndef CSON_SNAPSHOT_DEPTH_MAX
+#define CSON_SNAPSHOT_DEPTH_MAX 64
+#endif
+
+/**
+ * @brief 计算模型布局指纹
+ *
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return unsigned long long 指纹
+ */
+unsigned long long cson_snapshot_fingerprint(cson_model_t *model, int model_size);
+
+/**
+ * @brief 对象编码成快照
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @param len 快照长度
+ * @return unsigned char* 快照数据，使用`cson_snapshot_free`释放
+ */
+unsigned char *cson_snapshot_encode(void *obj, cson_model_t *model, int model_size, size_t *len);
+
+/**
+ * @brief 从快照数据恢复对象
+ *
+ * @param data 快照数据
+ * @param len 快照长度
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 恢复得到的对象，使用`cson_free`释放；指纹不匹配或数据损坏时返回NULL
+ */
+void *cson_snapshot_decode(const unsigned char *data, size_t len, cson_model_t *model, int model_size);
+
+/**
+ * @brief 释放快照数据
+ *
+ * @param data 快照数据
+ */
+void cson_snapshot_free(unsigned char *data);
+
+/**
+ * @brief 将对象写入快照文件
+ *
+ * @param path 文件路径
+ * @param obj 对象
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return int 0成功，-1失败
+ */
+int cson_snapshot_write(const char *path, void *obj, cson_model_t *model, int model_size);
+
+/**
+ * @brief 将对象写入快照文件
+ *
+ * @param path 文件路径
+ * @param obj 对象
+ * @param model 数据模型
+ * @return int 0成功，-1失败
+ */
+#define cson_snapshot_write_ex(path, obj, model) \
+        cson_snapshot_write(path, obj, model, sizeof(model) / sizeof(cson_model_t))
+
+/**
+ * @brief 从快照文件恢复对象
+ *
+ * @param path 文件路径
+ * @param model 数据模型
+ * @param model_size 数据模型数量
+ * @return void* 恢复得到的对象，使用`cson_free`释放；指纹不匹配或文件损坏时返回NULL
+ */
+void *cson_snapshot_read(const char *path, cson_model_t *model, int model_size);
+
+/**
+ * @brief 从快照文件恢复对象
+ *
+ * @param path 文件路径
+ * @param model 数据模型
+ * @return void* 恢复得到的对象
+ */
+#define cson_snapshot_read_ex(path, model) \
+        cson_snapshot_read(path, model, sizeof(model) / sizeof(cson_model_t))
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file test.h
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 测试公共定义：检查宏及覆盖全部字段类型的数据模型
+ */
+
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include "cson.h"
+#include "stdio.h"
+
+/**
+ * @brief 失败的检查数
+ *
+ */
+extern int test_failures;
+
+/**
+ * @brief 检查条件，失败时输出位置并计数
+ *
+ * @param expr 表达式
+ */
+#define TEST_CHECK(expr) \
+        do \
+        { \
+                if (!(expr)) \
+                { \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+                        test_failures++; \
+                } \
+        } while (0)
+
+/**
+ * @brief 测试结果，作为main的返回值
+ *
+ */
+#define TEST_RESULT() \
+        (test_failures ? (printf("%d check(s) failed\n", test_failures), 1) : 0)
+
+/**
+ * @brief 测试点
+ *
+ */
+typedef struct test_point
+{
+        int x;
+        char *tag;
+        double w;
+        struct test_point *next;
+} test_point_t;
+
+/**
+ * @brief 测试记录，覆盖全部字段类型
+ *
+ */
+typedef struct
+{
+        char c;
+        short s;
+        int id;
+        long l;
+        float f;
+        double d;
+        char b;
+        char *name;
+        test_point_t *pos;
+        test_point_t home;
+        test_point_t route[3];
+        int route_count;
+        test_point_t *chain;
+        cson_list_t *pts;
+        cson_list_t *nums;
+        cson_list_t *words;
+        cson_vector_t vals;
+        cson_vector_t marks;
+        int arr[3];
+        char *strs[2];
+        char code[8];
+        char *raw;
+} test_record_t;
+
+extern cson_model_t test_point_model[4];
+extern cson_model_t test_record_model[22];
+
+/**
+ * @brief 测试记录样例，覆盖全部字段类型
+ *
+ */
+extern const char *test_record_json;
+
+/**
+ * @brief 按JSON路径编码并比较
+ *
+ * @param expect 期望的JSON字符串
+ * @param obj 对象
+ * @return int 一致返回1
+ */
+int test_record_same(const char *expect, test_record_t *obj);
+
+#endif
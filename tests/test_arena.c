@@ -0,0 +1,179 @@
+/**
+ * @file test_arena.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief arena解析结果与普通解析一致，整体释放后不遗留内存
+ */
+
+#include "test.h"
+#include "cJSON.h"
+#include "stdlib.h"
+#include "string.h"
+
+#define TEST_MEMBERS (CJSON_INDEX_MIN * 3 + 1)
+
+/**
+ * @brief 未释放的内存块数
+ *
+ */
+static long test_live;
+
+/**
+ * @brief 不小于此大小的分配失败，0表示不限制
+ *
+ */
+static size_t test_fail_size;
+
+static void *_test_malloc(size_t size)
+{
+    void *ptr;
+
+    if (test_fail_size && size >= test_fail_size)
+    {
+        return NULL;
+    }
+    ptr = malloc(size);
+    test_live += ptr ? 1 : 0;
+    return ptr;
+}
+
+static void _test_free(void *ptr)
+{
+    test_live -= ptr ? 1 : 0;
+    free(ptr);
+}
+
+/**
+ * @brief 生成测试文档，包含大对象、嵌套数组及转义字符串
+ *
+ * @return char* 文档，使用cJSON_free释放
+ */
+static char *_test_document(void)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *big = cJSON_AddObjectToObject(root, "big");
+    cJSON *list = cJSON_AddArrayToObject(root, "list");
+    char key[32];
+    char *text;
+
+    for (int i = 0; i < TEST_MEMBERS; i++)
+    {
+        sprintf(key, "member%d", i);
+        cJSON_AddNumberToObject(big, key, i * 0.5);
+        cJSON_AddItemToArray(list, cJSON_CreateString(key));
+    }
+    cJSON_AddStringToObject(root, "text", "tab\tquote\"unicode\xc3\xa9");
+    cJSON_AddItemToObject(root, "nested", cJSON_Parse("[[],{},[1,[2,[3]]],null,true,false]"));
+    text = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return text;
+}
+
+/**
+ * @brief 检查arena中的树与普通解析结果一致，且拒绝修改
+ *
+ * @param tree arena中的树
+ * @param expect 普通解析结果的输出
+ */
+static void _test_tree(cJSON *tree, const char *expect)
+{
+    cJSON *big = cJSON_GetObjectItemCaseSensitive(tree, "big");
+    cJSON *item, *copy;
+    char key[32];
+    char *text;
+
+    text = cJSON_PrintUnformatted(tree);
+    TEST_CHECK(text && strcmp(text, expect) == 0);
+    cJSON_free(text);
+
+    TEST_CHECK(big && (big->type & cJSON_InArena) && big->child_count == TEST_MEMBERS);
+    for (int i = 0; big && i < TEST_MEMBERS; i++)
+    {
+        sprintf(key, "member%d", i);
+        item = cJSON_GetObjectItemCaseSensitive(big, key);
+        TEST_CHECK(item && item->valuedouble == i * 0.5);
+    }
+    TEST_CHECK(cJSON_GetArraySize(cJSON_GetObjectItem(tree, "list")) == TEST_MEMBERS);
+
+    /* 只读：修改接口一律拒绝，cJSON_Delete忽略 */
+    item = cJSON_CreateNumber(1);
+    TEST_CHECK(!cJSON_AddItemToObject(tree, "extra", item));
+    TEST_CHECK(!cJSON_ReplaceItemInObject(tree, "big", item));
+    cJSON_Delete(item);
+    TEST_CHECK(cJSON_DetachItemFromObject(tree, "big") == NULL);
+    TEST_CHECK(cJSON_SetValuestring(cJSON_GetObjectItem(tree, "text"), "x") == NULL);
+    cJSON_Delete(tree);
+    TEST_CHECK(cJSON_GetObjectItem(tree, "big") == big);
+
+    /* 复制得到可修改的普通树 */
+    copy = cJSON_Duplicate(tree, 1);
+    TEST_CHECK(copy && !(copy->type & cJSON_InArena));
+    TEST_CHECK(cJSON_AddItemToObject(copy, "extra", cJSON_CreateNumber(1)));
+    cJSON_DeleteItemFromObject(copy, "big");
+    cJSON_Delete(copy);
+}
+
+int main(void)
+{
+    cJSON_Arena *arena;
+    cJSON *first, *second;
+    test_record_t *obj;
+    char *doc, *expect;
+    long live;
+
+    cson_init((void *)_test_malloc, (void *)_test_free);
+    live = test_live;
+
+    doc = _test_document();
+    first = cJSON_Parse(doc);
+    expect = cJSON_PrintUnformatted(first);
+    cJSON_Delete(first);
+    TEST_CHECK(expect && strcmp(expect, doc) == 0);
+
+    /* 小块起步，解析过程中追加块 */
+    arena = cJSON_CreateArena(64);
+    TEST_CHECK(arena != NULL);
+    first = cJSON_ParseInArena(doc, strlen(doc) + 1, arena);
+    second = cJSON_ParseInArena(doc, strlen(doc) + 1, arena);
+    TEST_CHECK(first && second && first != second);
+    _test_tree(first, expect);
+    _test_tree(second, expect);
+    TEST_CHECK(cJSON_ParseInArena("{\"a\":[1,}", 10, arena) == NULL);
+
+    /* 重置后复用 */
+    cJSON_ResetArena(arena);
+    first = cJSON_ParseInArena(doc, strlen(doc) + 1, arena);
+    _test_tree(first, expect);
+    cJSON_DeleteArena(arena);
+
+    cJSON_free(expect);
+    cJSON_free(doc);
+    TEST_CHECK(test_live == live);
+
+    /* cson解析经由arena，arena不可用时退回普通解析，两者结果一致且不遗留内存 */
+    expect = NULL;
+    for (int fail = 0; fail < 2; fail++)
+    {
+        test_fail_size = fail ? 4096 : 0;
+        obj = cson_decode_ex(test_record_json, test_record_model);
+        TEST_CHECK(obj != NULL);
+        if (!expect)
+        {
+            expect = cson_encode_unformatted_ex(obj, test_record_model);
+        }
+        else
+        {
+            TEST_CHECK(test_record_same(expect, obj));
+        }
+        cson_free_ex(obj, test_record_model);
+    }
+    test_fail_size = 0;
+    cson_free_json(expect);
+    TEST_CHECK(test_live == live);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,94 @@
+/**
+ * @file test_cbor.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief CBOR编解码与JSON路径的一致性
+ */
+
+#include "test.h"
+#include "cson_cbor.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 流式输出缓冲
+ *
+ */
+typedef struct
+{
+    unsigned char data[4096];
+    size_t len;
+} test_sink_t;
+
+static int _test_sink_write(void *user, const unsigned char *data, size_t len)
+{
+    test_sink_t *sink = user;
+
+    if (sink->len + len > sizeof(sink->data))
+    {
+        return -1;
+    }
+    memcpy(sink->data + sink->len, data, len);
+    sink->len += len;
+    return 0;
+}
+
+/**
+ * @brief 按编码选项往返并与JSON路径比较
+ *
+ * @param obj 对象
+ * @param expect JSON路径的编码结果
+ * @param flags 编码选项
+ */
+static void _test_round_trip(test_record_t *obj, const char *expect, int flags)
+{
+    static test_sink_t sink;
+    test_record_t *copy;
+    unsigned char *data;
+    size_t len;
+
+    data = cson_cbor_encode_ex(obj, test_record_model, &len, flags);
+    TEST_CHECK(data != NULL && len > 0);
+    copy = cson_cbor_decode_ex(data, len, test_record_model);
+    TEST_CHECK(test_record_same(expect, copy));
+    TEST_CHECK(copy && copy->l == -5000000000L);
+    cson_free_ex(copy, test_record_model);
+
+    /* 流式输出与一次性编码结果一致 */
+    sink.len = 0;
+    TEST_CHECK(cson_cbor_encode_stream_ex(obj, test_record_model, _test_sink_write, &sink, flags) == 0);
+    TEST_CHECK(data && sink.len == len && memcmp(sink.data, data, len) == 0);
+
+    /* 截断的数据一律解码失败 */
+    for (size_t i = 0; data && i < len; i++)
+    {
+        copy = cson_cbor_decode_ex(data, i, test_record_model);
+        TEST_CHECK(copy == NULL);
+        cson_free_ex(copy, test_record_model);
+    }
+    cson_cbor_free(data);
+}
+
+int main(void)
+{
+    test_record_t *obj;
+    char *expect;
+
+    cson_init((void *)malloc, (void *)free);
+
+    obj = cson_decode_ex(test_record_json, test_record_model);
+    TEST_CHECK(obj != NULL);
+    expect = cson_encode_unformatted_ex(obj, test_record_model);
+    TEST_CHECK(expect != NULL);
+
+    _test_round_trip(obj, expect, 0);
+    _test_round_trip(obj, expect, CSON_CBOR_INDEFINITE);
+
+    cson_free_json(expect);
+    cson_free_ex(obj, test_record_model);
+    return TEST_RESULT();
+}
@@ -0,0 +1,158 @@
+/**
+ * @file test_chars.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 定长字符串超长时的截断与拒绝策略，JSON、分段解析、MessagePack、CBOR一致
+ */
+
+#include "test.h"
+#include "cson_cbor.h"
+#include "cson_decoder.h"
+#include "cson_msgpack.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 定长字符串字段
+ *
+ */
+typedef struct
+{
+    char code[4];
+    char strict[4];
+} test_chars_t;
+
+/**
+ * @brief 同名的普通字符串字段，用于生成超长输入
+ *
+ */
+typedef struct
+{
+    char *code;
+    char *strict;
+} test_wide_t;
+
+static cson_model_t test_chars_model[] = {
+    CSON_MODEL_OBJ(test_chars_t),
+    CSON_MODEL_CHAR_ARRAY(test_chars_t, code, 4),
+    CSON_MODEL_CHAR_ARRAY_POLICY(test_chars_t, strict, 4, CSON_CHARS_REJECT),
+};
+
+static cson_model_t test_wide_model[] = {
+    CSON_MODEL_OBJ(test_wide_t),
+    CSON_MODEL_STRING(test_wide_t, code),
+    CSON_MODEL_STRING(test_wide_t, strict),
+};
+
+/**
+ * @brief 输入及两种策略的期望结果
+ *
+ */
+static const struct
+{
+    const char *input;
+    const char *truncated;
+    const char *rejected;
+} test_cases[] = {
+    {"", "", ""},
+    {"ab", "ab", "ab"},
+    {"abc", "abc", "abc"},
+    {"abcd", "abc", ""},
+    {"abcdefghijklmnop", "abc", ""},
+    {"a\xc3\xa9", "a\xc3\xa9", "a\xc3\xa9"},
+    {"ab\xc3\xa9", "ab", ""},
+    {"a\xe2\x82\xac", "a", ""},
+    {"\xf0\x9f\x98\x80", "", ""},
+};
+
+/**
+ * @brief 检查解析结果
+ *
+ * @param obj 对象
+ * @param i 用例序号
+ */
+static void _test_expect(test_chars_t *obj, size_t i)
+{
+    TEST_CHECK(obj != NULL);
+    if (obj)
+    {
+        TEST_CHECK(strcmp(obj->code, test_cases[i].truncated) == 0);
+        TEST_CHECK(strcmp(obj->strict, test_cases[i].rejected) == 0);
+    }
+}
+
+/**
+ * @brief 分段解析，逐字节送入
+ *
+ * @param json JSON字符串
+ * @return test_chars_t* 解析得到的对象
+ */
+static test_chars_t *_test_feed(const char *json)
+{
+    cson_decoder_t *dec = cson_decoder_create_ex(test_chars_model);
+    cson_decoder_status_t status = CSON_DECODER_NEED_MORE;
+    test_chars_t *obj;
+
+    for (size_t i = 0; json[i] && status == CSON_DECODER_NEED_MORE; i++)
+    {
+        status = cson_decoder_feed(dec, json + i, 1);
+    }
+    TEST_CHECK(status == CSON_DECODER_DONE);
+    obj = cson_decoder_result(dec);
+    cson_decoder_destroy(dec);
+    return obj;
+}
+
+int main(void)
+{
+    test_chars_t *obj;
+    test_wide_t wide;
+    unsigned char *data;
+    char *json;
+    size_t len;
+
+    cson_init((void *)malloc, (void *)free);
+
+    for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++)
+    {
+        wide.code = (char *)test_cases[i].input;
+        wide.strict = (char *)test_cases[i].input;
+
+        json = cson_encode_unformatted(&wide, test_wide_model, 3);
+        obj = cson_decode_ex(json, test_chars_model);
+        _test_expect(obj, i);
+        cson_free(obj, test_chars_model, 3);
+        obj = _test_feed(json);
+        _test_expect(obj, i);
+        cson_free(obj, test_chars_model, 3);
+        cson_free_json(json);
+
+        data = cson_msgpack_encode(&wide, test_wide_model, 3, &len);
+        obj = cson_msgpack_decode_ex(data, len, test_chars_model);
+        _test_expect(obj, i);
+        cson_free(obj, test_chars_model, 3);
+        cson_msgpack_free(data);
+
+        data = cson_cbor_encode(&wide, test_wide_model, 3, &len, 0);
+        obj = cson_cbor_decode_ex(data, len, test_chars_model);
+        _test_expect(obj, i);
+        cson_free(obj, test_chars_model, 3);
+        cson_cbor_free(data);
+    }
+
+    /* 非字符串值解析为空字符串，编码输出字符串 */
+    obj = cson_decode_ex("{\"code\":123,\"strict\":[\"ab\"]}", test_chars_model);
+    TEST_CHECK(obj && obj->code[0] == '\0' && obj->strict[0] == '\0');
+    cson_free(obj, test_chars_model, 3);
+    obj = cson_decode_ex("{\"code\":\"abcdef\",\"strict\":\"xyz\"}", test_chars_model);
+    json = obj ? cson_encode_unformatted(obj, test_chars_model, 3) : NULL;
+    TEST_CHECK(json && strcmp(json, "{\"code\":\"abc\",\"strict\":\"xyz\"}") == 0);
+    cson_free_json(json);
+    cson_free(obj, test_chars_model, 3);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,181 @@
+/**
+ * @file test_count.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief cJSON的child_count在各修改接口后与子节点链表保持一致
+ */
+
+#include "test.h"
+#include "cJSON.h"
+#include "string.h"
+
+#define TEST_ITEMS (CJSON_INDEX_MIN * 2 + 5)
+
+/**
+ * @brief 检查child_count与链表长度一致，并按下标访问每个元素
+ *
+ * @param item 数组或对象
+ * @param expect 期望的元素数
+ */
+static void _test_count(const cJSON *item, int expect)
+{
+    const cJSON *child;
+    int count = 0;
+
+    TEST_CHECK(item != NULL);
+    if (!item)
+    {
+        return;
+    }
+    for (child = item->child; child; child = child->next, count++)
+    {
+        TEST_CHECK(cJSON_GetArrayItem(item, count) == child);
+        TEST_CHECK(child->next || item->child->prev == child);
+    }
+    TEST_CHECK(count == expect);
+    TEST_CHECK(item->child_count == (size_t)count);
+    TEST_CHECK(cJSON_GetArraySize(item) == count);
+    TEST_CHECK(cJSON_GetArrayItem(item, count) == NULL);
+    TEST_CHECK(cJSON_GetArrayItem(item, -1) == NULL);
+}
+
+/**
+ * @brief 检查引用容器的大小及按下标访问，引用的child_count只是创建时的快照，不参与检查
+ *
+ * @param reference 引用容器
+ * @param expect 期望的元素数
+ */
+static void _test_reference(const cJSON *reference, int expect)
+{
+    const cJSON *child;
+    int count = 0;
+
+    for (child = reference->child; child; child = child->next, count++)
+    {
+        TEST_CHECK(cJSON_GetArrayItem(reference, count) == child);
+    }
+    TEST_CHECK(count == expect);
+    TEST_CHECK(cJSON_GetArraySize(reference) == count);
+    TEST_CHECK(cJSON_GetArrayItem(reference, count) == NULL);
+    TEST_CHECK(reference->child_index == NULL);
+}
+
+int main(void)
+{
+    static int numbers[TEST_ITEMS];
+    const char *strings[] = {"a", "b", "c"};
+    cJSON *array, *object, *copy, *item, *ref;
+    char *text;
+
+    for (int i = 0; i < TEST_ITEMS; i++)
+    {
+        numbers[i] = i;
+    }
+
+    /* 创建 */
+    array = cJSON_CreateIntArray(numbers, TEST_ITEMS);
+    _test_count(array, TEST_ITEMS);
+    item = cJSON_CreateStringArray(strings, 3);
+    _test_count(item, 3);
+    cJSON_Delete(item);
+    item = cJSON_CreateArray();
+    _test_count(item, 0);
+    cJSON_Delete(item);
+
+    /* 追加、插入 */
+    TEST_CHECK(cJSON_AddItemToArray(array, cJSON_CreateNumber(-1)));
+    _test_count(array, TEST_ITEMS + 1);
+    TEST_CHECK(cJSON_InsertItemInArray(array, 0, cJSON_CreateNumber(-2)));
+    TEST_CHECK(cJSON_InsertItemInArray(array, TEST_ITEMS / 2, cJSON_CreateNumber(-3)));
+    TEST_CHECK(cJSON_InsertItemInArray(array, TEST_ITEMS * 4, cJSON_CreateNumber(-4)));
+    _test_count(array, TEST_ITEMS + 4);
+    TEST_CHECK(cJSON_GetArrayItem(array, 0)->valueint == -2);
+    TEST_CHECK(cJSON_GetArrayItem(array, TEST_ITEMS / 2)->valueint == -3);
+    TEST_CHECK(cJSON_GetArrayItem(array, TEST_ITEMS + 3)->valueint == -4);
+
+    /* 替换 */
+    TEST_CHECK(cJSON_ReplaceItemInArray(array, 0, cJSON_CreateNumber(-5)));
+    TEST_CHECK(cJSON_ReplaceItemViaPointer(array, cJSON_GetArrayItem(array, TEST_ITEMS + 3), cJSON_CreateNumber(-6)));
+    _test_count(array, TEST_ITEMS + 4);
+    TEST_CHECK(cJSON_GetArrayItem(array, 0)->valueint == -5);
+    TEST_CHECK(cJSON_GetArrayItem(array, TEST_ITEMS + 3)->valueint == -6);
+
+    /* 摘下、删除 */
+    item = cJSON_DetachItemFromArray(array, TEST_ITEMS / 2);
+    TEST_CHECK(item && item->valueint == -3);
+    cJSON_Delete(item);
+    cJSON_DeleteItemFromArray(array, 0);
+    item = cJSON_DetachItemViaPointer(array, cJSON_GetArrayItem(array, TEST_ITEMS + 1));
+    TEST_CHECK(item && item->valueint == -6);
+    cJSON_Delete(item);
+    TEST_CHECK(cJSON_DetachItemFromArray(array, TEST_ITEMS * 4) == NULL);
+    _test_count(array, TEST_ITEMS + 1);
+    for (int i = 0; i < TEST_ITEMS; i++)
+    {
+        TEST_CHECK(cJSON_GetArrayItem(array, i)->valueint == i);
+    }
+
+    /* 引用、复制 */
+    ref = cJSON_CreateArrayReference(array->child);
+    _test_count(ref, TEST_ITEMS + 1);
+    cJSON_Delete(ref);
+    ref = cJSON_CreateArray();
+    TEST_CHECK(cJSON_AddItemReferenceToArray(ref, array));
+    _test_count(ref, 1);
+    _test_count(cJSON_GetArrayItem(ref, 0), TEST_ITEMS + 1);
+    cJSON_Delete(ref);
+    copy = cJSON_Duplicate(array, 1);
+    _test_count(copy, TEST_ITEMS + 1);
+    cJSON_Delete(copy);
+
+    /* 原数组改变后，引用的大小及下标访问随之变化 */
+    ref = cJSON_CreateArrayReference(array->child);
+    copy = cJSON_CreateArray();
+    TEST_CHECK(cJSON_AddItemReferenceToArray(copy, array));
+    _test_reference(ref, TEST_ITEMS + 1);
+    cJSON_AddItemToArray(array, cJSON_CreateNumber(-7));
+    cJSON_AddItemToArray(array, cJSON_CreateNumber(-8));
+    _test_reference(ref, TEST_ITEMS + 3);
+    _test_reference(cJSON_GetArrayItem(copy, 0), TEST_ITEMS + 3);
+    cJSON_DeleteItemFromArray(array, TEST_ITEMS / 2);
+    cJSON_DeleteItemFromArray(array, TEST_ITEMS + 1);
+    cJSON_DeleteItemFromArray(array, TEST_ITEMS);
+    _test_reference(ref, TEST_ITEMS);
+    _test_reference(cJSON_GetArrayItem(copy, 0), TEST_ITEMS);
+    TEST_CHECK(cJSON_AddItemToArray(array, cJSON_CreateNumber(TEST_ITEMS / 2)));
+    _test_count(array, TEST_ITEMS + 1);
+    cJSON_Delete(ref);
+    cJSON_Delete(copy);
+
+    /* 对象 */
+    object = cJSON_CreateObject();
+    TEST_CHECK(cJSON_AddItemToObject(object, "array", array));
+    cJSON_AddNumberToObject(object, "n", 1);
+    cJSON_AddStringToObject(object, "s", "x");
+    _test_count(object, 3);
+    cJSON_ReplaceItemInObject(object, "n", cJSON_CreateNumber(2));
+    cJSON_DeleteItemFromObject(object, "s");
+    _test_count(object, 2);
+
+    /* 解析 */
+    text = cJSON_PrintUnformatted(object);
+    TEST_CHECK(text != NULL);
+    copy = cJSON_Parse(text);
+    _test_count(copy, 2);
+    _test_count(cJSON_GetObjectItem(copy, "array"), TEST_ITEMS + 1);
+    cJSON_Delete(copy);
+    cJSON_free(text);
+    copy = cJSON_Parse("{\"a\":[],\"b\":{},\"c\":[[1],[2,3]]}");
+    _test_count(copy, 3);
+    _test_count(cJSON_GetObjectItem(copy, "a"), 0);
+    _test_count(cJSON_GetObjectItem(copy, "b"), 0);
+    _test_count(cJSON_GetArrayItem(cJSON_GetObjectItem(copy, "c"), 1), 2);
+    cJSON_Delete(copy);
+
+    cJSON_Delete(object);
+    return TEST_RESULT();
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test_cpp.cpp
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief C++反射编解码与C数据模型的互通
+ */
+
+extern "C" {
+#include "test.h"
+}
+#include "cson.hpp"
+#include "stdlib.h"
+#include "string.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 反射描述的结构体，引用C模型描述的成员
+ *
+ */
+struct test_item_t
+{
+    int id;
+    double w;
+    char *name;
+    char code[6];
+    test_point_t *pos;
+    cson_list_t *pts;
+};
+
+CSON_REFLECT(test_item_t,
+             CSON_FIELD(test_item_t, id),
+             CSON_FIELD(test_item_t, w),
+             CSON_FIELD(test_item_t, name),
+             cson::field("code", &test_item_t::code, cson::chars),
+             cson::field("pos", &test_item_t::pos, test_point_model, 4),
+             cson::field("pts", &test_item_t::pts, test_point_model, 4));
+
+/**
+ * @brief 反射描述的外层结构体，成员为已反射的结构体
+ *
+ */
+struct test_group_t
+{
+    char *title;
+    test_item_t head;
+    test_item_t *tail;
+};
+
+CSON_REFLECT(test_group_t,
+             CSON_FIELD(test_group_t, title),
+             CSON_FIELD(test_group_t, head),
+             CSON_FIELD(test_group_t, tail));
+
+/**
+ * @brief 标准库类型成员
+ *
+ */
+struct test_user_t
+{
+    std::string name;
+    std::vector<int> scores;
+    std::vector<std::string> tags;
+    std::vector<bool> flags;
+    std::optional<std::string> email;
+    std::optional<int> age;
+    std::unique_ptr<test_group_t> group;
+    std::vector<test_item_t> items;
+};
+
+CSON_REFLECT(test_user_t,
+             CSON_FIELD(test_user_t, name),
+             CSON_FIELD(test_user_t, scores),
+             CSON_FIELD(test_user_t, tags),
+             CSON_FIELD(test_user_t, flags),
+             CSON_FIELD(test_user_t, email),
+             CSON_FIELD(test_user_t, age),
+             CSON_FIELD(test_user_t, group),
+             CSON_FIELD(test_user_t, items));
+
+static const char *test_item_json =
+    "{\"id\":7,\"w\":0.25,\"name\":\"caf\\u00e9\",\"code\":\"abcdefgh\","
+    "\"pos\":{\"x\":1,\"tag\":\"p\",\"w\":0.5},"
+    "\"pts\":[{\"x\":2,\"tag\":\"a\",\"w\":1},{\"x\":3,\"w\":-1}]}";
+
+/**
+ * @brief C++解析结果与按生成的C模型解析结果一致，编码输出逐字节相同
+ *
+ */
+static void _test_item(void)
+{
+    test_item_t item;
+    test_item_t *c_item;
+    char *c_json;
+    std::string json;
+
+    TEST_CHECK(cson::decode(test_item_json, item));
+    TEST_CHECK(item.id == 7 && item.w == 0.25);
+    TEST_CHECK(item.name && strcmp(item.name, "caf\xc3\xa9") == 0);
+    TEST_CHECK(strcmp(item.code, "abcde") == 0);
+    TEST_CHECK(item.pos && item.pos->x == 1 && item.pos->tag && strcmp(item.pos->tag, "p") == 0);
+    TEST_CHECK(item.pts && item.pts->obj && ((test_point_t *)item.pts->obj)->x == 2);
+    TEST_CHECK(item.pts && item.pts->next && ((test_point_t *)item.pts->next->obj)->x == 3);
+    TEST_CHECK(item.pts && item.pts->next && !item.pts->next->next);
+
+    json = cson::encode(item);
+    c_item = (test_item_t *)cson_decode(test_item_json, cson::c_model<test_item_t>(),
+                                        cson::c_model_size<test_item_t>());
+    TEST_CHECK(c_item != NULL);
+    if (c_item)
+    {
+        c_json = cson_encode_unformatted(c_item, cson::c_model<test_item_t>(), cson::c_model_size<test_item_t>());
+        TEST_CHECK(c_json && json == c_json);
+        cson_free_json(c_json);
+        TEST_CHECK(cson::encode(*c_item) == json);
+        cson_free(c_item, cson::c_model<test_item_t>(), cson::c_model_size<test_item_t>());
+    }
+
+    cson::clear(item);
+    TEST_CHECK(!item.name && !item.pos && !item.pts);
+    TEST_CHECK(cson::encode(item) == "{\"id\":7,\"w\":0.25,\"code\":\"abcde\"}");
+}
+
+/**
+ * @brief 已反射结构体作为内嵌成员及指针成员，C模型中分别对应EMBED及STRUCT
+ *
+ */
+static void _test_group(void)
+{
+    const char *json_str = "{\"title\":\"g\",\"head\":{\"id\":1,\"code\":\"h\"},\"tail\":{\"id\":2,\"name\":\"t\"}}";
+    test_group_t group;
+    test_group_t *c_group;
+    char *c_json;
+    std::string json;
+
+    TEST_CHECK(cson::decode(json_str, group));
+    TEST_CHECK(group.head.id == 1 && strcmp(group.head.code, "h") == 0);
+    TEST_CHECK(group.tail && group.tail->id == 2 && strcmp(group.tail->name, "t") == 0);
+    json = cson::encode(group);
+
+    TEST_CHECK(cson::c_model<test_group_t>()[2].type == CSON_TYPE_EMBED);
+    TEST_CHECK(cson::c_model<test_group_t>()[3].type == CSON_TYPE_STRUCT);
+    c_group = (test_group_t *)cson_decode(json_str, cson::c_model<test_group_t>(),
+                                          cson::c_model_size<test_group_t>());
+    TEST_CHECK(c_group != NULL);
+    if (c_group)
+    {
+        c_json = cson_encode_unformatted(c_group, cson::c_model<test_group_t>(), cson::c_model_size<test_group_t>());
+        TEST_CHECK(c_json && json == c_json);
+        cson_free_json(c_json);
+        cson_free(c_group, cson::c_model<test_group_t>(), cson::c_model_size<test_group_t>());
+    }
+    cson::clear(group);
+    TEST_CHECK(!group.title && !group.head.name && !group.tail);
+
+    cson::unique_ptr<test_group_t> owned(cson::decode<test_group_t>(json_str));
+    TEST_CHECK(owned && owned->tail && cson::encode(*owned) == json);
+    TEST_CHECK(!cson::decode<test_group_t>("null"));
+    TEST_CHECK(!cson::decode(" [1", group));
+}
+
+/**
+ * @brief 标准库类型成员的解析与编码，空的optional及unique_ptr编码时省略
+ *
+ */
+static void _test_user(void)
+{
+    const char *json_str =
+        "{\"name\":\"a \\\"b\\\"\\n\",\"scores\":[1,2,3],\"tags\":[\"x\",\"y\"],\"flags\":[true,false,true],"
+        "\"email\":\"a@b\",\"age\":30,\"group\":{\"title\":\"g\",\"head\":{\"id\":1,\"code\":\"\"}},"
+        "\"items\":[{\"id\":4,\"name\":\"n\",\"code\":\"i\"},{\"id\":5,\"code\":\"j\"}]}";
+    test_user_t user;
+    test_user_t again;
+    std::string json;
+
+    TEST_CHECK(cson::decode(json_str, user));
+    TEST_CHECK(user.name == "a \"b\"\n");
+    TEST_CHECK(user.scores == std::vector<int>({1, 2, 3}));
+    TEST_CHECK(user.tags == std::vector<std::string>({"x", "y"}));
+    TEST_CHECK(user.flags == std::vector<bool>({true, false, true}));
+    TEST_CHECK(user.email && *user.email == "a@b");
+    TEST_CHECK(user.age && *user.age == 30);
+    TEST_CHECK(user.group && user.group->title && strcmp(user.group->title, "g") == 0 && !user.group->tail);
+    TEST_CHECK(user.items.size() == 2 && user.items[0].id == 4 && user.items[1].id == 5);
+    TEST_CHECK(user.items.size() == 2 && strcmp(user.items[1].code, "j") == 0);
+
+    json = cson::encode(user);
+    TEST_CHECK(cson::decode(json.c_str(), again));
+    TEST_CHECK(cson::encode(again) == json);
+    cson::clear(user);
+    cson::clear(again);
+    TEST_CHECK(user.name.empty() && user.tags.empty() && !user.email && !user.group && user.items.empty());
+
+    TEST_CHECK(cson::decode("{\"name\":1,\"email\":null,\"age\":null,\"group\":null,\"tags\":{}}", user));
+    TEST_CHECK(user.name.empty() && user.scores.empty() && user.tags.empty() && user.items.empty());
+    TEST_CHECK(!user.email && !user.age && !user.group);
+    TEST_CHECK(cson::encode(user) == "{\"name\":\"\",\"scores\":[],\"tags\":[],\"flags\":[],\"items\":[]}");
+}
+
+int main(void)
+{
+    cson_init((void *)malloc, (void *)free);
+
+    _test_item();
+    _test_group();
+    _test_user();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_decoder.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 推送式解析器逐字节送入与JSON路径的一致性
+ */
+
+#include "test.h"
+#include "cson_decoder.h"
+#include "stdlib.h"
+#include "string.h"
+
+int main(void)
+{
+    test_record_t *obj;
+    cson_decoder_t *dec;
+    cson_decoder_status_t status = CSON_DECODER_NEED_MORE;
+    size_t len = strlen(test_record_json);
+    char *expect, *pair, *deep;
+
+    cson_init((void *)malloc, (void *)free);
+
+    obj = cson_decode_ex(test_record_json, test_record_model);
+    expect = cson_encode_unformatted_ex(obj, test_record_model);
+    TEST_CHECK(expect != NULL);
+    cson_free_ex(obj, test_record_model);
+
+    /* 逐字节送入，只有最后一个字节完成解析 */
+    dec = cson_decoder_create_ex(test_record_model);
+    TEST_CHECK(dec != NULL);
+    for (size_t i = 0; i < len; i++)
+    {
+        status = cson_decoder_feed(dec, test_record_json + i, 1);
+        if (i + 1 < len)
+        {
+            TEST_CHECK(status == CSON_DECODER_NEED_MORE);
+        }
+    }
+    TEST_CHECK(status == CSON_DECODER_DONE);
+    obj = cson_decoder_result(dec);
+    TEST_CHECK(test_record_same(expect, obj));
+    cson_free_ex(obj, test_record_model);
+
+    /* 一段数据包含两个报文时只消费第一个，重置后解析剩余部分 */
+    pair = malloc(len * 2 + 3);
+    TEST_CHECK(pair != NULL);
+    if (pair)
+    {
+        sprintf(pair, "%s \n%s", test_record_json, test_record_json);
+        cson_decoder_reset(dec);
+        TEST_CHECK(cson_decoder_feed(dec, pair, strlen(pair)) == CSON_DECODER_DONE);
+        TEST_CHECK(cson_decoder_consumed(dec) == len);
+        obj = cson_decoder_result(dec);
+        TEST_CHECK(test_record_same(expect, obj));
+        cson_free_ex(obj, test_record_model);
+        cson_decoder_reset(dec);
+        TEST_CHECK(cson_decoder_feed(dec, pair + len, strlen(pair) - len) == CSON_DECODER_DONE);
+        obj = cson_decoder_result(dec);
+        TEST_CHECK(test_record_same(expect, obj));
+        cson_free_ex(obj, test_record_model);
+        free(pair);
+    }
+
+    /* 格式错误 */
+    cson_decoder_reset(dec);
+    TEST_CHECK(cson_decoder_feed(dec, "{\"id\":1,]", 9) == CSON_DECODER_ERROR);
+    TEST_CHECK(cson_decoder_result(dec) == NULL);
+
+    /* 顶层数字到数据末尾才结束，报文不完整时结束解析报错 */
+    cson_decoder_reset(dec);
+    TEST_CHECK(cson_decoder_feed(dec, "123", 3) == CSON_DECODER_NEED_MORE);
+    TEST_CHECK(cson_decoder_finish(dec) == CSON_DECODER_DONE);
+    obj = cson_decoder_result(dec);
+    TEST_CHECK(obj != NULL);
+    cson_free_ex(obj, test_record_model);
+    cson_decoder_reset(dec);
+    TEST_CHECK(cson_decoder_feed(dec, test_record_json, len) == CSON_DECODER_DONE);
+    TEST_CHECK(cson_decoder_finish(dec) == CSON_DECODER_DONE);
+    obj = cson_decoder_result(dec);
+    TEST_CHECK(test_record_same(expect, obj));
+    cson_free_ex(obj, test_record_model);
+    cson_decoder_reset(dec);
+    TEST_CHECK(cson_decoder_feed(dec, "{\"id\":1", 7) == CSON_DECODER_NEED_MORE);
+    TEST_CHECK(cson_decoder_finish(dec) == CSON_DECODER_ERROR);
+    TEST_CHECK(cson_decoder_result(dec) == NULL);
+
+    /* 跳过的子树不受CSON_DECODER_DEPTH_MAX限制 */
+    deep = malloc(CSON_DECODER_DEPTH_MAX * 8 + 32);
+    TEST_CHECK(deep != NULL);
+    if (deep)
+    {
+        size_t n = 0;
+
+        n += sprintf(deep + n, "{\"unknown\":");
+        for (int i = 0; i < CSON_DECODER_DEPTH_MAX * 2; i++)
+        {
+            n += sprintf(deep + n, i % 2 ? "[" : "{\"a\":");
+        }
+        for (int i = CSON_DECODER_DEPTH_MAX * 2 - 1; i >= 0; i--)
+        {
+            n += sprintf(deep + n, i % 2 ? "]" : "}");
+        }
+        n += sprintf(deep + n, ",\"id\":5}");
+        cson_decoder_reset(dec);
+        TEST_CHECK(cson_decoder_feed(dec, deep, n) == CSON_DECODER_DONE);
+        obj = cson_decoder_result(dec);
+        TEST_CHECK(obj && obj->id == 5);
+        cson_free_ex(obj, test_record_model);
+        free(deep);
+    }
+
+    /* 同名字段取第一个，与cson_decode一致 */
+    {
+        const char *dup = "{\"id\":1,\"ID\":2,\"b\":true,\"b\":false,\"arr\":[1],\"arr\":[2,3],"
+                          "\"home\":{\"x\":1},\"home\":{\"x\":2,\"w\":3},\"code\":\"\",\"code\":\"x\","
+                          "\"pos\":{\"x\":1,\"x\":2}}";
+        char *ref;
+
+        obj = cson_decode_ex(dup, test_record_model);
+        ref = cson_encode_unformatted_ex(obj, test_record_model);
+        TEST_CHECK(obj && obj->id == 1 && obj->b == 1 && obj->arr[0] == 1 && obj->arr[1] == 0);
+        TEST_CHECK(obj && obj->home.x == 1 && obj->home.w == 0 && obj->code[0] == 0);
+        TEST_CHECK(obj && obj->pos && obj->pos->x == 1);
+        cson_free_ex(obj, test_record_model);
+        cson_decoder_reset(dec);
+        TEST_CHECK(cson_decoder_feed(dec, dup, strlen(dup)) == CSON_DECODER_DONE);
+        obj = cson_decoder_result(dec);
+        TEST_CHECK(ref && test_record_same(ref, obj));
+        cson_free_ex(obj, test_record_model);
+        cson_free_json(ref);
+    }
+
+    cson_decoder_destroy(dec);
+    cson_free_json(expect);
+    return TEST_RESULT();
+}
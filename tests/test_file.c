@@ -0,0 +1,124 @@
+/**
+ * @file test_file.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 文件解析的复制与借用模式，映射在对象释放时解除
+ */
+
+#include "test.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 未释放的内存块数
+ *
+ */
+static long test_live;
+
+/**
+ * @brief 分配次数
+ *
+ */
+static long test_allocs;
+
+static void *_test_malloc(size_t size)
+{
+    void *ptr = malloc(size);
+    test_live += ptr ? 1 : 0;
+    test_allocs++;
+    return ptr;
+}
+
+static void _test_free(void *ptr)
+{
+    test_live -= ptr ? 1 : 0;
+    free(ptr);
+}
+
+/**
+ * @brief 统计文件在当前进程中的映射数，不支持时返回-1
+ *
+ * @param name 文件名
+ * @return int 映射数
+ */
+static int _test_mappings(const char *name)
+{
+#if defined(__linux__) && CSON_USING_MMAP
+    FILE *fp = fopen("/proc/self/maps", "r");
+    char line[512];
+    int count = 0;
+
+    if (!fp)
+    {
+        return -1;
+    }
+    while (fgets(line, sizeof(line), fp))
+    {
+        count += strstr(line, name) != NULL;
+    }
+    fclose(fp);
+    return count;
+#else
+    (void)name;
+    return -1;
+#endif
+}
+
+int main(void)
+{
+    const char *path = "test_file.json";
+    test_record_t *obj;
+    long start, allocs[2];
+    char *expect;
+    FILE *fp;
+
+    cson_init((void *)_test_malloc, (void *)_test_free);
+    start = test_live;
+
+    obj = cson_decode_ex(test_record_json, test_record_model);
+    expect = cson_encode_unformatted_ex(obj, test_record_model);
+    cson_free_ex(obj, test_record_model);
+
+    fp = fopen(path, "wb");
+    TEST_CHECK(fp != NULL);
+    if (!fp)
+    {
+        return TEST_RESULT();
+    }
+    fputs(test_record_json, fp);
+    fclose(fp);
+
+    /* 复制模式解析完成即解除映射，借用模式保留映射到对象释放 */
+    for (int borrow = 0; borrow < 2; borrow++)
+    {
+        allocs[borrow] = test_allocs;
+        obj = cson_decode_file_ex(path, test_record_model, borrow ? CSON_FILE_BORROW : 0);
+        allocs[borrow] = test_allocs - allocs[borrow];
+        TEST_CHECK(test_record_same(expect, obj));
+        TEST_CHECK(_test_mappings(path) == (borrow ? 1 : 0) || _test_mappings(path) < 0);
+        cson_free_file_ex(obj, test_record_model);
+        TEST_CHECK(_test_mappings(path) <= 0);
+    }
+
+    /* 借用模式下不含转义的字符串不再复制 */
+    TEST_CHECK(allocs[1] < allocs[0]);
+
+    /* 文件不存在或为空 */
+    remove(path);
+    TEST_CHECK(cson_decode_file_ex(path, test_record_model, 0) == NULL);
+    fp = fopen(path, "wb");
+    if (fp)
+    {
+        fclose(fp);
+    }
+    TEST_CHECK(cson_decode_file_ex(path, test_record_model, CSON_FILE_BORROW) == NULL);
+    remove(path);
+
+    cson_free_json(expect);
+    TEST_CHECK(test_live == start);
+    return TEST_RESULT();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_gen.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 生成代码的解析/编码结果与模型解释执行一致
+ */
+
+#include "test.h"
+#include "test_model_gen.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 测试文档，覆盖转义、大整数、null元素、缺失及类型不符的字段
+ *
+ */
+static const char *test_docs[] = {
+    NULL,
+    "{\"id\":-1,\"l\":9007199254740992,\"d\":1e+300,\"f\":-0.25,\"name\":\"tab\\t\\u00e9\\ud83d\\ude00\\/\"}",
+    "{\"pts\":[null,{\"x\":1},null],\"nums\":[1.9,true,\"x\",-2],\"words\":[\"a\",null,\"b\"]}",
+    "{\"c\":300,\"s\":\"text\",\"b\":1,\"pos\":null,\"home\":[],\"arr\":[1,2,3,4],\"code\":\"0123456789\"}",
+    "{\"raw\":[1,{\"a\":null}],\"vals\":[],\"marks\":[{},{\"x\":2}],\"route\":[{},{},{},{}]}",
+    "{}",
+};
+
+/**
+ * @brief 语法校验文档，其中cJSON接受前导0及对象后的多余内容
+ *
+ */
+static const char *test_syntax[] = {
+    "", "{\"id\":1,}", "{\"id\":01}", "{\"id\":tru}", "{\"nums\":[1 2]}", "{\"id\":1} x", "{\"id\":\"\\x\"}",
+    "{\"id\":1", "null", "[]",
+};
+
+/**
+ * @brief 比较解释执行与生成代码的解析及编码结果
+ *
+ * @param doc 文档
+ */
+static void _test_doc(const char *doc)
+{
+    test_record_t *obj, *gen_obj;
+    char *expect, *json;
+
+    obj = cson_decode_ex(doc, test_record_model);
+    gen_obj = cson_gen_test_record_model_decode(doc);
+    TEST_CHECK(obj && gen_obj);
+    if (!obj || !gen_obj)
+    {
+        printf("doc: %s\n", doc);
+        cson_free_ex(obj, test_record_model);
+        cson_gen_test_record_model_free(gen_obj);
+        return;
+    }
+    expect = cson_encode_unformatted_ex(obj, test_record_model);
+
+    /* 生成代码解析的对象按模型编码 */
+    TEST_CHECK(test_record_same(expect, gen_obj));
+
+    /* 生成代码编码 */
+    json = cson_gen_test_record_model_encode(obj);
+    TEST_CHECK(json && strcmp(json, expect) == 0);
+    if (json && strcmp(json, expect) != 0)
+    {
+        printf("expect: %s\nactual: %s\n", expect, json);
+    }
+    cson_free_json(json);
+
+    cson_free_json(expect);
+    cson_free_ex(obj, test_record_model);
+    cson_gen_test_record_model_free(gen_obj);
+}
+
+int main(void)
+{
+    cson_init((void *)malloc, (void *)free);
+
+    test_docs[0] = test_record_json;
+    for (size_t i = 0; i < sizeof(test_docs) / sizeof(test_docs[0]); i++)
+    {
+        _test_doc(test_docs[i]);
+    }
+
+    /* 语法校验与cJSON一致 */
+    for (size_t i = 0; i < sizeof(test_syntax) / sizeof(test_syntax[0]); i++)
+    {
+        test_record_t *obj = cson_decode_ex(test_syntax[i], test_record_model);
+        test_record_t *gen_obj = cson_gen_test_record_model_decode(test_syntax[i]);
+
+        TEST_CHECK(!obj == !gen_obj);
+        if (!obj != !gen_obj)
+        {
+            printf("doc: %s\n", test_syntax[i]);
+        }
+        cson_free_ex(obj, test_record_model);
+        cson_gen_test_record_model_free(gen_obj);
+    }
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_index.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief cJSON对象成员索引在增删改后的查找结果
+ */
+
+#include "test.h"
+#include "cJSON.h"
+#include "string.h"
+
+#define TEST_MEMBERS (CJSON_INDEX_MIN * 4 + 67)
+
+/* 支持原子操作时查找会建立索引 */
+#if (CJSON_INDEX_MIN > 0) && (defined(__clang__) || defined(__GNUC__))
+#define TEST_INDEXED(object) TEST_CHECK((object)->child_index != NULL)
+#else
+#define TEST_INDEXED(object)
+#endif
+
+/**
+ * @brief 线性查找成员，作为索引查找的参照
+ *
+ * @param object 对象
+ * @param key 键值
+ * @return cJSON* 成员
+ */
+static cJSON *_test_scan(const cJSON *object, const char *key)
+{
+    cJSON *item;
+
+    for (item = object->child; item; item = item->next)
+    {
+        if (strcmp(item->string, key) == 0)
+        {
+            return item;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 检查每个键的索引查找与线性查找一致
+ *
+ * @param object 对象
+ */
+static void _test_lookup_all(const cJSON *object)
+{
+    char key[32];
+
+    for (int i = 0; i < TEST_MEMBERS + 8; i++)
+    {
+        sprintf(key, "key%d", i);
+        TEST_CHECK(cJSON_GetObjectItemCaseSensitive(object, key) == _test_scan(object, key));
+        TEST_CHECK(cJSON_GetObjectItem(object, key) == _test_scan(object, key));
+    }
+    TEST_CHECK(cJSON_GetObjectItemCaseSensitive(object, "KEY1") == NULL);
+    TEST_CHECK(cJSON_GetObjectItem(object, "KEY1") == _test_scan(object, "key1"));
+    TEST_INDEXED(object);
+}
+
+/**
+ * @brief 检查引用容器的查找结果，引用与原对象共享成员，不建立索引
+ *
+ * @param reference 引用容器
+ */
+static void _test_lookup_reference(const cJSON *reference)
+{
+    char key[32];
+
+    for (int i = 0; i < TEST_MEMBERS + 8; i++)
+    {
+        sprintf(key, "key%d", i);
+        TEST_CHECK(cJSON_GetObjectItemCaseSensitive(reference, key) == _test_scan(reference, key));
+        TEST_CHECK(cJSON_GetObjectItem(reference, key) == _test_scan(reference, key));
+    }
+    TEST_CHECK(reference->child_index == NULL);
+}
+
+int main(void)
+{
+    cJSON *object = cJSON_CreateObject();
+    cJSON *container, *reference;
+    cJSON *item;
+    char key[32];
+
+    for (int i = 0; i < TEST_MEMBERS; i++)
+    {
+        sprintf(key, "key%d", i);
+        cJSON_AddNumberToObject(object, key, i);
+    }
+    _test_lookup_all(object);
+    item = cJSON_GetObjectItemCaseSensitive(object, "key7");
+    TEST_CHECK(item && item->valueint == 7);
+
+    /* 添加 */
+    sprintf(key, "key%d", TEST_MEMBERS);
+    cJSON_AddStringToObject(object, key, "added");
+    _test_lookup_all(object);
+    item = cJSON_GetObjectItemCaseSensitive(object, key);
+    TEST_CHECK(item && strcmp(item->valuestring, "added") == 0);
+
+    /* 替换 */
+    TEST_CHECK(cJSON_ReplaceItemInObjectCaseSensitive(object, "key7", cJSON_CreateString("replaced")));
+    _test_lookup_all(object);
+    item = cJSON_GetObjectItemCaseSensitive(object, "key7");
+    TEST_CHECK(item && cJSON_IsString(item) && strcmp(item->valuestring, "replaced") == 0);
+
+    /* 删除首个、中间及末尾的成员 */
+    cJSON_DeleteItemFromObjectCaseSensitive(object, "key0");
+    cJSON_DeleteItemFromObjectCaseSensitive(object, "key40");
+    cJSON_DeleteItemFromObjectCaseSensitive(object, key);
+    _test_lookup_all(object);
+    TEST_CHECK(cJSON_GetObjectItemCaseSensitive(object, "key0") == NULL);
+    TEST_CHECK(cJSON_GetObjectItemCaseSensitive(object, "key40") == NULL);
+    TEST_CHECK(cJSON_GetObjectItemCaseSensitive(object, key) == NULL);
+    TEST_CHECK(cJSON_GetObjectItemCaseSensitive(object, "key41") != NULL);
+
+    /* 同名成员取第一个 */
+    cJSON_AddNumberToObject(object, "key41", -1);
+    _test_lookup_all(object);
+    item = cJSON_GetObjectItemCaseSensitive(object, "key41");
+    TEST_CHECK(item && item->valueint == 41);
+
+    /* 摘下后成员不再可查 */
+    item = cJSON_DetachItemFromObjectCaseSensitive(object, "key41");
+    TEST_CHECK(item && item->valueint == 41);
+    cJSON_Delete(item);
+    item = cJSON_GetObjectItemCaseSensitive(object, "key41");
+    TEST_CHECK(item && item->valueint == -1);
+    _test_lookup_all(object);
+
+    /* 原对象删除中间成员并追加一个，首成员与成员数不变，引用的查找不能用到已释放的成员 */
+    container = cJSON_CreateObject();
+    TEST_CHECK(cJSON_AddItemReferenceToObject(container, "ref", object));
+    reference = cJSON_CreateObjectReference(object->child);
+    _test_lookup_reference(reference);
+    _test_lookup_reference(cJSON_GetObjectItem(container, "ref"));
+    cJSON_DeleteItemFromObjectCaseSensitive(object, "key20");
+    cJSON_AddNumberToObject(object, "key20", 20);
+    cJSON_DeleteItemFromObjectCaseSensitive(object, "key30");
+    cJSON_AddNumberToObject(object, "key30", 30);
+    _test_lookup_reference(reference);
+    _test_lookup_reference(cJSON_GetObjectItem(container, "ref"));
+    item = cJSON_GetObjectItemCaseSensitive(reference, "key20");
+    TEST_CHECK(item && item->valueint == 20 && item->next && item->next->valueint == 30);
+    _test_lookup_all(object);
+    cJSON_Delete(reference);
+    cJSON_Delete(container);
+
+    cJSON_Delete(object);
+    return TEST_RESULT();
+}
@@ -0,0 +1,235 @@
+/**
+ * @file test_list.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 链表解析结果的形状，普通解析与对象池解析一致；链表头的追加、访问、移除及释放
+ */
+
+#include "test.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 含null元素的结构体链表
+ *
+ */
+static const char *test_null_json = "{\"pts\":[null,{\"x\":1},null,null,{\"x\":2}],\"nums\":[3,4]}";
+
+/**
+ * @brief 检查含null元素的链表：每个元素一个节点，null元素的节点对象为NULL
+ *
+ * @param obj 解析得到的对象
+ */
+static void _test_null_shape(test_record_t *obj)
+{
+    const int expect[] = {0, 1, 0, 0, 2};
+    cson_list_t *p;
+    int count = 0;
+
+    TEST_CHECK(obj != NULL);
+    if (!obj)
+    {
+        return;
+    }
+    for (p = obj->pts; p; p = p->next, count++)
+    {
+        if (count < 5)
+        {
+            TEST_CHECK(expect[count] ? (p->obj && ((test_point_t *)p->obj)->x == expect[count]) : !p->obj);
+        }
+    }
+    TEST_CHECK(count == 5);
+    TEST_CHECK(obj->nums && obj->nums->i == 3 && obj->nums->next && obj->nums->next->i == 4);
+    TEST_CHECK(obj->nums && obj->nums->next && !obj->nums->next->next);
+}
+
+/**
+ * @brief 检查链表头记录的节点与链表一致
+ *
+ * @param list 链表头
+ * @param expect 期望的元素值
+ * @param count 期望的元素数
+ */
+static void _test_head(cson_list_head_t *list, const int *expect, size_t count)
+{
+    cson_list_t *p, *last = NULL;
+    size_t i = 0;
+
+    for (p = list->head; p; last = p, p = p->next, i++)
+    {
+        TEST_CHECK(i < count && p->i == expect[i]);
+    }
+    TEST_CHECK(i == count && list->count == count && list->tail == last);
+}
+
+/**
+ * @brief 未释放的内存块数
+ *
+ */
+static long test_live;
+
+/**
+ * @brief 分配次数
+ *
+ */
+static long test_allocs;
+
+static void *_test_malloc(size_t size)
+{
+    void *ptr = malloc(size);
+    test_live += ptr ? 1 : 0;
+    test_allocs++;
+    return ptr;
+}
+
+static void _test_free(void *ptr)
+{
+    test_live -= ptr ? 1 : 0;
+    free(ptr);
+}
+
+/**
+ * @brief 链表头的追加、按序号访问、移除后复用及释放
+ *
+ */
+static void _test_push(void)
+{
+    const size_t total = 2 * CSON_LIST_CHUNK_NODES + 1;
+    cson_list_head_t list = CSON_LIST_HEAD_INIT;
+    test_record_t record;
+    cson_list_t *prev, *node;
+    long live = test_live, allocs;
+    size_t i, sum = 0;
+    char buf[16];
+    char *json;
+
+    /* 节点按块分配 */
+    allocs = test_allocs;
+    for (i = 0; i < total; i++)
+    {
+        node = cson_list_push(&list, NULL);
+        TEST_CHECK(node && !node->next && !node->obj && list.tail == node && list.count == i + 1);
+        if (node)
+        {
+            node->i = (int)i;
+        }
+    }
+    TEST_CHECK(test_allocs - allocs == 3);
+
+    /* 顺序访问沿cursor前进，回退时从头查找 */
+    for (i = 0; i < total; i++)
+    {
+        node = cson_list_at(&list, i);
+        TEST_CHECK(node && node->i == (int)i);
+    }
+    TEST_CHECK(cson_list_at(&list, total) == NULL);
+    TEST_CHECK(cson_list_at(&list, 3)->i == 3 && cson_list_at(&list, 1)->i == 1);
+    TEST_CHECK(cson_list_at(&list, total - 1) == list.tail);
+    CSON_LIST_FOREACH(p, &list)
+    {
+        sum += (size_t)p->i;
+    }
+    TEST_CHECK(sum == total * (total - 1) / 2);
+
+    /* 遍历时记录前一个节点，移除奇数元素 */
+    for (prev = NULL, node = list.head; node;)
+    {
+        cson_list_t *next = node->next;
+        if (node->i % 2)
+        {
+            TEST_CHECK(cson_list_remove(&list, prev, node) == 0);
+        }
+        else
+        {
+            prev = node;
+        }
+        node = next;
+    }
+    TEST_CHECK(list.count == total / 2 + 1 && list.tail->i == (int)total - 1);
+    i = 0;
+    CSON_LIST_FOREACH(p, &list)
+    {
+        TEST_CHECK(p->i == (int)(2 * i++));
+    }
+    TEST_CHECK(cson_list_at(&list, 2)->i == 4);
+
+    /* 移除的节点被复用，不再分配 */
+    allocs = test_allocs;
+    while (list.count < total)
+    {
+        TEST_CHECK(cson_list_push(&list, NULL) != NULL);
+    }
+    TEST_CHECK(test_allocs == allocs);
+    cson_list_release(&list, NULL, 0);
+    TEST_CHECK(test_live == live && !list.head && !list.tail && !list.count && !list.chunks && !list.spare);
+
+    /* 节点链可直接用于编码，释放时一并释放字符串 */
+    for (i = 0; i < 3; i++)
+    {
+        sprintf(buf, "w%d", (int)i);
+        cson_list_push(&list, NULL)->str = cson_new_string(buf);
+    }
+    memset(&record, 0, sizeof(record));
+    record.words = list.head;
+    json = cson_encode_unformatted_ex(&record, test_record_model);
+    TEST_CHECK(json && strstr(json, "\"words\":[\"w0\",\"w1\",\"w2\"]") != NULL);
+    cson_free_json(json);
+    cson_list_release(&list, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE);
+    TEST_CHECK(test_live == live);
+}
+
+int main(void)
+{
+    test_record_t *obj;
+    cson_pool_t *pool;
+    char *expect;
+
+    cson_init((void *)_test_malloc, (void *)_test_free);
+
+    /* null元素保留节点，编码时跳过 */
+    obj = cson_decode_ex(test_null_json, test_record_model);
+    _test_null_shape(obj);
+    expect = cson_encode_unformatted_ex(obj, test_record_model);
+    TEST_CHECK(expect && strstr(expect, "\"pts\":[{\"x\":1,\"w\":0},{\"x\":2,\"w\":0}]") != NULL);
+    cson_free_ex(obj, test_record_model);
+
+    pool = cson_pool_create_ex(test_record_model);
+    TEST_CHECK(pool != NULL);
+    obj = cson_pool_decode(pool, test_null_json);
+    _test_null_shape(obj);
+    TEST_CHECK(test_record_same(expect, obj));
+    cson_pool_release(obj);
+    cson_pool_destroy(pool);
+
+    cson_free_json(expect);
+
+    /* 给出前一个节点移除首、中、尾节点，前一个节点不匹配时拒绝 */
+    {
+        cson_list_head_t list = CSON_LIST_HEAD_INIT;
+        const int rest[] = {1, 3};
+        cson_list_t *node;
+
+        for (int i = 0; i < 5; i++)
+        {
+            cson_list_push(&list, NULL)->i = i;
+        }
+        node = cson_list_at(&list, 2);
+        TEST_CHECK(cson_list_remove(&list, NULL, node) == -1);
+        TEST_CHECK(cson_list_remove(&list, list.head, node) == -1);
+        TEST_CHECK(cson_list_remove(&list, NULL, list.head) == 0);
+        TEST_CHECK(cson_list_remove(&list, cson_list_at(&list, 2), list.tail) == 0);
+        TEST_CHECK(cson_list_remove(&list, cson_list_at(&list, 0), node) == 0);
+        _test_head(&list, rest, 2);
+        TEST_CHECK(cson_list_at(&list, 1) == list.tail);
+        TEST_CHECK(cson_list_push(&list, NULL) == node);
+        cson_list_release(&list, NULL, 0);
+    }
+
+    _test_push();
+
+    return TEST_RESULT();
+}
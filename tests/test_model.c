@@ -0,0 +1,83 @@
+/**
+ * @file test_model.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ */
+
+#include "test.h"
+#include "string.h"
+
+int test_failures;
+
+cson_model_t test_point_model[4] = {
+    CSON_MODEL_OBJ(test_point_t),
+    CSON_MODEL_INT(test_point_t, x),
+    CSON_MODEL_STRING(test_point_t, tag),
+    CSON_MODEL_DOUBLE(test_point_t, w),
+};
+
+cson_model_t test_record_model[22] = {
+    CSON_MODEL_OBJ(test_record_t),
+    CSON_MODEL_CHAR(test_record_t, c),
+    CSON_MODEL_SHORT(test_record_t, s),
+    CSON_MODEL_INT(test_record_t, id),
+    CSON_MODEL_LONG(test_record_t, l),
+    CSON_MODEL_FLOAT(test_record_t, f),
+    CSON_MODEL_DOUBLE(test_record_t, d),
+    {CSON_TYPE_BOOL, "b", offsetof(test_record_t, b)},
+    CSON_MODEL_STRING(test_record_t, name),
+    CSON_MODEL_STRUCT(test_record_t, pos, test_point_model, 4),
+    CSON_MODEL_EMBED(test_record_t, home, test_point_model),
+    CSON_MODEL_EMBED_ARRAY_COUNT(test_record_t, route, test_point_model, 3, route_count),
+    CSON_MODEL_ILIST(test_record_t, chain, test_point_model, 4, test_point_t, next),
+    CSON_MODEL_LIST(test_record_t, pts, test_point_model, 4),
+    CSON_MODEL_LIST(test_record_t, nums, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_LIST(test_record_t, words, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_VECTOR(test_record_t, vals, CSON_MODEL_DOUBLE_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_VECTOR(test_record_t, marks, test_point_model, 4),
+    CSON_MODEL_ARRAY(test_record_t, arr, CSON_TYPE_INT, 3),
+    CSON_MODEL_ARRAY(test_record_t, strs, CSON_TYPE_STRING, 2),
+    CSON_MODEL_CHAR_ARRAY(test_record_t, code, 8),
+    CSON_MODEL_JSON(test_record_t, raw),
+};
+
+const char *test_record_json =
+    "{\"c\":-5,\"s\":-300,\"id\":70000,\"l\":-5000000000,\"f\":1.5,\"d\":3.25,\"b\":true,"
+    "\"name\":\"caf\\u00e9 \\\"quoted\\\" and a string longer than thirty-two bytes\","
+    "\"pos\":{\"x\":1,\"tag\":\"t\",\"w\":0.5},"
+    "\"home\":{\"x\":7,\"tag\":\"h\",\"w\":-2},"
+    "\"route\":[{\"x\":8,\"tag\":\"r0\",\"w\":0},{\"x\":9,\"w\":1}],"
+    "\"chain\":[{\"x\":10,\"tag\":\"c0\",\"w\":0},{\"x\":11,\"tag\":\"c1\",\"w\":0.25}],"
+    "\"pts\":[{\"x\":2,\"tag\":\"u\",\"w\":1},{\"x\":3,\"w\":2}],"
+    "\"nums\":[1,200,-7],"
+    "\"words\":[\"a\",\"\",\"ccc\"],"
+    "\"vals\":[0.5,-1.25,1e+100],"
+    "\"marks\":[{\"x\":4,\"tag\":\"m\",\"w\":3}],"
+    "\"arr\":[1,2,3],"
+    "\"strs\":[\"s1\",\"s2\"],"
+    "\"code\":\"AB-12\","
+    "\"raw\":{\"k\":[1,2.5,\"v\",null,false]}}";
+
+int test_record_same(const char *expect, test_record_t *obj)
+{
+    char *json;
+    int same;
+
+    if (!obj)
+    {
+        printf("decode failed\n");
+        return 0;
+    }
+    json = cson_encode_unformatted(obj, test_record_model, 22);
+    same = json && strcmp(expect, json) == 0;
+    if (!same)
+    {
+        printf("expect: %s\nactual: %s\n", expect, json ? json : "(null)");
+    }
+    cson_free_json(json);
+    return same;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file test_msgpack.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief MessagePack编解码与JSON路径的一致性
+ */
+
+#include "test.h"
+#include "cson_msgpack.h"
+#include "stdlib.h"
+#include "string.h"
+
+int main(void)
+{
+    test_record_t *obj, *copy;
+    unsigned char *data;
+    char *expect;
+    size_t len;
+
+    cson_init((void *)malloc, (void *)free);
+
+    obj = cson_decode_ex(test_record_json, test_record_model);
+    TEST_CHECK(obj != NULL);
+    expect = cson_encode_unformatted_ex(obj, test_record_model);
+    TEST_CHECK(expect != NULL);
+
+    data = cson_msgpack_encode_ex(obj, test_record_model, &len);
+    TEST_CHECK(data != NULL && len > 0);
+    copy = cson_msgpack_decode_ex(data, len, test_record_model);
+    TEST_CHECK(test_record_same(expect, copy));
+    TEST_CHECK(copy && copy->l == -5000000000L);
+    cson_free_ex(copy, test_record_model);
+
+    /* 截断的数据一律解码失败 */
+    for (size_t i = 0; i < len; i++)
+    {
+        copy = cson_msgpack_decode_ex(data, i, test_record_model);
+        TEST_CHECK(copy == NULL);
+        cson_free_ex(copy, test_record_model);
+    }
+
+    cson_msgpack_free(data);
+    cson_free_json(expect);
+    cson_free_ex(obj, test_record_model);
+    return TEST_RESULT();
+}
@@ -0,0 +1,66 @@
+/**
+ * @file test_number.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 2^53以内的整数按完整数字输出，long字段编码后再解析保持不变
+ */
+
+#include "test.h"
+#include "cJSON.h"
+#include "stdlib.h"
+#include "string.h"
+
+int main(void)
+{
+    const double numbers[] = {9007199254740992.0, -9007199254740992.0, 9007199254740991.0, 4503599627370497.0,
+                              1e15, -5e9};
+    const char *texts[] = {"9007199254740992", "-9007199254740992", "9007199254740991", "4503599627370497",
+                           "1000000000000000", "-5000000000"};
+    test_record_t *obj, *copy;
+    cJSON *item;
+    char *json;
+    char buf[64];
+
+    cson_init((void *)malloc, (void *)free);
+
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++)
+    {
+        item = cJSON_CreateNumber(numbers[i]);
+        json = cJSON_PrintUnformatted(item);
+        TEST_CHECK(json && strcmp(json, texts[i]) == 0);
+        cJSON_free(json);
+        cJSON_Delete(item);
+
+        /* long字段经JSON往返 */
+        sprintf(buf, "{\"l\":%s}", texts[i]);
+        obj = cson_decode_ex(buf, test_record_model);
+        json = cson_encode_unformatted_ex(obj, test_record_model);
+        TEST_CHECK(json != NULL);
+        if (json)
+        {
+            copy = cson_decode_ex(json, test_record_model);
+            TEST_CHECK(obj && copy && obj->l == copy->l && (double)copy->l == numbers[i]);
+            cson_free_ex(copy, test_record_model);
+            cson_free_json(json);
+        }
+        cson_free_ex(obj, test_record_model);
+    }
+
+    /* 超出2^53及非整数仍按原规则输出 */
+    item = cJSON_CreateNumber(1e20);
+    json = cJSON_PrintUnformatted(item);
+    TEST_CHECK(json && strcmp(json, "1e+20") == 0);
+    cJSON_free(json);
+    cJSON_Delete(item);
+    item = cJSON_CreateNumber(0.5);
+    json = cJSON_PrintUnformatted(item);
+    TEST_CHECK(json && strcmp(json, "0.5") == 0);
+    cJSON_free(json);
+    cJSON_Delete(item);
+
+    return TEST_RESULT();
+}
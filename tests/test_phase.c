@@ -0,0 +1,137 @@
+/**
+ * @file test_phase.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 分阶段耗时：每个阶段的样本数、采样间隔、直方图合并及多线程汇总
+ */
+
+#include "test.h"
+#include "cson_phase.h"
+#include "pthread.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 解析、编码并释放测试记录
+ *
+ * @param times 次数
+ */
+static void _test_round(int times)
+{
+    for (int i = 0; i < times; i++)
+    {
+        test_record_t *obj = cson_decode_ex(test_record_json, test_record_model);
+        char *json = cson_encode_unformatted(obj, test_record_model, 22);
+        cson_free_json(json);
+        cson_free(obj, test_record_model, 22);
+    }
+}
+
+/**
+ * @brief 获取阶段样本数
+ *
+ * @param phase 阶段
+ * @param scope 统计范围
+ * @return unsigned long long 样本数
+ */
+static unsigned long long _test_count(cson_phase_t phase, cson_stats_scope_t scope)
+{
+    cson_phase_hist_t hist;
+    cson_phase_snapshot(phase, scope, &hist);
+    return hist.count;
+}
+
+/**
+ * @brief 检查直方图自洽：桶计数之和等于样本数，百分位单调且不超过最大值
+ *
+ * @param hist 直方图
+ */
+static void _test_hist(const cson_phase_hist_t *hist)
+{
+    unsigned long long total = 0;
+
+    for (int i = 0; i < CSON_PHASE_BUCKETS; i++)
+    {
+        total += hist->buckets[i];
+    }
+    TEST_CHECK(total == hist->count);
+    TEST_CHECK(hist->min <= hist->max && hist->sum >= hist->max);
+    TEST_CHECK(hist->sum >= hist->min * hist->count && hist->sum <= hist->max * hist->count);
+    TEST_CHECK(cson_phase_percentile(hist, 0.5) <= cson_phase_percentile(hist, 0.99));
+    TEST_CHECK(cson_phase_percentile(hist, 0.99) <= hist->max);
+    TEST_CHECK(cson_phase_percentile(hist, 1) == hist->max);
+}
+
+/**
+ * @brief 在另一线程中处理
+ *
+ * @param arg 次数
+ * @return void* NULL
+ */
+static void *_test_thread(void *arg)
+{
+    _test_round(*(int *)arg);
+    return NULL;
+}
+
+int main(void)
+{
+    cson_phase_hist_t hist, merged;
+    pthread_t thread;
+    int times = 5;
+
+    cson_init((void *)malloc, (void *)free);
+    cson_phase_reset(CSON_STATS_GLOBAL);
+
+    /* 每次解析各记录一次PARSE、BIND，编码各记录一次BUILD、PRINT，两者均释放cJSON树 */
+    _test_round(10);
+    TEST_CHECK(_test_count(CSON_PHASE_PARSE, CSON_STATS_THREAD) == 10);
+    TEST_CHECK(_test_count(CSON_PHASE_BIND, CSON_STATS_THREAD) == 10);
+    TEST_CHECK(_test_count(CSON_PHASE_BUILD, CSON_STATS_THREAD) == 10);
+    TEST_CHECK(_test_count(CSON_PHASE_PRINT, CSON_STATS_THREAD) == 10);
+    TEST_CHECK(_test_count(CSON_PHASE_DELETE, CSON_STATS_THREAD) == 20);
+    TEST_CHECK(_test_count(CSON_PHASE_FREE, CSON_STATS_THREAD) == 10);
+    for (int i = 0; i < CSON_PHASE_MAX; i++)
+    {
+        TEST_CHECK(cson_phase_snapshot((cson_phase_t)i, CSON_STATS_THREAD, &hist) == 0);
+        _test_hist(&hist);
+        TEST_CHECK(cson_phase_name((cson_phase_t)i) != NULL);
+    }
+
+    /* 合并两份直方图 */
+    cson_phase_snapshot(CSON_PHASE_PARSE, CSON_STATS_THREAD, &hist);
+    memset(&merged, 0, sizeof(merged));
+    cson_phase_merge(&merged, &hist);
+    TEST_CHECK(memcmp(&merged, &hist, sizeof(hist)) == 0);
+    cson_phase_merge(&merged, &hist);
+    TEST_CHECK(merged.count == 2 * hist.count && merged.sum == 2 * hist.sum);
+    TEST_CHECK(merged.min == hist.min && merged.max == hist.max);
+    _test_hist(&merged);
+
+    /* 每4次记录一次，各阶段独立计数 */
+    cson_phase_reset(CSON_STATS_THREAD);
+    TEST_CHECK(_test_count(CSON_PHASE_PARSE, CSON_STATS_THREAD) == 0);
+    cson_phase_sample(4);
+    _test_round(8);
+    TEST_CHECK(_test_count(CSON_PHASE_PARSE, CSON_STATS_THREAD) == 2);
+    TEST_CHECK(_test_count(CSON_PHASE_DELETE, CSON_STATS_THREAD) == 4);
+    TEST_CHECK(_test_count(CSON_PHASE_FREE, CSON_STATS_THREAD) == 2);
+    cson_phase_sample(0);
+
+    /* 全局统计汇总其他线程，线程结束后仍计入 */
+    cson_phase_reset(CSON_STATS_GLOBAL);
+    _test_round(3);
+    TEST_CHECK(pthread_create(&thread, NULL, _test_thread, &times) == 0);
+    pthread_join(thread, NULL);
+    TEST_CHECK(_test_count(CSON_PHASE_PARSE, CSON_STATS_THREAD) == 3);
+    TEST_CHECK(_test_count(CSON_PHASE_PARSE, CSON_STATS_GLOBAL) == 8);
+    cson_phase_snapshot(CSON_PHASE_DELETE, CSON_STATS_GLOBAL, &hist);
+    TEST_CHECK(hist.count == 16);
+    _test_hist(&hist);
+
+    return TEST_RESULT();
+}
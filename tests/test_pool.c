@@ -0,0 +1,143 @@
+/**
+ * @file test_pool.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 对象池分级、预分配与复用
+ */
+
+#include "test.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 只以内嵌方式出现的结构体，成员中有单独分配的结构体
+ *
+ */
+typedef struct
+{
+    int a;
+    test_point_t *p;
+} test_inner_t;
+
+typedef struct
+{
+    test_inner_t in;
+    test_inner_t ins[2];
+    int ins_count;
+} test_outer_t;
+
+static cson_model_t test_inner_model[] = {
+    CSON_MODEL_OBJ(test_inner_t),
+    CSON_MODEL_INT(test_inner_t, a),
+    CSON_MODEL_STRUCT(test_inner_t, p, test_point_model, 4),
+};
+
+static cson_model_t test_outer_model[] = {
+    CSON_MODEL_OBJ(test_outer_t),
+    CSON_MODEL_EMBED(test_outer_t, in, test_inner_model),
+    CSON_MODEL_EMBED_ARRAY_COUNT(test_outer_t, ins, test_inner_model, 2, ins_count),
+};
+
+/**
+ * @brief 未释放的内存块数
+ *
+ */
+static long test_live;
+
+/**
+ * @brief 分配次数
+ *
+ */
+static long test_allocs;
+
+static void *_test_malloc(size_t size)
+{
+    void *ptr = malloc(size);
+    test_live += ptr ? 1 : 0;
+    test_allocs++;
+    return ptr;
+}
+
+static void _test_free(void *ptr)
+{
+    test_live -= ptr ? 1 : 0;
+    free(ptr);
+}
+
+/**
+ * @brief 使用对象池解析并归还一次测试记录
+ *
+ * @param pool 对象池
+ * @param expect 期望的编码结果
+ * @return long 解析过程中的分配次数
+ */
+static long _test_cycle(cson_pool_t *pool, const char *expect)
+{
+    test_record_t *obj;
+    long allocs = test_allocs;
+
+    obj = cson_pool_decode(pool, test_record_json);
+    allocs = test_allocs - allocs;
+    TEST_CHECK(test_record_same(expect, obj));
+    cson_pool_release(obj);
+    return allocs;
+}
+
+int main(void)
+{
+    const char *outer_json = "{\"in\":{\"a\":1,\"p\":{\"x\":2}},\"ins\":[{\"a\":3,\"p\":{\"x\":4}},{\"a\":5}]}";
+    test_outer_t *outer;
+    cson_pool_t *pool;
+    long start, live;
+
+    cson_init((void *)_test_malloc, (void *)_test_free);
+    start = test_live;
+
+    /* 内嵌结构体不单独分配，只为顶层模型及其中的结构体指针建立分级，预分配时各分配一个chunk */
+    pool = cson_pool_create_ex(test_outer_model);
+    TEST_CHECK(pool != NULL);
+    live = test_live;
+    TEST_CHECK(cson_pool_prewarm(pool, 1) == 0);
+    TEST_CHECK(test_live - live == 2);
+    outer = cson_pool_decode(pool, outer_json);
+    TEST_CHECK(outer && outer->in.a == 1 && outer->in.p && outer->in.p->x == 2);
+    TEST_CHECK(outer && outer->ins_count == 2 && outer->ins[0].p && outer->ins[0].p->x == 4 && !outer->ins[1].p);
+    cson_pool_release(outer);
+    cson_pool_destroy(pool);
+    TEST_CHECK(test_live == start);
+
+    /* 首次解析时对象池扩容，此后复用归还的对象，分配次数不再变化；预分配后首次解析即不再扩容 */
+    {
+        test_record_t *obj = cson_decode_ex(test_record_json, test_record_model);
+        char *expect = cson_encode_unformatted_ex(obj, test_record_model);
+        long first, steady;
+
+        cson_free_ex(obj, test_record_model);
+        pool = cson_pool_create_ex(test_record_model);
+        first = _test_cycle(pool, expect);
+        steady = _test_cycle(pool, expect);
+        TEST_CHECK(first > steady);
+        live = test_live;
+        for (int i = 0; i < 8; i++)
+        {
+            TEST_CHECK(_test_cycle(pool, expect) == steady);
+        }
+        TEST_CHECK(test_live == live);
+        cson_pool_destroy(pool);
+
+        pool = cson_pool_create_ex(test_record_model);
+        TEST_CHECK(cson_pool_prewarm(pool, CSON_POOL_CHUNK_BLOCKS + 1) == 0);
+        live = test_live;
+        TEST_CHECK(_test_cycle(pool, expect) == steady);
+        TEST_CHECK(test_live == live);
+        cson_pool_destroy(pool);
+        cson_free_json(expect);
+        TEST_CHECK(test_live == start);
+    }
+
+    return TEST_RESULT();
+}
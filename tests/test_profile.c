@@ -0,0 +1,128 @@
+/**
+ * @file test_profile.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 字段级统计：处理次数、缺失次数、分配计数、排序及JSON输出
+ */
+
+#include "test.h"
+#include "cJSON.h"
+#include "cson_profile.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 按键值查找测试点模型的字段统计
+ *
+ * @param entries 字段统计
+ * @param count 数量
+ * @param key 键值
+ * @return const cson_profile_entry_t* 字段统计，未找到返回NULL
+ */
+static const cson_profile_entry_t *_test_find(const cson_profile_entry_t *entries, int count, const char *key)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (entries[i].model == test_point_model && strcmp(entries[i].key, key) == 0)
+        {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 解析并编码测试点
+ *
+ * @param decodes 解析次数
+ * @param encodes 每次解析后的编码次数
+ */
+static void _test_run(int decodes, int encodes)
+{
+    for (int i = 0; i < decodes; i++)
+    {
+        test_point_t *point = cson_decode_ex("{\"x\":1,\"tag\":\"abc\"}", test_point_model);
+        for (int j = 0; j < encodes; j++)
+        {
+            cson_free_json(cson_encode_unformatted(point, test_point_model, 4));
+        }
+        cson_free(point, test_point_model, 4);
+    }
+}
+
+int main(void)
+{
+    cson_profile_entry_t entries[8];
+    const cson_profile_entry_t *x, *tag, *w;
+    cJSON *root, *fields, *item;
+    char *dump;
+    int count;
+
+    cson_init((void *)malloc, (void *)free);
+    TEST_CHECK(cson_profile_name(test_point_model, "point") == 0);
+    cson_profile_reset();
+
+    _test_run(4, 2);
+    count = cson_profile_report(entries, 8, CSON_PROFILE_SORT_TIME);
+    TEST_CHECK(count == 3);
+    x = _test_find(entries, count, "x");
+    tag = _test_find(entries, count, "tag");
+    w = _test_find(entries, count, "w");
+    TEST_CHECK(x && tag && w);
+    if (x && tag && w)
+    {
+        TEST_CHECK(x->name && strcmp(x->name, "point") == 0);
+        TEST_CHECK(x->decode.count == 4 && tag->decode.count == 4 && w->decode.count == 4);
+        TEST_CHECK(x->encode.count == 8 && tag->encode.count == 8 && w->encode.count == 8);
+
+        /* 缺失的键值计入miss，不分配内存 */
+        TEST_CHECK(x->decode.miss == 0 && tag->decode.miss == 0 && w->decode.miss == 4);
+        TEST_CHECK(cson_profile_miss_rate(w) == 1.0 && cson_profile_miss_rate(x) == 0.0);
+        TEST_CHECK(x->decode.alloc_count == 0 && w->decode.alloc_count == 0);
+        TEST_CHECK(tag->decode.alloc_count == 4 && tag->decode.alloc_bytes == 4 * sizeof("abc"));
+        TEST_CHECK(x->encode.alloc_count >= 8 && tag->encode.alloc_count >= 8);
+    }
+
+    /* 各排序方式降序，超出max时截断 */
+    count = cson_profile_report(entries, 8, CSON_PROFILE_SORT_MISS_RATE);
+    TEST_CHECK(count == 3 && strcmp(entries[0].key, "w") == 0);
+    count = cson_profile_report(entries, 8, CSON_PROFILE_SORT_BYTES);
+    TEST_CHECK(count == 3 && strcmp(entries[0].key, "tag") == 0);
+    for (int i = 1; i < count; i++)
+    {
+        TEST_CHECK(entries[i - 1].decode.alloc_bytes + entries[i - 1].encode.alloc_bytes >=
+                   entries[i].decode.alloc_bytes + entries[i].encode.alloc_bytes);
+    }
+    count = cson_profile_report(entries, 8, CSON_PROFILE_SORT_COUNT);
+    TEST_CHECK(count == 3 && strcmp(entries[0].key, "tag") == 0 && strcmp(entries[1].key, "w") == 0 &&
+               strcmp(entries[2].key, "x") == 0);
+    TEST_CHECK(cson_profile_report(entries, 1, CSON_PROFILE_SORT_COUNT) == 1 && strcmp(entries[0].key, "tag") == 0);
+
+    /* JSON输出与报告一致 */
+    dump = cson_profile_dump(CSON_PROFILE_SORT_MISS_RATE);
+    root = dump ? cJSON_Parse(dump) : NULL;
+    fields = cJSON_GetObjectItem(root, "fields");
+    TEST_CHECK(cJSON_GetArraySize(fields) == 3);
+    item = cJSON_GetArrayItem(fields, 0);
+    TEST_CHECK(strcmp(cJSON_GetStringValue(cJSON_GetObjectItem(item, "model")), "point") == 0);
+    TEST_CHECK(strcmp(cJSON_GetStringValue(cJSON_GetObjectItem(item, "key")), "w") == 0);
+    item = cJSON_GetObjectItem(item, "decode");
+    TEST_CHECK(cJSON_GetNumberValue(cJSON_GetObjectItem(item, "miss")) == 4);
+    TEST_CHECK(cJSON_GetNumberValue(cJSON_GetObjectItem(item, "miss_rate")) == 1);
+    cJSON_Delete(root);
+    cson_free_json(dump);
+
+    /* 清零后没有字段统计，命名保留 */
+    cson_profile_reset();
+    TEST_CHECK(cson_profile_report(entries, 8, CSON_PROFILE_SORT_TIME) == 0);
+    _test_run(1, 0);
+    count = cson_profile_report(entries, 8, CSON_PROFILE_SORT_TIME);
+    TEST_CHECK(count == 3 && entries[0].name && strcmp(entries[0].name, "point") == 0);
+    TEST_CHECK(entries[0].encode.count == 0 && entries[0].decode.count == 1);
+
+    return TEST_RESULT();
+}
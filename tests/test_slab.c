@@ -0,0 +1,120 @@
+/**
+ * @file test_slab.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief slab分配器跨线程释放及线程退出后的回收
+ */
+
+#include "test.h"
+#include "cson_slab.h"
+#include "cJSON.h"
+#include "pthread.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 后端分配器未释放的内存块数
+ *
+ */
+static long test_live;
+
+static void *_test_malloc(size_t size)
+{
+    void *ptr = malloc(size);
+    test_live += ptr ? 1 : 0;
+    return ptr;
+}
+
+static void _test_free(void *ptr)
+{
+    test_live -= ptr ? 1 : 0;
+    free(ptr);
+}
+
+/**
+ * @brief 解析文档后退出，解析结果留给主线程释放
+ *
+ * @param arg 解析结果
+ * @return void* NULL
+ */
+static void *_test_thread(void *arg)
+{
+    cJSON *garbage = cJSON_Parse("[1,2,3,\"short\"]");
+
+    *(cJSON **)arg = cJSON_Parse("{\"a\":[1,2,3],\"b\":\"text\",\"c\":{\"d\":null}}");
+    cJSON_Delete(garbage);
+    cson_slab_thread_exit();
+    return NULL;
+}
+
+int main(void)
+{
+    cJSON *json = NULL, *item;
+    pthread_t thread;
+
+    cson_slab_init((void *)_test_malloc, (void *)_test_free);
+    cson_init((void *)cson_slab_malloc, (void *)cson_slab_free);
+
+    /* 线程退出时仍有块在使用，池转为孤立池，主线程释放后由trim回收 */
+    TEST_CHECK(pthread_create(&thread, NULL, _test_thread, &json) == 0);
+    pthread_join(thread, NULL);
+    TEST_CHECK(json != NULL);
+    TEST_CHECK(test_live > 0);
+    item = cJSON_GetObjectItem(json, "b");
+    TEST_CHECK(item && strcmp(item->valuestring, "text") == 0);
+    cJSON_Delete(json);
+    TEST_CHECK(cson_slab_trim() >= CSON_SLAB_CHUNK_SIZE);
+    TEST_CHECK(test_live == 0);
+
+    /* 统计：节点与短字符串走slab，长字符串回落到后端分配器；全部释放后trim归还chunk */
+    {
+        char text[CSON_SLAB_STRING_MAX * 2];
+        cson_slab_stats_t stats;
+        size_t blocks;
+        cJSON *list;
+
+        memset(text, 'x', sizeof(text) - 1);
+        text[sizeof(text) - 1] = 0;
+        cson_slab_stats(&stats);
+        TEST_CHECK(stats.alloc_count == 0 && stats.chunk_count == 0);
+        list = cJSON_CreateArray();
+        for (int i = 0; i < 100; i++)
+        {
+            cJSON_AddItemToArray(list, cJSON_CreateString("short"));
+        }
+        cJSON_AddItemToArray(list, cJSON_CreateString(text));
+        cson_slab_stats(&stats);
+        TEST_CHECK(stats.alloc_count == 1 + 101 * 2 && stats.large_count == 1);
+        TEST_CHECK(stats.class_used[0] == 102 && stats.class_used[1] == 100);
+        TEST_CHECK(stats.chunk_count >= 2 && stats.chunk_bytes == stats.chunk_count * CSON_SLAB_CHUNK_SIZE);
+        blocks = stats.class_blocks[0];
+        TEST_CHECK(cson_slab_trim() == 0);
+
+        /* 释放后块留在chunk中复用，不再切分新块 */
+        cJSON_Delete(cJSON_DetachItemFromArray(list, 0));
+        cJSON_AddItemToArray(list, cJSON_CreateString("again"));
+        cson_slab_stats(&stats);
+        TEST_CHECK(stats.class_blocks[0] == blocks && stats.class_used[0] == 102);
+
+        cJSON_Delete(list);
+        cson_slab_stats(&stats);
+        TEST_CHECK(stats.free_count == stats.alloc_count && stats.class_used[0] == 0 && stats.class_used[1] == 0);
+        TEST_CHECK(cson_slab_trim() == 2 * CSON_SLAB_CHUNK_SIZE);
+        cson_slab_stats(&stats);
+        TEST_CHECK(stats.chunk_count == 0 && stats.chunk_bytes == 0 && stats.class_blocks[0] == 0);
+        TEST_CHECK(test_live == 1);
+    }
+
+    /* 线程退出时已无块在使用，池直接释放 */
+    json = cJSON_Parse("[true]");
+    TEST_CHECK(test_live > 0);
+    cJSON_Delete(json);
+    TEST_CHECK(cson_slab_thread_exit() >= CSON_SLAB_CHUNK_SIZE);
+    TEST_CHECK(test_live == 0);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,78 @@
+/**
+ * @file test_snapshot.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 快照编解码与JSON路径的一致性
+ */
+
+#include "test.h"
+#include "cson_snapshot.h"
+#include "stdlib.h"
+#include "string.h"
+#include "unistd.h"
+
+int main(void)
+{
+    const char *path = "test_snapshot.snap";
+    test_record_t *obj, *copy;
+    unsigned char *data;
+    char *expect;
+    size_t len;
+    FILE *out;
+    int saved;
+
+    cson_init((void *)malloc, (void *)free);
+
+    obj = cson_decode_ex(test_record_json, test_record_model);
+    TEST_CHECK(obj != NULL);
+    expect = cson_encode_unformatted_ex(obj, test_record_model);
+    TEST_CHECK(expect != NULL);
+
+    data = cson_snapshot_encode(obj, test_record_model, 22, &len);
+    TEST_CHECK(data != NULL && len > CSON_SNAPSHOT_HEAD_SIZE);
+    copy = cson_snapshot_decode(data, len, test_record_model, 22);
+    TEST_CHECK(test_record_same(expect, copy));
+    TEST_CHECK(copy && copy->l == -5000000000L && copy->route_count == 2);
+    cson_free_ex(copy, test_record_model);
+
+    /* 截断的数据一律解码失败 */
+    for (size_t i = 0; data && i < len; i++)
+    {
+        copy = cson_snapshot_decode(data, i, test_record_model, 22);
+        TEST_CHECK(copy == NULL);
+        cson_free_ex(copy, test_record_model);
+    }
+
+    /* 模型不同时指纹不同，快照被拒绝，不输出断言信息 */
+    TEST_CHECK(cson_snapshot_fingerprint(test_record_model, 22) != cson_snapshot_fingerprint(test_point_model, 4));
+    out = tmpfile();
+    TEST_CHECK(out != NULL);
+    if (out)
+    {
+        fflush(stdout);
+        saved = dup(fileno(stdout));
+        dup2(fileno(out), fileno(stdout));
+        copy = cson_snapshot_decode(data, len, test_point_model, 4);
+        fflush(stdout);
+        dup2(saved, fileno(stdout));
+        close(saved);
+        fseek(out, 0, SEEK_END);
+        TEST_CHECK(copy == NULL && ftell(out) == 0);
+        fclose(out);
+    }
+    cson_snapshot_free(data);
+
+    TEST_CHECK(cson_snapshot_write_ex(path, obj, test_record_model) == 0);
+    copy = cson_snapshot_read_ex(path, test_record_model);
+    TEST_CHECK(test_record_same(expect, copy));
+    cson_free_ex(copy, test_record_model);
+    remove(path);
+
+    cson_free_json(expect);
+    cson_free_ex(obj, test_record_model);
+    return TEST_RESULT();
+}
@@ -0,0 +1,88 @@
+/**
+ * @file test_stats.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief 内存统计：解析、编码后释放计数平衡，已注册的模型单独计数
+ */
+
+#include "test.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 检查计数平衡：分配全部释放，峰值不小于给定值
+ *
+ * @param stats 内存统计
+ * @param peak 峰值下界
+ */
+static void _test_balanced(const cson_stats_t *stats, size_t peak)
+{
+    TEST_CHECK(stats->alloc_count > 0 && stats->alloc_count == stats->free_count);
+    TEST_CHECK(stats->alloc_bytes > 0 && stats->alloc_bytes == stats->free_bytes);
+    TEST_CHECK(stats->live_bytes == 0);
+    TEST_CHECK(stats->peak_bytes >= peak && stats->peak_bytes <= stats->alloc_bytes);
+}
+
+int main(void)
+{
+    cson_stats_t stats, model_stats, point_stats;
+    test_record_t *obj;
+    test_point_t *point;
+    size_t live;
+    char *json;
+
+    cson_init((void *)malloc, (void *)free);
+
+    TEST_CHECK(cson_stats_model_get(test_record_model, &model_stats) == -1);
+    TEST_CHECK(cson_stats_track(test_record_model) == 0);
+    TEST_CHECK(cson_stats_track(test_record_model) == 0);
+    cson_stats_reset(CSON_STATS_GLOBAL);
+
+    /* 解析后对象占用的内存在释放前保持为live */
+    obj = cson_decode_ex(test_record_json, test_record_model);
+    TEST_CHECK(obj != NULL);
+    TEST_CHECK(cson_stats_get(&stats, CSON_STATS_THREAD) == 0);
+    TEST_CHECK(stats.alloc_count > stats.free_count && stats.live_bytes > 0);
+    TEST_CHECK((size_t)stats.live_bytes == stats.alloc_bytes - stats.free_bytes);
+    TEST_CHECK(stats.peak_bytes > (size_t)stats.live_bytes);
+    live = (size_t)stats.live_bytes;
+    TEST_CHECK(cson_stats_model_get(test_record_model, &model_stats) == 0);
+    TEST_CHECK(model_stats.alloc_count == stats.alloc_count && model_stats.live_bytes == stats.live_bytes);
+
+    json = cson_encode_unformatted(obj, test_record_model, 22);
+    TEST_CHECK(json != NULL);
+    cson_free_json(json);
+    cson_free(obj, test_record_model, 22);
+
+    cson_stats_get(&stats, CSON_STATS_THREAD);
+    _test_balanced(&stats, live);
+    cson_stats_model_get(test_record_model, &model_stats);
+    _test_balanced(&model_stats, live);
+    TEST_CHECK(model_stats.alloc_count == stats.alloc_count);
+
+    /* 未注册的模型只计入线程统计 */
+    point = cson_decode_ex("{\"x\":1,\"tag\":\"t\"}", test_point_model);
+    TEST_CHECK(point != NULL);
+    cson_free(point, test_point_model, 4);
+    TEST_CHECK(cson_stats_model_get(test_point_model, &point_stats) == -1);
+    cson_stats_get(&stats, CSON_STATS_THREAD);
+    _test_balanced(&stats, live);
+    cson_stats_model_get(test_record_model, &point_stats);
+    TEST_CHECK(point_stats.alloc_count == model_stats.alloc_count && stats.alloc_count > model_stats.alloc_count);
+
+    /* 全局统计不小于当前线程，清零后重新计数 */
+    TEST_CHECK(cson_stats_get(&point_stats, CSON_STATS_GLOBAL) == 0);
+    TEST_CHECK(point_stats.alloc_count >= stats.alloc_count);
+    cson_stats_reset(CSON_STATS_THREAD);
+    cson_stats_get(&stats, CSON_STATS_THREAD);
+    TEST_CHECK(stats.alloc_count == 0 && stats.alloc_bytes == 0 && stats.peak_bytes == 0 && stats.live_bytes == 0);
+    cson_stats_reset(CSON_STATS_GLOBAL);
+    cson_stats_model_get(test_record_model, &model_stats);
+    TEST_CHECK(model_stats.alloc_count == 0 && model_stats.alloc_bytes == 0);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,181 @@
+/**
+ * @file test_vector.c
+ * @author Aki
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2026 Aki
+ *
+ * @brief vector容量：按数组长度一次分配，追加时按倍数扩容，释放后置空
+ */
+
+#include "test.h"
+#include "cson_decoder.h"
+#include "stdlib.h"
+#include "string.h"
+
+/**
+ * @brief 基础类型及结构体元素的vector
+ *
+ */
+typedef struct
+{
+    cson_vector_t nums;
+    cson_vector_t vals;
+    cson_vector_t tags;
+    cson_vector_t pts;
+} test_shape_t;
+
+static cson_model_t test_shape_model[] = {
+    CSON_MODEL_OBJ(test_shape_t),
+    CSON_MODEL_VECTOR(test_shape_t, nums, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_VECTOR(test_shape_t, vals, CSON_MODEL_DOUBLE_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_VECTOR(test_shape_t, tags, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_VECTOR(test_shape_t, pts, test_point_model, 4),
+};
+
+static const char *test_shape_json =
+    "{\"nums\":[1,-2,3,2147483647,5],\"vals\":[0.1,1e300,-2.5],\"tags\":[\"a\",\"bc\"],"
+    "\"pts\":[{\"x\":1,\"tag\":\"p\",\"w\":0.5},{\"x\":2,\"w\":0},{\"x\":3,\"tag\":\"q\",\"w\":1},"
+    "{\"x\":4,\"w\":0},{\"x\":5,\"w\":0}]}";
+
+/**
+ * @brief 检查解析结果的元素
+ *
+ * @param shape 对象
+ */
+static void _test_elements(test_shape_t *shape)
+{
+    const int nums[] = {1, -2, 3, 2147483647, 5};
+    const double vals[] = {0.1, 1e300, -2.5};
+
+    TEST_CHECK(shape->nums.count == 5 && shape->vals.count == 3 && shape->tags.count == 2 && shape->pts.count == 5);
+    for (size_t i = 0; i < shape->nums.count && i < 5; i++)
+    {
+        TEST_CHECK(((int *)shape->nums.data)[i] == nums[i]);
+    }
+    for (size_t i = 0; i < shape->vals.count && i < 3; i++)
+    {
+        TEST_CHECK(((double *)shape->vals.data)[i] == vals[i]);
+    }
+    TEST_CHECK(shape->tags.count == 2 && strcmp(((char **)shape->tags.data)[1], "bc") == 0);
+    for (size_t i = 0; i < shape->pts.count; i++)
+    {
+        TEST_CHECK(((test_point_t *)shape->pts.data)[i].x == (int)i + 1);
+    }
+}
+
+/**
+ * @brief 容量为不小于数量的最小倍数扩容结果
+ *
+ * @param vec vector
+ * @return int 是否符合
+ */
+static int _test_doubled(const cson_vector_t *vec)
+{
+    size_t cap = 4;
+
+    while (cap < vec->count)
+    {
+        cap *= 2;
+    }
+    return vec->cap == cap;
+}
+
+/**
+ * @brief 追加与预留
+ *
+ */
+static void _test_push(void)
+{
+    cson_vector_t vec = {0};
+    test_point_t *pt;
+    void *data;
+
+    for (int i = 0; i < 9; i++)
+    {
+        pt = cson_vector_push(&vec, test_point_model, 4);
+        TEST_CHECK(pt && pt->x == 0 && pt->tag == NULL && pt->w == 0);
+        if (pt)
+        {
+            pt->x = i;
+            pt->tag = cson_new_string("t");
+        }
+        TEST_CHECK(vec.count == (size_t)i + 1 && _test_doubled(&vec));
+    }
+    TEST_CHECK(vec.cap == 16);
+
+    data = vec.data;
+    TEST_CHECK(cson_vector_reserve(&vec, test_point_model, 4, 10) == 0);
+    TEST_CHECK(vec.data == data && vec.cap == 16);
+    TEST_CHECK(cson_vector_reserve(&vec, test_point_model, 4, 40) == 0);
+    TEST_CHECK(vec.cap == 40 && vec.count == 9);
+    for (size_t i = 0; i < vec.count; i++)
+    {
+        TEST_CHECK(((test_point_t *)vec.data)[i].x == (int)i && strcmp(((test_point_t *)vec.data)[i].tag, "t") == 0);
+    }
+    pt = (test_point_t *)vec.data + vec.count;
+    TEST_CHECK(pt->x == 0 && pt->tag == NULL);
+
+    cson_vector_free(&vec, test_point_model, 4);
+    TEST_CHECK(vec.data == NULL && vec.count == 0 && vec.cap == 0);
+    TEST_CHECK(cson_vector_push(&vec, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE) != NULL);
+    TEST_CHECK(vec.count == 1 && vec.cap == 4);
+    cson_vector_free(&vec, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE);
+}
+
+int main(void)
+{
+    cson_decoder_t *dec;
+    test_shape_t *shape;
+    char *json;
+
+    cson_init((void *)malloc, (void *)free);
+
+    /* 整体解析时容量等于数组长度 */
+    shape = cson_decode_ex(test_shape_json, test_shape_model);
+    TEST_CHECK(shape != NULL);
+    if (shape)
+    {
+        _test_elements(shape);
+        TEST_CHECK(shape->nums.cap == 5 && shape->vals.cap == 3 && shape->tags.cap == 2 && shape->pts.cap == 5);
+        json = cson_encode_unformatted(shape, test_shape_model, 5);
+        TEST_CHECK(json != NULL);
+        cson_free(shape, test_shape_model, 5);
+        shape = cson_decode_ex(json, test_shape_model);
+        TEST_CHECK(shape != NULL);
+        if (shape)
+        {
+            _test_elements(shape);
+        }
+        cson_free(shape, test_shape_model, 5);
+        cson_free_json(json);
+    }
+
+    /* 分段解析无法预知长度，按倍数扩容 */
+    dec = cson_decoder_create_ex(test_shape_model);
+    TEST_CHECK(cson_decoder_feed(dec, test_shape_json, strlen(test_shape_json)) == CSON_DECODER_DONE);
+    shape = cson_decoder_result(dec);
+    TEST_CHECK(shape != NULL);
+    if (shape)
+    {
+        _test_elements(shape);
+        TEST_CHECK(_test_doubled(&shape->nums) && _test_doubled(&shape->pts) && _test_doubled(&shape->tags));
+    }
+    cson_free(shape, test_shape_model, 5);
+    cson_decoder_destroy(dec);
+
+    /* 空数组、缺失及非数组均为空vector */
+    shape = cson_decode_ex("{\"nums\":[],\"vals\":{},\"tags\":\"a\"}", test_shape_model);
+    TEST_CHECK(shape != NULL);
+    if (shape)
+    {
+        TEST_CHECK(!shape->nums.data && !shape->nums.count && !shape->nums.cap);
+        TEST_CHECK(!shape->vals.data && !shape->tags.data && !shape->pts.data);
+    }
+    cson_free(shape, test_shape_model, 5);
+
+    _test_push();
+
+    return TEST_RESULT();
+}
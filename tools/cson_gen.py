@@ -0,0 +1,2085 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file cson_gen.py
+@author Aki
+@version 1.0.0
+@date 2026-10-18
+
+@copyright (c) 2026 Aki
+
+cson模型代码生成器
+
+读取C源文件中的`cson_model_t`定义，为每个模型生成专用的解析/编码函数:
+字段处理展开为直线代码，键值查找使用生成时计算的完美哈希，编码时键值以转义后的
+字面量直接写入，解析/编码均不再构建cJSON对象。生成的函数输出与`cson_decode`/`cson_encode_unformatted`一致
+
+用法:
+    python3 tools/cson_gen.py -o user_gen --include user.h user.c
+
+生成`user_gen.h`及`user_gen.c`，每个模型`xxx_model`对应:
+    type_t *cson_gen_xxx_model_decode(const char *json_str);
+    char *cson_gen_xxx_model_encode(const type_t *obj);
+    void cson_gen_xxx_model_free(type_t *obj);
+解析不经过cJSON树，直接从json字符串读取到对象，语法校验与cJSON一致；
+解析结果亦可使用`cson_free`释放，编码结果使用`cson_free_json`释放
+"""
+
+import argparse
+import os
+import re
+import sys
+
+BASIC_LISTS = {
+    'CSON_MODEL_CHAR_LIST': 'CSON_TYPE_CHAR',
+    'CSON_MODEL_SHORT_LIST': 'CSON_TYPE_SHORT',
+    'CSON_MODEL_INT_LIST': 'CSON_TYPE_INT',
+    'CSON_MODEL_LONG_LIST': 'CSON_TYPE_LONG',
+    'CSON_MODEL_FLOAT_LIST': 'CSON_TYPE_FLOAT',
+    'CSON_MODEL_DOUBLE_LIST': 'CSON_TYPE_DOUBLE',
+    'CSON_MODEL_STRING_LIST': 'CSON_TYPE_STRING',
+}
+
+SCALAR_MACROS = {
+    'CHAR': 'CSON_TYPE_CHAR',
+    'SHORT': 'CSON_TYPE_SHORT',
+    'INT': 'CSON_TYPE_INT',
+    'LONG': 'CSON_TYPE_LONG',
+    'FLOAT': 'CSON_TYPE_FLOAT',
+    'DOUBLE': 'CSON_TYPE_DOUBLE',
+    'BOOL': 'CSON_TYPE_CHAR',
+    'STRING': 'CSON_TYPE_STRING',
+    'JSON': 'CSON_TYPE_JSON',
+}
+
+C_TYPES = {
+    'CSON_TYPE_CHAR': 'char',
+    'CSON_TYPE_SHORT': 'short',
+    'CSON_TYPE_INT': 'int',
+    'CSON_TYPE_LONG': 'long',
+    'CSON_TYPE_FLOAT': 'float',
+    'CSON_TYPE_DOUBLE': 'double',
+    'CSON_TYPE_BOOL': 'char',
+    'CSON_TYPE_STRING': 'char *',
+}
+
+UNION_MEMBERS = {
+    'CSON_TYPE_CHAR': 'c',
+    'CSON_TYPE_SHORT': 's',
+    'CSON_TYPE_INT': 'i',
+    'CSON_TYPE_LONG': 'l',
+    'CSON_TYPE_FLOAT': 'f',
+    'CSON_TYPE_DOUBLE': 'd',
+    'CSON_TYPE_STRING': 'str',
+}
+
+
+class GenError(Exception):
+    pass
+
+
+class Field(object):
+    """模型中的一个字段"""
+
+    def __init__(self, kind, key, member):
+        self.kind = kind
+        self.key = key
+        self.member = member
+        self.sub = None
+        self.basic = None
+        self.ele_type = None
+        self.size = None
+        self.policy = 'CSON_CHARS_TRUNCATE'
+        self.count = None
+        self.next = None
+
+
+class Model(object):
+    """一个cson_model_t数组"""
+
+    def __init__(self, name, static=False):
+        self.name = name
+        self.static = static
+        self.type = None
+        self.fields = []
+
+    def ref(self):
+        """生成代码中引用模型数组的表达式，static模型在生成代码中不可见，不单独统计"""
+        return 'NULL' if self.static else self.name
+
+
+def strip_comments(text):
+    """去除注释，保留字符串字面量"""
+    pattern = re.compile(r'//[^\n]*|/\*.*?\*/|"(?:\\.|[^"\\])*"|\'(?:\\.|[^\'\\])*\'', re.S)
+
+    def repl(m):
+        s = m.group(0)
+        return ' ' if s.startswith('/') else s
+    return pattern.sub(repl, text)
+
+
+def split_top(text, sep=','):
+    """按顶层分隔符切分，忽略括号及字符串内部"""
+    parts, depth, cur, i = [], 0, [], 0
+    while i < len(text):
+        c = text[i]
+        if c == '"':
+            j = i + 1
+            while j < len(text) and text[j] != '"':
+                j += 2 if text[j] == '\\' else 1
+            cur.append(text[i:j + 1])
+            i = j + 1
+            continue
+        if c in '([{':
+            depth += 1
+        elif c in ')]}':
+            depth -= 1
+        if c == sep and depth == 0:
+            parts.append(''.join(cur).strip())
+            cur = []
+        else:
+            cur.append(c)
+        i += 1
+    if ''.join(cur).strip():
+        parts.append(''.join(cur).strip())
+    return parts
+
+
+def match_brace(text, start):
+    """返回与text[start]处括号匹配的位置"""
+    depth = 0
+    i = start
+    while i < len(text):
+        c = text[i]
+        if c == '"':
+            i += 1
+            while i < len(text) and text[i] != '"':
+                i += 2 if text[i] == '\\' else 1
+        elif c == '{':
+            depth += 1
+        elif c == '}':
+            depth -= 1
+            if depth == 0:
+                return i
+        i += 1
+    raise GenError('unbalanced braces')
+
+
+def parse_entry(model, entry):
+    """解析模型中的一项"""
+    entry = entry.strip()
+    m = re.match(r'^CSON_MODEL_(\w+)\s*\((.*)\)$', entry, re.S)
+    if m:
+        macro, args = m.group(1), split_top(m.group(2))
+        if macro == 'OBJ':
+            model.type = args[0]
+            return None
+        if macro in SCALAR_MACROS:
+            return Field(SCALAR_MACROS[macro], args[1], args[1])
+        if macro in ('STRUCT', 'LIST', 'VECTOR', 'EMBED'):
+            f = Field('CSON_TYPE_' + macro, args[1], args[1])
+            f.sub = args[2].strip()
+            return f
+        if macro in ('EMBED_ARRAY', 'EMBED_ARRAY_COUNT'):
+            f = Field('CSON_TYPE_EMBED_ARRAY', args[1], args[1])
+            f.sub = args[2].strip()
+            f.size = args[3].strip()
+            if macro == 'EMBED_ARRAY_COUNT':
+                f.count = args[4].strip()
+            return f
+        if macro == 'ILIST':
+            f = Field('CSON_TYPE_ILIST', args[1], args[1])
+            f.sub = args[2].strip()
+            f.next = args[5].strip()
+            return f
+        if macro == 'ARRAY':
+            f = Field('CSON_TYPE_ARRAY', args[1], args[1])
+            f.ele_type = args[2].strip()
+            f.size = args[3].strip()
+            return f
+        if macro in ('CHAR_ARRAY', 'CHAR_ARRAY_POLICY'):
+            f = Field('CSON_TYPE_CHAR_ARRAY', args[1], args[1])
+            f.size = args[2].strip()
+            if macro == 'CHAR_ARRAY_POLICY':
+                f.policy = args[3].strip()
+            return f
+        raise GenError('%s: unsupported macro CSON_MODEL_%s' % (model.name, macro))
+    m = re.match(r'^\{(.*)\}$', entry, re.S)
+    if not m:
+        raise GenError('%s: cannot parse entry %r' % (model.name, entry))
+    items = split_top(m.group(1))
+    kind = items[0].strip()
+    if kind == 'CSON_TYPE_OBJ':
+        for item in items[3:]:
+            d = re.match(r'^\.param\.obj_size\s*=\s*sizeof\s*\((.*)\)$', item.strip(), re.S)
+            if d:
+                model.type = d.group(1).strip()
+        return None
+    key = items[1].strip()
+    if key == 'NULL':
+        raise GenError('%s: field without key' % model.name)
+    key = bytes(key[1:-1], 'utf-8').decode('unicode_escape')
+    off = re.match(r'^offsetof\s*\((.*)\)$', items[2].strip(), re.S)
+    if not off:
+        raise GenError('%s: field "%s" needs offsetof()' % (model.name, key))
+    f = Field(kind, key, split_top(off.group(1))[1].strip())
+    for item in items[3:]:
+        d = re.match(r'^\.param\.(\w+(?:\.\w+)?)\s*=\s*(.*)$', item.strip(), re.S)
+        if not d:
+            continue
+        name, value = d.group(1), d.group(2).strip()
+        if name in ('sub.model', 'embeds.model', 'ilist.model'):
+            f.sub = value
+        elif name == 'array.ele_type':
+            f.ele_type = value
+        elif name in ('array.size', 'chars.size', 'embeds.capacity'):
+            f.size = value
+        elif name == 'embeds.count':
+            cnt = re.match(r'^offsetof\s*\((.*)\)$', value, re.S)
+            if cnt:
+                f.count = split_top(cnt.group(1))[1].strip()
+        elif name == 'ilist.next':
+            nxt = re.match(r'^offsetof\s*\((.*)\)$', value, re.S)
+            if nxt:
+                f.next = split_top(nxt.group(1))[1].strip()
+        elif name == 'chars.policy':
+            f.policy = value
+    return f
+
+
+def parse_models(paths):
+    """解析源文件中的全部模型"""
+    models = []
+    for path in paths:
+        with open(path, encoding='utf-8') as fp:
+            text = strip_comments(fp.read())
+        for m in re.finditer(r'(\bstatic\s+)?cson_model_t\s+(\w+)\s*\[\s*\w*\s*\]\s*=\s*\{', text):
+            end = match_brace(text, m.end() - 1)
+            model = Model(m.group(2), bool(m.group(1)))
+            for entry in split_top(text[m.end():end]):
+                f = parse_entry(model, entry)
+                if f:
+                    model.fields.append(f)
+            if not model.type:
+                raise GenError('%s: missing CSON_MODEL_OBJ' % model.name)
+            models.append(model)
+    names = dict((mdl.name, mdl) for mdl in models)
+    for mdl in models:
+        for f in mdl.fields:
+            if f.kind in ('CSON_TYPE_STRUCT', 'CSON_TYPE_LIST', 'CSON_TYPE_VECTOR', 'CSON_TYPE_EMBED',
+                          'CSON_TYPE_EMBED_ARRAY', 'CSON_TYPE_ILIST'):
+                ref = f.sub.lstrip('&').strip()
+                if f.kind in ('CSON_TYPE_LIST', 'CSON_TYPE_VECTOR') and ref in BASIC_LISTS:
+                    f.basic = BASIC_LISTS[ref]
+                    f.sub = None
+                elif ref in names:
+                    f.sub = names[ref]
+                else:
+                    raise GenError('%s.%s: unknown submodel %s' % (mdl.name, f.key, ref))
+            if f.kind == 'CSON_TYPE_ILIST' and not f.next:
+                raise GenError('%s.%s: intrusive list needs offsetof() for next' % (mdl.name, f.key))
+    return models
+
+
+def key_hash(key, seed):
+    """与生成代码中`_cson_gen_hash`一致的哈希"""
+    h = seed
+    for c in key.encode('utf-8'):
+        if 65 <= c <= 90:
+            c += 32
+        h = ((h ^ c) * 16777619) & 0xffffffff
+    return h
+
+
+def perfect_hash(keys):
+    """搜索使全部键值落在不同槽位的种子"""
+    size = 1
+    while size < len(keys):
+        size *= 2
+    while True:
+        for seed in range(1, 20000):
+            slots = set(key_hash(k, seed) & (size - 1) for k in keys)
+            if len(slots) == len(keys):
+                return seed, size
+        size *= 2
+
+
+def c_string(text):
+    """转换为C字符串字面量"""
+    out = []
+    for b in text.encode('utf-8'):
+        c = chr(b)
+        if c in '"\\':
+            out.append('\\' + c)
+        elif 32 <= b < 127:
+            out.append(c)
+        else:
+            out.append('\\%03o' % b)
+    return '"' + ''.join(out) + '"'
+
+
+def json_key(key):
+    """按cJSON规则转义键值，生成`"key":`字面量"""
+    out = []
+    for b in key.encode('utf-8'):
+        c = chr(b)
+        if c == '"':
+            out.append('\\"')
+        elif c == '\\':
+            out.append('\\\\')
+        elif c in '\b\f\n\r\t':
+            out.append('\\' + {'\b': 'b', '\f': 'f', '\n': 'n', '\r': 'r', '\t': 't'}[c])
+        elif b < 32:
+            out.append('\\u%04x' % b)
+        else:
+            out.append(c)
+    return '"' + ''.join(out) + '":'
+
+
+RUNTIME = r'''
+/**
+ * @brief 编码缓冲
+ *
+ */
+typedef struct
+{
+    char *buf;    /**< 缓冲 */
+    size_t len;   /**< 已写入长度 */
+    size_t cap;   /**< 缓冲容量 */
+    int error;    /**< 是否出错 */
+} cson_gen_buf_t;
+
+/**
+ * @brief 解析读取器
+ *
+ */
+typedef struct
+{
+    const char *p; /**< 当前位置 */
+    int depth;     /**< 嵌套深度 */
+    int error;     /**< 是否出错 */
+} cson_gen_reader_t;
+
+/**
+ * @brief 键值哈希(ASCII大小写不敏感)
+ *
+ * @param key 键值
+ * @param seed 种子
+ * @return unsigned int 哈希值
+ */
+static unsigned int _cson_gen_hash(const char *key, unsigned int seed)
+{
+    unsigned int h = seed;
+    for (; *key; key++)
+    {
+        unsigned char c = (unsigned char)*key;
+        if (c >= 'A' && c <= 'Z')
+        {
+            c += 32;
+        }
+        h = (h ^ c) * 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief 键值比较(大小写不敏感，与cJSON_GetObjectItem一致)
+ *
+ * @param a 键值
+ * @param b 模型键值
+ * @return int 是否相等
+ */
+static int _cson_gen_key_equal(const char *a, const char *b)
+{
+    for (; tolower((unsigned char)*a) == tolower((unsigned char)*b); a++, b++)
+    {
+        if (!*a)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 跳过空白字符，返回当前字符
+ *
+ * @param r 读取器
+ * @return int 当前字符，出错或结束时返回0
+ */
+static int _cson_gen_peek(cson_gen_reader_t *r)
+{
+    while (*r->p && (unsigned char)*r->p <= 32)
+    {
+        r->p++;
+    }
+    return r->error ? 0 : (unsigned char)*r->p;
+}
+
+/**
+ * @brief 是否为数值起始字符
+ *
+ * @param c 字符
+ * @return int 是否为数值
+ */
+static int _cson_gen_is_number(int c)
+{
+    return c == '-' || (c >= '0' && c <= '9');
+}
+
+/**
+ * @brief 解析4位十六进制数，非法字符按cJSON处理为0
+ *
+ * @param s 字符串
+ * @return unsigned int 数值
+ */
+static unsigned int _cson_gen_hex4(const unsigned char *s)
+{
+    unsigned int h = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        h <<= 4;
+        if (s[i] >= '0' && s[i] <= '9')
+        {
+            h += s[i] - '0';
+        }
+        else if (s[i] >= 'A' && s[i] <= 'F')
+        {
+            h += 10 + s[i] - 'A';
+        }
+        else if (s[i] >= 'a' && s[i] <= 'f')
+        {
+            h += 10 + s[i] - 'a';
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    return h;
+}
+
+/**
+ * @brief 解析字符串，转义规则与cJSON一致
+ *
+ * @param r 读取器，当前字符为'"'
+ * @param out 输出缓冲，为NULL时仅校验
+ * @param size 输出缓冲大小，超出部分被截断
+ */
+static void _cson_gen_unescape(cson_gen_reader_t *r, char *out, size_t size)
+{
+    const unsigned char *s = (const unsigned char *)r->p + 1;
+    const unsigned char *end = s;
+    unsigned char utf8[4];
+    size_t n = 0;
+
+    while (*end && *end != '\"')
+    {
+        if (*end == '\\' && !*++end)
+        {
+            break;
+        }
+        end++;
+    }
+    if (*end != '\"')
+    {
+        r->error = 1;
+        return;
+    }
+    while (s < end)
+    {
+        size_t len = 1;
+        size_t step = 2;
+        if (*s != '\\')
+        {
+            utf8[0] = *s;
+            step = 1;
+        }
+        else
+        {
+            switch (s[1])
+            {
+            case 'b':
+                utf8[0] = '\b';
+                break;
+            case 'f':
+                utf8[0] = '\f';
+                break;
+            case 'n':
+                utf8[0] = '\n';
+                break;
+            case 'r':
+                utf8[0] = '\r';
+                break;
+            case 't':
+                utf8[0] = '\t';
+                break;
+            case '\"':
+            case '\\':
+            case '/':
+                utf8[0] = s[1];
+                break;
+            case 'u':
+            {
+                unsigned long code;
+                if (end - s < 6)
+                {
+                    r->error = 1;
+                    return;
+                }
+                code = _cson_gen_hex4(s + 2);
+                step = 6;
+                if (code >= 0xDC00 && code <= 0xDFFF)
+                {
+                    r->error = 1;
+                    return;
+                }
+                if (code >= 0xD800 && code <= 0xDBFF)
+                {
+                    unsigned long low;
+                    if (end - s < 12 || s[6] != '\\' || s[7] != 'u')
+                    {
+                        r->error = 1;
+                        return;
+                    }
+                    low = _cson_gen_hex4(s + 8);
+                    if (low < 0xDC00 || low > 0xDFFF)
+                    {
+                        r->error = 1;
+                        return;
+                    }
+                    code = 0x10000 + (((code & 0x3FF) << 10) | (low & 0x3FF));
+                    step = 12;
+                }
+                if (code < 0x80)
+                {
+                    utf8[0] = (unsigned char)code;
+                }
+                else if (code < 0x800)
+                {
+                    utf8[0] = (unsigned char)(0xC0 | (code >> 6));
+                    utf8[1] = (unsigned char)(0x80 | (code & 0x3F));
+                    len = 2;
+                }
+                else if (code < 0x10000)
+                {
+                    utf8[0] = (unsigned char)(0xE0 | (code >> 12));
+                    utf8[1] = (unsigned char)(0x80 | ((code >> 6) & 0x3F));
+                    utf8[2] = (unsigned char)(0x80 | (code & 0x3F));
+                    len = 3;
+                }
+                else
+                {
+                    utf8[0] = (unsigned char)(0xF0 | (code >> 18));
+                    utf8[1] = (unsigned char)(0x80 | ((code >> 12) & 0x3F));
+                    utf8[2] = (unsigned char)(0x80 | ((code >> 6) & 0x3F));
+                    utf8[3] = (unsigned char)(0x80 | (code & 0x3F));
+                    len = 4;
+                }
+                break;
+            }
+            default:
+                r->error = 1;
+                return;
+            }
+        }
+        for (size_t i = 0; out && i < len && n + 1 < size; i++)
+        {
+            out[n++] = (char)utf8[i];
+        }
+        s += step;
+    }
+    if (out)
+    {
+        out[n] = 0;
+    }
+    r->p = (const char *)end + 1;
+}
+
+/**
+ * @brief 解析数值，规则与cJSON一致
+ *
+ * @param r 读取器
+ * @return double 数值
+ */
+static double _cson_gen_number(cson_gen_reader_t *r)
+{
+    char buf[64];
+    char *end;
+    size_t i;
+    double d;
+    long long v = 0;
+    int neg = *r->p == '-';
+    const char *s = r->p + neg;
+
+    for (i = 0; i < 15 && s[i] >= '0' && s[i] <= '9'; i++)
+    {
+        v = v * 10 + (s[i] - '0');
+    }
+    if (i > 0 && !((s[i] >= '0' && s[i] <= '9') || s[i] == '.' || s[i] == 'e' || s[i] == 'E'
+                   || s[i] == '+' || s[i] == '-'))
+    {
+        /* 15位以内的整数可由double精确表示，结果与strtod一致 */
+        r->p = s + i;
+        return neg ? -(double)v : (double)v;
+    }
+    for (i = 0; i < sizeof(buf) - 1; i++)
+    {
+        char c = r->p[i];
+        if (!((c >= '0' && c <= '9') || c == '+' || c == '-' || c == 'e' || c == 'E' || c == '.'))
+        {
+            break;
+        }
+        buf[i] = c;
+    }
+    buf[i] = 0;
+    d = strtod(buf, &end);
+    if (end == buf)
+    {
+        r->error = 1;
+        return 0.0;
+    }
+    r->p += end - buf;
+    return d;
+}
+
+/**
+ * @brief 数值转换为整型，与cJSON的valueint一致
+ *
+ * @param d 数值
+ * @return int 整型值
+ */
+static int _cson_gen_valueint(double d)
+{
+    if (d >= INT_MAX)
+    {
+        return INT_MAX;
+    }
+    if (d <= (double)INT_MIN)
+    {
+        return INT_MIN;
+    }
+    return (int)d;
+}
+
+/**
+ * @brief 数值转换为长整型，超出范围时取边界值，与`_cson_decode_long`一致
+ *
+ * @param d 数值
+ * @return long 长整型值
+ */
+static long _cson_gen_valuelong(double d)
+{
+    if (d >= (double)LONG_MAX)
+    {
+        return LONG_MAX;
+    }
+    if (d <= (double)LONG_MIN)
+    {
+        return LONG_MIN;
+    }
+    return d == d ? (long)d : 0;
+}
+
+/**
+ * @brief 进入数组或对象
+ *
+ * @param r 读取器，当前字符为'['或'{'
+ * @param close 结束字符
+ * @return int 是否有成员
+ */
+static int _cson_gen_begin(cson_gen_reader_t *r, char close)
+{
+    if (r->depth >= CJSON_NESTING_LIMIT)
+    {
+        r->error = 1;
+        return 0;
+    }
+    r->depth++;
+    r->p++;
+    if (_cson_gen_peek(r) == close)
+    {
+        r->p++;
+        r->depth--;
+        return 0;
+    }
+    return !r->error;
+}
+
+/**
+ * @brief 移动到下一个成员
+ *
+ * @param r 读取器
+ * @param close 结束字符
+ * @return int 是否还有成员
+ */
+static int _cson_gen_next(cson_gen_reader_t *r, char close)
+{
+    int c = _cson_gen_peek(r);
+
+    if (c == ',')
+    {
+        r->p++;
+        return 1;
+    }
+    if (c == close && c)
+    {
+        r->p++;
+        r->depth--;
+        return 0;
+    }
+    r->error = 1;
+    return 0;
+}
+
+/**
+ * @brief 解析对象成员的键值及':'
+ *
+ * @param r 读取器
+ * @param key 键值缓冲，为NULL时仅校验
+ * @param size 键值缓冲大小
+ */
+static void _cson_gen_key(cson_gen_reader_t *r, char *key, size_t size)
+{
+    if (_cson_gen_peek(r) == '\"')
+    {
+        _cson_gen_unescape(r, key, size);
+        if (_cson_gen_peek(r) == ':')
+        {
+            r->p++;
+            return;
+        }
+    }
+    r->error = 1;
+    if (key)
+    {
+        key[0] = 0;
+    }
+}
+
+/**
+ * @brief 跳过一个值
+ *
+ * @param r 读取器
+ */
+static void _cson_gen_skip(cson_gen_reader_t *r)
+{
+    int c = _cson_gen_peek(r);
+
+    switch (c)
+    {
+    case 'n':
+        r->error |= strncmp(r->p, "null", 4) != 0;
+        r->p += r->error ? 0 : 4;
+        break;
+    case 't':
+        r->error |= strncmp(r->p, "true", 4) != 0;
+        r->p += r->error ? 0 : 4;
+        break;
+    case 'f':
+        r->error |= strncmp(r->p, "false", 5) != 0;
+        r->p += r->error ? 0 : 5;
+        break;
+    case '\"':
+        _cson_gen_unescape(r, NULL, 0);
+        break;
+    case '[':
+        if (_cson_gen_begin(r, ']'))
+        {
+            do
+            {
+                _cson_gen_skip(r);
+            } while (_cson_gen_next(r, ']'));
+        }
+        break;
+    case '{':
+        if (_cson_gen_begin(r, '}'))
+        {
+            do
+            {
+                _cson_gen_key(r, NULL, 0);
+                _cson_gen_skip(r);
+            } while (_cson_gen_next(r, '}'));
+        }
+        break;
+    default:
+        if (_cson_gen_is_number(c))
+        {
+            _cson_gen_number(r);
+        }
+        else
+        {
+            r->error = 1;
+        }
+        break;
+    }
+}
+
+/**
+ * @brief 读取整型值，非数值返回0
+ *
+ * @param r 读取器
+ * @return int 整型值
+ */
+static int _cson_gen_read_int(cson_gen_reader_t *r)
+{
+    if (_cson_gen_is_number(_cson_gen_peek(r)))
+    {
+        return _cson_gen_valueint(_cson_gen_number(r));
+    }
+    _cson_gen_skip(r);
+    return 0;
+}
+
+/**
+ * @brief 读取数组中的整型元素，不检查类型，与cJSON的valueint一致(true为1)
+ *
+ * @param r 读取器
+ * @return int 整型值
+ */
+static int _cson_gen_read_element(cson_gen_reader_t *r)
+{
+    int c = _cson_gen_peek(r);
+
+    if (_cson_gen_is_number(c))
+    {
+        return _cson_gen_valueint(_cson_gen_number(r));
+    }
+    _cson_gen_skip(r);
+    return c == 't' && !r->error;
+}
+
+/**
+ * @brief 读取长整型值，非数值返回0
+ *
+ * @param r 读取器
+ * @return long 长整型值
+ */
+static long _cson_gen_read_long(cson_gen_reader_t *r)
+{
+    if (_cson_gen_is_number(_cson_gen_peek(r)))
+    {
+        return _cson_gen_valuelong(_cson_gen_number(r));
+    }
+    _cson_gen_skip(r);
+    return 0;
+}
+
+/**
+ * @brief 读取数组中的长整型元素，不检查类型(true为1)
+ *
+ * @param r 读取器
+ * @return long 长整型值
+ */
+static long _cson_gen_read_long_element(cson_gen_reader_t *r)
+{
+    int c = _cson_gen_peek(r);
+
+    if (_cson_gen_is_number(c))
+    {
+        return _cson_gen_valuelong(_cson_gen_number(r));
+    }
+    _cson_gen_skip(r);
+    return c == 't' && !r->error;
+}
+
+/**
+ * @brief 读取浮点值，非数值返回0
+ *
+ * @param r 读取器
+ * @return double 浮点值
+ */
+static double _cson_gen_read_double(cson_gen_reader_t *r)
+{
+    if (_cson_gen_is_number(_cson_gen_peek(r)))
+    {
+        return _cson_gen_number(r);
+    }
+    _cson_gen_skip(r);
+    return 0.0;
+}
+
+/**
+ * @brief 读取布尔值
+ *
+ * @param r 读取器
+ * @return char 是否为true
+ */
+static char _cson_gen_read_bool(cson_gen_reader_t *r)
+{
+    int c = _cson_gen_peek(r);
+
+    _cson_gen_skip(r);
+    return (char)(c == 't' && !r->error);
+}
+
+/**
+ * @brief 读取字符串，非字符串返回NULL
+ *
+ * @param r 读取器
+ * @return char* 新字符串
+ */
+static char *_cson_gen_read_string(cson_gen_reader_t *r)
+{
+    const char *start;
+    size_t size;
+    char *str;
+
+    if (_cson_gen_peek(r) != '\"')
+    {
+        _cson_gen_skip(r);
+        return NULL;
+    }
+    start = r->p;
+    _cson_gen_unescape(r, NULL, 0);
+    if (r->error)
+    {
+        return NULL;
+    }
+    size = (size_t)(r->p - start) - 1;
+    str = cson_mem_alloc(size);
+    if (!str)
+    {
+        r->error = 1;
+        return NULL;
+    }
+    r->p = start;
+    _cson_gen_unescape(r, str, size);
+    return str;
+}
+
+/**
+ * @brief 读取定长字符串，超长时的处理与`cson_chars_assign`一致，非字符串读取为空字符串
+ *
+ * @param r 读取器
+ * @param dest 字符数组
+ * @param size 字符数组大小(含结束符)
+ * @param policy 超长处理策略
+ */
+static void _cson_gen_read_chars(cson_gen_reader_t *r, char *dest, size_t size, cson_chars_policy_t policy)
+{
+    const char *start;
+    char *str;
+    size_t len;
+
+    dest[0] = 0;
+    if (_cson_gen_peek(r) != '\"')
+    {
+        _cson_gen_skip(r);
+        return;
+    }
+    start = r->p;
+    _cson_gen_unescape(r, NULL, 0);
+    if (r->error)
+    {
+        return;
+    }
+    len = (size_t)(r->p - start);
+    r->p = start;
+    if (len < size + 2)
+    {
+        _cson_gen_unescape(r, dest, size);
+        return;
+    }
+    str = _cson_gen_read_string(r);
+    if (!str)
+    {
+        return;
+    }
+    len = strlen(str);
+    if (len >= size)
+    {
+        len = policy == CSON_CHARS_REJECT ? 0 : size - 1;
+        while (len && ((unsigned char)str[len] & 0xC0) == 0x80)
+        {
+            len--;
+        }
+    }
+    memcpy(dest, str, len);
+    dest[len] = 0;
+    cson_mem_free(str);
+}
+
+/**
+ * @brief 读取任意值并按cJSON规范化输出
+ *
+ * @param r 读取器
+ * @return char* json字符串
+ */
+static char *_cson_gen_read_json(cson_gen_reader_t *r)
+{
+    const char *start;
+    cJSON *json;
+    char *str;
+
+    _cson_gen_peek(r);
+    start = r->p;
+    _cson_gen_skip(r);
+    if (r->error)
+    {
+        return NULL;
+    }
+    json = cJSON_ParseWithLength(start, (size_t)(r->p - start));
+    str = cJSON_PrintUnformatted(json);
+    cJSON_Delete(json);
+    return str;
+}
+
+/**
+ * @brief 进入对象值，非对象值直接跳过
+ *
+ * @param r 读取器
+ * @return int 是否有成员需要解析
+ */
+static int _cson_gen_open_object(cson_gen_reader_t *r)
+{
+    if (_cson_gen_peek(r) != '{')
+    {
+        _cson_gen_skip(r);
+        return 0;
+    }
+    return _cson_gen_begin(r, '}');
+}
+
+/**
+ * @brief 读取对象值的起始部分
+ *
+ * @param r 读取器
+ * @param size 对象大小
+ * @param more 是否有成员需要解析
+ * @return void* 分配并清零的对象，值为null时返回NULL
+ */
+static void *_cson_gen_read_object(cson_gen_reader_t *r, size_t size, int *more)
+{
+    void *obj;
+
+    *more = 0;
+    if (r->error || _cson_gen_peek(r) == 'n')
+    {
+        _cson_gen_skip(r);
+        return NULL;
+    }
+    obj = cson_mem_alloc(size);
+    if (!obj)
+    {
+        r->error = 1;
+        return NULL;
+    }
+    memset(obj, 0, size);
+    *more = _cson_gen_open_object(r);
+    return obj;
+}
+
+/**
+ * @brief vector尾部追加一个置零的元素，与`cson_vector_push`行为一致
+ *
+ * @param r 读取器
+ * @param vec vector
+ * @param size 元素大小
+ * @return void* 新元素，失败时返回NULL并置错误标志
+ */
+static void *_cson_gen_vector_push(cson_gen_reader_t *r, cson_vector_t *vec, size_t size)
+{
+    void *ele;
+
+    if (vec->count == vec->cap)
+    {
+        size_t cap = vec->cap ? vec->cap * 2 : 4;
+        void *data = cap <= (size_t)-1 / size ? cson_mem_alloc(cap * size) : NULL;
+        if (!data)
+        {
+            r->error = 1;
+            return NULL;
+        }
+        if (vec->count)
+        {
+            memcpy(data, vec->data, vec->count * size);
+        }
+        cson_mem_free(vec->data);
+        vec->data = data;
+        vec->cap = cap;
+    }
+    ele = (char *)vec->data + vec->count++ * size;
+    memset(ele, 0, size);
+    return ele;
+}
+
+/**
+ * @brief 链表追加节点，与`cson_decode`一致每个元素对应一个节点，null元素的节点对象为NULL
+ *
+ * @param list 链表
+ * @param tail 链表尾部
+ * @param obj 节点对象
+ */
+static void _cson_gen_list_append(cson_list_t **list, cson_list_t **tail, void *obj)
+{
+    cson_list_t *node;
+
+    node = cson_mem_alloc(sizeof(cson_list_t));
+    if (!node)
+    {
+        return;
+    }
+    node->obj = obj;
+    node->next = NULL;
+    if (*tail)
+    {
+        (*tail)->next = node;
+    }
+    else
+    {
+        *list = node;
+    }
+    *tail = node;
+}
+
+/**
+ * @brief 基础类型链表追加一个置零的节点，元素值随后直接写入节点
+ *
+ * @param r 读取器
+ * @param list 链表
+ * @param tail 链表尾部
+ * @return cson_list_t* 新节点，失败时返回NULL并置错误标志
+ */
+static cson_list_t *_cson_gen_list_node(cson_gen_reader_t *r, cson_list_t **list, cson_list_t **tail)
+{
+    cson_list_t *node = cson_mem_alloc(sizeof(cson_list_t));
+
+    if (!node)
+    {
+        r->error = 1;
+        return NULL;
+    }
+    memset(node, 0, sizeof(cson_list_t));
+    if (*tail)
+    {
+        (*tail)->next = node;
+    }
+    else
+    {
+        *list = node;
+    }
+    *tail = node;
+    return node;
+}
+
+/**
+ * @brief 预留编码缓冲空间
+ *
+ * @param b 编码缓冲
+ * @param n 需要的字节数
+ * @return char* 写入位置，失败返回NULL
+ */
+static char *_cson_gen_reserve(cson_gen_buf_t *b, size_t n)
+{
+    if (b->error)
+    {
+        return NULL;
+    }
+    if (b->len + n + 1 > b->cap)
+    {
+        size_t cap = b->cap ? b->cap * 2 : 256;
+        char *p;
+        while (cap < b->len + n + 1)
+        {
+            cap *= 2;
+        }
+        p = cson_mem_alloc(cap);
+        if (!p)
+        {
+            b->error = 1;
+            return NULL;
+        }
+        if (b->buf)
+        {
+            memcpy(p, b->buf, b->len);
+            cson_mem_free(b->buf);
+        }
+        b->buf = p;
+        b->cap = cap;
+    }
+    b->len += n;
+    return b->buf + b->len - n;
+}
+
+/**
+ * @brief 写入数据
+ *
+ * @param b 编码缓冲
+ * @param data 数据
+ * @param n 数据长度
+ */
+static void _cson_gen_put(cson_gen_buf_t *b, const char *data, size_t n)
+{
+    char *p = _cson_gen_reserve(b, n);
+    if (p)
+    {
+        memcpy(p, data, n);
+    }
+}
+
+/**
+ * @brief 写入键值，非首个成员前写入','
+ *
+ * @param b 编码缓冲
+ * @param first 是否为首个成员
+ * @param key 转义后的`"key":`字面量
+ * @param n 字面量长度
+ */
+static void _cson_gen_put_key(cson_gen_buf_t *b, int *first, const char *key, size_t n)
+{
+    if (!*first)
+    {
+        _cson_gen_put(b, ",", 1);
+    }
+    *first = 0;
+    _cson_gen_put(b, key, n);
+}
+
+/**
+ * @brief 写入整型
+ *
+ * @param b 编码缓冲
+ * @param value 整型值
+ */
+static void _cson_gen_put_int(cson_gen_buf_t *b, long long value)
+{
+    char tmp[24];
+    char *p = tmp + sizeof(tmp);
+    unsigned long long u = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    do
+    {
+        *--p = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0)
+    {
+        *--p = '-';
+    }
+    _cson_gen_put(b, p, (size_t)(tmp + sizeof(tmp) - p));
+}
+
+/**
+ * @brief 写入数值，格式与cJSON一致
+ *
+ * @param b 编码缓冲
+ * @param d 数值
+ */
+static void _cson_gen_put_number(cson_gen_buf_t *b, double d)
+{
+    char tmp[26];
+    double test = 0.0;
+    int len;
+
+    if (isnan(d) || isinf(d))
+    {
+        _cson_gen_put(b, "null", 4);
+        return;
+    }
+    if (d >= INT_MIN && d <= INT_MAX && d == (double)(int)d)
+    {
+        _cson_gen_put_int(b, (int)d);
+        return;
+    }
+    if (fabs(d) <= 9007199254740992.0 && d == floor(d))
+    {
+        len = sprintf(tmp, "%.0f", d);
+        _cson_gen_put(b, tmp, (size_t)len);
+        return;
+    }
+    len = sprintf(tmp, "%1.15g", d);
+    if (sscanf(tmp, "%lg", &test) != 1
+        || fabs(test - d) > (fabs(test) > fabs(d) ? fabs(test) : fabs(d)) * DBL_EPSILON)
+    {
+        len = sprintf(tmp, "%1.17g", d);
+    }
+    _cson_gen_put(b, tmp, (size_t)len);
+}
+
+/**
+ * @brief 写入至多size字节的字符串，遇到'\\0'提前结束，转义规则与cJSON一致
+ *
+ * @param b 编码缓冲
+ * @param str 字符串
+ * @param size 最大长度
+ */
+static void _cson_gen_put_chars(cson_gen_buf_t *b, const char *str, size_t size)
+{
+    const unsigned char *s = (const unsigned char *)str;
+    const unsigned char *run = s;
+    char esc[8];
+
+    _cson_gen_put(b, "\"", 1);
+    for (size_t i = 0; i < size && *s; i++, s++)
+    {
+        if (*s > 31 && *s != '\"' && *s != '\\')
+        {
+            continue;
+        }
+        _cson_gen_put(b, (const char *)run, (size_t)(s - run));
+        run = s + 1;
+        esc[0] = '\\';
+        switch (*s)
+        {
+        case '\\':
+        case '\"':
+            esc[1] = (char)*s;
+            break;
+        case '\b':
+            esc[1] = 'b';
+            break;
+        case '\f':
+            esc[1] = 'f';
+            break;
+        case '\n':
+            esc[1] = 'n';
+            break;
+        case '\r':
+            esc[1] = 'r';
+            break;
+        case '\t':
+            esc[1] = 't';
+            break;
+        default:
+            sprintf(esc + 1, "u%04x", *s);
+            _cson_gen_put(b, esc, 6);
+            continue;
+        }
+        _cson_gen_put(b, esc, 2);
+    }
+    _cson_gen_put(b, (const char *)run, (size_t)(s - run));
+    _cson_gen_put(b, "\"", 1);
+}
+
+/**
+ * @brief 写入字符串，转义规则与cJSON一致
+ *
+ * @param b 编码缓冲
+ * @param str 字符串
+ */
+static void _cson_gen_put_string(cson_gen_buf_t *b, const char *str)
+{
+    _cson_gen_put_chars(b, str, (size_t)-1);
+}
+
+/**
+ * @brief 写入子json，经cJSON规范化
+ *
+ * @param b 编码缓冲
+ * @param first 是否为首个成员
+ * @param key 转义后的`"key":`字面量
+ * @param n 字面量长度
+ * @param text json文本
+ */
+static void _cson_gen_put_json(cson_gen_buf_t *b, int *first, const char *key, size_t n, const char *text)
+{
+    cJSON *json = cJSON_Parse(text);
+    char *str;
+
+    if (!json)
+    {
+        return;
+    }
+    str = cJSON_PrintUnformatted(json);
+    if (str)
+    {
+        _cson_gen_put_key(b, first, key, n);
+        _cson_gen_put(b, str, strlen(str));
+        cJSON_free(str);
+    }
+    cJSON_Delete(json);
+}
+
+/**
+ * @brief 结束编码，返回json字符串
+ *
+ * @param b 编码缓冲
+ * @return char* json字符串
+ */
+static char *_cson_gen_finish(cson_gen_buf_t *b)
+{
+    if (b->error || !_cson_gen_reserve(b, 0))
+    {
+        cson_mem_free(b->buf);
+        return NULL;
+    }
+    b->buf[b->len] = 0;
+    return b->buf;
+}
+'''
+
+
+class Writer(object):
+    def __init__(self):
+        self.lines = []
+
+    def __call__(self, line='', indent=0):
+        self.lines.append(('    ' * indent + line) if line else '')
+
+    def text(self):
+        return '\n'.join(self.lines) + '\n'
+
+
+def emit_value_decode(w, kind, target, ind):
+    """读取一个值，规则与解释执行时`_cson_decode_into`一致"""
+    if kind in ('CSON_TYPE_CHAR', 'CSON_TYPE_SHORT', 'CSON_TYPE_INT'):
+        w('%s = (%s)_cson_gen_read_int(r);' % (target, C_TYPES[kind]), ind)
+    elif kind == 'CSON_TYPE_LONG':
+        w('%s = _cson_gen_read_long(r);' % target, ind)
+    elif kind in ('CSON_TYPE_FLOAT', 'CSON_TYPE_DOUBLE'):
+        w('%s = (%s)_cson_gen_read_double(r);' % (target, C_TYPES[kind]), ind)
+    elif kind == 'CSON_TYPE_BOOL':
+        w('%s = _cson_gen_read_bool(r);' % target, ind)
+    elif kind == 'CSON_TYPE_STRING':
+        w('%s = _cson_gen_read_string(r);' % target, ind)
+    elif kind == 'CSON_TYPE_JSON':
+        w('%s = _cson_gen_read_json(r);' % target, ind)
+    else:
+        w('_cson_gen_skip(r);', ind)
+
+
+def emit_array_begin(w, ind):
+    w("if (_cson_gen_peek(r) != '[')", ind)
+    w('{', ind)
+    w('_cson_gen_skip(r);', ind + 1)
+    w('}', ind)
+    w("else if (_cson_gen_begin(r, ']'))", ind)
+    w('{', ind)
+
+
+def emit_field_decode(w, f, ind):
+    target = 'obj->%s' % f.member
+    if f.kind == 'CSON_TYPE_STRUCT':
+        w('%s = _cson_gen_read_%s(r);' % (target, f.sub.name), ind)
+    elif f.kind == 'CSON_TYPE_EMBED':
+        w('if (_cson_gen_open_object(r))', ind)
+        w('{', ind)
+        w('_cson_gen_fields_%s(r, &%s);' % (f.sub.name, target), ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_EMBED_ARRAY':
+        emit_array_begin(w, ind)
+        w('int i = 0;', ind + 1)
+        w('do', ind + 1)
+        w('{', ind + 1)
+        w('if (i < %s)' % f.size, ind + 2)
+        w('{', ind + 2)
+        w('if (_cson_gen_open_object(r))', ind + 3)
+        w('{', ind + 3)
+        w('_cson_gen_fields_%s(r, &%s[i]);' % (f.sub.name, target), ind + 4)
+        w('}', ind + 3)
+        w('i++;', ind + 3)
+        w('}', ind + 2)
+        w('else', ind + 2)
+        w('{', ind + 2)
+        w('_cson_gen_skip(r);', ind + 3)
+        w('}', ind + 2)
+        w("} while (_cson_gen_next(r, ']'));", ind + 1)
+        if f.count:
+            w('obj->%s = i;' % f.count, ind + 1)
+        else:
+            w('(void)i;', ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_ILIST':
+        emit_array_begin(w, ind)
+        w('%s **tail = &%s;' % (f.sub.type, target), ind + 1)
+        w('do', ind + 1)
+        w('{', ind + 1)
+        w("if (_cson_gen_peek(r) == '{')", ind + 2)
+        w('{', ind + 2)
+        w('%s *ele = _cson_gen_read_%s(r);' % (f.sub.type, f.sub.name), ind + 3)
+        w('if (ele)', ind + 3)
+        w('{', ind + 3)
+        w('*tail = ele;', ind + 4)
+        w('tail = &ele->%s;' % f.next, ind + 4)
+        w('}', ind + 3)
+        w('}', ind + 2)
+        w('else', ind + 2)
+        w('{', ind + 2)
+        w('_cson_gen_skip(r);', ind + 3)
+        w('}', ind + 2)
+        w("} while (_cson_gen_next(r, ']'));", ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_LIST':
+        emit_array_begin(w, ind)
+        w('cson_list_t *tail = NULL;', ind + 1)
+        w('do', ind + 1)
+        w('{', ind + 1)
+        if f.basic:
+            w('cson_list_t *node = _cson_gen_list_node(r, &%s, &tail);' % target, ind + 2)
+            w('if (!node)', ind + 2)
+            w('{', ind + 2)
+            w('break;', ind + 3)
+            w('}', ind + 2)
+            emit_value_decode(w, f.basic, 'node->%s' % UNION_MEMBERS[f.basic], ind + 2)
+        else:
+            w('_cson_gen_list_append(&%s, &tail, _cson_gen_read_%s(r));' % (target, f.sub.name), ind + 2)
+        w("} while (_cson_gen_next(r, ']'));", ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_ARRAY':
+        emit_array_begin(w, ind)
+        w('int i = 0;', ind + 1)
+        w('do', ind + 1)
+        w('{', ind + 1)
+        w('if (i < %s)' % f.size, ind + 2)
+        w('{', ind + 2)
+        if f.ele_type in ('CSON_TYPE_CHAR', 'CSON_TYPE_SHORT', 'CSON_TYPE_INT'):
+            w('%s[i++] = (%s)_cson_gen_read_element(r);' % (target, C_TYPES[f.ele_type]), ind + 3)
+        elif f.ele_type == 'CSON_TYPE_LONG':
+            w('%s[i++] = _cson_gen_read_long_element(r);' % target, ind + 3)
+        elif f.ele_type in ('CSON_TYPE_FLOAT', 'CSON_TYPE_DOUBLE', 'CSON_TYPE_STRING'):
+            emit_value_decode(w, f.ele_type, '%s[i++]' % target, ind + 3)
+        else:
+            w('_cson_gen_skip(r);', ind + 3)
+        w('}', ind + 2)
+        w('else', ind + 2)
+        w('{', ind + 2)
+        w('_cson_gen_skip(r);', ind + 3)
+        w('}', ind + 2)
+        w("} while (_cson_gen_next(r, ']'));", ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_VECTOR':
+        ele_type = C_TYPES[f.basic] if f.basic else f.sub.type
+        emit_array_begin(w, ind)
+        w('do', ind + 1)
+        w('{', ind + 1)
+        w('%s *ele = _cson_gen_vector_push(r, &%s, sizeof(%s));' % (ele_type, target, ele_type), ind + 2)
+        w('if (!ele)', ind + 2)
+        w('{', ind + 2)
+        w('break;', ind + 3)
+        w('}', ind + 2)
+        if f.basic:
+            emit_value_decode(w, f.basic, '*ele', ind + 2)
+        else:
+            w('if (_cson_gen_open_object(r))', ind + 2)
+            w('{', ind + 2)
+            w('_cson_gen_fields_%s(r, ele);' % f.sub.name, ind + 3)
+            w('}', ind + 2)
+        w("} while (_cson_gen_next(r, ']'));", ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_CHAR_ARRAY':
+        w('_cson_gen_read_chars(r, %s, %s, %s);' % (target, f.size, f.policy), ind)
+    else:
+        emit_value_decode(w, f.kind, target, ind)
+
+
+def emit_decode(w, mdl):
+    keys = []
+    for f in mdl.fields:
+        if f.key.lower() not in [k.lower() for k in keys]:
+            keys.append(f.key)
+    w('/**')
+    w(' * @brief 读取%s的成员' % mdl.type)
+    w(' *')
+    w(' * @param r 读取器，已进入对象且对象非空')
+    w(' * @param obj 对象')
+    w(' */')
+    w('static void _cson_gen_fields_%s(cson_gen_reader_t *r, %s *obj)' % (mdl.name, mdl.type))
+    w('{')
+    if not keys:
+        w('(void)obj;', 1)
+        w('do', 1)
+        w('{', 1)
+        w('_cson_gen_key(r, NULL, 0);', 2)
+        w('_cson_gen_skip(r);', 2)
+        w("} while (_cson_gen_next(r, '}'));", 1)
+    else:
+        key_size = max(len(k.encode('utf-8')) for k in keys) + 2
+        seed, size = perfect_hash([k.lower() for k in keys])
+        w('unsigned char seen[%d] = {0};' % len(keys), 1)
+        w('char key[%d];' % key_size, 1)
+        w('', 1)
+        w('do', 1)
+        w('{', 1)
+        w('_cson_gen_key(r, key, sizeof(key));', 2)
+        w('switch (_cson_gen_hash(key, %du) & %du)' % (seed, size - 1), 2)
+        w('{', 2)
+        slots = sorted((key_hash(k.lower(), seed) & (size - 1), i, k) for i, k in enumerate(keys))
+        for slot, index, key in slots:
+            w('case %d:' % slot, 2)
+            w('if (!seen[%d] && _cson_gen_key_equal(key, %s))' % (index, c_string(key)), 3)
+            w('{', 3)
+            w('seen[%d] = 1;' % index, 4)
+            fields = [f for f in mdl.fields if f.key.lower() == key.lower()]
+            emit_field_decode(w, fields[0], 4)
+            w('continue;', 4)
+            w('}', 3)
+            w('break;', 3)
+        w('default:', 2)
+        w('break;', 3)
+        w('}', 2)
+        w('_cson_gen_skip(r);', 2)
+        w("} while (_cson_gen_next(r, '}'));", 1)
+    w('}')
+    w()
+    w('/**')
+    w(' * @brief 读取%s' % mdl.type)
+    w(' *')
+    w(' * @param r 读取器')
+    w(' * @return %s* 读取得到的对象，值为null时返回NULL' % mdl.type)
+    w(' */')
+    w('static %s *_cson_gen_read_%s(cson_gen_reader_t *r)' % (mdl.type, mdl.name))
+    w('{')
+    w('int more;', 1)
+    w('%s *obj = _cson_gen_read_object(r, sizeof(%s), &more);' % (mdl.type, mdl.type), 1)
+    w('', 1)
+    w('if (more)', 1)
+    w('{', 1)
+    w('_cson_gen_fields_%s(r, obj);' % mdl.name, 2)
+    w('}', 1)
+    w('return obj;', 1)
+    w('}')
+    w()
+
+
+def emit_free(w, mdl):
+    w('/**')
+    w(' * @brief 释放%s的成员，对象本身保留' % mdl.type)
+    w(' *')
+    w(' * @param obj 对象')
+    w(' */')
+    w('static void _cson_gen_clear_%s(%s *obj)' % (mdl.name, mdl.type))
+    w('{')
+    lists = [f for f in mdl.fields if f.kind == 'CSON_TYPE_LIST']
+    if lists:
+        w('cson_list_t *p, *next;', 1)
+        w('', 1)
+    if not [f for f in mdl.fields if f.kind in ('CSON_TYPE_STRING', 'CSON_TYPE_JSON', 'CSON_TYPE_STRUCT',
+                                                 'CSON_TYPE_LIST', 'CSON_TYPE_VECTOR', 'CSON_TYPE_EMBED',
+                                                 'CSON_TYPE_EMBED_ARRAY', 'CSON_TYPE_ILIST')
+            or (f.kind == 'CSON_TYPE_ARRAY' and f.ele_type == 'CSON_TYPE_STRING')]:
+        w('(void)obj;', 1)
+    for f in mdl.fields:
+        value = 'obj->%s' % f.member
+        if f.kind in ('CSON_TYPE_STRING', 'CSON_TYPE_JSON'):
+            w('cson_mem_free(%s);' % value, 1)
+        elif f.kind == 'CSON_TYPE_STRUCT':
+            w('_cson_gen_free_%s(%s);' % (f.sub.name, value), 1)
+        elif f.kind == 'CSON_TYPE_EMBED':
+            w('_cson_gen_clear_%s(&%s);' % (f.sub.name, value), 1)
+        elif f.kind == 'CSON_TYPE_EMBED_ARRAY':
+            w('for (int i = 0; i < %s; i++)' % f.size, 1)
+            w('{', 1)
+            w('_cson_gen_clear_%s(&%s[i]);' % (f.sub.name, value), 2)
+            w('}', 1)
+        elif f.kind == 'CSON_TYPE_ILIST':
+            w('for (%s *p = %s, *next; p; p = next)' % (f.sub.type, value), 1)
+            w('{', 1)
+            w('next = p->%s;' % f.next, 2)
+            w('_cson_gen_free_%s(p);' % f.sub.name, 2)
+            w('}', 1)
+        elif f.kind == 'CSON_TYPE_LIST':
+            w('for (p = %s; p; p = next)' % value, 1)
+            w('{', 1)
+            w('next = p->next;', 2)
+            if not f.basic:
+                w('_cson_gen_free_%s((%s *)p->obj);' % (f.sub.name, f.sub.type), 2)
+            elif f.basic == 'CSON_TYPE_STRING':
+                w('cson_mem_free(p->str);', 2)
+            w('cson_mem_free(p);', 2)
+            w('}', 1)
+        elif f.kind == 'CSON_TYPE_ARRAY' and f.ele_type == 'CSON_TYPE_STRING':
+            w('for (int i = 0; i < %s; i++)' % f.size, 1)
+            w('{', 1)
+            w('cson_mem_free(%s[i]);' % value, 2)
+            w('}', 1)
+        elif f.kind == 'CSON_TYPE_VECTOR':
+            if not f.basic:
+                w('for (size_t i = 0; i < %s.count; i++)' % value, 1)
+                w('{', 1)
+                w('_cson_gen_clear_%s(&((%s *)%s.data)[i]);' % (f.sub.name, f.sub.type, value), 2)
+                w('}', 1)
+            elif f.basic == 'CSON_TYPE_STRING':
+                w('for (size_t i = 0; i < %s.count; i++)' % value, 1)
+                w('{', 1)
+                w('cson_mem_free(((char **)%s.data)[i]);' % value, 2)
+                w('}', 1)
+            w('cson_mem_free(%s.data);' % value, 1)
+    w('}')
+    w()
+    w('/**')
+    w(' * @brief 释放%s' % mdl.type)
+    w(' *')
+    w(' * @param obj 对象')
+    w(' */')
+    w('static void _cson_gen_free_%s(%s *obj)' % (mdl.name, mdl.type))
+    w('{')
+    w('if (!obj)', 1)
+    w('{', 1)
+    w('return;', 2)
+    w('}', 1)
+    w('_cson_gen_clear_%s(obj);' % mdl.name, 1)
+    w('cson_mem_free(obj);', 1)
+    w('}')
+    w()
+
+
+def emit_scalar_encode(w, kind, value, ind):
+    if kind in ('CSON_TYPE_CHAR', 'CSON_TYPE_SHORT', 'CSON_TYPE_INT'):
+        w('_cson_gen_put_int(b, %s);' % value, ind)
+    elif kind == 'CSON_TYPE_LONG':
+        w('if (%s >= INT_MIN && %s <= INT_MAX)' % (value, value), ind)
+        w('_cson_gen_put_int(b, %s);' % value, ind + 1)
+        w('else', ind)
+        w('_cson_gen_put_number(b, (double)%s);' % value, ind + 1)
+    elif kind in ('CSON_TYPE_FLOAT', 'CSON_TYPE_DOUBLE'):
+        w('_cson_gen_put_number(b, (double)%s);' % value, ind)
+    elif kind == 'CSON_TYPE_STRING':
+        w('_cson_gen_put_string(b, %s);' % value, ind)
+
+
+def emit_field_encode(w, f, ind):
+    value = 'obj->%s' % f.member
+    key = json_key(f.key)
+    lit = '%s, %d' % (c_string(key), len(key.encode('utf-8')))
+    if f.kind in ('CSON_TYPE_CHAR', 'CSON_TYPE_SHORT', 'CSON_TYPE_INT', 'CSON_TYPE_LONG',
+                  'CSON_TYPE_FLOAT', 'CSON_TYPE_DOUBLE'):
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind)
+        emit_scalar_encode(w, f.kind, value, ind)
+    elif f.kind == 'CSON_TYPE_BOOL':
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind)
+        w('_cson_gen_put(b, %s ? "true" : "false", %s ? 4 : 5);' % (value, value), ind)
+    elif f.kind == 'CSON_TYPE_STRING':
+        w('if (%s)' % value, ind)
+        w('{', ind)
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind + 1)
+        w('_cson_gen_put_string(b, %s);' % value, ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_CHAR_ARRAY':
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind)
+        w('_cson_gen_put_chars(b, %s, %s);' % (value, f.size), ind)
+    elif f.kind == 'CSON_TYPE_JSON':
+        w('if (%s)' % value, ind)
+        w('{', ind)
+        w('_cson_gen_put_json(b, &first, %s, %s);' % (lit, value), ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_STRUCT':
+        w('if (%s)' % value, ind)
+        w('{', ind)
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind + 1)
+        w('_cson_gen_encode_%s(b, %s);' % (f.sub.name, value), ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_EMBED':
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind)
+        w('_cson_gen_encode_%s(b, &%s);' % (f.sub.name, value), ind)
+    elif f.kind == 'CSON_TYPE_EMBED_ARRAY':
+        count = f.size
+        if f.count:
+            count = 'obj->%s < 0 ? 0 : (obj->%s > %s ? %s : obj->%s)' % (f.count, f.count, f.size, f.size, f.count)
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind)
+        w('_cson_gen_put(b, "[", 1);', ind)
+        w('for (int i = 0, n = %s; i < n; i++)' % count, ind)
+        w('{', ind)
+        w('if (i)', ind + 1)
+        w('{', ind + 1)
+        w('_cson_gen_put(b, ",", 1);', ind + 2)
+        w('}', ind + 1)
+        w('_cson_gen_encode_%s(b, &%s[i]);' % (f.sub.name, value), ind + 1)
+        w('}', ind)
+        w('_cson_gen_put(b, "]", 1);', ind)
+    elif f.kind == 'CSON_TYPE_ILIST':
+        w('if (%s)' % value, ind)
+        w('{', ind)
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind + 1)
+        w('_cson_gen_put(b, "[", 1);', ind + 1)
+        w('for (const %s *p = %s; p; p = p->%s)' % (f.sub.type, value, f.next), ind + 1)
+        w('{', ind + 1)
+        w('if (p != %s)' % value, ind + 2)
+        w('{', ind + 2)
+        w('_cson_gen_put(b, ",", 1);', ind + 3)
+        w('}', ind + 2)
+        w('_cson_gen_encode_%s(b, p);' % f.sub.name, ind + 2)
+        w('}', ind + 1)
+        w('_cson_gen_put(b, "]", 1);', ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_LIST':
+        w('if (%s)' % value, ind)
+        w('{', ind)
+        w('const cson_list_t *p;', ind + 1)
+        w('int head = 1;', ind + 1)
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind + 1)
+        w('_cson_gen_put(b, "[", 1);', ind + 1)
+        w('for (p = %s; p; p = p->next)' % value, ind + 1)
+        w('{', ind + 1)
+        if f.basic in (None, 'CSON_TYPE_STRING'):
+            w('if (!p->obj)', ind + 2)
+            w('{', ind + 2)
+            w('continue;', ind + 3)
+            w('}', ind + 2)
+        w('if (!head)', ind + 2)
+        w('{', ind + 2)
+        w('_cson_gen_put(b, ",", 1);', ind + 3)
+        w('}', ind + 2)
+        w('head = 0;', ind + 2)
+        if f.basic:
+            emit_scalar_encode(w, f.basic, 'p->%s' % UNION_MEMBERS[f.basic], ind + 2)
+        else:
+            w('_cson_gen_encode_%s(b, (const %s *)p->obj);' % (f.sub.name, f.sub.type), ind + 2)
+        w('}', ind + 1)
+        w('_cson_gen_put(b, "]", 1);', ind + 1)
+        w('}', ind)
+    elif f.kind == 'CSON_TYPE_VECTOR':
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind)
+        w('_cson_gen_put(b, "[", 1);', ind)
+        w('{', ind)
+        if f.basic == 'CSON_TYPE_STRING':
+            w('int head = 1;', ind + 1)
+        w('for (size_t i = 0; i < %s.count; i++)' % value, ind + 1)
+        w('{', ind + 1)
+        if f.basic == 'CSON_TYPE_STRING':
+            w('if (!((char **)%s.data)[i])' % value, ind + 2)
+            w('{', ind + 2)
+            w('continue;', ind + 3)
+            w('}', ind + 2)
+            w('if (!head)', ind + 2)
+            w('{', ind + 2)
+            w('_cson_gen_put(b, ",", 1);', ind + 3)
+            w('}', ind + 2)
+            w('head = 0;', ind + 2)
+        else:
+            w('if (i)', ind + 2)
+            w('{', ind + 2)
+            w('_cson_gen_put(b, ",", 1);', ind + 3)
+            w('}', ind + 2)
+        if f.basic:
+            ptr = C_TYPES[f.basic] + ('*' if f.basic == 'CSON_TYPE_STRING' else ' *')
+            emit_scalar_encode(w, f.basic, '((const %s)%s.data)[i]' % (ptr, value), ind + 2)
+        else:
+            w('_cson_gen_encode_%s(b, &((const %s *)%s.data)[i]);' % (f.sub.name, f.sub.type, value), ind + 2)
+        w('}', ind + 1)
+        w('}', ind)
+        w('_cson_gen_put(b, "]", 1);', ind)
+    elif f.kind == 'CSON_TYPE_ARRAY':
+        w('_cson_gen_put_key(b, &first, %s);' % lit, ind)
+        w('_cson_gen_put(b, "[", 1);', ind)
+        if f.ele_type == 'CSON_TYPE_STRING':
+            w('{', ind)
+            w('int head = 1;', ind + 1)
+            w('for (int i = 0; i < %s; i++)' % f.size, ind + 1)
+            w('{', ind + 1)
+            w('if (!%s[i])' % value, ind + 2)
+            w('{', ind + 2)
+            w('continue;', ind + 3)
+            w('}', ind + 2)
+            w('if (!head)', ind + 2)
+            w('{', ind + 2)
+            w('_cson_gen_put(b, ",", 1);', ind + 3)
+            w('}', ind + 2)
+            w('head = 0;', ind + 2)
+            w('_cson_gen_put_string(b, %s[i]);' % value, ind + 2)
+            w('}', ind + 1)
+            w('}', ind)
+        elif f.ele_type in C_TYPES and f.ele_type != 'CSON_TYPE_BOOL':
+            w('for (int i = 0; i < %s; i++)' % f.size, ind)
+            w('{', ind)
+            w('if (i)', ind + 1)
+            w('{', ind + 1)
+            w('_cson_gen_put(b, ",", 1);', ind + 2)
+            w('}', ind + 1)
+            emit_scalar_encode(w, f.ele_type, '%s[i]' % value, ind + 1)
+            w('}', ind)
+        w('_cson_gen_put(b, "]", 1);', ind)
+
+
+def emit_encode(w, mdl):
+    w('/**')
+    w(' * @brief %s编码成JSON' % mdl.type)
+    w(' *')
+    w(' * @param b 编码缓冲')
+    w(' * @param obj 对象')
+    w(' */')
+    w('static void _cson_gen_encode_%s(cson_gen_buf_t *b, const %s *obj)' % (mdl.name, mdl.type))
+    w('{')
+    w('int first = 1;', 1)
+    w('', 1)
+    w('if (!obj)', 1)
+    w('{', 1)
+    w('_cson_gen_put(b, "null", 4);', 2)
+    w('return;', 2)
+    w('}', 1)
+    w('_cson_gen_put(b, "{", 1);', 1)
+    for f in mdl.fields:
+        emit_field_encode(w, f, 1)
+    w('(void)first;', 1)
+    w('_cson_gen_put(b, "}", 1);', 1)
+    w('}')
+    w()
+
+
+def emit_public(w, mdl):
+    w('/**')
+    w(' * @brief 解析JSON字符串')
+    w(' *')
+    w(' * @param json_str json字符串')
+    w(' * @return %s* 解析得到的对象，使用`cson_gen_%s_free`或`cson_free`释放' % (mdl.type, mdl.name))
+    w(' */')
+    w('%s *cson_gen_%s_decode(const char *json_str)' % (mdl.type, mdl.name))
+    w('{')
+    w('cson_gen_reader_t r = {json_str, 0, 0};', 1)
+    w('%s *obj;' % mdl.type, 1)
+    w('', 1)
+    w('if (!json_str)', 1)
+    w('{', 1)
+    w('return NULL;', 2)
+    w('}', 1)
+    w('CSON_STATS_ENTER(%s);' % mdl.ref(), 1)
+    w('if (strncmp(r.p, "\\xEF\\xBB\\xBF", 3) == 0)', 1)
+    w('{', 1)
+    w('r.p += 3;', 2)
+    w('}', 1)
+    w('obj = _cson_gen_read_%s(&r);' % mdl.name, 1)
+    w('if (r.error)', 1)
+    w('{', 1)
+    w('_cson_gen_free_%s(obj);' % mdl.name, 2)
+    w('obj = NULL;', 2)
+    w('}', 1)
+    w('CSON_STATS_LEAVE();', 1)
+    w('return obj;', 1)
+    w('}')
+    w()
+    w('/**')
+    w(' * @brief 编码成json字符串')
+    w(' *')
+    w(' * @param obj 对象')
+    w(' * @return char* 编码得到的json字符串，使用`cson_free_json`释放')
+    w(' */')
+    w('char *cson_gen_%s_encode(const %s *obj)' % (mdl.name, mdl.type))
+    w('{')
+    w('cson_gen_buf_t b = {NULL, 0, 0, 0};', 1)
+    w('char *json;', 1)
+    w('', 1)
+    w('CSON_STATS_ENTER(%s);' % mdl.ref(), 1)
+    w('_cson_gen_encode_%s(&b, obj);' % mdl.name, 1)
+    w('json = _cson_gen_finish(&b);', 1)
+    w('CSON_STATS_LEAVE();', 1)
+    w('return json;', 1)
+    w('}')
+    w()
+    w('/**')
+    w(' * @brief 释放对象')
+    w(' *')
+    w(' * @param obj 对象')
+    w(' */')
+    w('void cson_gen_%s_free(%s *obj)' % (mdl.name, mdl.type))
+    w('{')
+    w('CSON_STATS_ENTER(%s);' % mdl.ref(), 1)
+    w('_cson_gen_free_%s(obj);' % mdl.name, 1)
+    w('CSON_STATS_LEAVE();', 1)
+    w('}')
+    w()
+
+
+def banner(name, sources):
+    return ('/**\n'
+            ' * @file %s\n'
+            ' * @brief 由tools/cson_gen.py根据%s生成，请勿手动修改\n'
+            ' *\n'
+            ' */\n' % (name, ', '.join(sources)))
+
+
+def runtime_for(code):
+    """只保留生成代码直接或间接用到的运行时函数，避免未使用的static函数告警"""
+    chunks = re.split(r'\n(?=/\*\*\n)', RUNTIME.strip('\n'))
+    define = re.compile(r'^static [^\n(]*?\b(_cson_gen_\w+)\(', re.M)
+    refer = re.compile(r'\b(_cson_gen_\w+)\(')
+    names = {}
+    for i, chunk in enumerate(chunks):
+        m = define.search(chunk)
+        if m:
+            names[m.group(1)] = i
+    used = set(n for n in refer.findall(code) if n in names)
+    pending = list(used)
+    while pending:
+        for n in refer.findall(chunks[names.pop(pending.pop())]):
+            if n in names and n not in used:
+                used.add(n)
+                pending.append(n)
+    keep = [c for c in chunks if not define.search(c) or define.search(c).group(1) in used]
+    return '\n\n'.join(keep)
+
+
+def generate(models, out, includes, sources):
+    base = os.path.basename(out)
+    guard = '__%s_H__' % re.sub(r'\W', '_', base).upper()
+
+    h = Writer()
+    h(banner(base + '.h', sources).rstrip('\n'))
+    h()
+    h('#ifndef %s' % guard)
+    h('#define %s' % guard)
+    h()
+    h('#include "cson.h"')
+    for inc in includes:
+        h('#include "%s"' % inc)
+    h()
+    for mdl in models:
+        h('%s *cson_gen_%s_decode(const char *json_str);' % (mdl.type, mdl.name))
+        h('char *cson_gen_%s_encode(const %s *obj);' % (mdl.name, mdl.type))
+        h('void cson_gen_%s_free(%s *obj);' % (mdl.name, mdl.type))
+        h()
+    h('#endif')
+
+    c = Writer()
+    c(banner(base + '.c', sources).rstrip('\n'))
+    c()
+    c('#include "%s.h"' % base)
+    c('#include "cJSON.h"')
+    c('#include "stddef.h"')
+    c('#include "string.h"')
+    c('#include "stdio.h"')
+    c('#include "stdlib.h"')
+    c('#include "limits.h"')
+    c('#include "float.h"')
+    c('#include "math.h"')
+    c('#include "ctype.h"')
+    exported = [mdl for mdl in models if not mdl.static]
+    if exported:
+        c()
+    for mdl in exported:
+        c('extern cson_model_t %s[];' % mdl.name)
+    body = Writer()
+    for mdl in models:
+        body('static void _cson_gen_fields_%s(cson_gen_reader_t *r, %s *obj);' % (mdl.name, mdl.type))
+        body('static %s *_cson_gen_read_%s(cson_gen_reader_t *r);' % (mdl.type, mdl.name))
+        body('static void _cson_gen_clear_%s(%s *obj);' % (mdl.name, mdl.type))
+        body('static void _cson_gen_free_%s(%s *obj);' % (mdl.name, mdl.type))
+        body('static void _cson_gen_encode_%s(cson_gen_buf_t *b, const %s *obj);' % (mdl.name, mdl.type))
+    body()
+    for mdl in models:
+        emit_decode(body, mdl)
+        emit_free(body, mdl)
+        emit_encode(body, mdl)
+        emit_public(body, mdl)
+    c()
+    c(runtime_for(body.text()))
+    c()
+    c(body.text().rstrip('\n'))
+
+    with open(out + '.h', 'w', encoding='utf-8') as fp:
+        fp.write(h.text())
+    with open(out + '.c', 'w', encoding='utf-8') as fp:
+        fp.write(c.text().rstrip('\n') + '\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='generate specialized codecs from cson_model_t definitions')
+    parser.add_argument('sources', nargs='+', help='C files containing cson_model_t definitions')
+    parser.add_argument('-o', '--output', required=True, help='output path without extension')
+    parser.add_argument('--include', action='append', default=[],
+                        help='header declaring the struct types, included by the generated code')
+    args = parser.parse_args()
+    try:
+        models = parse_models(args.sources)
+    except (GenError, IOError) as e:
+        sys.stderr.write('cson_gen: %s\n' % e)
+        return 1
+    if not models:
+        sys.stderr.write('cson_gen: no cson_model_t found\n')
+        return 1
+    generate(models, args.output, args.include, [os.path.basename(s) for s in args.sources])
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())